@@ -9,6 +9,8 @@
 #   * common_disable_in_src_builds()
 #   * common_warn_build_type([DEFAULT])
 #   * common_option(<NAME> [CHOICES] [DESCRIPTION] [DEFAULT])
+#   * common_perfect_hash(<NAME> KEYS_FILE [OUTPUT_DIR] [GENERATOR]
+#                         [OUTPUT_SOURCES])
 # Macros:
 #   * n/a
 # ~~~
@@ -180,3 +182,68 @@ function(common_option NAME)
     )
   endif()
 endfunction()
+
+# ~~~
+# Generate, at build time, the C sources <NAME>.c/<NAME>.h of a minimal perfect
+# hash over the static set of keys listed inside KEYS_FILE (one key per line,
+# empty lines are ignored). The generated header declares:
+#   * K_<UPPER NAME>_SIZE: Number of keys;
+#   * <NAME>_Find(struct atb_StrView key, size_t *index) -> bool: Find key
+#     inside the set (single key comparison), returning its index (line order
+#     of KEYS_FILE);
+#   * <NAME>_Key(size_t index) -> struct atb_StrView: index-th key.
+#
+# The generated source needs to be linked against atb (atb_Hash_StrView).
+#
+# Arguments:
+#   * NAME (in):
+#       Prefix of the generated functions, and name of the generated files.
+#   * KEYS_FILE <FILE> (in):
+#       File listing the keys. Sources are re-generated when it changes.
+#   * OUTPUT_DIR <DIR> (optional - in):
+#       Directory of the generated files (Default: CMAKE_CURRENT_BINARY_DIR).
+#   * GENERATOR <TARGET> (optional - in):
+#       Generator executable target (Default: atb-perfect-hash).
+#   * OUTPUT_SOURCES <VAR> (optional - out):
+#       Variable set to the list of generated files, to be added to the
+#       sources of a target.
+# ~~~
+function(common_perfect_hash NAME)
+  cmake_parse_arguments(_args
+    ""                                              # <- Flags
+    "KEYS_FILE;OUTPUT_DIR;GENERATOR;OUTPUT_SOURCES" # <- One value
+    ""                                              # <- Multi values
+    ${ARGN}
+  )
+
+  if(NOT _args_KEYS_FILE)
+    message(FATAL_ERROR
+      " common_perfect_hash(${NAME}): KEYS_FILE is required.\n"
+    )
+  endif()
+
+  if(NOT _args_OUTPUT_DIR)
+    set(_args_OUTPUT_DIR ${CMAKE_CURRENT_BINARY_DIR})
+  endif()
+
+  if(NOT _args_GENERATOR)
+    set(_args_GENERATOR atb-perfect-hash)
+  endif()
+
+  get_filename_component(_keys_file "${_args_KEYS_FILE}" ABSOLUTE)
+  set(_source "${_args_OUTPUT_DIR}/${NAME}.c")
+  set(_header "${_args_OUTPUT_DIR}/${NAME}.h")
+
+  add_custom_command(
+    OUTPUT "${_source}" "${_header}"
+    COMMAND ${CMAKE_COMMAND} -E make_directory "${_args_OUTPUT_DIR}"
+    COMMAND ${_args_GENERATOR} ${NAME} "${_keys_file}" "${_source}" "${_header}"
+    DEPENDS ${_args_GENERATOR} "${_keys_file}"
+    COMMENT "Generating perfect hash ${NAME} from ${_args_KEYS_FILE}"
+    VERBATIM
+  )
+
+  if(_args_OUTPUT_SOURCES)
+    set(${_args_OUTPUT_SOURCES} "${_source}" "${_header}" PARENT_SCOPE)
+  endif()
+endfunction()
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <assert.h>
 #include <stdint.h>
 
 #include "atb/macro.h"
@@ -45,6 +46,76 @@ extern "C" {
     (value) &= ~(ATB_BITMASK(i, ##__VA_ARGS__)); \
   } while (0)
 
+/**
+ *  \return Number of bits set to 0b1 inside value
+ *
+ *  \note Uses the POPCNT instruction when the target supports it, SWAR
+ *        otherwise (faster than the generic libgcc fallback)
+ */
+static inline unsigned atb_Bits_Popcount_u64(uint64_t value);
+
+/**
+ *  \return Index of the least significant bit set to 0b1 ('Count Trailing
+ *          Zeros')
+ *
+ *  \pre value != 0
+ */
+static inline unsigned atb_Bits_Ctz_u64(uint64_t value);
+
+/**
+ *  \return Number of bits set to 0b0 before the most significant bit set to
+ *          0b1 ('Count Leading Zeros')
+ *
+ *  \pre value != 0
+ */
+static inline unsigned atb_Bits_Clz_u64(uint64_t value);
+
+/***************************************************************************/
+/*                           Inline definitions                            */
+/***************************************************************************/
+
+static inline unsigned atb_Bits_Popcount_u64(uint64_t value) {
+#if defined(__POPCNT__) || defined(__ARM_NEON)
+  return (unsigned)__builtin_popcountll(value);
+#else
+  value = value - ((value >> 1) & 0x5555555555555555ULL);
+  value = (value & 0x3333333333333333ULL) +
+          ((value >> 2) & 0x3333333333333333ULL);
+  value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return (unsigned)((value * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+static inline unsigned atb_Bits_Ctz_u64(uint64_t value) {
+  assert(value != 0);
+
+#if defined(__GNUC__) || defined(__clang__)
+  return (unsigned)__builtin_ctzll(value);
+#else
+  unsigned count = 0;
+  while ((value & 0x1) == 0) {
+    value >>= 1;
+    count++;
+  }
+  return count;
+#endif
+}
+
+static inline unsigned atb_Bits_Clz_u64(uint64_t value) {
+  assert(value != 0);
+
+#if defined(__GNUC__) || defined(__clang__)
+  return (unsigned)__builtin_clzll(value);
+#else
+  unsigned count = 0;
+  while ((value & 0x8000000000000000ULL) == 0) {
+    value <<= 1;
+    count++;
+  }
+  return count;
+#endif
+}
+
 #if defined(__cplusplus)
 } /* extern "C" */
 #endif
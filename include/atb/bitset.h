@@ -0,0 +1,235 @@
+#pragma once
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "atb/bits.h"
+#include "atb/export.h"
+#include "atb/span/ints.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/// Number of bits stored inside a single word of a bitset
+#define K_ATB_BITSET_WORD_BITS 64
+
+/// Number of uint64_t words needed to store \a BITS bits
+#define ATB_BITSET_WORDS_FOR(BITS) \
+  (((BITS) + (K_ATB_BITSET_WORD_BITS - 1)) / K_ATB_BITSET_WORD_BITS)
+
+/**
+ *  \brief Dynamic bitset, storing its bits inside a user provided span of
+ *         words
+ *
+ *  Bit i is stored inside words.data[i / 64], at position (i % 64) (least
+ *  significant bit first). Bits of the last word beyond size are never
+ *  modified nor taken into account by the functions below.
+ *
+ *  Example:
+ *  uint64_t storage[ATB_BITSET_WORDS_FOR(1000)];
+ *  struct atb_Bitset rows = atb_Bitset_From(
+ *      (struct atb_Span_u64)atb_AnySpan_From_Array(storage), 1000);
+ *
+ *  atb_Bitset_ClearRange(rows, 0, rows.size);
+ *  atb_Bitset_SetRange(rows, 10, 20);
+ *
+ *  for (size_t i = atb_Bitset_FindFirst(rows); i < rows.size;
+ *       i = atb_Bitset_FindNext(rows, i + 1)) {
+ *    ...
+ *  }
+ */
+struct atb_Bitset {
+  struct atb_Span_u64 words; /*!< Storage of the bits */
+  size_t size;               /*!< Number of bits */
+};
+
+/* Init *********************************************************************/
+
+/**
+ *  \brief Construct a bitset of \a size bits over \a words
+ *
+ *  \note The bits are NOT initialized
+ *
+ *  \pre atb_Span_u64_IsValid(words)
+ *  \pre words.size >= ATB_BITSET_WORDS_FOR(size)
+ */
+static inline struct atb_Bitset atb_Bitset_From(struct atb_Span_u64 words,
+                                                size_t size);
+
+/* Single bit ***************************************************************/
+
+/**
+ *  \return True when the bit \a i is set
+ *
+ *  \pre i < self.size
+ */
+static inline bool atb_Bitset_Test(struct atb_Bitset self, size_t i);
+
+/**
+ *  \brief Set the bit \a i to 0b1
+ *
+ *  \pre i < self.size
+ */
+static inline void atb_Bitset_Set(struct atb_Bitset self, size_t i);
+
+/**
+ *  \brief Set the bit \a i to 0b0
+ *
+ *  \pre i < self.size
+ */
+static inline void atb_Bitset_Clear(struct atb_Bitset self, size_t i);
+
+/* Ranges *******************************************************************/
+
+/**
+ *  \brief Set the \a count bits starting at \a first to 0b1
+ *
+ *  \pre (first + count) <= self.size
+ *
+ *  \note Complexity: O(count / 64)
+ */
+ATB_PUBLIC extern void atb_Bitset_SetRange(struct atb_Bitset self, size_t first,
+                                           size_t count);
+
+/**
+ *  \brief Set the \a count bits starting at \a first to 0b0
+ *
+ *  \pre (first + count) <= self.size
+ *
+ *  \note Complexity: O(count / 64)
+ */
+ATB_PUBLIC extern void atb_Bitset_ClearRange(struct atb_Bitset self,
+                                             size_t first, size_t count);
+
+/**
+ *  \return True when ALL the \a count bits starting at \a first are set (true
+ *          for an empty range)
+ *
+ *  \pre (first + count) <= self.size
+ */
+ATB_PUBLIC extern bool atb_Bitset_TestAll(struct atb_Bitset self, size_t first,
+                                          size_t count);
+
+/**
+ *  \return True when ANY of the \a count bits starting at \a first is set
+ *          (false for an empty range)
+ *
+ *  \pre (first + count) <= self.size
+ */
+ATB_PUBLIC extern bool atb_Bitset_TestAny(struct atb_Bitset self, size_t first,
+                                          size_t count);
+
+/* Count / Find *************************************************************/
+
+/**
+ *  \return Number of bits set among the \a count bits starting at \a first
+ *
+ *  \pre (first + count) <= self.size
+ *
+ *  \note Complexity: O(count / 64), whole words are counted 4 at a time,
+ *        using POPCNT when the target supports it, SWAR otherwise
+ */
+ATB_PUBLIC extern size_t atb_Bitset_CountRange(struct atb_Bitset self,
+                                               size_t first, size_t count);
+
+/**
+ *  \return Number of bits set inside the bitset
+ */
+static inline size_t atb_Bitset_Count(struct atb_Bitset self);
+
+/**
+ *  \return Index of the first bit set at or after \a from, self.size when
+ *          there are none
+ *
+ *  \pre from <= self.size
+ *
+ *  \note Complexity: O((self.size - from) / 64) (one word at a time)
+ */
+ATB_PUBLIC extern size_t atb_Bitset_FindNext(struct atb_Bitset self,
+                                             size_t from);
+
+/**
+ *  \return Index of the first bit set, self.size when there are none
+ */
+static inline size_t atb_Bitset_FindFirst(struct atb_Bitset self);
+
+/* Set operations ***********************************************************/
+
+/**@{*/
+/**
+ *  \brief Word-wise set operations: dest = lhs OP rhs, with OP being one of:
+ *         - And: lhs & rhs (intersection)
+ *         - Or: lhs | rhs (union)
+ *         - Xor: lhs ^ rhs (symmetric difference)
+ *         - AndNot: lhs & ~rhs (difference)
+ *
+ *  \pre dest.size == lhs.size == rhs.size
+ *
+ *  \note dest may be the same bitset than lhs and/or rhs
+ *  \note Complexity: O(size / 64), loops are trivially auto-vectorized
+ */
+ATB_PUBLIC extern void atb_Bitset_And(struct atb_Bitset dest,
+                                      struct atb_Bitset lhs,
+                                      struct atb_Bitset rhs);
+
+ATB_PUBLIC extern void atb_Bitset_Or(struct atb_Bitset dest,
+                                     struct atb_Bitset lhs,
+                                     struct atb_Bitset rhs);
+
+ATB_PUBLIC extern void atb_Bitset_Xor(struct atb_Bitset dest,
+                                      struct atb_Bitset lhs,
+                                      struct atb_Bitset rhs);
+
+ATB_PUBLIC extern void atb_Bitset_AndNot(struct atb_Bitset dest,
+                                         struct atb_Bitset lhs,
+                                         struct atb_Bitset rhs);
+/**@}*/
+
+/***************************************************************************/
+/*                           Inline definitions                            */
+/***************************************************************************/
+
+static inline struct atb_Bitset atb_Bitset_From(struct atb_Span_u64 words,
+                                                size_t size) {
+  assert(atb_Span_u64_IsValid(words));
+  assert(words.size >= ATB_BITSET_WORDS_FOR(size));
+
+  struct atb_Bitset bitset;
+  bitset.words = words;
+  bitset.size = size;
+  return bitset;
+}
+
+static inline bool atb_Bitset_Test(struct atb_Bitset self, size_t i) {
+  assert(i < self.size);
+  return ((self.words.data[i / K_ATB_BITSET_WORD_BITS] >>
+           (i % K_ATB_BITSET_WORD_BITS)) &
+          0x1) != 0;
+}
+
+static inline void atb_Bitset_Set(struct atb_Bitset self, size_t i) {
+  assert(i < self.size);
+  self.words.data[i / K_ATB_BITSET_WORD_BITS] |=
+      (uint64_t)0x1 << (i % K_ATB_BITSET_WORD_BITS);
+}
+
+static inline void atb_Bitset_Clear(struct atb_Bitset self, size_t i) {
+  assert(i < self.size);
+  self.words.data[i / K_ATB_BITSET_WORD_BITS] &=
+      ~((uint64_t)0x1 << (i % K_ATB_BITSET_WORD_BITS));
+}
+
+static inline size_t atb_Bitset_Count(struct atb_Bitset self) {
+  return atb_Bitset_CountRange(self, 0, self.size);
+}
+
+static inline size_t atb_Bitset_FindFirst(struct atb_Bitset self) {
+  return atb_Bitset_FindNext(self, 0);
+}
+
+#if defined(__cplusplus)
+} /* extern "C" */
+#endif
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "atb/export.h"
+#include "atb/hash.h"
+#include "atb/span/ints.h"
+#include "atb/span/string.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/// Number of uint64_t words of a block (one 64 bytes cache line)
+#define K_ATB_BLOOM_BLOCK_WORDS 8
+
+/// Number of uint64_t words needed to hold \a KEYS keys with (at least)
+/// \a BITS_PER_KEY bits each, as whole blocks
+#define ATB_BLOOM_WORDS_FOR(KEYS, BITS_PER_KEY)                         \
+  (((((KEYS) * (BITS_PER_KEY)) / (K_ATB_BLOOM_BLOCK_WORDS * 64)) + 1) * \
+   K_ATB_BLOOM_BLOCK_WORDS)
+
+/**
+ *  \brief Blocked (split block) Bloom filter, storing its bits inside a user
+ *         provided span of words
+ *
+ *  Each key sets/tests 8 bits, one per word of a SINGLE 64 bytes block:
+ *  a probe costs at most one cache miss. With 10 bits per key, the false
+ *  positive rate is ~1%.
+ *
+ *  Keys are given as 64 bits hashes (e.g. atb_Hash_u64/atb_Hash_Bytes), the
+ *  32 upper bits select the block, the 32 lower ones the bits inside it.
+ *
+ *  Example:
+ *  static uint64_t storage[ATB_BLOOM_WORDS_FOR(100000, 10)];
+ *  struct atb_Bloom bloom = atb_Bloom_From(
+ *      (struct atb_Span_u64)atb_AnySpan_From_Array(storage));
+ *
+ *  atb_Bloom_Clear(bloom);
+ *  atb_Bloom_Insert(bloom, atb_Hash_u64(42));
+ *
+ *  if (atb_Bloom_MayContain(bloom, atb_Hash_u64(key))) {
+ *    ... expensive lookup ...
+ *  }
+ */
+struct atb_Bloom {
+  struct atb_Span_u64 words; /*!< Storage of the blocks */
+};
+
+/* Init *********************************************************************/
+
+/**
+ *  \brief Construct a filter over \a words
+ *
+ *  \note The bits are NOT initialized (see atb_Bloom_Clear)
+ *
+ *  \pre atb_Span_u64_IsValid(words)
+ *  \pre words.size is a non-zero multiple of K_ATB_BLOOM_BLOCK_WORDS
+ *  \pre (words.size / K_ATB_BLOOM_BLOCK_WORDS) <= UINT32_MAX
+ */
+static inline struct atb_Bloom atb_Bloom_From(struct atb_Span_u64 words);
+
+/**
+ *  \brief Remove ALL keys from the filter
+ */
+ATB_PUBLIC extern void atb_Bloom_Clear(struct atb_Bloom self);
+
+/* Single key ***************************************************************/
+
+/**
+ *  \brief Insert the key whose hash is \a hash
+ */
+static inline void atb_Bloom_Insert(struct atb_Bloom self, uint64_t hash);
+
+/**
+ *  \return False when the key whose hash is \a hash was never inserted, true
+ *          when it MAY have been
+ */
+static inline bool atb_Bloom_MayContain(struct atb_Bloom self, uint64_t hash);
+
+/* Batch ********************************************************************/
+
+/**
+ *  \brief Insert ALL the keys whose hashes are \a hashes
+ *
+ *  \pre atb_View_u64_IsValid(hashes)
+ *
+ *  \note Blocks are prefetched a few keys ahead, such that cache misses of
+ *        consecutive keys overlap
+ */
+ATB_PUBLIC extern void atb_Bloom_InsertBatch(struct atb_Bloom self,
+                                             struct atb_View_u64 hashes);
+
+/**
+ *  \brief Query ALL the keys whose hashes are \a hashes, setting results[i]
+ *         to 1 when the key i MAY have been inserted, 0 otherwise
+ *
+ *  \return Number of keys that MAY have been inserted
+ *
+ *  \pre atb_View_u64_IsValid(hashes)
+ *  \pre atb_Span_u8_IsValid(results)
+ *  \pre results.size >= hashes.size
+ */
+ATB_PUBLIC extern size_t atb_Bloom_QueryBatch(struct atb_Bloom self,
+                                              struct atb_View_u64 hashes,
+                                              struct atb_Span_u8 results);
+
+/**@{*/
+/**
+ *  \brief Same as atb_Bloom_InsertBatch/atb_Bloom_QueryBatch, with keys hashed
+ *         using atb_Hash_StrView(keys[i], K_ATB_HASH_SEED)
+ *
+ *  \pre keys != NULL || count == 0
+ *  \pre atb_Span_u8_IsValid(results) && results.size >= count
+ */
+ATB_PUBLIC extern void atb_Bloom_InsertStrs(struct atb_Bloom self,
+                                            struct atb_StrView const *keys,
+                                            size_t count);
+
+ATB_PUBLIC extern size_t atb_Bloom_QueryStrs(struct atb_Bloom self,
+                                             struct atb_StrView const *keys,
+                                             size_t count,
+                                             struct atb_Span_u8 results);
+/**@}*/
+
+/***************************************************************************/
+/*                           Inline definitions                            */
+/***************************************************************************/
+
+static inline struct atb_Bloom atb_Bloom_From(struct atb_Span_u64 words) {
+  assert(atb_Span_u64_IsValid(words));
+  assert((words.size > 0) && ((words.size % K_ATB_BLOOM_BLOCK_WORDS) == 0));
+  assert((words.size / K_ATB_BLOOM_BLOCK_WORDS) <= UINT32_MAX);
+
+  struct atb_Bloom bloom;
+  bloom.words = words;
+  return bloom;
+}
+
+/// First word of the block associated to hash (multiply-shift range
+/// reduction, no modulo)
+static inline uint64_t *atb_Bloom_BlockOf(struct atb_Bloom self,
+                                          uint64_t hash) {
+  uint64_t const blocks = self.words.size / K_ATB_BLOOM_BLOCK_WORDS;
+  uint64_t const block = ((hash >> 32) * blocks) >> 32;
+  return &(self.words.data[block * K_ATB_BLOOM_BLOCK_WORDS]);
+}
+
+/// Bit set inside the word i of a block for hash
+static inline uint64_t atb_Bloom_MaskOf(uint64_t hash, size_t i) {
+  static uint32_t const K_SALT[K_ATB_BLOOM_BLOCK_WORDS] = {
+      0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+      0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U,
+  };
+
+  uint32_t const key = (uint32_t)hash * K_SALT[i];
+  return (uint64_t)0x1 << (key >> 26);
+}
+
+static inline void atb_Bloom_Insert(struct atb_Bloom self, uint64_t hash) {
+  uint64_t *const block = atb_Bloom_BlockOf(self, hash);
+
+  for (size_t i = 0; i < K_ATB_BLOOM_BLOCK_WORDS; ++i) {
+    block[i] |= atb_Bloom_MaskOf(hash, i);
+  }
+}
+
+static inline bool atb_Bloom_MayContain(struct atb_Bloom self,
+                                        uint64_t hash) {
+  uint64_t const *const block = atb_Bloom_BlockOf(self, hash);
+  uint64_t missing = 0;
+
+  /* No early exit: the 8 tests are independent (vectorizable) */
+  for (size_t i = 0; i < K_ATB_BLOOM_BLOCK_WORDS; ++i) {
+    uint64_t const mask = atb_Bloom_MaskOf(hash, i);
+    missing |= (block[i] & mask) ^ mask;
+  }
+
+  return missing == 0;
+}
+
+#if defined(__cplusplus)
+} /* extern "C" */
+#endif
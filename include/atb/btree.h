@@ -0,0 +1,613 @@
+#pragma once
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "atb/allocator.h"
+#include "atb/compare.h"
+#include "atb/error.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/// Size (in bytes) of a cache line, used to tune the B-tree nodes size
+#define K_ATB_BTREE_CACHE_LINE_BYTES 64
+
+/// Number of cache lines covered by the keys of a single B-tree node
+#define K_ATB_BTREE_NODE_CACHE_LINES 4
+
+/// Minimum degree 't' of a B-tree node (each node, except the root, contains
+/// between t-1 and 2t-1 keys) storing keys of type \a K. This is tuned such
+/// that all keys of a node fit inside K_ATB_BTREE_NODE_CACHE_LINES cache lines.
+#define ATB_BTREE_MIN_DEGREE(K)                                          \
+  (((K_ATB_BTREE_NODE_CACHE_LINES * K_ATB_BTREE_CACHE_LINE_BYTES) /      \
+    (2 * sizeof(K))) < 2                                                 \
+       ? 2                                                               \
+       : ((K_ATB_BTREE_NODE_CACHE_LINES * K_ATB_BTREE_CACHE_LINE_BYTES) / \
+          (2 * sizeof(K))))
+
+/// Maximum number of keys inside a single B-tree node storing keys of type \a K
+#define ATB_BTREE_MAX_KEYS(K) (2 * ATB_BTREE_MIN_DEGREE(K) - 1)
+
+/// Declare an ordered map struct named \a NAME, implemented as a B-tree,
+/// associating UNIQUE keys of type \a K to values of type \a V, and all its
+/// associated functions. All functions are declared using \a SPECIFIER as
+/// specifiers.
+///
+/// Nodes are sized to fit K_ATB_BTREE_NODE_CACHE_LINES cache lines of keys
+/// (keys and values are stored in separate arrays, such that searching a node
+/// only touches keys), and are allocated through a struct atb_Allocator.
+///
+/// Functions declared are the following:
+/// - `_Init(self, allocator)`: Initialize an EMPTY map;
+/// - `_Destroy(self)`: Release all nodes of the map;
+/// - `_Size(self) -> size_t`: Number of elements inside the map;
+/// - `_Find(self, key) -> V*`: Value associated to key (NULL when not found);
+/// - `_Insert(self, key, value, err) -> bool`: Insert (or replace) the value
+///   associated to key. Only fails on allocation failure;
+/// - `_Erase(self, key, value) -> bool`: Remove key from the map, optionally
+///   returning the value removed. False when key wasn't found;
+/// - `_Begin(self) -> it`: Iterator to the smallest key;
+/// - `_LowerBound(self, key) -> it`: Iterator to the first key >= key;
+/// - `_UpperBound(self, key) -> it`: Iterator to the first key > key;
+/// - `_Iterator_IsEnd(it) -> bool`: True when it is the END iterator;
+/// - `_Iterator_Next(it) -> it`: Iterator to the next key (in order);
+/// - `_Iterator_Key(it) -> K const*`: Key pointed by the iterator;
+/// - `_Iterator_Value(it) -> V*`: Value pointed by the iterator;
+///
+/// Range scan example (all keys in [lo, hi)):
+///
+/// struct NAME_Iterator it;
+/// for (it = NAME_LowerBound(&map, lo);
+///      !NAME_Iterator_IsEnd(it) && (COMPARE(*NAME_Iterator_Key(it), hi) < 0);
+///      it = NAME_Iterator_Next(it)) {
+///   ...
+/// }
+#define ATB_BTREE_DECLARE(SPECIFIER, NAME, K, V)                           \
+  struct NAME##_Node {                                                     \
+    struct NAME##_Node *parent;                                            \
+    uint16_t count;                                                        \
+    uint16_t index;                                                        \
+    bool leaf;                                                             \
+    K keys[ATB_BTREE_MAX_KEYS(K)];                                         \
+    V values[ATB_BTREE_MAX_KEYS(K)];                                       \
+    struct NAME##_Node *childs[ATB_BTREE_MAX_KEYS(K) + 1];                 \
+  };                                                                       \
+                                                                           \
+  struct NAME {                                                            \
+    struct NAME##_Node *root;                                              \
+    size_t size;                                                           \
+    struct atb_Allocator const *allocator;                                 \
+  };                                                                       \
+                                                                           \
+  struct NAME##_Iterator {                                                 \
+    struct NAME##_Node *node;                                              \
+    size_t index;                                                          \
+  };                                                                       \
+                                                                           \
+  SPECIFIER void NAME##_Init(struct NAME *const self,                      \
+                             struct atb_Allocator const *const allocator); \
+  SPECIFIER void NAME##_Destroy(struct NAME *const self);                  \
+  SPECIFIER size_t NAME##_Size(struct NAME const *const self);             \
+  SPECIFIER V *NAME##_Find(struct NAME const *const self, K key);          \
+  SPECIFIER bool NAME##_Insert(struct NAME *const self, K key, V value,    \
+                               struct atb_Error *const err);               \
+  SPECIFIER bool NAME##_Erase(struct NAME *const self, K key,              \
+                              V *const value);                             \
+  SPECIFIER struct NAME##_Iterator NAME##_Begin(                           \
+      struct NAME const *const self);                                      \
+  SPECIFIER struct NAME##_Iterator NAME##_LowerBound(                      \
+      struct NAME const *const self, K key);                               \
+  SPECIFIER struct NAME##_Iterator NAME##_UpperBound(                      \
+      struct NAME const *const self, K key);                               \
+  SPECIFIER bool NAME##_Iterator_IsEnd(struct NAME##_Iterator it);         \
+  SPECIFIER struct NAME##_Iterator NAME##_Iterator_Next(                   \
+      struct NAME##_Iterator it);                                          \
+  SPECIFIER K const *NAME##_Iterator_Key(struct NAME##_Iterator it);       \
+  SPECIFIER V *NAME##_Iterator_Value(struct NAME##_Iterator it)
+
+/// Define all functions associated to a B-tree ordered map named \a NAME
+/// (struct needs to be declared beforehands using ATB_BTREE_DECLARE), with keys
+/// of type \a K and values of type \a V. All functions are defined using
+/// \a SPECIFIER as specifiers.
+///
+/// Keys are ordered using \a COMPARE, a function (or function-like macro)
+/// following the 'three-way comparison' idiom (see compare.h), with the
+/// following signature: `COMPARE(K lhs, K rhs) -> atb_Cmp_t`.
+///
+/// See ATB_BTREE_DECLARE for the list of functions defined.
+#define ATB_BTREE_DEFINE(SPECIFIER, NAME, K, V, COMPARE)                       \
+  enum {                                                                       \
+    NAME##_MIN_DEGREE = ATB_BTREE_MIN_DEGREE(K),                               \
+    NAME##_MAX_KEYS = ATB_BTREE_MAX_KEYS(K),                                   \
+  };                                                                           \
+                                                                               \
+  static struct NAME##_Node *NAME##_Node_New(struct NAME const *const self,    \
+                                             bool leaf,                        \
+                                             struct atb_Error *const err) {    \
+    /* Leaves never access their childs: don't allocate them */                \
+    size_t const size = leaf ? offsetof(struct NAME##_Node, childs)            \
+                             : sizeof(struct NAME##_Node);                     \
+                                                                               \
+    struct NAME##_Node *node = (struct NAME##_Node *)atb_Allocator_Alloc(      \
+        self->allocator, NULL, size, err);                                     \
+                                                                               \
+    if (node != NULL) {                                                        \
+      node->parent = NULL;                                                     \
+      node->count = 0;                                                         \
+      node->index = 0;                                                         \
+      node->leaf = leaf;                                                       \
+    }                                                                          \
+                                                                               \
+    return node;                                                               \
+  }                                                                            \
+                                                                               \
+  static void NAME##_Node_Delete(struct NAME const *const self,                \
+                                 struct NAME##_Node *node) {                   \
+    (void)atb_Allocator_Release(self->allocator, (void **)&node,               \
+                                K_ATB_ERROR_IGNORED);                          \
+  }                                                                            \
+                                                                               \
+  static void NAME##_Node_DeleteAll(struct NAME const *const self,             \
+                                    struct NAME##_Node *node) {                \
+    if (!node->leaf) {                                                         \
+      for (size_t i = 0; i <= node->count; ++i) {                              \
+        NAME##_Node_DeleteAll(self, node->childs[i]);                          \
+      }                                                                        \
+    }                                                                          \
+    NAME##_Node_Delete(self, node);                                            \
+  }                                                                            \
+                                                                               \
+  /* Index of the first key >= key (branchless binary search) */               \
+  static size_t NAME##_Node_LowerBound(struct NAME##_Node const *const node,   \
+                                       K key) {                                \
+    size_t first = 0;                                                          \
+    size_t len = node->count;                                                  \
+                                                                               \
+    if (len == 0) return 0;                                                    \
+                                                                               \
+    while (len > 1) {                                                          \
+      size_t const half = len / 2;                                             \
+      first += (COMPARE(node->keys[first + half - 1], key) < 0) ? half : 0;    \
+      len -= half;                                                             \
+    }                                                                          \
+                                                                               \
+    return first + (COMPARE(node->keys[first], key) < 0 ? 1 : 0);              \
+  }                                                                            \
+                                                                               \
+  /* Index of the first key > key (branchless binary search) */                \
+  static size_t NAME##_Node_UpperBound(struct NAME##_Node const *const node,   \
+                                       K key) {                                \
+    size_t first = 0;                                                          \
+    size_t len = node->count;                                                  \
+                                                                               \
+    if (len == 0) return 0;                                                    \
+                                                                               \
+    while (len > 1) {                                                          \
+      size_t const half = len / 2;                                             \
+      first += (COMPARE(node->keys[first + half - 1], key) <= 0) ? half : 0;   \
+      len -= half;                                                             \
+    }                                                                          \
+                                                                               \
+    return first + (COMPARE(node->keys[first], key) <= 0 ? 1 : 0);             \
+  }                                                                            \
+                                                                               \
+  /* Set node->childs[i] = child, updating child's back-links */               \
+  static void NAME##_Node_SetChild(struct NAME##_Node *const node, size_t i,   \
+                                   struct NAME##_Node *const child) {          \
+    node->childs[i] = child;                                                   \
+    child->parent = node;                                                      \
+    child->index = (uint16_t)i;                                                \
+  }                                                                            \
+                                                                               \
+  /* Shift elements [from, count) of node by 'shift' (+1/-1) positions. When   \
+   * the node is internal, childs [from + 1, count + 1) are shifted too. */    \
+  static void NAME##_Node_Shift(struct NAME##_Node *const node, size_t from,   \
+                                int shift) {                                   \
+    size_t const n = node->count - from;                                       \
+    size_t const to = (size_t)((ptrdiff_t)from + shift);                       \
+                                                                               \
+    memmove(&(node->keys[to]), &(node->keys[from]), n * sizeof(K));            \
+    memmove(&(node->values[to]), &(node->values[from]), n * sizeof(V));        \
+                                                                               \
+    if (!node->leaf) {                                                         \
+      memmove(&(node->childs[to + 1]), &(node->childs[from + 1]),              \
+              n * sizeof(struct NAME##_Node *));                               \
+      for (size_t i = to + 1; i <= to + n; ++i) {                              \
+        node->childs[i]->index = (uint16_t)i;                                  \
+      }                                                                        \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  /* Split the FULL child parent->childs[i] in 2, moving its median key up */  \
+  static bool NAME##_SplitChild(struct NAME const *const self,                 \
+                                struct NAME##_Node *const parent, size_t i,    \
+                                struct atb_Error *const err) {                 \
+    size_t const t = NAME##_MIN_DEGREE;                                        \
+    struct NAME##_Node *const lhs = parent->childs[i];                         \
+    struct NAME##_Node *const rhs = NAME##_Node_New(self, lhs->leaf, err);     \
+                                                                               \
+    if (rhs == NULL) return false;                                             \
+                                                                               \
+    assert(lhs->count == NAME##_MAX_KEYS);                                     \
+                                                                               \
+    memcpy(rhs->keys, &(lhs->keys[t]), (t - 1) * sizeof(K));                   \
+    memcpy(rhs->values, &(lhs->values[t]), (t - 1) * sizeof(V));               \
+    if (!lhs->leaf) {                                                          \
+      for (size_t j = 0; j < t; ++j) {                                         \
+        NAME##_Node_SetChild(rhs, j, lhs->childs[t + j]);                      \
+      }                                                                        \
+    }                                                                          \
+    rhs->count = (uint16_t)(t - 1);                                            \
+    lhs->count = (uint16_t)(t - 1);                                            \
+                                                                               \
+    NAME##_Node_Shift(parent, i, +1);                                          \
+    parent->keys[i] = lhs->keys[t - 1];                                        \
+    parent->values[i] = lhs->values[t - 1];                                    \
+    NAME##_Node_SetChild(parent, i + 1, rhs);                                  \
+    parent->count = (uint16_t)(parent->count + 1);                             \
+                                                                               \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  /* Merge parent->childs[i + 1] and the key i into parent->childs[i] */       \
+  static void NAME##_MergeChilds(struct NAME const *const self,                \
+                                 struct NAME##_Node *const parent, size_t i) { \
+    struct NAME##_Node *const lhs = parent->childs[i];                         \
+    struct NAME##_Node *const rhs = parent->childs[i + 1];                     \
+    size_t const offset = lhs->count + 1u;                                     \
+                                                                               \
+    assert((lhs->count + rhs->count + 1u) <= NAME##_MAX_KEYS);                 \
+                                                                               \
+    lhs->keys[lhs->count] = parent->keys[i];                                   \
+    lhs->values[lhs->count] = parent->values[i];                               \
+    memcpy(&(lhs->keys[offset]), rhs->keys, rhs->count * sizeof(K));           \
+    memcpy(&(lhs->values[offset]), rhs->values, rhs->count * sizeof(V));       \
+    if (!lhs->leaf) {                                                          \
+      for (size_t j = 0; j <= rhs->count; ++j) {                               \
+        NAME##_Node_SetChild(lhs, offset + j, rhs->childs[j]);                 \
+      }                                                                        \
+    }                                                                          \
+    lhs->count = (uint16_t)(offset + rhs->count);                              \
+                                                                               \
+    NAME##_Node_Shift(parent, i + 1, -1);                                      \
+    parent->count = (uint16_t)(parent->count - 1);                             \
+                                                                               \
+    NAME##_Node_Delete(self, rhs);                                             \
+  }                                                                            \
+                                                                               \
+  /* Make sure parent->childs[i] contains at least t keys, by borrowing from a \
+   * sibling or merging with it. Returns the index of the child containing the \
+   * keys initially in parent->childs[i]. */                                   \
+  static size_t NAME##_FillChild(struct NAME const *const self,                \
+                                 struct NAME##_Node *const parent, size_t i) { \
+    size_t const t = NAME##_MIN_DEGREE;                                        \
+    struct NAME##_Node *const child = parent->childs[i];                       \
+                                                                               \
+    if ((i > 0) && (parent->childs[i - 1]->count >= t)) {                      \
+      struct NAME##_Node *const left = parent->childs[i - 1];                  \
+                                                                               \
+      memmove(&(child->keys[1]), child->keys, child->count * sizeof(K));       \
+      memmove(&(child->values[1]), child->values, child->count * sizeof(V));   \
+      child->keys[0] = parent->keys[i - 1];                                    \
+      child->values[0] = parent->values[i - 1];                                \
+      if (!child->leaf) {                                                      \
+        for (size_t j = child->count + 1u; j > 0; --j) {                       \
+          NAME##_Node_SetChild(child, j, child->childs[j - 1]);                \
+        }                                                                      \
+        NAME##_Node_SetChild(child, 0, left->childs[left->count]);             \
+      }                                                                        \
+      child->count = (uint16_t)(child->count + 1);                             \
+                                                                               \
+      parent->keys[i - 1] = left->keys[left->count - 1];                       \
+      parent->values[i - 1] = left->values[left->count - 1];                   \
+      left->count = (uint16_t)(left->count - 1);                               \
+    } else if ((i < parent->count) && (parent->childs[i + 1]->count >= t)) {   \
+      struct NAME##_Node *const right = parent->childs[i + 1];                 \
+                                                                               \
+      child->keys[child->count] = parent->keys[i];                             \
+      child->values[child->count] = parent->values[i];                         \
+      if (!child->leaf) {                                                      \
+        NAME##_Node_SetChild(child, child->count + 1u, right->childs[0]);      \
+      }                                                                        \
+      child->count = (uint16_t)(child->count + 1);                             \
+                                                                               \
+      parent->keys[i] = right->keys[0];                                        \
+      parent->values[i] = right->values[0];                                    \
+                                                                               \
+      memmove(right->keys, &(right->keys[1]),                                  \
+              (right->count - 1u) * sizeof(K));                                \
+      memmove(right->values, &(right->values[1]),                              \
+              (right->count - 1u) * sizeof(V));                                \
+      if (!right->leaf) {                                                      \
+        for (size_t j = 0; j < right->count; ++j) {                            \
+          NAME##_Node_SetChild(right, j, right->childs[j + 1]);                \
+        }                                                                      \
+      }                                                                        \
+      right->count = (uint16_t)(right->count - 1);                             \
+    } else if (i < parent->count) {                                            \
+      NAME##_MergeChilds(self, parent, i);                                     \
+    } else {                                                                   \
+      i -= 1;                                                                  \
+      NAME##_MergeChilds(self, parent, i);                                     \
+    }                                                                          \
+                                                                               \
+    return i;                                                                  \
+  }                                                                            \
+                                                                               \
+  SPECIFIER void NAME##_Init(struct NAME *const self,                          \
+                             struct atb_Allocator const *const allocator) {    \
+    assert(self != NULL);                                                      \
+    assert(allocator != NULL);                                                 \
+                                                                               \
+    self->root = NULL;                                                         \
+    self->size = 0;                                                            \
+    self->allocator = allocator;                                               \
+  }                                                                            \
+                                                                               \
+  SPECIFIER void NAME##_Destroy(struct NAME *const self) {                     \
+    assert(self != NULL);                                                      \
+                                                                               \
+    if (self->root != NULL) {                                                  \
+      NAME##_Node_DeleteAll(self, self->root);                                 \
+    }                                                                          \
+                                                                               \
+    self->root = NULL;                                                         \
+    self->size = 0;                                                            \
+  }                                                                            \
+                                                                               \
+  SPECIFIER size_t NAME##_Size(struct NAME const *const self) {                \
+    assert(self != NULL);                                                      \
+    return self->size;                                                         \
+  }                                                                            \
+                                                                               \
+  SPECIFIER V *NAME##_Find(struct NAME const *const self, K key) {             \
+    assert(self != NULL);                                                      \
+                                                                               \
+    struct NAME##_Node *node = self->root;                                     \
+                                                                               \
+    while (node != NULL) {                                                     \
+      size_t const i = NAME##_Node_LowerBound(node, key);                      \
+                                                                               \
+      if ((i < node->count) && (COMPARE(node->keys[i], key) == 0)) {           \
+        return &(node->values[i]);                                             \
+      }                                                                        \
+                                                                               \
+      node = node->leaf ? NULL : node->childs[i];                              \
+    }                                                                          \
+                                                                               \
+    return NULL;                                                               \
+  }                                                                            \
+                                                                               \
+  SPECIFIER bool NAME##_Insert(struct NAME *const self, K key, V value,        \
+                               struct atb_Error *const err) {                  \
+    assert(self != NULL);                                                      \
+                                                                               \
+    if (self->root == NULL) {                                                  \
+      self->root = NAME##_Node_New(self, true, err);                           \
+      if (self->root == NULL) return false;                                    \
+    } else if (self->root->count == NAME##_MAX_KEYS) {                         \
+      struct NAME##_Node *const root = NAME##_Node_New(self, false, err);      \
+      if (root == NULL) return false;                                          \
+                                                                               \
+      NAME##_Node_SetChild(root, 0, self->root);                               \
+      if (!NAME##_SplitChild(self, root, 0, err)) {                            \
+        self->root->parent = NULL;                                             \
+        NAME##_Node_Delete(self, root);                                        \
+        return false;                                                          \
+      }                                                                        \
+                                                                               \
+      self->root = root;                                                       \
+    }                                                                          \
+                                                                               \
+    struct NAME##_Node *node = self->root;                                     \
+                                                                               \
+    while (true) {                                                             \
+      size_t i = NAME##_Node_LowerBound(node, key);                            \
+                                                                               \
+      if ((i < node->count) && (COMPARE(node->keys[i], key) == 0)) {           \
+        node->values[i] = value;                                               \
+        return true;                                                           \
+      }                                                                        \
+                                                                               \
+      if (node->leaf) {                                                        \
+        NAME##_Node_Shift(node, i, +1);                                        \
+        node->keys[i] = key;                                                   \
+        node->values[i] = value;                                               \
+        node->count = (uint16_t)(node->count + 1);                             \
+        self->size += 1;                                                       \
+        return true;                                                           \
+      }                                                                        \
+                                                                               \
+      if (node->childs[i]->count == NAME##_MAX_KEYS) {                         \
+        if (!NAME##_SplitChild(self, node, i, err)) return false;              \
+                                                                               \
+        atb_Cmp_t const cmp = COMPARE(node->keys[i], key);                     \
+        if (cmp == 0) {                                                        \
+          node->values[i] = value;                                             \
+          return true;                                                         \
+        } else if (cmp < 0) {                                                  \
+          i += 1;                                                              \
+        }                                                                      \
+      }                                                                        \
+                                                                               \
+      node = node->childs[i];                                                  \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  SPECIFIER bool NAME##_Erase(struct NAME *const self, K key,                  \
+                              V *const value) {                                \
+    assert(self != NULL);                                                      \
+                                                                               \
+    size_t const t = NAME##_MIN_DEGREE;                                        \
+    struct NAME##_Node *node = self->root;                                     \
+    bool found = false;                                                        \
+                                                                               \
+    while (node != NULL) {                                                     \
+      size_t i = NAME##_Node_LowerBound(node, key);                            \
+      bool const here =                                                        \
+          (i < node->count) && (COMPARE(node->keys[i], key) == 0);             \
+                                                                               \
+      if (here && !found) {                                                    \
+        found = true;                                                          \
+        if (value != NULL) *value = node->values[i];                           \
+      }                                                                        \
+                                                                               \
+      if (node->leaf) {                                                        \
+        if (here) {                                                            \
+          NAME##_Node_Shift(node, i + 1, -1);                                  \
+          node->count = (uint16_t)(node->count - 1);                           \
+        }                                                                      \
+        break;                                                                 \
+      }                                                                        \
+                                                                               \
+      if (here) {                                                              \
+        struct NAME##_Node *const lhs = node->childs[i];                       \
+        struct NAME##_Node *const rhs = node->childs[i + 1];                   \
+                                                                               \
+        if (lhs->count >= t) {                                                 \
+          /* Replace key by its predecessor, then erase the predecessor */     \
+          struct NAME##_Node *pred = lhs;                                      \
+          while (!pred->leaf) pred = pred->childs[pred->count];                \
+                                                                               \
+          node->keys[i] = key = pred->keys[pred->count - 1];                   \
+          node->values[i] = pred->values[pred->count - 1];                     \
+          node = lhs;                                                          \
+        } else if (rhs->count >= t) {                                          \
+          /* Replace key by its successor, then erase the successor */         \
+          struct NAME##_Node *succ = rhs;                                      \
+          while (!succ->leaf) succ = succ->childs[0];                          \
+                                                                               \
+          node->keys[i] = key = succ->keys[0];                                 \
+          node->values[i] = succ->values[0];                                   \
+          node = rhs;                                                          \
+        } else {                                                               \
+          NAME##_MergeChilds(self, node, i);                                   \
+          node = lhs;                                                          \
+        }                                                                      \
+      } else {                                                                 \
+        if (node->childs[i]->count < t) {                                      \
+          i = NAME##_FillChild(self, node, i);                                 \
+        }                                                                      \
+        node = node->childs[i];                                                \
+      }                                                                        \
+    }                                                                          \
+                                                                               \
+    if ((self->root != NULL) && (self->root->count == 0)) {                    \
+      struct NAME##_Node *const root = self->root;                             \
+                                                                               \
+      if (root->leaf) {                                                        \
+        self->root = NULL;                                                     \
+      } else {                                                                 \
+        self->root = root->childs[0];                                          \
+        self->root->parent = NULL;                                             \
+        self->root->index = 0;                                                 \
+      }                                                                        \
+                                                                               \
+      NAME##_Node_Delete(self, root);                                          \
+    }                                                                          \
+                                                                               \
+    if (found) self->size -= 1;                                                \
+                                                                               \
+    return found;                                                              \
+  }                                                                            \
+                                                                               \
+  SPECIFIER struct NAME##_Iterator NAME##_Begin(                               \
+      struct NAME const *const self) {                                         \
+    assert(self != NULL);                                                      \
+                                                                               \
+    struct NAME##_Iterator it = {NULL, 0};                                     \
+                                                                               \
+    if (self->size > 0) {                                                      \
+      it.node = self->root;                                                    \
+      while (!it.node->leaf) it.node = it.node->childs[0];                     \
+    }                                                                          \
+                                                                               \
+    return it;                                                                 \
+  }                                                                            \
+                                                                               \
+  SPECIFIER struct NAME##_Iterator NAME##_LowerBound(                          \
+      struct NAME const *const self, K key) {                                  \
+    assert(self != NULL);                                                      \
+                                                                               \
+    struct NAME##_Iterator it = {NULL, 0};                                     \
+    struct NAME##_Node *node = self->root;                                     \
+                                                                               \
+    while (node != NULL) {                                                     \
+      size_t const i = NAME##_Node_LowerBound(node, key);                      \
+                                                                               \
+      if (i < node->count) {                                                   \
+        it.node = node;                                                        \
+        it.index = i;                                                          \
+        if (COMPARE(node->keys[i], key) == 0) break;                           \
+      }                                                                        \
+                                                                               \
+      node = node->leaf ? NULL : node->childs[i];                              \
+    }                                                                          \
+                                                                               \
+    return it;                                                                 \
+  }                                                                            \
+                                                                               \
+  SPECIFIER struct NAME##_Iterator NAME##_UpperBound(                          \
+      struct NAME const *const self, K key) {                                  \
+    assert(self != NULL);                                                      \
+                                                                               \
+    struct NAME##_Iterator it = {NULL, 0};                                     \
+    struct NAME##_Node *node = self->root;                                     \
+                                                                               \
+    while (node != NULL) {                                                     \
+      size_t const i = NAME##_Node_UpperBound(node, key);                      \
+                                                                               \
+      if (i < node->count) {                                                   \
+        it.node = node;                                                        \
+        it.index = i;                                                          \
+      }                                                                        \
+                                                                               \
+      node = node->leaf ? NULL : node->childs[i];                              \
+    }                                                                          \
+                                                                               \
+    return it;                                                                 \
+  }                                                                            \
+                                                                               \
+  SPECIFIER bool NAME##_Iterator_IsEnd(struct NAME##_Iterator it) {            \
+    return it.node == NULL;                                                    \
+  }                                                                            \
+                                                                               \
+  SPECIFIER struct NAME##_Iterator NAME##_Iterator_Next(                       \
+      struct NAME##_Iterator it) {                                             \
+    assert(!NAME##_Iterator_IsEnd(it));                                        \
+                                                                               \
+    if (!it.node->leaf) {                                                      \
+      it.node = it.node->childs[it.index + 1];                                 \
+      while (!it.node->leaf) it.node = it.node->childs[0];                     \
+      it.index = 0;                                                            \
+    } else {                                                                   \
+      it.index += 1;                                                           \
+      while ((it.node != NULL) && (it.index >= it.node->count)) {              \
+        it.index = it.node->index;                                             \
+        it.node = it.node->parent;                                             \
+      }                                                                        \
+    }                                                                          \
+                                                                               \
+    return it;                                                                 \
+  }                                                                            \
+                                                                               \
+  SPECIFIER K const *NAME##_Iterator_Key(struct NAME##_Iterator it) {          \
+    assert(!NAME##_Iterator_IsEnd(it));                                        \
+    return &(it.node->keys[it.index]);                                         \
+  }                                                                            \
+                                                                               \
+  SPECIFIER V *NAME##_Iterator_Value(struct NAME##_Iterator it) {              \
+    assert(!NAME##_Iterator_IsEnd(it));                                        \
+    return &(it.node->values[it.index]);                                       \
+  }                                                                            \
+                                                                               \
+  static_assert(true, "SEMI-COLON NEEDED HERE")
+
+#if defined(__cplusplus)
+}
+#endif
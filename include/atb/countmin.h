@@ -0,0 +1,155 @@
+#pragma once
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "atb/export.h"
+#include "atb/hash.h"
+#include "atb/span/ints.h"
+#include "atb/span/string.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ *  \brief Count-Min frequency sketch, storing its counters inside a user
+ *         provided span
+ *
+ *  Counters are organized as depth rows of width counters each. Estimated
+ *  frequencies are never below the real ones, and exceed them by at most
+ *  (e * total / width) with probability (1 - exp(-depth)).
+ *
+ *  Memory is fixed (counters are saturating, they never wrap).
+ *
+ *  Example:
+ *  static uint32_t counters[4 * 2048];
+ *  struct atb_CountMin cms = atb_CountMin_From(
+ *      (struct atb_Span_u32)atb_AnySpan_From_Array(counters), 4);
+ *
+ *  atb_CountMin_Clear(&cms);
+ *  atb_CountMin_AddStrs(&cms, endpoints, count);
+ *
+ *  uint32_t const hits = atb_CountMin_Estimate(
+ *      &cms, atb_Hash_StrView(endpoint, K_ATB_HASH_SEED));
+ *
+ *  if (hits > (cms.total / 100)) { ... heavy hitter ... }
+ */
+struct atb_CountMin {
+  struct atb_Span_u32 counters; /*!< depth rows of width counters */
+  size_t width;                 /*!< Number of counters per row */
+  size_t depth;                 /*!< Number of rows */
+  uint64_t total;               /*!< Sum of all the counts added */
+};
+
+/* Init *********************************************************************/
+
+/**
+ *  \brief Construct a sketch of \a depth rows over \a counters
+ *
+ *  \note The counters are NOT initialized (see atb_CountMin_Clear)
+ *
+ *  \pre atb_Span_u32_IsValid(counters)
+ *  \pre depth > 0
+ *  \pre counters.size is a non-zero multiple of depth
+ *  \pre (counters.size / depth) <= UINT32_MAX
+ */
+static inline struct atb_CountMin atb_CountMin_From(
+    struct atb_Span_u32 counters, size_t depth);
+
+/**
+ *  \brief Reset ALL counters
+ *
+ *  \pre self != NULL
+ */
+ATB_PUBLIC extern void atb_CountMin_Clear(struct atb_CountMin *const self);
+
+/* Update *******************************************************************/
+
+/**
+ *  \brief Add \a count occurrences of the element whose hash is \a hash
+ *
+ *  \pre self != NULL
+ *
+ *  \note Complexity: O(depth)
+ */
+ATB_PUBLIC extern void atb_CountMin_Add(struct atb_CountMin *const self,
+                                        uint64_t hash, uint32_t count);
+
+/**
+ *  \brief Add one occurrence of each element whose hash is in \a hashes
+ *
+ *  \pre self != NULL
+ *  \pre atb_View_u64_IsValid(hashes)
+ */
+ATB_PUBLIC extern void atb_CountMin_AddHashes(struct atb_CountMin *const self,
+                                              struct atb_View_u64 hashes);
+
+/**
+ *  \brief Add one occurrence of each integer of \a values (hashed using
+ *         atb_Hash_u64)
+ *
+ *  \pre self != NULL
+ *  \pre atb_View_u64_IsValid(values)
+ */
+ATB_PUBLIC extern void atb_CountMin_AddInts(struct atb_CountMin *const self,
+                                            struct atb_View_u64 values);
+
+/**
+ *  \brief Add one occurrence of each string keys[0, count) (hashed using
+ *         atb_Hash_StrView(keys[i], K_ATB_HASH_SEED))
+ *
+ *  \pre self != NULL
+ *  \pre keys != NULL || count == 0
+ */
+ATB_PUBLIC extern void atb_CountMin_AddStrs(struct atb_CountMin *const self,
+                                            struct atb_StrView const *keys,
+                                            size_t count);
+
+/**
+ *  \brief Merge \a other into \a self, such that self counts the elements
+ *         added to either of them
+ *
+ *  \pre self != NULL
+ *  \pre other != NULL
+ *  \pre self->width == other->width && self->depth == other->depth
+ */
+ATB_PUBLIC extern void atb_CountMin_Merge(
+    struct atb_CountMin *const self, struct atb_CountMin const *const other);
+
+/* Estimate *****************************************************************/
+
+/**
+ *  \return Estimated number of occurrences of the element whose hash is
+ *          \a hash (never below the real one)
+ *
+ *  \pre self != NULL
+ *
+ *  \note Complexity: O(depth)
+ */
+ATB_PUBLIC extern uint32_t atb_CountMin_Estimate(
+    struct atb_CountMin const *const self, uint64_t hash);
+
+/***************************************************************************/
+/*                           Inline definitions                            */
+/***************************************************************************/
+
+static inline struct atb_CountMin atb_CountMin_From(
+    struct atb_Span_u32 counters, size_t depth) {
+  assert(atb_Span_u32_IsValid(counters));
+  assert(depth > 0);
+  assert((counters.size > 0) && ((counters.size % depth) == 0));
+  assert((counters.size / depth) <= UINT32_MAX);
+
+  struct atb_CountMin cms;
+  cms.counters = counters;
+  cms.width = counters.size / depth;
+  cms.depth = depth;
+  cms.total = 0;
+  return cms;
+}
+
+#if defined(__cplusplus)
+} /* extern "C" */
+#endif
@@ -0,0 +1,308 @@
+#pragma once
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "atb/allocator.h"
+#include "atb/error.h"
+#include "atb/list.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/// Targeted size (in bytes) of the elements stored inside a single chunk
+#define K_ATB_DEQUE_CHUNK_BYTES 512
+
+/// Number of elements of type \a T stored inside a single chunk
+#define ATB_DEQUE_CHUNK_CAPACITY(T)       \
+  ((sizeof(T) >= K_ATB_DEQUE_CHUNK_BYTES) \
+       ? (size_t)1                        \
+       : (size_t)(K_ATB_DEQUE_CHUNK_BYTES / sizeof(T)))
+
+/// Declare a double ended queue struct named \a NAME, storing elements of type
+/// \a T, and all its associated functions. All functions are declared using
+/// \a SPECIFIER as specifiers.
+///
+/// \a SPAN is the span type (see ATB_SPAN_DECLARE) associated to \a T, used to
+/// expose the content of each chunk.
+///
+/// The deque is an unrolled list: elements are stored inside fixed size chunks
+/// (see ATB_DEQUE_CHUNK_CAPACITY) linked together using struct atb_List.
+/// Elements NEVER move once pushed: pointers to them stay valid until they are
+/// popped. Only the first and last chunks can be partially filled, such that
+/// iterating over the deque walks contiguous spans of elements.
+///
+/// Functions declared are the following:
+/// - `_Init(self, allocator)`: Initialize an EMPTY deque;
+/// - `_Destroy(self)`: Release all chunks of the deque;
+/// - `_Size(self) -> size_t`: Number of elements inside the deque;
+/// - `_PushBack/_PushFront(self, value, err) -> T*`: Add value at one end,
+///   returning its (stable) address. NULL on allocation failure;
+/// - `_PopBack/_PopFront(self, value) -> bool`: Remove an element at one end,
+///   optionally returning it. False when empty;
+/// - `_Front/_Back(self) -> T*`: Element at one end (NULL when empty);
+/// - `_Chunk_First/_Chunk_Last(self) -> chunk`: First/Last chunk (NULL when
+///   empty);
+/// - `_Chunk_Next/_Chunk_Prev(self, chunk) -> chunk`: Next/Prev chunk (NULL
+///   when reaching the end);
+/// - `_Chunk_AsSpan(chunk) -> SPAN`: Elements stored inside a chunk;
+///
+/// Iteration example:
+///
+/// struct NAME_Chunk *chunk;
+/// for (chunk = NAME_Chunk_First(&dq); chunk != NULL;
+///      chunk = NAME_Chunk_Next(&dq, chunk)) {
+///   struct SPAN span = NAME_Chunk_AsSpan(chunk);
+///   ...
+/// }
+///
+/// \warning The struct NAME contains the head of a struct atb_List, it can't
+///          be copied/moved once initialized.
+#define ATB_DEQUE_DECLARE(SPECIFIER, NAME, SPAN, T)                           \
+  struct NAME##_Chunk {                                                       \
+    struct atb_List node;                                                     \
+    size_t begin;                                                             \
+    size_t end;                                                               \
+    T data[ATB_DEQUE_CHUNK_CAPACITY(T)];                                      \
+  };                                                                          \
+                                                                              \
+  struct NAME {                                                               \
+    struct atb_List chunks;                                                   \
+    struct NAME##_Chunk *spare;                                               \
+    size_t size;                                                              \
+    struct atb_Allocator const *allocator;                                    \
+  };                                                                          \
+                                                                              \
+  SPECIFIER void NAME##_Init(struct NAME *const self,                         \
+                             struct atb_Allocator const *const allocator);    \
+  SPECIFIER void NAME##_Destroy(struct NAME *const self);                     \
+  SPECIFIER size_t NAME##_Size(struct NAME const *const self);                \
+  SPECIFIER T *NAME##_PushBack(struct NAME *const self, T value,              \
+                               struct atb_Error *const err);                  \
+  SPECIFIER T *NAME##_PushFront(struct NAME *const self, T value,             \
+                                struct atb_Error *const err);                 \
+  SPECIFIER bool NAME##_PopBack(struct NAME *const self, T *const value);     \
+  SPECIFIER bool NAME##_PopFront(struct NAME *const self, T *const value);    \
+  SPECIFIER T *NAME##_Front(struct NAME const *const self);                   \
+  SPECIFIER T *NAME##_Back(struct NAME const *const self);                    \
+  SPECIFIER struct NAME##_Chunk *NAME##_Chunk_First(                          \
+      struct NAME const *const self);                                         \
+  SPECIFIER struct NAME##_Chunk *NAME##_Chunk_Last(                           \
+      struct NAME const *const self);                                         \
+  SPECIFIER struct NAME##_Chunk *NAME##_Chunk_Next(                           \
+      struct NAME const *const self, struct NAME##_Chunk const *const chunk); \
+  SPECIFIER struct NAME##_Chunk *NAME##_Chunk_Prev(                           \
+      struct NAME const *const self, struct NAME##_Chunk const *const chunk); \
+  SPECIFIER struct SPAN NAME##_Chunk_AsSpan(                                  \
+      struct NAME##_Chunk *const chunk)
+
+/// Define all functions associated to a double ended queue named \a NAME
+/// (struct needs to be declared beforehands using ATB_DEQUE_DECLARE), storing
+/// elements of type \a T, with \a SPAN being the span type associated to \a T.
+/// All functions are defined using \a SPECIFIER as specifiers.
+///
+/// See ATB_DEQUE_DECLARE for the list of functions defined.
+#define ATB_DEQUE_DEFINE(SPECIFIER, NAME, SPAN, T)                             \
+  static struct NAME##_Chunk *NAME##_Chunk_From(                               \
+      struct NAME const *const self, struct atb_List const *const node) {      \
+    return (node == &(self->chunks))                                           \
+               ? NULL                                                          \
+               : atb_List_Entry(node, struct NAME##_Chunk, node);              \
+  }                                                                            \
+                                                                               \
+  /* New EMPTY chunk, with both begin/end set to position */                   \
+  static struct NAME##_Chunk *NAME##_Chunk_New(struct NAME *const self,        \
+                                               size_t position,                \
+                                               struct atb_Error *const err) {  \
+    struct NAME##_Chunk *chunk = self->spare;                                  \
+                                                                               \
+    if (chunk != NULL) {                                                       \
+      self->spare = NULL;                                                      \
+    } else {                                                                   \
+      chunk = (struct NAME##_Chunk *)atb_Allocator_Alloc(                      \
+          self->allocator, NULL, sizeof(struct NAME##_Chunk), err);            \
+      if (chunk == NULL) return NULL;                                          \
+    }                                                                          \
+                                                                               \
+    atb_List_Init(&(chunk->node));                                             \
+    chunk->begin = chunk->end = position;                                      \
+                                                                               \
+    return chunk;                                                              \
+  }                                                                            \
+                                                                               \
+  /* Unlink an EMPTY chunk from the deque, keeping it as spare to avoid        \
+   * allocation ping-pong when the deque size oscillates around a chunk        \
+   * boundary */                                                               \
+  static void NAME##_Chunk_Delete(struct NAME *const self,                     \
+                                  struct NAME##_Chunk *chunk) {                \
+    atb_List_Pop(&(chunk->node));                                              \
+                                                                               \
+    if (self->spare == NULL) {                                                 \
+      self->spare = chunk;                                                     \
+    } else {                                                                   \
+      (void)atb_Allocator_Release(self->allocator, (void **)&chunk,            \
+                                  K_ATB_ERROR_IGNORED);                        \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  SPECIFIER void NAME##_Init(struct NAME *const self,                          \
+                             struct atb_Allocator const *const allocator) {    \
+    assert(self != NULL);                                                      \
+    assert(allocator != NULL);                                                 \
+                                                                               \
+    atb_List_Init(&(self->chunks));                                            \
+    self->spare = NULL;                                                        \
+    self->size = 0;                                                            \
+    self->allocator = allocator;                                               \
+  }                                                                            \
+                                                                               \
+  SPECIFIER void NAME##_Destroy(struct NAME *const self) {                     \
+    assert(self != NULL);                                                      \
+                                                                               \
+    while (self->chunks.next != &(self->chunks)) {                             \
+      struct NAME##_Chunk *chunk = NAME##_Chunk_From(self, self->chunks.next); \
+      atb_List_Pop(&(chunk->node));                                            \
+      (void)atb_Allocator_Release(self->allocator, (void **)&chunk,            \
+                                  K_ATB_ERROR_IGNORED);                        \
+    }                                                                          \
+                                                                               \
+    if (self->spare != NULL) {                                                 \
+      (void)atb_Allocator_Release(self->allocator, (void **)&(self->spare),    \
+                                  K_ATB_ERROR_IGNORED);                        \
+      self->spare = NULL;                                                      \
+    }                                                                          \
+                                                                               \
+    self->size = 0;                                                            \
+  }                                                                            \
+                                                                               \
+  SPECIFIER size_t NAME##_Size(struct NAME const *const self) {                \
+    assert(self != NULL);                                                      \
+    return self->size;                                                         \
+  }                                                                            \
+                                                                               \
+  SPECIFIER T *NAME##_PushBack(struct NAME *const self, T value,               \
+                               struct atb_Error *const err) {                  \
+    assert(self != NULL);                                                      \
+                                                                               \
+    struct NAME##_Chunk *chunk = NAME##_Chunk_Last(self);                      \
+                                                                               \
+    if ((chunk == NULL) || (chunk->end == ATB_DEQUE_CHUNK_CAPACITY(T))) {      \
+      chunk = NAME##_Chunk_New(self, 0, err);                                  \
+      if (chunk == NULL) return NULL;                                          \
+      atb_List_InsertBefore(&(chunk->node), &(self->chunks));                  \
+    }                                                                          \
+                                                                               \
+    T *const element = &(chunk->data[chunk->end]);                             \
+    *element = value;                                                          \
+    chunk->end += 1;                                                           \
+    self->size += 1;                                                           \
+                                                                               \
+    return element;                                                            \
+  }                                                                            \
+                                                                               \
+  SPECIFIER T *NAME##_PushFront(struct NAME *const self, T value,              \
+                                struct atb_Error *const err) {                 \
+    assert(self != NULL);                                                      \
+                                                                               \
+    struct NAME##_Chunk *chunk = NAME##_Chunk_First(self);                     \
+                                                                               \
+    if ((chunk == NULL) || (chunk->begin == 0)) {                              \
+      chunk = NAME##_Chunk_New(self, ATB_DEQUE_CHUNK_CAPACITY(T), err);        \
+      if (chunk == NULL) return NULL;                                          \
+      atb_List_InsertAfter(&(chunk->node), &(self->chunks));                   \
+    }                                                                          \
+                                                                               \
+    chunk->begin -= 1;                                                         \
+    T *const element = &(chunk->data[chunk->begin]);                           \
+    *element = value;                                                          \
+    self->size += 1;                                                           \
+                                                                               \
+    return element;                                                            \
+  }                                                                            \
+                                                                               \
+  SPECIFIER bool NAME##_PopBack(struct NAME *const self, T *const value) {     \
+    assert(self != NULL);                                                      \
+                                                                               \
+    struct NAME##_Chunk *const chunk = NAME##_Chunk_Last(self);                \
+                                                                               \
+    if (chunk == NULL) return false;                                           \
+                                                                               \
+    chunk->end -= 1;                                                           \
+    if (value != NULL) *value = chunk->data[chunk->end];                       \
+    self->size -= 1;                                                           \
+                                                                               \
+    if (chunk->begin == chunk->end) NAME##_Chunk_Delete(self, chunk);          \
+                                                                               \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  SPECIFIER bool NAME##_PopFront(struct NAME *const self, T *const value) {    \
+    assert(self != NULL);                                                      \
+                                                                               \
+    struct NAME##_Chunk *const chunk = NAME##_Chunk_First(self);               \
+                                                                               \
+    if (chunk == NULL) return false;                                           \
+                                                                               \
+    if (value != NULL) *value = chunk->data[chunk->begin];                     \
+    chunk->begin += 1;                                                         \
+    self->size -= 1;                                                           \
+                                                                               \
+    if (chunk->begin == chunk->end) NAME##_Chunk_Delete(self, chunk);          \
+                                                                               \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  SPECIFIER T *NAME##_Front(struct NAME const *const self) {                   \
+    struct NAME##_Chunk *const chunk = NAME##_Chunk_First(self);               \
+    return (chunk == NULL) ? NULL : &(chunk->data[chunk->begin]);              \
+  }                                                                            \
+                                                                               \
+  SPECIFIER T *NAME##_Back(struct NAME const *const self) {                    \
+    struct NAME##_Chunk *const chunk = NAME##_Chunk_Last(self);                \
+    return (chunk == NULL) ? NULL : &(chunk->data[chunk->end - 1]);            \
+  }                                                                            \
+                                                                               \
+  SPECIFIER struct NAME##_Chunk *NAME##_Chunk_First(                           \
+      struct NAME const *const self) {                                         \
+    assert(self != NULL);                                                      \
+    return NAME##_Chunk_From(self, self->chunks.next);                         \
+  }                                                                            \
+                                                                               \
+  SPECIFIER struct NAME##_Chunk *NAME##_Chunk_Last(                            \
+      struct NAME const *const self) {                                         \
+    assert(self != NULL);                                                      \
+    return NAME##_Chunk_From(self, self->chunks.prev);                         \
+  }                                                                            \
+                                                                               \
+  SPECIFIER struct NAME##_Chunk *NAME##_Chunk_Next(                            \
+      struct NAME const *const self, struct NAME##_Chunk const *const chunk) { \
+    assert(self != NULL);                                                      \
+    assert(chunk != NULL);                                                     \
+    return NAME##_Chunk_From(self, chunk->node.next);                          \
+  }                                                                            \
+                                                                               \
+  SPECIFIER struct NAME##_Chunk *NAME##_Chunk_Prev(                            \
+      struct NAME const *const self, struct NAME##_Chunk const *const chunk) { \
+    assert(self != NULL);                                                      \
+    assert(chunk != NULL);                                                     \
+    return NAME##_Chunk_From(self, chunk->node.prev);                          \
+  }                                                                            \
+                                                                               \
+  SPECIFIER struct SPAN NAME##_Chunk_AsSpan(                                   \
+      struct NAME##_Chunk *const chunk) {                                      \
+    assert(chunk != NULL);                                                     \
+                                                                               \
+    struct SPAN span;                                                          \
+    span.data = &(chunk->data[chunk->begin]);                                  \
+    span.size = chunk->end - chunk->begin;                                     \
+                                                                               \
+    return span;                                                               \
+  }                                                                            \
+                                                                               \
+  static_assert(true, "SEMI-COLON NEEDED HERE")
+
+#if defined(__cplusplus)
+}
+#endif
@@ -0,0 +1,419 @@
+#pragma once
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "atb/allocator.h"
+#include "atb/compare.h"
+#include "atb/error.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/// Capacity of a flat map after its first allocation
+#define K_ATB_FLATMAP_MIN_CAPACITY 8
+
+/// Size of the runs sorted using insertion sort, before being merged, when
+/// sorting a batch
+#define K_ATB_FLATMAP_SORT_RUN 16
+
+/// Declare an ordered map struct named \a NAME, associating UNIQUE keys of type
+/// \a K to values of type \a V, and all its associated functions. All
+/// functions are declared using \a SPECIFIER as specifiers.
+///
+/// \a K_SPAN and \a V_SPAN are the span types (see ATB_SPAN_DECLARE)
+/// associated to \a K and \a V, used to expose the content of the map.
+///
+/// Keys and values are stored in 2 separate arrays from struct atb_Allocator,
+/// sorted by keys: lookups are a branchless binary search touching keys only,
+/// iterating is a walk over contiguous memory. Inserting a single key is
+/// O(size), hence batches should be inserted using _InsertBatch, merging all
+/// of them in a single pass.
+///
+/// Functions declared are the following:
+/// - `_Init(self, allocator)`: Initialize an EMPTY map;
+/// - `_Destroy(self)`: Release the storage of the map;
+/// - `_Clear(self)`: Remove all elements (keeping the storage);
+/// - `_Size(self) -> size_t`: Number of elements inside the map;
+/// - `_Reserve(self, capacity, err) -> bool`: Make sure the map can hold
+///   capacity elements without growing;
+/// - `_Find(self, key) -> V*`: Value associated to key (NULL when not found);
+/// - `_LowerBound(self, key) -> size_t`: Index of the first key >= key;
+/// - `_UpperBound(self, key) -> size_t`: Index of the first key > key;
+/// - `_Insert(self, key, value, err) -> bool`: Insert (or replace) the value
+///   associated to key. Only fails on allocation failure;
+/// - `_InsertBatch(self, keys, values, count, err) -> bool`: Insert (or
+///   replace) count key/values at once, in O(size + count * log(count)). The
+///   keys/values arrays are used as scratch space (their content is
+///   unspecified afterwards). When a key appears several times inside the
+///   batch, the last value wins. Only fails on allocation failure (map
+///   unchanged);
+/// - `_Erase(self, key, value) -> bool`: Remove key from the map, optionally
+///   returning the value removed. False when key wasn't found;
+/// - `_Keys(self) -> K_SPAN`: All keys, sorted;
+/// - `_Values(self) -> V_SPAN`: All values, in the same order as keys;
+///
+/// Range scan example (all keys in [lo, hi)):
+///
+/// struct K_SPAN const keys = NAME_Keys(&map);
+/// struct V_SPAN const values = NAME_Values(&map);
+/// for (size_t i = NAME_LowerBound(&map, lo), end = NAME_LowerBound(&map, hi);
+///      i < end; ++i) {
+///   ... keys.data[i], values.data[i] ...
+/// }
+#define ATB_FLATMAP_DECLARE(SPECIFIER, NAME, K, V, K_SPAN, V_SPAN)          \
+  struct NAME {                                                             \
+    K *keys;                                                                \
+    V *values;                                                              \
+    size_t size;                                                            \
+    size_t capacity;                                                        \
+    struct atb_Allocator const *allocator;                                  \
+  };                                                                        \
+                                                                            \
+  SPECIFIER void NAME##_Init(struct NAME *const self,                       \
+                             struct atb_Allocator const *const allocator);  \
+  SPECIFIER void NAME##_Destroy(struct NAME *const self);                   \
+  SPECIFIER void NAME##_Clear(struct NAME *const self);                     \
+  SPECIFIER size_t NAME##_Size(struct NAME const *const self);              \
+  SPECIFIER bool NAME##_Reserve(struct NAME *const self, size_t capacity,   \
+                                struct atb_Error *const err);               \
+  SPECIFIER V *NAME##_Find(struct NAME const *const self, K key);           \
+  SPECIFIER size_t NAME##_LowerBound(struct NAME const *const self, K key); \
+  SPECIFIER size_t NAME##_UpperBound(struct NAME const *const self, K key); \
+  SPECIFIER bool NAME##_Insert(struct NAME *const self, K key, V value,     \
+                               struct atb_Error *const err);                \
+  SPECIFIER bool NAME##_InsertBatch(struct NAME *const self, K *const keys, \
+                                    V *const values, size_t count,          \
+                                    struct atb_Error *const err);           \
+  SPECIFIER bool NAME##_Erase(struct NAME *const self, K key,               \
+                              V *const value);                              \
+  SPECIFIER struct K_SPAN NAME##_Keys(struct NAME const *const self);       \
+  SPECIFIER struct V_SPAN NAME##_Values(struct NAME const *const self)
+
+/// Define all functions associated to a flat ordered map named \a NAME
+/// (struct needs to be declared beforehands using ATB_FLATMAP_DECLARE), with
+/// keys of type \a K and values of type \a V. All functions are defined using
+/// \a SPECIFIER as specifiers.
+///
+/// Keys are ordered using \a COMPARE, a function (or function-like macro)
+/// following the 'three-way comparison' idiom (see compare.h), with the
+/// following signature: `COMPARE(K lhs, K rhs) -> atb_Cmp_t`.
+///
+/// See ATB_FLATMAP_DECLARE for the list of functions defined.
+#define ATB_FLATMAP_DEFINE(SPECIFIER, NAME, K, V, K_SPAN, V_SPAN, COMPARE)     \
+  /* Stable sort of keys/values[0, count), using tmp_keys/tmp_values[0, count) \
+   * as scratch space: insertion sort of small runs, then bottom-up merges */  \
+  static void NAME##_SortBatch(K *const keys, V *const values,                 \
+                               K *const tmp_keys, V *const tmp_values,         \
+                               size_t count) {                                 \
+    for (size_t begin = 0; begin < count; begin += K_ATB_FLATMAP_SORT_RUN) {   \
+      size_t const end = ((count - begin) < K_ATB_FLATMAP_SORT_RUN)            \
+                             ? count                                           \
+                             : (begin + K_ATB_FLATMAP_SORT_RUN);               \
+                                                                               \
+      for (size_t i = begin + 1; i < end; ++i) {                               \
+        K const key = keys[i];                                                 \
+        V const value = values[i];                                             \
+        size_t j = i;                                                          \
+                                                                               \
+        for (; (j > begin) && (COMPARE(keys[j - 1], key) > 0); --j) {          \
+          keys[j] = keys[j - 1];                                               \
+          values[j] = values[j - 1];                                           \
+        }                                                                      \
+                                                                               \
+        keys[j] = key;                                                         \
+        values[j] = value;                                                     \
+      }                                                                        \
+    }                                                                          \
+                                                                               \
+    K *src_keys = keys;                                                        \
+    V *src_values = values;                                                    \
+    K *dst_keys = tmp_keys;                                                    \
+    V *dst_values = tmp_values;                                                \
+                                                                               \
+    for (size_t width = K_ATB_FLATMAP_SORT_RUN; width < count; width *= 2) {   \
+      for (size_t lo = 0; lo < count; lo += (2 * width)) {                     \
+        size_t const mid = ((count - lo) < width) ? count : (lo + width);      \
+        size_t const hi = ((count - mid) < width) ? count : (mid + width);     \
+        size_t a = lo;                                                         \
+        size_t b = mid;                                                        \
+        size_t w = lo;                                                         \
+                                                                               \
+        for (; (a < mid) && (b < hi); ++w) {                                   \
+          size_t const from = (COMPARE(src_keys[b], src_keys[a]) < 0)          \
+                                  ? b++                                        \
+                                  : a++;                                       \
+          dst_keys[w] = src_keys[from];                                        \
+          dst_values[w] = src_values[from];                                    \
+        }                                                                      \
+                                                                               \
+        memcpy(&(dst_keys[w]), &(src_keys[a]), (mid - a) * sizeof(K));         \
+        memcpy(&(dst_values[w]), &(src_values[a]), (mid - a) * sizeof(V));     \
+        w += (mid - a);                                                        \
+        memcpy(&(dst_keys[w]), &(src_keys[b]), (hi - b) * sizeof(K));          \
+        memcpy(&(dst_values[w]), &(src_values[b]), (hi - b) * sizeof(V));      \
+      }                                                                        \
+                                                                               \
+      K *const swap_keys = src_keys;                                           \
+      V *const swap_values = src_values;                                       \
+      src_keys = dst_keys;                                                     \
+      src_values = dst_values;                                                 \
+      dst_keys = swap_keys;                                                    \
+      dst_values = swap_values;                                                \
+    }                                                                          \
+                                                                               \
+    if (src_keys != keys) {                                                    \
+      memcpy(keys, src_keys, count * sizeof(K));                               \
+      memcpy(values, src_values, count * sizeof(V));                           \
+    }                                                                          \
+  }                                                                            \
+                                                                               \
+  SPECIFIER void NAME##_Init(struct NAME *const self,                          \
+                             struct atb_Allocator const *const allocator) {    \
+    assert(self != NULL);                                                      \
+    assert(allocator != NULL);                                                 \
+                                                                               \
+    self->keys = NULL;                                                         \
+    self->values = NULL;                                                       \
+    self->size = 0;                                                            \
+    self->capacity = 0;                                                        \
+    self->allocator = allocator;                                               \
+  }                                                                            \
+                                                                               \
+  SPECIFIER void NAME##_Destroy(struct NAME *const self) {                     \
+    assert(self != NULL);                                                      \
+                                                                               \
+    if (self->keys != NULL) {                                                  \
+      (void)atb_Allocator_Release(self->allocator, (void **)&(self->keys),     \
+                                  K_ATB_ERROR_IGNORED);                        \
+    }                                                                          \
+                                                                               \
+    if (self->values != NULL) {                                                \
+      (void)atb_Allocator_Release(self->allocator, (void **)&(self->values),   \
+                                  K_ATB_ERROR_IGNORED);                        \
+    }                                                                          \
+                                                                               \
+    self->size = 0;                                                            \
+    self->capacity = 0;                                                        \
+  }                                                                            \
+                                                                               \
+  SPECIFIER void NAME##_Clear(struct NAME *const self) {                       \
+    assert(self != NULL);                                                      \
+    self->size = 0;                                                            \
+  }                                                                            \
+                                                                               \
+  SPECIFIER size_t NAME##_Size(struct NAME const *const self) {                \
+    assert(self != NULL);                                                      \
+    return self->size;                                                         \
+  }                                                                            \
+                                                                               \
+  /* keys are grown before values: on failure, keys might be larger than       \
+   * capacity, which is harmless (capacity is unchanged) */                    \
+  SPECIFIER bool NAME##_Reserve(struct NAME *const self, size_t capacity,      \
+                                struct atb_Error *const err) {                 \
+    assert(self != NULL);                                                      \
+                                                                               \
+    if (capacity <= self->capacity) return true;                               \
+                                                                               \
+    size_t new_capacity = (self->capacity == 0) ? K_ATB_FLATMAP_MIN_CAPACITY   \
+                                                : (self->capacity * 2);        \
+                                                                               \
+    if (new_capacity < capacity) new_capacity = capacity;                      \
+                                                                               \
+    if ((new_capacity > (SIZE_MAX / sizeof(K))) ||                             \
+        (new_capacity > (SIZE_MAX / sizeof(V)))) {                             \
+      atb_GenericError_Set(err, K_ATB_ERROR_GENERIC_VALUE_TOO_LARGE);          \
+      return false;                                                            \
+    }                                                                          \
+                                                                               \
+    K *const keys = (K *)atb_Allocator_Alloc(                                  \
+        self->allocator, self->keys, new_capacity * sizeof(K), err);           \
+    if (keys == NULL) return false;                                            \
+    self->keys = keys;                                                         \
+                                                                               \
+    V *const values = (V *)atb_Allocator_Alloc(                                \
+        self->allocator, self->values, new_capacity * sizeof(V), err);         \
+    if (values == NULL) return false;                                          \
+    self->values = values;                                                     \
+                                                                               \
+    self->capacity = new_capacity;                                             \
+                                                                               \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  /* Branchless binary search (see btree.h) */                                 \
+  SPECIFIER size_t NAME##_LowerBound(struct NAME const *const self, K key) {   \
+    assert(self != NULL);                                                      \
+                                                                               \
+    size_t first = 0;                                                          \
+    size_t len = self->size;                                                   \
+                                                                               \
+    if (len == 0) return 0;                                                    \
+                                                                               \
+    while (len > 1) {                                                          \
+      size_t const half = len / 2;                                             \
+      first += (COMPARE(self->keys[first + half - 1], key) < 0) ? half : 0;    \
+      len -= half;                                                             \
+    }                                                                          \
+                                                                               \
+    return first + (COMPARE(self->keys[first], key) < 0 ? 1 : 0);              \
+  }                                                                            \
+                                                                               \
+  SPECIFIER size_t NAME##_UpperBound(struct NAME const *const self, K key) {   \
+    assert(self != NULL);                                                      \
+                                                                               \
+    size_t first = 0;                                                          \
+    size_t len = self->size;                                                   \
+                                                                               \
+    if (len == 0) return 0;                                                    \
+                                                                               \
+    while (len > 1) {                                                          \
+      size_t const half = len / 2;                                             \
+      first += (COMPARE(self->keys[first + half - 1], key) <= 0) ? half : 0;   \
+      len -= half;                                                             \
+    }                                                                          \
+                                                                               \
+    return first + (COMPARE(self->keys[first], key) <= 0 ? 1 : 0);             \
+  }                                                                            \
+                                                                               \
+  SPECIFIER V *NAME##_Find(struct NAME const *const self, K key) {             \
+    size_t const i = NAME##_LowerBound(self, key);                             \
+                                                                               \
+    return ((i < self->size) && (COMPARE(self->keys[i], key) == 0))            \
+               ? &(self->values[i])                                            \
+               : NULL;                                                         \
+  }                                                                            \
+                                                                               \
+  SPECIFIER bool NAME##_Insert(struct NAME *const self, K key, V value,        \
+                               struct atb_Error *const err) {                  \
+    size_t const i = NAME##_LowerBound(self, key);                             \
+                                                                               \
+    if ((i < self->size) && (COMPARE(self->keys[i], key) == 0)) {              \
+      self->values[i] = value;                                                 \
+      return true;                                                             \
+    }                                                                          \
+                                                                               \
+    if (!NAME##_Reserve(self, self->size + 1, err)) return false;              \
+                                                                               \
+    memmove(&(self->keys[i + 1]), &(self->keys[i]),                            \
+            (self->size - i) * sizeof(K));                                     \
+    memmove(&(self->values[i + 1]), &(self->values[i]),                        \
+            (self->size - i) * sizeof(V));                                     \
+                                                                               \
+    self->keys[i] = key;                                                       \
+    self->values[i] = value;                                                   \
+    self->size += 1;                                                           \
+                                                                               \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  SPECIFIER bool NAME##_InsertBatch(struct NAME *const self, K *const keys,    \
+                                    V *const values, size_t count,             \
+                                    struct atb_Error *const err) {             \
+    assert(self != NULL);                                                      \
+    assert(((keys != NULL) && (values != NULL)) || (count == 0));              \
+                                                                               \
+    if (count == 0) return true;                                               \
+                                                                               \
+    if (count > (SIZE_MAX - self->size)) {                                     \
+      atb_GenericError_Set(err, K_ATB_ERROR_GENERIC_VALUE_TOO_LARGE);          \
+      return false;                                                            \
+    }                                                                          \
+                                                                               \
+    if (!NAME##_Reserve(self, self->size + count, err)) return false;          \
+                                                                               \
+    /* Sort the batch, using the unused tail of the map as scratch space */    \
+    NAME##_SortBatch(keys, values, &(self->keys[self->size]),                  \
+                     &(self->values[self->size]), count);                      \
+                                                                               \
+    /* Remove duplicates from the batch (last value wins) */                   \
+    size_t n = 1;                                                              \
+    for (size_t i = 1; i < count; ++i) {                                       \
+      if (COMPARE(keys[n - 1], keys[i]) != 0) {                                \
+        keys[n] = keys[i];                                                     \
+        n += 1;                                                                \
+      }                                                                        \
+      values[n - 1] = values[i];                                               \
+    }                                                                          \
+                                                                               \
+    /* Merge from the back, such that each element moves at most once */       \
+    size_t i = self->size;                                                     \
+    size_t j = n;                                                              \
+    size_t w = self->size + n;                                                 \
+                                                                               \
+    while (j > 0) {                                                            \
+      atb_Cmp_t const cmp =                                                    \
+          (i == 0) ? K_ATB_CMP_LESS : COMPARE(self->keys[i - 1], keys[j - 1]); \
+      w -= 1;                                                                  \
+                                                                               \
+      if (cmp > 0) {                                                           \
+        i -= 1;                                                                \
+        self->keys[w] = self->keys[i];                                         \
+        self->values[w] = self->values[i];                                     \
+      } else {                                                                 \
+        if (cmp == 0) i -= 1;                                                  \
+        j -= 1;                                                                \
+        self->keys[w] = keys[j];                                               \
+        self->values[w] = values[j];                                           \
+      }                                                                        \
+    }                                                                          \
+                                                                               \
+    /* Close the gap left by keys that were already part of the map */         \
+    memmove(&(self->keys[i]), &(self->keys[w]),                                \
+            (self->size + n - w) * sizeof(K));                                 \
+    memmove(&(self->values[i]), &(self->values[w]),                            \
+            (self->size + n - w) * sizeof(V));                                 \
+                                                                               \
+    self->size = i + (self->size + n - w);                                     \
+                                                                               \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  SPECIFIER bool NAME##_Erase(struct NAME *const self, K key,                  \
+                              V *const value) {                                \
+    size_t const i = NAME##_LowerBound(self, key);                             \
+                                                                               \
+    if ((i == self->size) || (COMPARE(self->keys[i], key) != 0)) {             \
+      return false;                                                            \
+    }                                                                          \
+                                                                               \
+    if (value != NULL) *value = self->values[i];                               \
+                                                                               \
+    memmove(&(self->keys[i]), &(self->keys[i + 1]),                            \
+            (self->size - i - 1) * sizeof(K));                                 \
+    memmove(&(self->values[i]), &(self->values[i + 1]),                        \
+            (self->size - i - 1) * sizeof(V));                                 \
+    self->size -= 1;                                                           \
+                                                                               \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  SPECIFIER struct K_SPAN NAME##_Keys(struct NAME const *const self) {         \
+    assert(self != NULL);                                                      \
+                                                                               \
+    struct K_SPAN span;                                                        \
+    span.data = self->keys;                                                    \
+    span.size = self->size;                                                    \
+                                                                               \
+    return span;                                                               \
+  }                                                                            \
+                                                                               \
+  SPECIFIER struct V_SPAN NAME##_Values(struct NAME const *const self) {       \
+    assert(self != NULL);                                                      \
+                                                                               \
+    struct V_SPAN span;                                                        \
+    span.data = self->values;                                                  \
+    span.size = self->size;                                                    \
+                                                                               \
+    return span;                                                               \
+  }                                                                            \
+                                                                               \
+  static_assert(true, "SEMI-COLON NEEDED HERE")
+
+#if defined(__cplusplus)
+} /* extern "C" */
+#endif
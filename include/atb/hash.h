@@ -0,0 +1,68 @@
+#pragma once
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "atb/export.h"
+#include "atb/span/string.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/// Default seed used by the hashing functions
+#define K_ATB_HASH_SEED ((uint64_t)0x9E3779B97F4A7C15ULL)
+
+/**
+ *  \brief Hash a 64 bits integer (bijective finalizer, full avalanche)
+ *
+ *  \note Suitable for integer keys used to index power of 2 hash tables
+ */
+static inline uint64_t atb_Hash_u64(uint64_t value);
+
+/**
+ *  \brief Hash \a size bytes starting at \a data
+ *
+ *  \param[in] data Bytes to be hashed
+ *  \param[in] size Number of bytes to be hashed
+ *  \param[in] seed Seed of the hash (K_ATB_HASH_SEED by default)
+ *
+ *  \return uint64_t Hash of the bytes
+ *
+ *  \pre (data != NULL) || (size == 0)
+ *
+ *  \note This is NOT a cryptographic hash
+ */
+ATB_PUBLIC extern uint64_t atb_Hash_Bytes(void const *data, size_t size,
+                                          uint64_t seed);
+
+/**
+ *  \brief Hash the characters of \a str (see atb_Hash_Bytes)
+ *
+ *  \pre atb_StrView_IsValid(str)
+ */
+static inline uint64_t atb_Hash_StrView(struct atb_StrView str, uint64_t seed);
+
+/***************************************************************************/
+/*                           Inline definitions                            */
+/***************************************************************************/
+
+static inline uint64_t atb_Hash_u64(uint64_t value) {
+  value ^= value >> 33;
+  value *= 0xFF51AFD7ED558CCDULL;
+  value ^= value >> 33;
+  value *= 0xC4CEB9FE1A85EC53ULL;
+  value ^= value >> 33;
+  return value;
+}
+
+static inline uint64_t atb_Hash_StrView(struct atb_StrView str,
+                                        uint64_t seed) {
+  assert(atb_StrView_IsValid(str));
+  return atb_Hash_Bytes(str.data, str.size, seed);
+}
+
+#if defined(__cplusplus)
+} /* extern "C" */
+#endif
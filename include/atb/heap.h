@@ -0,0 +1,233 @@
+#pragma once
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h> /* NULL */
+
+#include "atb/compare.h"
+#include "atb/export.h"
+#include "atb/functional.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ *  \brief Intrusive priority queue node (pairing heap)
+ *
+ *  Same as atb_List, this is meant to be embedded inside any other data
+ *  structure that should be part of a heap. The heap never allocates nor copies
+ *  anything, it only re-links nodes.
+ *
+ *  Example:
+ *  struct Timer {
+ *    uint64_t deadline;
+ *    struct atb_Heap_Node node;
+ *  };
+ *
+ *  static atb_Cmp_t Timer_Compare(void *data,
+ *                                 struct atb_Heap_Node const *lhs,
+ *                                 struct atb_Heap_Node const *rhs) {
+ *    (void)data;
+ *    uint64_t l = atb_Heap_Entry(lhs, struct Timer const, node)->deadline;
+ *    uint64_t r = atb_Heap_Entry(rhs, struct Timer const, node)->deadline;
+ *    return (l < r) ? K_ATB_CMP_LESS
+ *                   : ((l > r) ? K_ATB_CMP_GREATER : K_ATB_CMP_EQUAL);
+ *  }
+ *
+ *  struct atb_Heap timers;
+ *  atb_Heap_Init(&timers, ATB_BIND_AS(struct atb_Heap_Compare, Timer_Compare,
+ *                                     NULL));
+ *
+ *  struct Timer t = {.deadline = 42};
+ *  atb_Heap_Insert(&timers, &(t.node));
+ *
+ *  // Earliest deadline first
+ *  struct Timer *next = atb_Heap_Entry(atb_Heap_Pop(&timers), struct Timer,
+ *                                      node);
+ */
+struct atb_Heap_Node {
+  struct atb_Heap_Node *child; /*!< Left most child */
+  struct atb_Heap_Node *next;  /*!< Next sibling */
+  struct atb_Heap_Node *prev;  /*!< Prev sibling, or PARENT for first child */
+};
+
+/// Three-way comparison between 2 nodes. The heap's top is the node that
+/// compares LESS than all others.
+ATB_CALLABLE_DECLARE(atb_Cmp_t, atb_Heap_Compare,
+                     struct atb_Heap_Node const *lhs,
+                     struct atb_Heap_Node const *rhs);
+
+/// Heap HEAD, holding the root node and the ordering used
+struct atb_Heap {
+  struct atb_Heap_Node *root;      /*!< Top of the heap (NULL when empty) */
+  size_t size;                     /*!< Number of nodes inside the heap */
+  struct atb_Heap_Compare compare; /*!< Ordering of the nodes */
+};
+
+/**
+ *  \brief Retreive the ptr of the data structure containing the given
+ *         node_ptr, based on the parent struct type and the member name of the
+ *         node
+ *
+ *  \param[in] node_ptr A atb_Heap_Node ptr
+ *  \param[in] type The parent struct type containing the node_ptr
+ *  \param[in] member The name of the atb_Heap_Node member inside type
+ *
+ *  \return type* The parent struct ptr containing node_ptr
+ */
+#define atb_Heap_Entry(node_ptr, type, member) \
+  ((type *)((char *)(node_ptr) - offsetof(type, member)))
+
+/* Init *********************************************************************/
+
+/**
+ *  \brief Statically initialize an EMPTY atb_Heap using the given compare
+ *         callable (static initializer)
+ */
+#define atb_Heap_INITIALIZE(cmp) \
+  { .root = NULL, .size = 0, .compare = cmp, }
+
+/**
+ *  \brief Initialize an EMPTY heap, ordered using \a compare
+ *
+ *  \pre self != NULL
+ *  \pre ATB_CALLABLE_IS_VALID(compare)
+ */
+static inline void atb_Heap_Init(struct atb_Heap *const self,
+                                 struct atb_Heap_Compare compare);
+
+/**
+ *  \brief Initialize a node (unlinked from any heap)
+ *
+ *  \pre node != NULL
+ */
+static inline void atb_Heap_Node_Init(struct atb_Heap_Node *const node);
+
+/* Introspect **************************************************************/
+
+/**
+ *  \return True when the heap doesn't contain any node
+ *
+ *  \pre self != NULL
+ */
+static inline bool atb_Heap_IsEmpty(struct atb_Heap const *const self);
+
+/**
+ *  \return The node on top of the heap (i.e. the one comparing LESS than all
+ *          others), without removing it. NULL when the heap is empty.
+ *
+ *  \pre self != NULL
+ *
+ *  \note Complexity: O(1)
+ */
+static inline struct atb_Heap_Node *atb_Heap_Top(
+    struct atb_Heap const *const self);
+
+/* Mutation *****************************************************************/
+
+/**
+ *  \brief Insert \a node inside the heap
+ *
+ *  \pre self != NULL
+ *  \pre node != NULL
+ *  \pre node is not part of any heap
+ *
+ *  \note Complexity: O(1)
+ */
+ATB_PUBLIC extern void atb_Heap_Insert(struct atb_Heap *const self,
+                                       struct atb_Heap_Node *const node);
+
+/**
+ *  \brief Remove the node on top of the heap
+ *
+ *  \return struct atb_Heap_Node* The node removed (initialized, i.e. unlinked).
+ *          NULL when the heap is empty.
+ *
+ *  \pre self != NULL
+ *
+ *  \note Complexity: O(log n) amortized
+ */
+ATB_PUBLIC extern struct atb_Heap_Node *atb_Heap_Pop(
+    struct atb_Heap *const self);
+
+/**
+ *  \brief Remove ANY \a node from the heap
+ *
+ *  \pre self != NULL
+ *  \pre node != NULL
+ *  \pre node is part of self
+ *
+ *  \post node is initialized (i.e. unlinked)
+ *
+ *  \note Complexity: O(log n) amortized
+ */
+ATB_PUBLIC extern void atb_Heap_Remove(struct atb_Heap *const self,
+                                       struct atb_Heap_Node *const node);
+
+/**
+ *  \brief Restore the heap ordering after the key of \a node has been DECREASED
+ *         (i.e. \a node now compares LESS or EQUAL than before)
+ *
+ *  \pre self != NULL
+ *  \pre node != NULL
+ *  \pre node is part of self
+ *
+ *  \warning Increasing the key of a node is not supported by this function,
+ *           use _Remove() followed by _Insert() instead.
+ *
+ *  \note Complexity: O(1) (O(log n) amortized on the following _Pop())
+ */
+ATB_PUBLIC extern void atb_Heap_DecreaseKey(struct atb_Heap *const self,
+                                            struct atb_Heap_Node *const node);
+
+/**
+ *  \brief Move all nodes of \a other inside \a self
+ *
+ *  \pre self != NULL
+ *  \pre other != NULL
+ *  \pre Both heaps are using the same ordering
+ *
+ *  \post other is empty
+ *
+ *  \note Complexity: O(1)
+ */
+ATB_PUBLIC extern void atb_Heap_Merge(struct atb_Heap *const self,
+                                      struct atb_Heap *const other);
+
+/***************************************************************************/
+/*                           Inline definitions                            */
+/***************************************************************************/
+
+static inline void atb_Heap_Init(struct atb_Heap *const self,
+                                 struct atb_Heap_Compare compare) {
+  assert(self != NULL);
+  assert(ATB_CALLABLE_IS_VALID(compare));
+
+  self->root = NULL;
+  self->size = 0;
+  self->compare = compare;
+}
+
+static inline void atb_Heap_Node_Init(struct atb_Heap_Node *const node) {
+  assert(node != NULL);
+
+  node->child = NULL;
+  node->next = NULL;
+  node->prev = NULL;
+}
+
+static inline bool atb_Heap_IsEmpty(struct atb_Heap const *const self) {
+  assert(self != NULL);
+  return self->root == NULL;
+}
+
+static inline struct atb_Heap_Node *atb_Heap_Top(
+    struct atb_Heap const *const self) {
+  assert(self != NULL);
+  return self->root;
+}
+
+#if defined(__cplusplus)
+} /* extern "C" */
+#endif
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "atb/bits.h"
+#include "atb/export.h"
+#include "atb/hash.h"
+#include "atb/span/ints.h"
+#include "atb/span/string.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/// Minimum precision (number of bits used to select a register)
+#define K_ATB_HYPERLOGLOG_MIN_PRECISION 4
+
+/// Maximum precision (number of bits used to select a register)
+#define K_ATB_HYPERLOGLOG_MAX_PRECISION 18
+
+/// Number of registers (bytes) of a sketch with the given \a PRECISION
+#define ATB_HYPERLOGLOG_REGISTERS(PRECISION) ((size_t)1 << (PRECISION))
+
+/**
+ *  \brief HyperLogLog distinct count sketch, storing its registers inside a
+ *         user provided span of bytes
+ *
+ *  Memory is fixed: 2^precision bytes, whatever the number of elements
+ *  added. The standard error of the estimation is ~1.04 / sqrt(2^precision)
+ *  (e.g. 0.8% with precision 14, using 16 KiB).
+ *
+ *  Elements are given as 64 bits hashes (see atb/hash.h), or as integers/
+ *  strings hashed by the batch functions.
+ *
+ *  Example:
+ *  static uint8_t registers[ATB_HYPERLOGLOG_REGISTERS(14)];
+ *  struct atb_HyperLogLog hll = atb_HyperLogLog_From(
+ *      (struct atb_Span_u8)atb_AnySpan_From_Array(registers), 14);
+ *
+ *  atb_HyperLogLog_Clear(hll);
+ *  atb_HyperLogLog_AddStrs(hll, user_ids, count);
+ *
+ *  uint64_t const distinct_users = atb_HyperLogLog_Estimate(hll);
+ */
+struct atb_HyperLogLog {
+  struct atb_Span_u8 registers; /*!< Maximum rank observed per register */
+  uint8_t precision;            /*!< log2(registers.size) */
+};
+
+/* Init *********************************************************************/
+
+/**
+ *  \brief Construct a sketch over \a registers
+ *
+ *  \note The registers are NOT initialized (see atb_HyperLogLog_Clear)
+ *
+ *  \pre atb_Span_u8_IsValid(registers)
+ *  \pre K_ATB_HYPERLOGLOG_MIN_PRECISION <= precision <=
+ *       K_ATB_HYPERLOGLOG_MAX_PRECISION
+ *  \pre registers.size == ATB_HYPERLOGLOG_REGISTERS(precision)
+ */
+static inline struct atb_HyperLogLog atb_HyperLogLog_From(
+    struct atb_Span_u8 registers, uint8_t precision);
+
+/**
+ *  \brief Reset the sketch (no elements)
+ */
+ATB_PUBLIC extern void atb_HyperLogLog_Clear(struct atb_HyperLogLog self);
+
+/* Update *******************************************************************/
+
+/**
+ *  \brief Add the element whose hash is \a hash
+ */
+static inline void atb_HyperLogLog_Add(struct atb_HyperLogLog self,
+                                       uint64_t hash);
+
+/**
+ *  \brief Add ALL the elements whose hashes are \a hashes
+ *
+ *  \pre atb_View_u64_IsValid(hashes)
+ */
+ATB_PUBLIC extern void atb_HyperLogLog_AddHashes(struct atb_HyperLogLog self,
+                                                 struct atb_View_u64 hashes);
+
+/**
+ *  \brief Add ALL the integers of \a values (hashed using atb_Hash_u64)
+ *
+ *  \pre atb_View_u64_IsValid(values)
+ */
+ATB_PUBLIC extern void atb_HyperLogLog_AddInts(struct atb_HyperLogLog self,
+                                               struct atb_View_u64 values);
+
+/**
+ *  \brief Add ALL the strings keys[0, count) (hashed using
+ *         atb_Hash_StrView(keys[i], K_ATB_HASH_SEED))
+ *
+ *  \pre keys != NULL || count == 0
+ */
+ATB_PUBLIC extern void atb_HyperLogLog_AddStrs(struct atb_HyperLogLog self,
+                                               struct atb_StrView const *keys,
+                                               size_t count);
+
+/**
+ *  \brief Merge \a other into \a self, such that self estimates the number of
+ *         distinct elements added to either of them
+ *
+ *  \pre self.precision == other.precision
+ */
+ATB_PUBLIC extern void atb_HyperLogLog_Merge(struct atb_HyperLogLog self,
+                                             struct atb_HyperLogLog other);
+
+/* Estimate *****************************************************************/
+
+/**
+ *  \return Estimated number of distinct elements added to the sketch
+ *
+ *  \note Complexity: O(registers)
+ */
+ATB_PUBLIC extern uint64_t atb_HyperLogLog_Estimate(
+    struct atb_HyperLogLog self);
+
+/***************************************************************************/
+/*                           Inline definitions                            */
+/***************************************************************************/
+
+static inline struct atb_HyperLogLog atb_HyperLogLog_From(
+    struct atb_Span_u8 registers, uint8_t precision) {
+  assert(atb_Span_u8_IsValid(registers));
+  assert(precision >= K_ATB_HYPERLOGLOG_MIN_PRECISION);
+  assert(precision <= K_ATB_HYPERLOGLOG_MAX_PRECISION);
+  assert(registers.size == ATB_HYPERLOGLOG_REGISTERS(precision));
+
+  struct atb_HyperLogLog hll;
+  hll.registers = registers;
+  hll.precision = precision;
+  return hll;
+}
+
+static inline void atb_HyperLogLog_Add(struct atb_HyperLogLog self,
+                                       uint64_t hash) {
+  /* The first bits select the register, the remaining ones give the rank
+   * (position of the leftmost 1), a sentinel bit bounds it */
+  size_t const index = (size_t)(hash >> (64 - self.precision));
+  uint64_t const rest = (hash << self.precision) |
+                        ((uint64_t)0x1 << (self.precision - 1));
+  uint8_t const rank = (uint8_t)(atb_Bits_Clz_u64(rest) + 1);
+
+  if (self.registers.data[index] < rank) self.registers.data[index] = rank;
+}
+
+#if defined(__cplusplus)
+} /* extern "C" */
+#endif
@@ -64,3 +64,42 @@
   ATB_INTERNAL_TKN_CAT_N_IMPL(N, __VA_ARGS__)
 
 #define ATB_INTERNAL_TKN_STR(a) #a
+
+#define ATB_INTERNAL_UNPACK(...) __VA_ARGS__
+
+#define ATB_INTERNAL_FOR_EACH_1(F, CTX, a) F(CTX, a)
+#define ATB_INTERNAL_FOR_EACH_2(F, CTX, a, ...) \
+  F(CTX, a) ATB_INTERNAL_FOR_EACH_1(F, CTX, __VA_ARGS__)
+#define ATB_INTERNAL_FOR_EACH_3(F, CTX, a, ...) \
+  F(CTX, a) ATB_INTERNAL_FOR_EACH_2(F, CTX, __VA_ARGS__)
+#define ATB_INTERNAL_FOR_EACH_4(F, CTX, a, ...) \
+  F(CTX, a) ATB_INTERNAL_FOR_EACH_3(F, CTX, __VA_ARGS__)
+#define ATB_INTERNAL_FOR_EACH_5(F, CTX, a, ...) \
+  F(CTX, a) ATB_INTERNAL_FOR_EACH_4(F, CTX, __VA_ARGS__)
+#define ATB_INTERNAL_FOR_EACH_6(F, CTX, a, ...) \
+  F(CTX, a) ATB_INTERNAL_FOR_EACH_5(F, CTX, __VA_ARGS__)
+#define ATB_INTERNAL_FOR_EACH_7(F, CTX, a, ...) \
+  F(CTX, a) ATB_INTERNAL_FOR_EACH_6(F, CTX, __VA_ARGS__)
+#define ATB_INTERNAL_FOR_EACH_8(F, CTX, a, ...) \
+  F(CTX, a) ATB_INTERNAL_FOR_EACH_7(F, CTX, __VA_ARGS__)
+#define ATB_INTERNAL_FOR_EACH_9(F, CTX, a, ...) \
+  F(CTX, a) ATB_INTERNAL_FOR_EACH_8(F, CTX, __VA_ARGS__)
+#define ATB_INTERNAL_FOR_EACH_10(F, CTX, a, ...) \
+  F(CTX, a) ATB_INTERNAL_FOR_EACH_9(F, CTX, __VA_ARGS__)
+#define ATB_INTERNAL_FOR_EACH_11(F, CTX, a, ...) \
+  F(CTX, a) ATB_INTERNAL_FOR_EACH_10(F, CTX, __VA_ARGS__)
+#define ATB_INTERNAL_FOR_EACH_12(F, CTX, a, ...) \
+  F(CTX, a) ATB_INTERNAL_FOR_EACH_11(F, CTX, __VA_ARGS__)
+#define ATB_INTERNAL_FOR_EACH_13(F, CTX, a, ...) \
+  F(CTX, a) ATB_INTERNAL_FOR_EACH_12(F, CTX, __VA_ARGS__)
+#define ATB_INTERNAL_FOR_EACH_14(F, CTX, a, ...) \
+  F(CTX, a) ATB_INTERNAL_FOR_EACH_13(F, CTX, __VA_ARGS__)
+#define ATB_INTERNAL_FOR_EACH_15(F, CTX, a, ...) \
+  F(CTX, a) ATB_INTERNAL_FOR_EACH_14(F, CTX, __VA_ARGS__)
+#define ATB_INTERNAL_FOR_EACH_16(F, CTX, a, ...) \
+  F(CTX, a) ATB_INTERNAL_FOR_EACH_15(F, CTX, __VA_ARGS__)
+
+#define ATB_INTERNAL_FOR_EACH_N_IMPL(N, F, CTX, ...) \
+  ATB_INTERNAL_FOR_EACH_##N(F, CTX, __VA_ARGS__)
+#define ATB_INTERNAL_FOR_EACH_N(N, F, CTX, ...) \
+  ATB_INTERNAL_FOR_EACH_N_IMPL(N, F, CTX, __VA_ARGS__)
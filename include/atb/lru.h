@@ -0,0 +1,239 @@
+#pragma once
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "atb/allocator.h"
+#include "atb/error.h"
+#include "atb/export.h"
+#include "atb/functional.h"
+#include "atb/list.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ *  \brief Intrusive LRU cache node
+ *
+ *  Same as atb_List, this is meant to be embedded inside the entries stored in
+ *  the cache. The cache never allocates/copies entries: recency is kept using
+ *  an atb_List (most recently used first) and keys are indexed using a hash
+ *  table (chained through the nodes), such that lookups, insertions and
+ *  evictions are all O(1).
+ *
+ *  Example:
+ *  struct Entry {
+ *    uint32_t key;
+ *    char value[64];
+ *    struct atb_Lru_Node node;
+ *  };
+ *
+ *  static bool Entry_Match(void *data, struct atb_Lru_Node const *node,
+ *                          void const *key) {
+ *    (void)data;
+ *    return atb_Lru_Entry(node, struct Entry const, node)->key ==
+ *           *(uint32_t const *)key;
+ *  }
+ *
+ *  static void Entry_Evict(void *data, struct atb_Lru_Node *node) {
+ *    free(atb_Lru_Entry(node, struct Entry, node));
+ *  }
+ *
+ *  struct atb_Lru cache;
+ *  atb_Lru_Init(&cache, atb_DefaultAllocator(),
+ *               (struct atb_Lru_Limits){.entries = 1024, .bytes = 0},
+ *               ATB_BIND_AS(struct atb_Lru_Match, Entry_Match, NULL),
+ *               ATB_BIND_AS(struct atb_Lru_Evict, Entry_Evict, NULL));
+ *
+ *  uint32_t key = 42;
+ *  struct atb_Lru_Node *hit = atb_Lru_Find(&cache, atb_Hash_u64(key), &key);
+ */
+struct atb_Lru_Node {
+  struct atb_List recency;    /*!< Position inside the recency list */
+  struct atb_Lru_Node *chain; /*!< Next node inside the same hash bucket */
+  uint64_t hash;              /*!< Hash of the key of this node */
+  size_t bytes;               /*!< Cost of this node for the bytes limit */
+};
+
+/// Indicates if the key of a node is EQUAL to the given key (same key type as
+/// the one given to _Find/_Insert)
+ATB_CALLABLE_DECLARE(bool, atb_Lru_Match, struct atb_Lru_Node const *node,
+                     void const *key);
+
+/// Called on each node evicted from the cache (already unlinked from it)
+ATB_CALLABLE_DECLARE(void, atb_Lru_Evict, struct atb_Lru_Node *node);
+
+/// Limits of the cache, 0 meaning 'unlimited'
+struct atb_Lru_Limits {
+  size_t entries; /*!< Maximum number of nodes */
+  size_t bytes;   /*!< Maximum sum of the nodes bytes */
+};
+
+/// LRU cache HEAD
+struct atb_Lru {
+  struct atb_List recency;               /*!< Most recently used first */
+  struct atb_Lru_Node **buckets;         /*!< Hash index (power of 2 size) */
+  size_t bucket_count;                   /*!< Number of buckets */
+  size_t size;                           /*!< Number of nodes */
+  size_t bytes;                          /*!< Sum of the nodes bytes */
+  struct atb_Lru_Limits limits;          /*!< Eviction thresholds */
+  struct atb_Lru_Match match;            /*!< Key equality */
+  struct atb_Lru_Evict evict;            /*!< Eviction callback (optional) */
+  struct atb_Allocator const *allocator; /*!< Used for the buckets */
+};
+
+/**
+ *  \brief Retreive the ptr of the data structure containing the given
+ *         node_ptr, based on the parent struct type and the member name of the
+ *         node
+ *
+ *  \param[in] node_ptr A atb_Lru_Node ptr
+ *  \param[in] type The parent struct type containing the node_ptr
+ *  \param[in] member The name of the atb_Lru_Node member inside type
+ *
+ *  \return type* The parent struct ptr containing node_ptr
+ */
+#define atb_Lru_Entry(node_ptr, type, member) \
+  ((type *)((char *)(node_ptr) - offsetof(type, member)))
+
+/* Init *********************************************************************/
+
+/**
+ *  \brief Initialize an EMPTY cache
+ *
+ *  \param[in] allocator Allocator used for the hash index
+ *  \param[in] limits Entries/Bytes limits, nodes are evicted (least recently
+ *                    used first) when one of them is exceeded
+ *  \param[in] match Key equality callable
+ *  \param[in] evict Callable invoked on evicted nodes (K_ATB_BIND_NULL_AS when
+ *                   not needed)
+ *
+ *  \pre self != NULL
+ *  \pre allocator != NULL
+ *  \pre ATB_CALLABLE_IS_VALID(match)
+ *
+ *  \warning The struct atb_Lru contains the head of a struct atb_List, it can't
+ *           be copied/moved once initialized.
+ */
+ATB_PUBLIC extern void atb_Lru_Init(struct atb_Lru *const self,
+                                    struct atb_Allocator const *const allocator,
+                                    struct atb_Lru_Limits limits,
+                                    struct atb_Lru_Match match,
+                                    struct atb_Lru_Evict evict);
+
+/**
+ *  \brief Evict ALL nodes from the cache and release its hash index
+ *
+ *  \pre self != NULL
+ */
+ATB_PUBLIC extern void atb_Lru_Destroy(struct atb_Lru *const self);
+
+/* Introspect **************************************************************/
+
+/**
+ *  \return Number of nodes inside the cache
+ *
+ *  \pre self != NULL
+ */
+static inline size_t atb_Lru_Size(struct atb_Lru const *const self);
+
+/**
+ *  \return Sum of the bytes of all nodes inside the cache
+ *
+ *  \pre self != NULL
+ */
+static inline size_t atb_Lru_Bytes(struct atb_Lru const *const self);
+
+/* Lookup *******************************************************************/
+
+/**
+ *  \brief Find the node associated to \a key, and mark it as the most recently
+ *         used one
+ *
+ *  \param[in] hash Hash of the key
+ *  \param[in] key Key given to the match callable
+ *
+ *  \return struct atb_Lru_Node* The node found, NULL when not found
+ *
+ *  \pre self != NULL
+ *
+ *  \note Complexity: O(1) average
+ */
+ATB_PUBLIC extern struct atb_Lru_Node *atb_Lru_Find(
+    struct atb_Lru *const self, uint64_t hash, void const *key);
+
+/**
+ *  \brief Same as atb_Lru_Find, without modifying the recency of the node
+ */
+ATB_PUBLIC extern struct atb_Lru_Node *atb_Lru_Peek(
+    struct atb_Lru const *const self, uint64_t hash, void const *key);
+
+/* Mutation *****************************************************************/
+
+/**
+ *  \brief Insert \a node, as the most recently used one
+ *
+ *  If a node with the same key is already inside the cache, it is replaced
+ *  (and evicted). Least recently used nodes are then evicted until the limits
+ *  are respected (\a node itself is never evicted by its own insertion).
+ *
+ *  \param[in] node Node to be inserted
+ *  \param[in] hash Hash of the key of node
+ *  \param[in] key Key of node, given to the match callable
+ *  \param[in] bytes Cost of node for the bytes limit
+ *  \param[out] err Set on failure
+ *
+ *  \return bool False when the hash index failed to grow (node not inserted)
+ *
+ *  \pre self != NULL
+ *  \pre node != NULL
+ *  \pre node is not part of any cache
+ *
+ *  \note Complexity: O(1) amortized
+ */
+ATB_PUBLIC extern bool atb_Lru_Insert(struct atb_Lru *const self,
+                                      struct atb_Lru_Node *const node,
+                                      uint64_t hash, void const *key,
+                                      size_t bytes,
+                                      struct atb_Error *const err);
+
+/**
+ *  \brief Remove \a node from the cache (the evict callable is NOT invoked)
+ *
+ *  \pre self != NULL
+ *  \pre node != NULL
+ *  \pre node is part of self
+ *
+ *  \note Complexity: O(1) average
+ */
+ATB_PUBLIC extern void atb_Lru_Remove(struct atb_Lru *const self,
+                                      struct atb_Lru_Node *const node);
+
+/**
+ *  \brief Update the limits of the cache, evicting nodes accordingly
+ *
+ *  \pre self != NULL
+ */
+ATB_PUBLIC extern void atb_Lru_SetLimits(struct atb_Lru *const self,
+                                         struct atb_Lru_Limits limits);
+
+/***************************************************************************/
+/*                           Inline definitions                            */
+/***************************************************************************/
+
+static inline size_t atb_Lru_Size(struct atb_Lru const *const self) {
+  assert(self != NULL);
+  return self->size;
+}
+
+static inline size_t atb_Lru_Bytes(struct atb_Lru const *const self) {
+  assert(self != NULL);
+  return self->bytes;
+}
+
+#if defined(__cplusplus)
+} /* extern "C" */
+#endif
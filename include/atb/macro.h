@@ -19,3 +19,15 @@
  *  \brief Stringify a token AFTER evaluation
  */
 #define ATB_TKN_STR(a) ATB_INTERNAL_TKN_STR(a)
+
+/**
+ *  \brief Expand to F(CTX, arg) for each arg of __VA_ARGS__ (up to 16 args),
+ *         in order, without any separator
+ *
+ *  Example:
+ *  #define DECLARE_FIELD(T, NAME) T NAME;
+ *  struct S { ATB_FOR_EACH(DECLARE_FIELD, int, a, b, c) };
+ *  -> struct S { int a; int b; int c; };
+ */
+#define ATB_FOR_EACH(F, CTX, ...) \
+  ATB_INTERNAL_FOR_EACH_N(ATB_VA_ARGN(__VA_ARGS__), F, CTX, __VA_ARGS__)
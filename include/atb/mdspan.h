@@ -0,0 +1,278 @@
+#pragma once
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "atb/span.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/// Maximum number of dimensions of a mdspan
+#define K_ATB_MDSPAN_MAX_RANK 3
+
+/// Order of the elements of a mdspan inside its underlying span
+typedef enum {
+  K_ATB_MDSPAN_ROW_MAJOR, /*!< Last dimension contiguous (C arrays) */
+  K_ATB_MDSPAN_COL_MAJOR, /*!< First dimension contiguous (Fortran arrays) */
+} ATB_MDSPAN_LAYOUT;
+
+/// True whenever the enum value is in its defined range.
+static inline bool ATB_MDSPAN_LAYOUT_IsValid(ATB_MDSPAN_LAYOUT v) {
+  switch (v) {
+    case K_ATB_MDSPAN_ROW_MAJOR:
+    case K_ATB_MDSPAN_COL_MAJOR:
+      return true;
+  }
+  return false;
+}
+
+/// Declare a mdspan struct named \a NAME, representing a NON-OWNING
+/// multi-dimensional (1 to K_ATB_MDSPAN_MAX_RANK dimensions) view over values
+/// of type \a T, and all its associated functions. \a SPAN is the span type
+/// (see ATB_SPAN_DECLARE) of T, the mdspan is built from and flattened to.
+/// All functions are declared using \a SPECIFIER as specifiers.
+///
+/// Element (i0, i1, ...) is located at data[i0 * strides[0] + i1 *
+/// strides[1] + ...] (strides counted in elements): row-major, column-major
+/// and arbitrary strided layouts are all represented that way, such that
+/// slicing never copies (only the data pointer, extents and strides change).
+///
+/// Functions declared are the following:
+/// - `_From(span, rank, extents, layout) -> MDSPAN`: View the elements of span
+///   as a rank dimensions array of the given extents (their product can't
+///   exceed span.size), ordered following layout;
+/// - `_From_Strided(data, rank, extents, strides) -> MDSPAN`: View with
+///   explicit strides (in elements);
+/// - `_Extent(md, dim) -> size_t`: Number of elements along dimension dim;
+/// - `_Stride(md, dim) -> size_t`: Distance between 2 consecutive elements
+///   along dimension dim;
+/// - `_Size(md) -> size_t`: Total number of elements (product of extents);
+/// - `_At2(md, i, j) -> T*`: Element (i, j) of a 2-D mdspan;
+/// - `_At3(md, i, j, k) -> T*`: Element (i, j, k) of a 3-D mdspan;
+/// - `_Slice(md, dim, offset, count) -> MDSPAN`: Sub view of the count
+///   elements starting at offset along dimension dim (same rank);
+/// - `_Select(md, dim, index) -> MDSPAN`: Sub view with dimension dim fixed to
+///   index (rank - 1), e.g. a plane of a 3-D mdspan, a column of a 2-D one;
+/// - `_Transpose(md, dim0, dim1) -> MDSPAN`: Same elements with dimensions
+///   dim0 and dim1 swapped;
+/// - `_IsContiguous(md) -> bool`: True when the elements are contiguous, in
+///   row-major order (no gap);
+/// - `_Flatten(md) -> SPAN`: All elements of a contiguous mdspan;
+/// - `_Row(md, i) -> SPAN`: The i-th row of a 2-D mdspan which last dimension
+///   is contiguous (e.g. to vectorize the inner loop of tiles);
+///
+/// Example (iterating over 8x8 tiles of a row-major image, the last ones
+/// being smaller when width/height aren't multiples of 8):
+///
+/// ATB_MDSPAN_DECLARE(static, Image, atb_Span_u8, uint8_t);
+/// ATB_MDSPAN_DEFINE(static, Image, atb_Span_u8, uint8_t);
+///
+/// size_t const extents[] = {height, width};
+/// struct Image const image =
+///     Image_From(pixels, 2, extents, K_ATB_MDSPAN_ROW_MAJOR);
+///
+/// for (size_t y = 0; y < height; y += 8) {
+///   struct Image const band =
+///       Image_Slice(image, 0, y, (height - y < 8) ? height - y : 8);
+///   for (size_t x = 0; x < width; x += 8) {
+///     struct Image const tile =
+///         Image_Slice(band, 1, x, (width - x < 8) ? width - x : 8);
+///     for (size_t i = 0; i < Image_Extent(tile, 0); ++i) {
+///       struct atb_Span_u8 const row = Image_Row(tile, i);
+///       ...
+///     }
+///   }
+/// }
+#define ATB_MDSPAN_DECLARE(SPECIFIER, NAME, SPAN, T)                      \
+  struct NAME {                                                           \
+    T *data;                                                              \
+    size_t rank;                                                          \
+    size_t extents[K_ATB_MDSPAN_MAX_RANK];                                \
+    size_t strides[K_ATB_MDSPAN_MAX_RANK];                                \
+  };                                                                      \
+                                                                          \
+  SPECIFIER struct NAME NAME##_From(struct SPAN span, size_t rank,        \
+                                    size_t const *const extents,          \
+                                    ATB_MDSPAN_LAYOUT layout);            \
+  SPECIFIER struct NAME NAME##_From_Strided(T *data, size_t rank,         \
+                                            size_t const *const extents,  \
+                                            size_t const *const strides); \
+  SPECIFIER size_t NAME##_Extent(struct NAME md, size_t dim);             \
+  SPECIFIER size_t NAME##_Stride(struct NAME md, size_t dim);             \
+  SPECIFIER size_t NAME##_Size(struct NAME md);                           \
+  SPECIFIER T *NAME##_At2(struct NAME md, size_t i, size_t j);            \
+  SPECIFIER T *NAME##_At3(struct NAME md, size_t i, size_t j, size_t k);  \
+  SPECIFIER struct NAME NAME##_Slice(struct NAME md, size_t dim,          \
+                                     size_t offset, size_t count);        \
+  SPECIFIER struct NAME NAME##_Select(struct NAME md, size_t dim,         \
+                                      size_t index);                      \
+  SPECIFIER struct NAME NAME##_Transpose(struct NAME md, size_t dim0,     \
+                                         size_t dim1);                    \
+  SPECIFIER bool NAME##_IsContiguous(struct NAME md);                     \
+  SPECIFIER struct SPAN NAME##_Flatten(struct NAME md);                   \
+  SPECIFIER struct SPAN NAME##_Row(struct NAME md, size_t i)
+
+/// Define all functions associated to a mdspan struct named \a NAME (struct
+/// needs to be declared beforehands, see ATB_MDSPAN_DECLARE). All functions
+/// are defined using \a SPECIFIER as specifiers.
+#define ATB_MDSPAN_DEFINE(SPECIFIER, NAME, SPAN, T)                        \
+  SPECIFIER struct NAME NAME##_From_Strided(T *data, size_t rank,          \
+                                            size_t const *const extents,   \
+                                            size_t const *const strides) { \
+    assert((0 < rank) && (rank <= K_ATB_MDSPAN_MAX_RANK));                 \
+    assert(extents != NULL);                                               \
+    assert(strides != NULL);                                               \
+                                                                           \
+    struct NAME md;                                                        \
+    md.data = data;                                                        \
+    md.rank = rank;                                                        \
+                                                                           \
+    for (size_t dim = 0; dim < K_ATB_MDSPAN_MAX_RANK; ++dim) {             \
+      md.extents[dim] = (dim < rank) ? extents[dim] : 1;                   \
+      md.strides[dim] = (dim < rank) ? strides[dim] : 0;                   \
+    }                                                                      \
+                                                                           \
+    return md;                                                             \
+  }                                                                        \
+                                                                           \
+  SPECIFIER struct NAME NAME##_From(struct SPAN span, size_t rank,         \
+                                    size_t const *const extents,           \
+                                    ATB_MDSPAN_LAYOUT layout) {            \
+    assert((0 < rank) && (rank <= K_ATB_MDSPAN_MAX_RANK));                 \
+    assert(extents != NULL);                                               \
+    assert(ATB_MDSPAN_LAYOUT_IsValid(layout));                             \
+                                                                           \
+    size_t strides[K_ATB_MDSPAN_MAX_RANK];                                 \
+    size_t stride = 1;                                                     \
+                                                                           \
+    for (size_t n = 0; n < rank; ++n) {                                    \
+      size_t const dim =                                                   \
+          (layout == K_ATB_MDSPAN_ROW_MAJOR) ? (rank - 1 - n) : n;         \
+      strides[dim] = stride;                                               \
+      stride *= extents[dim];                                              \
+    }                                                                      \
+                                                                           \
+    assert(stride <= span.size);                                           \
+    return NAME##_From_Strided(span.data, rank, extents, strides);         \
+  }                                                                        \
+                                                                           \
+  SPECIFIER size_t NAME##_Extent(struct NAME md, size_t dim) {             \
+    assert(dim < md.rank);                                                 \
+    return md.extents[dim];                                                \
+  }                                                                        \
+                                                                           \
+  SPECIFIER size_t NAME##_Stride(struct NAME md, size_t dim) {             \
+    assert(dim < md.rank);                                                 \
+    return md.strides[dim];                                                \
+  }                                                                        \
+                                                                           \
+  SPECIFIER size_t NAME##_Size(struct NAME md) {                           \
+    /* Unused dimensions have an extent of 1 */                            \
+    return md.extents[0] * md.extents[1] * md.extents[2];                  \
+  }                                                                        \
+                                                                           \
+  SPECIFIER T *NAME##_At2(struct NAME md, size_t i, size_t j) {            \
+    assert(md.rank == 2);                                                  \
+    assert(i < md.extents[0]);                                             \
+    assert(j < md.extents[1]);                                             \
+                                                                           \
+    return md.data + (i * md.strides[0]) + (j * md.strides[1]);            \
+  }                                                                        \
+                                                                           \
+  SPECIFIER T *NAME##_At3(struct NAME md, size_t i, size_t j, size_t k) {  \
+    assert(md.rank == 3);                                                  \
+    assert(i < md.extents[0]);                                             \
+    assert(j < md.extents[1]);                                             \
+    assert(k < md.extents[2]);                                             \
+                                                                           \
+    return md.data + (i * md.strides[0]) + (j * md.strides[1]) +           \
+           (k * md.strides[2]);                                            \
+  }                                                                        \
+                                                                           \
+  SPECIFIER struct NAME NAME##_Slice(struct NAME md, size_t dim,           \
+                                     size_t offset, size_t count) {        \
+    assert(dim < md.rank);                                                 \
+    assert(offset <= md.extents[dim]);                                     \
+    assert(count <= (md.extents[dim] - offset));                           \
+                                                                           \
+    md.data += offset * md.strides[dim];                                   \
+    md.extents[dim] = count;                                               \
+    return md;                                                             \
+  }                                                                        \
+                                                                           \
+  SPECIFIER struct NAME NAME##_Select(struct NAME md, size_t dim,          \
+                                      size_t index) {                      \
+    assert(md.rank > 1);                                                   \
+    assert(dim < md.rank);                                                 \
+    assert(index < md.extents[dim]);                                       \
+                                                                           \
+    md.data += index * md.strides[dim];                                    \
+                                                                           \
+    for (size_t d = dim + 1; d < K_ATB_MDSPAN_MAX_RANK; ++d) {             \
+      md.extents[d - 1] = md.extents[d];                                   \
+      md.strides[d - 1] = md.strides[d];                                   \
+    }                                                                      \
+                                                                           \
+    md.extents[K_ATB_MDSPAN_MAX_RANK - 1] = 1;                             \
+    md.strides[K_ATB_MDSPAN_MAX_RANK - 1] = 0;                             \
+    md.rank -= 1;                                                          \
+    return md;                                                             \
+  }                                                                        \
+                                                                           \
+  SPECIFIER struct NAME NAME##_Transpose(struct NAME md, size_t dim0,      \
+                                         size_t dim1) {                    \
+    assert(dim0 < md.rank);                                                \
+    assert(dim1 < md.rank);                                                \
+                                                                           \
+    size_t const extent = md.extents[dim0];                                \
+    size_t const stride = md.strides[dim0];                                \
+    md.extents[dim0] = md.extents[dim1];                                   \
+    md.strides[dim0] = md.strides[dim1];                                   \
+    md.extents[dim1] = extent;                                             \
+    md.strides[dim1] = stride;                                             \
+    return md;                                                             \
+  }                                                                        \
+                                                                           \
+  SPECIFIER bool NAME##_IsContiguous(struct NAME md) {                     \
+    size_t stride = 1;                                                     \
+                                                                           \
+    for (size_t n = 0; n < md.rank; ++n) {                                 \
+      size_t const dim = md.rank - 1 - n;                                  \
+      /* Strides of a dimension of extent 1 never matter */                \
+      if ((md.extents[dim] != 1) && (md.strides[dim] != stride)) {         \
+        return false;                                                      \
+      }                                                                    \
+      stride *= md.extents[dim];                                           \
+    }                                                                      \
+                                                                           \
+    return true;                                                           \
+  }                                                                        \
+                                                                           \
+  SPECIFIER struct SPAN NAME##_Flatten(struct NAME md) {                   \
+    assert(NAME##_IsContiguous(md));                                       \
+                                                                           \
+    struct SPAN span;                                                      \
+    span.data = md.data;                                                   \
+    span.size = NAME##_Size(md);                                           \
+    return span;                                                           \
+  }                                                                        \
+                                                                           \
+  SPECIFIER struct SPAN NAME##_Row(struct NAME md, size_t i) {             \
+    assert(md.rank == 2);                                                  \
+    assert(i < md.extents[0]);                                             \
+    assert((md.strides[1] == 1) || (md.extents[1] <= 1));                  \
+                                                                           \
+    struct SPAN span;                                                      \
+    span.data = md.data + (i * md.strides[0]);                             \
+    span.size = md.extents[1];                                             \
+    return span;                                                           \
+  }                                                                        \
+                                                                           \
+  static_assert(true, "SEMI-COLON NEEDED HERE")
+
+#if defined(__cplusplus)
+} /* extern "C" */
+#endif
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "atb/allocator.h"
+#include "atb/error.h"
+#include "atb/export.h"
+#include "atb/functional.h"
+#include "atb/span/string.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/// Node of a radix tree (opaque)
+struct atb_Radix_Node;
+
+/**
+ *  \brief Compressed radix tree (a.k.a. patricia trie), mapping string keys to
+ *         user values
+ *
+ *  Each edge holds a (copied) string label, chains of nodes with a single
+ *  child are merged: a lookup is a single walk over the key, whatever the
+ *  number of keys stored.
+ *
+ *  Example:
+ *  struct atb_Radix routes;
+ *  atb_Radix_Init(&routes, atb_DefaultAllocator());
+ *
+ *  atb_Radix_Insert(&routes, atb_StrView_From_StrLiteral("/api/"), &api, &err);
+ *  atb_Radix_Insert(&routes, atb_StrView_From_StrLiteral("/api/v2/"), &v2,
+ *                   &err);
+ *
+ *  size_t length = 0;
+ *  void *handler = NULL;
+ *  if (atb_Radix_LongestPrefix(&routes, path, &length, &handler)) {
+ *    ... path starts with the (length first bytes) route of handler ...
+ *  }
+ *
+ *  atb_Radix_Destroy(&routes);
+ */
+struct atb_Radix {
+  struct atb_Radix_Node *root;           /*!< Node of the empty prefix */
+  size_t size;                           /*!< Number of keys */
+  struct atb_Allocator const *allocator; /*!< Used for the nodes */
+};
+
+/// Invoked on each key (and its value) that is a prefix of the searched key,
+/// shortest first. Returns false to stop the iteration.
+ATB_CALLABLE_DECLARE(bool, atb_Radix_Visit, struct atb_StrView prefix,
+                     void *value);
+
+/* Init *********************************************************************/
+
+/**
+ *  \brief Initialize an EMPTY tree
+ *
+ *  \pre self != NULL
+ *  \pre allocator != NULL
+ */
+ATB_PUBLIC extern void atb_Radix_Init(
+    struct atb_Radix *const self, struct atb_Allocator const *const allocator);
+
+/**
+ *  \brief Release ALL nodes of the tree (values are NOT touched)
+ *
+ *  \pre self != NULL
+ */
+ATB_PUBLIC extern void atb_Radix_Destroy(struct atb_Radix *const self);
+
+/**
+ *  \return Number of keys inside the tree
+ *
+ *  \pre self != NULL
+ */
+static inline size_t atb_Radix_Size(struct atb_Radix const *const self);
+
+/* Mutation *****************************************************************/
+
+/**
+ *  \brief Associate \a value to \a key (replacing the previous value, if any)
+ *
+ *  \return False when memory allocation failed (tree unchanged)
+ *
+ *  \pre self != NULL
+ *  \pre atb_StrView_IsValid(key)
+ *
+ *  \note Complexity: O(key.size)
+ */
+ATB_PUBLIC extern bool atb_Radix_Insert(struct atb_Radix *const self,
+                                        struct atb_StrView key, void *value,
+                                        struct atb_Error *const err);
+
+/**
+ *  \brief Remove \a key from the tree
+ *
+ *  \param[out] value Set to the value of the removed key (optional)
+ *
+ *  \return False when the key is not part of the tree
+ *
+ *  \pre self != NULL
+ *  \pre atb_StrView_IsValid(key)
+ */
+ATB_PUBLIC extern bool atb_Radix_Remove(struct atb_Radix *const self,
+                                        struct atb_StrView key, void **value);
+
+/* Lookup *******************************************************************/
+
+/**
+ *  \brief Find the value associated to \a key (exact match)
+ *
+ *  \param[out] value Set to the value found (optional)
+ *
+ *  \return False when the key is not part of the tree
+ *
+ *  \pre self != NULL
+ *  \pre atb_StrView_IsValid(key)
+ */
+ATB_PUBLIC extern bool atb_Radix_Find(struct atb_Radix const *const self,
+                                      struct atb_StrView key, void **value);
+
+/**
+ *  \brief Find the longest key of the tree that is a prefix of \a key
+ *
+ *  \param[out] length Set to the size of the key found (optional)
+ *  \param[out] value Set to the value of the key found (optional)
+ *
+ *  \return False when no key of the tree is a prefix of \a key
+ *
+ *  \pre self != NULL
+ *  \pre atb_StrView_IsValid(key)
+ *
+ *  \note Complexity: O(key.size)
+ */
+ATB_PUBLIC extern bool atb_Radix_LongestPrefix(
+    struct atb_Radix const *const self, struct atb_StrView key,
+    size_t *length, void **value);
+
+/**
+ *  \brief Invoke \a visit on ALL the keys of the tree that are a prefix of
+ *         \a key, shortest first, until it returns false
+ *
+ *  \return True when all prefixes were visited
+ *
+ *  \pre self != NULL
+ *  \pre atb_StrView_IsValid(key)
+ *  \pre ATB_CALLABLE_IS_VALID(visit)
+ *
+ *  \note Complexity: O(key.size)
+ */
+ATB_PUBLIC extern bool atb_Radix_AllPrefixes(struct atb_Radix const *const self,
+                                             struct atb_StrView key,
+                                             struct atb_Radix_Visit visit);
+
+/***************************************************************************/
+/*                           Inline definitions                            */
+/***************************************************************************/
+
+static inline size_t atb_Radix_Size(struct atb_Radix const *const self) {
+  assert(self != NULL);
+  return self->size;
+}
+
+#if defined(__cplusplus)
+} /* extern "C" */
+#endif
@@ -0,0 +1,374 @@
+#pragma once
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "atb/allocator.h"
+#include "atb/error.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/// Capacity of a growable ring after its first allocation
+#define K_ATB_RING_MIN_CAPACITY 8
+
+/// Declare a circular deque struct named \a NAME, storing elements of type
+/// \a T, and all its associated functions. All functions are declared using
+/// \a SPECIFIER as specifiers.
+///
+/// \a SPAN is the span type (see ATB_SPAN_DECLARE) associated to \a T, used to
+/// provide an external buffer and to expose the ring content.
+///
+/// The capacity of the ring is ALWAYS a power of 2, such that wrapping indexes
+/// is done using a mask instead of a modulo/branch. A ring is either:
+/// - FIXED: using a buffer provided by the user, pushing elements when full
+///   fails;
+/// - GROWABLE: using a buffer from struct atb_Allocator, that doubles in size
+///   when full;
+///
+/// Functions declared are the following:
+/// - `_Init(self, allocator)`: Initialize an EMPTY growable ring;
+/// - `_Init_Fixed(self, buffer)`: Initialize an EMPTY ring using buffer as
+///   storage (buffer.size MUST be a power of 2);
+/// - `_Destroy(self)`: Release the storage of a growable ring;
+/// - `_Clear(self)`: Remove all elements (keeping the storage);
+/// - `_Size(self) -> size_t`: Number of elements inside the ring;
+/// - `_Capacity(self) -> size_t`: Number of elements the ring can hold without
+///   growing;
+/// - `_Reserve(self, capacity, err) -> bool`: Make sure the ring can hold
+///   capacity elements without growing;
+/// - `_PushBack/_PushFront(self, value, err) -> bool`: Add value at one end;
+/// - `_PopBack/_PopFront(self, value) -> bool`: Remove an element at one end,
+///   optionally returning it. False when empty;
+/// - `_At(self, i) -> T*`: i-th element, starting from the front;
+/// - `_Append(self, values, n, err) -> bool`: Push back n values at once;
+/// - `_Consume(self, n)`: Pop front n elements at once;
+/// - `_Commit(self, n)`: Push back the first n elements of _AsFreeSpans;
+/// - `_AsSpans(self, first, second)`: Content of the ring, as 2 contiguous
+///   spans (second being empty when the content doesn't wrap around);
+/// - `_AsFreeSpans(self, first, second)`: Unused storage of the ring, as 2
+///   contiguous spans, following the content;
+///
+/// Streaming example (bytes ring with a fixed buffer of 4096 bytes):
+///
+/// struct atb_Span_u8 first, second;
+/// ByteRing_AsFreeSpans(&ring, &first, &second);
+/// ByteRing_Commit(&ring, read(fd, first.data, first.size));
+///
+/// ByteRing_AsSpans(&ring, &first, &second);
+/// ByteRing_Consume(&ring, Parse(first, second));
+#define ATB_RING_DECLARE(SPECIFIER, NAME, SPAN, T)                         \
+  struct NAME {                                                            \
+    T *data;                                                               \
+    size_t capacity;                                                       \
+    size_t head;                                                           \
+    size_t size;                                                           \
+    struct atb_Allocator const *allocator;                                 \
+  };                                                                       \
+                                                                           \
+  SPECIFIER void NAME##_Init(struct NAME *const self,                      \
+                             struct atb_Allocator const *const allocator); \
+  SPECIFIER void NAME##_Init_Fixed(struct NAME *const self,                \
+                                   struct SPAN buffer);                    \
+  SPECIFIER void NAME##_Destroy(struct NAME *const self);                  \
+  SPECIFIER void NAME##_Clear(struct NAME *const self);                    \
+  SPECIFIER size_t NAME##_Size(struct NAME const *const self);             \
+  SPECIFIER size_t NAME##_Capacity(struct NAME const *const self);         \
+  SPECIFIER bool NAME##_Reserve(struct NAME *const self, size_t capacity,  \
+                                struct atb_Error *const err);              \
+  SPECIFIER bool NAME##_PushBack(struct NAME *const self, T value,         \
+                                 struct atb_Error *const err);             \
+  SPECIFIER bool NAME##_PushFront(struct NAME *const self, T value,        \
+                                  struct atb_Error *const err);            \
+  SPECIFIER bool NAME##_PopBack(struct NAME *const self, T *const value);  \
+  SPECIFIER bool NAME##_PopFront(struct NAME *const self, T *const value); \
+  SPECIFIER T *NAME##_At(struct NAME const *const self, size_t i);         \
+  SPECIFIER bool NAME##_Append(struct NAME *const self,                    \
+                               T const *const values, size_t n,            \
+                               struct atb_Error *const err);               \
+  SPECIFIER void NAME##_Consume(struct NAME *const self, size_t n);        \
+  SPECIFIER void NAME##_Commit(struct NAME *const self, size_t n);         \
+  SPECIFIER void NAME##_AsSpans(struct NAME const *const self,             \
+                                struct SPAN *const first,                  \
+                                struct SPAN *const second);                \
+  SPECIFIER void NAME##_AsFreeSpans(struct NAME const *const self,         \
+                                    struct SPAN *const first,              \
+                                    struct SPAN *const second)
+
+/// Define all functions associated to a circular deque named \a NAME (struct
+/// needs to be declared beforehands using ATB_RING_DECLARE), storing elements
+/// of type \a T, with \a SPAN being the span type associated to \a T. All
+/// functions are defined using \a SPECIFIER as specifiers.
+///
+/// See ATB_RING_DECLARE for the list of functions defined.
+#define ATB_RING_DEFINE(SPECIFIER, NAME, SPAN, T)                             \
+  static inline bool NAME##_IsPow2(size_t value) {                            \
+    return (value != 0) && ((value & (value - 1)) == 0);                      \
+  }                                                                           \
+                                                                              \
+  /* Index inside data of the i-th element (starting from the front) */       \
+  static size_t NAME##_Index(struct NAME const *const self, size_t i) {       \
+    return (self->head + i) & (self->capacity - 1);                           \
+  }                                                                           \
+                                                                              \
+  /* Split the range of n elements, starting at the i-th element, into (at    \
+   * most) 2 contiguous spans */                                              \
+  static void NAME##_Split(struct NAME const *const self, size_t i, size_t n, \
+                           struct SPAN *const first,                          \
+                           struct SPAN *const second) {                       \
+    if (self->capacity == 0) {                                                \
+      first->data = second->data = self->data;                                \
+      first->size = second->size = 0;                                         \
+      return;                                                                 \
+    }                                                                         \
+                                                                              \
+    size_t const begin = NAME##_Index(self, i);                               \
+    size_t const until_end = self->capacity - begin;                          \
+                                                                              \
+    first->data = self->data + begin;                                         \
+    first->size = (n < until_end) ? n : until_end;                            \
+    second->data = self->data;                                                \
+    second->size = n - first->size;                                           \
+  }                                                                           \
+                                                                              \
+  SPECIFIER void NAME##_Init(struct NAME *const self,                         \
+                             struct atb_Allocator const *const allocator) {   \
+    assert(self != NULL);                                                     \
+    assert(allocator != NULL);                                                \
+                                                                              \
+    self->data = NULL;                                                        \
+    self->capacity = 0;                                                       \
+    self->head = 0;                                                           \
+    self->size = 0;                                                           \
+    self->allocator = allocator;                                              \
+  }                                                                           \
+                                                                              \
+  SPECIFIER void NAME##_Init_Fixed(struct NAME *const self,                   \
+                                   struct SPAN buffer) {                      \
+    assert(self != NULL);                                                     \
+    assert(buffer.data != NULL);                                              \
+    assert(NAME##_IsPow2(buffer.size));                                       \
+                                                                              \
+    self->data = buffer.data;                                                 \
+    self->capacity = buffer.size;                                             \
+    self->head = 0;                                                           \
+    self->size = 0;                                                           \
+    self->allocator = NULL;                                                   \
+  }                                                                           \
+                                                                              \
+  SPECIFIER void NAME##_Destroy(struct NAME *const self) {                    \
+    assert(self != NULL);                                                     \
+                                                                              \
+    if ((self->allocator != NULL) && (self->data != NULL)) {                  \
+      (void)atb_Allocator_Release(self->allocator, (void **)&(self->data),    \
+                                  K_ATB_ERROR_IGNORED);                       \
+      self->data = NULL;                                                      \
+      self->capacity = 0;                                                     \
+    }                                                                         \
+                                                                              \
+    NAME##_Clear(self);                                                       \
+  }                                                                           \
+                                                                              \
+  SPECIFIER void NAME##_Clear(struct NAME *const self) {                      \
+    assert(self != NULL);                                                     \
+                                                                              \
+    self->head = 0;                                                           \
+    self->size = 0;                                                           \
+  }                                                                           \
+                                                                              \
+  SPECIFIER size_t NAME##_Size(struct NAME const *const self) {               \
+    assert(self != NULL);                                                     \
+    return self->size;                                                        \
+  }                                                                           \
+                                                                              \
+  SPECIFIER size_t NAME##_Capacity(struct NAME const *const self) {           \
+    assert(self != NULL);                                                     \
+    return self->capacity;                                                    \
+  }                                                                           \
+                                                                              \
+  SPECIFIER bool NAME##_Reserve(struct NAME *const self, size_t capacity,     \
+                                struct atb_Error *const err) {                \
+    assert(self != NULL);                                                     \
+                                                                              \
+    if (capacity <= self->capacity) return true;                              \
+                                                                              \
+    if (self->allocator == NULL) {                                            \
+      atb_GenericError_Set(err, K_ATB_ERROR_GENERIC_NO_BUFFER_SPACE);         \
+      return false;                                                           \
+    }                                                                         \
+                                                                              \
+    size_t const old_capacity = self->capacity;                               \
+    size_t new_capacity = (old_capacity == 0) ? K_ATB_RING_MIN_CAPACITY       \
+                                              : (old_capacity * 2);           \
+                                                                              \
+    while (new_capacity < capacity) {                                         \
+      if (new_capacity > (SIZE_MAX / 2)) break;                               \
+      new_capacity *= 2;                                                      \
+    }                                                                         \
+                                                                              \
+    if ((new_capacity < capacity) ||                                          \
+        (new_capacity > (SIZE_MAX / sizeof(T)))) {                            \
+      atb_GenericError_Set(err, K_ATB_ERROR_GENERIC_VALUE_TOO_LARGE);         \
+      return false;                                                           \
+    }                                                                         \
+                                                                              \
+    T *const data = (T *)atb_Allocator_Alloc(                                 \
+        self->allocator, self->data, new_capacity * sizeof(T), err);          \
+                                                                              \
+    if (data == NULL) return false;                                           \
+                                                                              \
+    self->data = data;                                                        \
+    self->capacity = new_capacity;                                            \
+                                                                              \
+    /* Unwrap the content, moving the smallest part of it */                  \
+    if ((self->head + self->size) > old_capacity) {                           \
+      size_t const head_part = old_capacity - self->head;                     \
+      size_t const wrapped_part = self->size - head_part;                     \
+                                                                              \
+      if (wrapped_part <= head_part) {                                        \
+        memcpy(&(data[old_capacity]), data, wrapped_part * sizeof(T));        \
+      } else {                                                                \
+        size_t const head = new_capacity - head_part;                         \
+        memcpy(&(data[head]), &(data[self->head]), head_part * sizeof(T));    \
+        self->head = head;                                                    \
+      }                                                                       \
+    }                                                                         \
+                                                                              \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  SPECIFIER bool NAME##_PushBack(struct NAME *const self, T value,            \
+                                 struct atb_Error *const err) {               \
+    assert(self != NULL);                                                     \
+                                                                              \
+    if ((self->size == self->capacity) &&                                     \
+        !NAME##_Reserve(self, self->size + 1, err)) {                         \
+      return false;                                                           \
+    }                                                                         \
+                                                                              \
+    self->data[NAME##_Index(self, self->size)] = value;                       \
+    self->size += 1;                                                          \
+                                                                              \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  SPECIFIER bool NAME##_PushFront(struct NAME *const self, T value,           \
+                                  struct atb_Error *const err) {              \
+    assert(self != NULL);                                                     \
+                                                                              \
+    if ((self->size == self->capacity) &&                                     \
+        !NAME##_Reserve(self, self->size + 1, err)) {                         \
+      return false;                                                           \
+    }                                                                         \
+                                                                              \
+    self->head = (self->head - 1) & (self->capacity - 1);                     \
+    self->data[self->head] = value;                                           \
+    self->size += 1;                                                          \
+                                                                              \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  SPECIFIER bool NAME##_PopBack(struct NAME *const self, T *const value) {    \
+    assert(self != NULL);                                                     \
+                                                                              \
+    if (self->size == 0) return false;                                        \
+                                                                              \
+    self->size -= 1;                                                          \
+    if (value != NULL) *value = self->data[NAME##_Index(self, self->size)];   \
+                                                                              \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  SPECIFIER bool NAME##_PopFront(struct NAME *const self, T *const value) {   \
+    assert(self != NULL);                                                     \
+                                                                              \
+    if (self->size == 0) return false;                                        \
+                                                                              \
+    if (value != NULL) *value = self->data[self->head];                       \
+    self->head = NAME##_Index(self, 1);                                       \
+    self->size -= 1;                                                          \
+                                                                              \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  SPECIFIER T *NAME##_At(struct NAME const *const self, size_t i) {           \
+    assert(self != NULL);                                                     \
+    assert(i < self->size);                                                   \
+                                                                              \
+    return &(self->data[NAME##_Index(self, i)]);                              \
+  }                                                                           \
+                                                                              \
+  SPECIFIER bool NAME##_Append(struct NAME *const self,                       \
+                               T const *const values, size_t n,               \
+                               struct atb_Error *const err) {                 \
+    assert(self != NULL);                                                     \
+    assert((values != NULL) || (n == 0));                                     \
+                                                                              \
+    if (n == 0) return true;                                                  \
+                                                                              \
+    if (n > (SIZE_MAX - self->size)) {                                        \
+      atb_GenericError_Set(err, K_ATB_ERROR_GENERIC_VALUE_TOO_LARGE);         \
+      return false;                                                           \
+    }                                                                         \
+                                                                              \
+    if (!NAME##_Reserve(self, self->size + n, err)) return false;             \
+                                                                              \
+    struct SPAN first;                                                        \
+    struct SPAN second;                                                       \
+    NAME##_AsFreeSpans(self, &first, &second);                                \
+                                                                              \
+    size_t const count = (n < first.size) ? n : first.size;                   \
+    memcpy(first.data, values, count * sizeof(T));                            \
+    memcpy(second.data, values + count, (n - count) * sizeof(T));             \
+    self->size += n;                                                          \
+                                                                              \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  SPECIFIER void NAME##_Consume(struct NAME *const self, size_t n) {          \
+    assert(self != NULL);                                                     \
+    assert(n <= self->size);                                                  \
+                                                                              \
+    self->head = NAME##_Index(self, n);                                       \
+    self->size -= n;                                                          \
+                                                                              \
+    if (self->size == 0) self->head = 0;                                      \
+  }                                                                           \
+                                                                              \
+  SPECIFIER void NAME##_Commit(struct NAME *const self, size_t n) {           \
+    assert(self != NULL);                                                     \
+    assert(n <= (self->capacity - self->size));                               \
+                                                                              \
+    self->size += n;                                                          \
+  }                                                                           \
+                                                                              \
+  SPECIFIER void NAME##_AsSpans(struct NAME const *const self,                \
+                                struct SPAN *const first,                     \
+                                struct SPAN *const second) {                  \
+    assert(self != NULL);                                                     \
+    assert(first != NULL);                                                    \
+    assert(second != NULL);                                                   \
+                                                                              \
+    NAME##_Split(self, 0, self->size, first, second);                         \
+  }                                                                           \
+                                                                              \
+  SPECIFIER void NAME##_AsFreeSpans(struct NAME const *const self,            \
+                                    struct SPAN *const first,                 \
+                                    struct SPAN *const second) {              \
+    assert(self != NULL);                                                     \
+    assert(first != NULL);                                                    \
+    assert(second != NULL);                                                   \
+                                                                              \
+    NAME##_Split(self, self->size, self->capacity - self->size, first,        \
+                 second);                                                     \
+  }                                                                           \
+                                                                              \
+  static_assert(true, "SEMI-COLON NEEDED HERE")
+
+#if defined(__cplusplus)
+}
+#endif
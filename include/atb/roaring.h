@@ -0,0 +1,285 @@
+#pragma once
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "atb/allocator.h"
+#include "atb/error.h"
+#include "atb/export.h"
+#include "atb/functional.h"
+#include "atb/span/ints.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/// Maximum number of values stored inside an ARRAY container, above which a
+/// BITMAP container is smaller
+#define K_ATB_ROARING_ARRAY_MAX_SIZE 4096
+
+/// Number of uint64_t words of a BITMAP container (65536 bits)
+#define K_ATB_ROARING_BITMAP_WORDS 1024
+
+/// Magic number starting a serialized bitmap ('ATBR' in little endian)
+#define K_ATB_ROARING_MAGIC 0x52425441
+
+/// Representation of the values of a container
+enum atb_Roaring_Kind {
+  K_ATB_ROARING_ARRAY = 0,  /*!< Sorted uint16_t values */
+  K_ATB_ROARING_BITMAP = 1, /*!< K_ATB_ROARING_BITMAP_WORDS uint64_t words */
+  K_ATB_ROARING_RUN = 2,    /*!< Sorted atb_Roaring_Run */
+};
+
+/// Range of consecutive values [start, last] inside a RUN container
+struct atb_Roaring_Run {
+  uint16_t start; /*!< First value of the run */
+  uint16_t last;  /*!< Last value of the run (included) */
+};
+
+/**
+ *  \brief Set of the values sharing the same 16 most significant bits
+ *
+ *  \note Containers are never empty
+ */
+struct atb_Roaring_Container {
+  void *data;           /*!< Values (representation depends on kind) */
+  uint32_t size;        /*!< Number of elements of data */
+  uint32_t capacity;    /*!< Elements allocated, 0 when borrowed (view) */
+  uint32_t cardinality; /*!< Number of values inside the container */
+  uint16_t key;         /*!< 16 most significant bits of the values */
+  uint8_t kind;         /*!< enum atb_Roaring_Kind */
+};
+
+/**
+ *  \brief Roaring compressed bitmap, a set of uint32_t values
+ *
+ *  Values are split into chunks of 65536 values (sharing their 16 most
+ *  significant bits), each stored inside the smallest of:
+ *  - ARRAY: sorted values, for sparse chunks (<= 4096 values);
+ *  - BITMAP: 65536 bits, for dense chunks;
+ *  - RUN: sorted ranges of consecutive values (see atb_Roaring_Optimize).
+ *
+ *  Example:
+ *  struct atb_Roaring ids;
+ *  atb_Roaring_Init(&ids, atb_DefaultAllocator());
+ *
+ *  atb_Roaring_Add(&ids, 42, &err);
+ *  atb_Roaring_AddRange(&ids, 1000, 200000, &err);
+ *  atb_Roaring_Optimize(&ids, &err);
+ *
+ *  assert(atb_Roaring_Contains(&ids, 42));
+ *  assert(atb_Roaring_Cardinality(&ids) == 199001);
+ *
+ *  atb_Roaring_Destroy(&ids);
+ */
+struct atb_Roaring {
+  struct atb_Roaring_Container *containers; /*!< Sorted by key */
+  size_t size;                              /*!< Number of containers */
+  size_t capacity;                          /*!< Containers allocated */
+  struct atb_Allocator const *allocator;    /*!< Containers allocator */
+};
+
+/// Invoked on each value of a bitmap (increasing order), returns false to stop
+/// the iteration
+ATB_CALLABLE_DECLARE(bool, atb_Roaring_Visit, uint32_t value);
+
+/* Init *********************************************************************/
+
+/**
+ *  \brief Initialize an EMPTY bitmap
+ *
+ *  \pre self != NULL
+ *  \pre allocator != NULL
+ */
+ATB_PUBLIC extern void atb_Roaring_Init(
+    struct atb_Roaring *const self,
+    struct atb_Allocator const *const allocator);
+
+/**
+ *  \brief Release ALL the memory owned by the bitmap (leaving it EMPTY)
+ *
+ *  \pre self != NULL
+ */
+ATB_PUBLIC extern void atb_Roaring_Destroy(struct atb_Roaring *const self);
+
+/* Introspect **************************************************************/
+
+/**
+ *  \return Number of values inside the bitmap
+ *
+ *  \pre self != NULL
+ *
+ *  \note Complexity: O(number of containers)
+ */
+ATB_PUBLIC extern uint64_t atb_Roaring_Cardinality(
+    struct atb_Roaring const *const self);
+
+/**
+ *  \return True when \a value is part of the bitmap
+ *
+ *  \pre self != NULL
+ *
+ *  \note Complexity: O(log(containers) + log(container size))
+ */
+ATB_PUBLIC extern bool atb_Roaring_Contains(
+    struct atb_Roaring const *const self, uint32_t value);
+
+/**
+ *  \brief Invoke \a visit on each value of the bitmap, in increasing order,
+ *         until it returns false
+ *
+ *  \return True when all values were visited
+ *
+ *  \pre self != NULL
+ *  \pre ATB_CALLABLE_IS_VALID(visit)
+ */
+ATB_PUBLIC extern bool atb_Roaring_ForEach(struct atb_Roaring const *const self,
+                                           struct atb_Roaring_Visit visit);
+
+/* Mutation *****************************************************************/
+
+/**
+ *  \brief Add \a value to the bitmap
+ *
+ *  \return False when memory allocation failed (bitmap unchanged)
+ *
+ *  \pre self != NULL
+ */
+ATB_PUBLIC extern bool atb_Roaring_Add(struct atb_Roaring *const self,
+                                       uint32_t value,
+                                       struct atb_Error *const err);
+
+/**
+ *  \brief Add ALL the values in [first, last] to the bitmap
+ *
+ *  \return False when memory allocation failed (values might have been
+ *          partially added)
+ *
+ *  \pre self != NULL
+ *  \pre first <= last
+ */
+ATB_PUBLIC extern bool atb_Roaring_AddRange(struct atb_Roaring *const self,
+                                            uint32_t first, uint32_t last,
+                                            struct atb_Error *const err);
+
+/**
+ *  \brief Remove \a value from the bitmap
+ *
+ *  \return False when memory allocation failed (bitmap unchanged), which can
+ *          only happen when splitting a RUN container
+ *
+ *  \pre self != NULL
+ */
+ATB_PUBLIC extern bool atb_Roaring_Remove(struct atb_Roaring *const self,
+                                          uint32_t value,
+                                          struct atb_Error *const err);
+
+/**
+ *  \brief Convert each container to its smallest representation, using RUN
+ *         containers when values are mostly consecutive
+ *
+ *  \return False when memory allocation failed (some containers might not be
+ *          converted, the bitmap content is unchanged)
+ *
+ *  \pre self != NULL
+ */
+ATB_PUBLIC extern bool atb_Roaring_Optimize(struct atb_Roaring *const self,
+                                            struct atb_Error *const err);
+
+/* Set operations ***********************************************************/
+
+/**@{*/
+/**
+ *  \brief Compute \a lhs OP \a rhs into \a dest, OP being:
+ *         - Union: lhs | rhs
+ *         - Intersection: lhs & rhs
+ *
+ *  The previous content of \a dest is released, dest is left EMPTY on failure.
+ *
+ *  \pre dest != NULL, dest is initialized
+ *  \pre lhs != NULL
+ *  \pre rhs != NULL
+ *  \pre dest != lhs && dest != rhs
+ *
+ *  \note Complexity: O(containers), with containers combined using merges for
+ *        sparse ones and 64-bit words operations for dense ones
+ */
+ATB_PUBLIC extern bool atb_Roaring_Union(struct atb_Roaring *const dest,
+                                         struct atb_Roaring const *const lhs,
+                                         struct atb_Roaring const *const rhs,
+                                         struct atb_Error *const err);
+
+ATB_PUBLIC extern bool atb_Roaring_Intersection(
+    struct atb_Roaring *const dest, struct atb_Roaring const *const lhs,
+    struct atb_Roaring const *const rhs, struct atb_Error *const err);
+/**@}*/
+
+/**
+ *  \return Cardinality of \a lhs & \a rhs, without materializing it
+ *
+ *  \pre lhs != NULL
+ *  \pre rhs != NULL
+ */
+ATB_PUBLIC extern uint64_t atb_Roaring_IntersectionCardinality(
+    struct atb_Roaring const *const lhs, struct atb_Roaring const *const rhs);
+
+/* Serialization ************************************************************/
+
+/**
+ *  \brief Serialized format (native byte order, everything 8 bytes aligned):
+ *         - header: uint32_t magic, uint32_t number of containers;
+ *         - descriptors: for each container, uint16_t key, uint16_t kind,
+ *           uint32_t size, uint32_t cardinality, uint32_t offset (in bytes,
+ *           from the beginning of the header) of its data;
+ *         - the data of each container (padded to 8 bytes).
+ *
+ *  The data of the containers is stored exactly as in memory, such that
+ *  atb_Roaring_View can use it in place (e.g. from a mmapped file).
+ */
+
+/**
+ *  \return Number of bytes needed by atb_Roaring_Serialize
+ *
+ *  \pre self != NULL
+ */
+ATB_PUBLIC extern size_t atb_Roaring_SerializedSize(
+    struct atb_Roaring const *const self);
+
+/**
+ *  \brief Serialize the bitmap into \a buffer
+ *
+ *  \return False when buffer is too small (K_ATB_ERROR_GENERIC_NO_BUFFER_SPACE)
+ *
+ *  \pre self != NULL
+ *  \pre atb_Span_u8_IsValid(buffer)
+ *  \pre buffer.data is 8 bytes aligned
+ */
+ATB_PUBLIC extern bool atb_Roaring_Serialize(
+    struct atb_Roaring const *const self, struct atb_Span_u8 buffer,
+    struct atb_Error *const err);
+
+/**
+ *  \brief Initialize \a self from serialized \a bytes WITHOUT copying the
+ *         containers data (only the container descriptors are allocated)
+ *
+ *  Containers data is copied (copy-on-write) only when modified, such that
+ *  \a bytes is never written to.
+ *
+ *  \return False when bytes are not a valid serialized bitmap
+ *          (K_ATB_ERROR_GENERIC_BAD_MESSAGE) or allocation failed
+ *
+ *  \pre self != NULL
+ *  \pre allocator != NULL
+ *  \pre atb_View_u8_IsValid(bytes)
+ *
+ *  \warning \a bytes MUST outlive self (or until atb_Roaring_Destroy)
+ */
+ATB_PUBLIC extern bool atb_Roaring_View(
+    struct atb_Roaring *const self, struct atb_Allocator const *const allocator,
+    struct atb_View_u8 bytes, struct atb_Error *const err);
+
+#if defined(__cplusplus)
+} /* extern "C" */
+#endif
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "atb/allocator.h"
+#include "atb/error.h"
+#include "atb/export.h"
+#include "atb/span/string.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/// Maximum number of chars stored by a single chunk of a rope
+#define K_ATB_ROPE_CHUNK_SIZE 480
+
+/// Chunk of text, node of the tree (opaque)
+struct atb_Rope_Node;
+
+/**
+ *  \brief Mutable text stored as a balanced tree of chunks
+ *
+ *  Chunks (up to K_ATB_ROPE_CHUNK_SIZE chars, allocated through a struct
+ *  atb_Allocator) are the nodes of a treap ordered by position: each node
+ *  stores the total number of chars of its subtree, such that the chunk
+ *  holding any position is reached in O(log n) (expected).
+ *
+ *  Edits contained inside a single chunk are done in place. Otherwise the tree
+ *  is split at the edited positions and merged back, such that an edit costs
+ *  O(log n + edit size) whatever the size of the text.
+ *
+ *  Example:
+ *  struct atb_Rope text;
+ *  atb_Rope_Init(&text, atb_DefaultAllocator());
+ *
+ *  atb_Rope_Insert(&text, 0, atb_StrView_From_StrLiteral("Hello!"), &err);
+ *  atb_Rope_Insert(&text, 5, atb_StrView_From_StrLiteral(" World"), &err);
+ *  atb_Rope_Erase(&text, 0, 6, &err);
+ *
+ *  for (struct atb_Rope_Iterator it = atb_Rope_Begin(&text);
+ *       !atb_Rope_Iterator_IsEnd(it); it = atb_Rope_Iterator_Next(it)) {
+ *    struct atb_StrView const chunk = atb_Rope_Iterator_Chunk(it);
+ *    ...
+ *  }
+ *
+ *  atb_Rope_Destroy(&text);
+ */
+struct atb_Rope {
+  struct atb_Rope_Node *root;            /*!< Tree of chunks (NULL if empty) */
+  uint64_t priorities;                   /*!< Seed of the next node priority */
+  struct atb_Allocator const *allocator; /*!< Used for each chunk */
+};
+
+/// Iterate over the chunks of a rope (invalidated by any modification)
+struct atb_Rope_Iterator {
+  struct atb_Rope const *rope; /*!< Rope iterated */
+  struct atb_Rope_Node *node;  /*!< Chunk pointed (NULL at the end) */
+  size_t begin;                /*!< First char pointed inside the chunk */
+  size_t offset;               /*!< Position of that char inside the rope */
+};
+
+/* Init *********************************************************************/
+
+/**
+ *  \brief Initialize an EMPTY rope (nothing is allocated)
+ *
+ *  \pre self != NULL
+ *  \pre allocator != NULL
+ */
+ATB_PUBLIC extern void atb_Rope_Init(
+    struct atb_Rope *const self, struct atb_Allocator const *const allocator);
+
+/**
+ *  \brief Release all chunks of the rope, leaving it EMPTY
+ *
+ *  \pre self != NULL
+ *
+ *  \note Complexity: O(n) (no recursion)
+ */
+ATB_PUBLIC extern void atb_Rope_Destroy(struct atb_Rope *const self);
+
+/* Access *******************************************************************/
+
+/**
+ *  \return Number of chars of the rope
+ *
+ *  \pre self != NULL
+ */
+ATB_PUBLIC extern size_t atb_Rope_Size(struct atb_Rope const *const self);
+
+/**
+ *  \return Iterator to the chunk holding the first char
+ *
+ *  \pre self != NULL
+ */
+ATB_PUBLIC extern struct atb_Rope_Iterator atb_Rope_Begin(
+    struct atb_Rope const *const self);
+
+/**
+ *  \return Iterator to the (part of the) chunk starting at \a offset
+ *
+ *  \pre self != NULL
+ *  \pre offset <= atb_Rope_Size(self)
+ *
+ *  \note Complexity: O(log n)
+ */
+ATB_PUBLIC extern struct atb_Rope_Iterator atb_Rope_At(
+    struct atb_Rope const *const self, size_t offset);
+
+/**
+ *  \return True when \a it points past the last chunk
+ */
+ATB_PUBLIC extern bool atb_Rope_Iterator_IsEnd(struct atb_Rope_Iterator it);
+
+/**
+ *  \return Iterator to the following chunk
+ *
+ *  \pre !atb_Rope_Iterator_IsEnd(it)
+ *
+ *  \note Complexity: O(log n)
+ */
+ATB_PUBLIC extern struct atb_Rope_Iterator atb_Rope_Iterator_Next(
+    struct atb_Rope_Iterator it);
+
+/**
+ *  \return Chars of the chunk pointed by \a it (never empty)
+ *
+ *  \pre !atb_Rope_Iterator_IsEnd(it)
+ */
+ATB_PUBLIC extern struct atb_StrView atb_Rope_Iterator_Chunk(
+    struct atb_Rope_Iterator it);
+
+/* Modifiers ****************************************************************/
+
+/**
+ *  \brief Insert a copy of \a str at \a offset
+ *
+ *  \return False when memory allocation failed (rope content unchanged)
+ *
+ *  \pre self != NULL
+ *  \pre offset <= atb_Rope_Size(self)
+ *  \pre (str.size == 0) || (str.data != NULL)
+ *
+ *  \note Complexity: O(log n + str.size) (expected)
+ */
+ATB_PUBLIC extern bool atb_Rope_Insert(struct atb_Rope *const self,
+                                       size_t offset, struct atb_StrView str,
+                                       struct atb_Error *const err);
+
+/**
+ *  \brief Remove the \a count chars starting at \a offset
+ *
+ *  \return False when memory allocation failed (rope content unchanged).
+ *          Splitting a chunk may require one.
+ *
+ *  \pre self != NULL
+ *  \pre offset <= atb_Rope_Size(self)
+ *  \pre count <= (atb_Rope_Size(self) - offset)
+ *
+ *  \note Complexity: O(log n) (expected, plus the chunks released)
+ */
+ATB_PUBLIC extern bool atb_Rope_Erase(struct atb_Rope *const self,
+                                      size_t offset, size_t count,
+                                      struct atb_Error *const err);
+
+/**
+ *  \brief Move all chars from \a offset onward into \a tail
+ *
+ *  \param[in] self Rope to split
+ *  \param[in] offset Position of the first char moved
+ *  \param[out] tail Initialized with the allocator of \a self, holding the
+ *                   moved chars on success (EMPTY otherwise)
+ *  \param[out] err Optional. Error set whenever the operation failed.
+ *
+ *  \return False when memory allocation failed (rope content unchanged)
+ *
+ *  \pre self != NULL
+ *  \pre tail != NULL
+ *  \pre offset <= atb_Rope_Size(self)
+ *
+ *  \note Complexity: O(log n) (expected)
+ */
+ATB_PUBLIC extern bool atb_Rope_Split(struct atb_Rope *const self,
+                                      size_t offset,
+                                      struct atb_Rope *const tail,
+                                      struct atb_Error *const err);
+
+/**
+ *  \brief Move all chars of \a other at the end of \a self (no copy), leaving
+ *         \a other EMPTY
+ *
+ *  \pre self != NULL
+ *  \pre other != NULL
+ *  \pre self->allocator == other->allocator
+ *
+ *  \note Complexity: O(log n) (expected)
+ */
+ATB_PUBLIC extern void atb_Rope_Concat(struct atb_Rope *const self,
+                                       struct atb_Rope *const other);
+
+#if defined(__cplusplus)
+} /* extern "C" */
+#endif
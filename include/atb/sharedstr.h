@@ -0,0 +1,143 @@
+#pragma once
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "atb/allocator.h"
+#include "atb/error.h"
+#include "atb/export.h"
+#include "atb/span/string.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/// Immutable, reference counted, allocation holding the chars (opaque)
+struct atb_SharedStr_Block;
+
+/**
+ *  \brief Slice of an immutable string buffer shared between its owners
+ *
+ *  Every slice holds one reference on the underlying block: sub-slices share
+ *  the parent allocation instead of copying it, and the block is released
+ *  (through the allocator given on creation) along with its last slice.
+ *  Reference counting is atomic, such that slices of the same block can be
+ *  shared/released from different threads (as long as the allocator itself
+ *  supports it). A single slice must not be accessed concurrently.
+ *
+ *  Example:
+ *  struct atb_SharedStr line;
+ *  atb_SharedStr_From(&line, atb_StrView_From_StrLiteral("key=value"),
+ *                     atb_DefaultAllocator(), &err);
+ *
+ *  struct atb_SharedStr key = atb_SharedStr_Slice(&line, 0, 3);
+ *  struct atb_SharedStr value = atb_SharedStr_Slice(&line, 4, 5);
+ *  atb_SharedStr_Release(&line);
+ *
+ *  ... send key/value to other threads, each calling atb_SharedStr_Release ...
+ */
+struct atb_SharedStr {
+  struct atb_SharedStr_Block *block; /*!< Owned reference (NULL when empty) */
+  char const *data;                  /*!< First char of the slice */
+  size_t size;                       /*!< Number of chars of the slice */
+};
+
+/// An EMPTY slice (static initializer), holding no reference
+#define K_ATB_SHAREDSTR_EMPTY \
+  { .block = NULL, .data = NULL, .size = 0 }
+
+/* Init *********************************************************************/
+
+/**
+ *  \brief Copy \a str into a newly allocated shared block
+ *
+ *  \param[out] self Slice referencing the entire copy on success (otherwise
+ *                   EMPTY)
+ *  \param[in] str Chars to copy (no allocation when empty)
+ *  \param[in] allocator Allocator used for the block (and its release)
+ *  \param[out] err Optional. Error set whenever the operation failed.
+ *
+ *  \return False when memory allocation failed
+ *
+ *  \pre self != NULL
+ *  \pre allocator != NULL
+ *  \pre (str.size == 0) || (str.data != NULL)
+ */
+ATB_PUBLIC extern bool atb_SharedStr_From(
+    struct atb_SharedStr *const self, struct atb_StrView str,
+    struct atb_Allocator const *const allocator, struct atb_Error *const err);
+
+/**
+ *  \brief Drop the reference held by \a self, leaving it EMPTY. The block is
+ *         released along with its last reference.
+ *
+ *  \pre self != NULL
+ *
+ *  \note Complexity: O(1) (one atomic decrement)
+ */
+ATB_PUBLIC extern void atb_SharedStr_Release(struct atb_SharedStr *const self);
+
+/* Slicing ******************************************************************/
+
+/**
+ *  \return A new slice (holding its own reference) over the same chars as
+ *          \a self
+ *
+ *  \pre self != NULL
+ *
+ *  \note Complexity: O(1) (one atomic increment)
+ */
+ATB_PUBLIC extern struct atb_SharedStr atb_SharedStr_Share(
+    struct atb_SharedStr const *const self);
+
+/**
+ *  \return A new slice (holding its own reference) over the \a size chars of
+ *          \a self starting at \a offset, sharing the same block
+ *
+ *  \pre self != NULL
+ *  \pre offset <= self->size
+ *  \pre size <= (self->size - offset)
+ *
+ *  \note Complexity: O(1) (one atomic increment)
+ */
+ATB_PUBLIC extern struct atb_SharedStr atb_SharedStr_Slice(
+    struct atb_SharedStr const *const self, size_t offset, size_t size);
+
+/* Access *******************************************************************/
+
+/**
+ *  \return Chars of the slice, valid as long as \a self holds its reference
+ *
+ *  \pre self != NULL
+ */
+static inline struct atb_StrView atb_SharedStr_View(
+    struct atb_SharedStr const *const self);
+
+/**
+ *  \return Number of slices referencing the block of \a self (0 when EMPTY)
+ *
+ *  \pre self != NULL
+ *
+ *  \warning Only a snapshot when slices are shared between threads
+ */
+ATB_PUBLIC extern size_t atb_SharedStr_UseCount(
+    struct atb_SharedStr const *const self);
+
+/***************************************************************************/
+/*                           Inline definitions                            */
+/***************************************************************************/
+
+static inline struct atb_StrView atb_SharedStr_View(
+    struct atb_SharedStr const *const self) {
+  assert(self != NULL);
+
+  struct atb_StrView view;
+  view.data = self->data;
+  view.size = self->size;
+  return view;
+}
+
+#if defined(__cplusplus)
+} /* extern "C" */
+#endif
@@ -0,0 +1,276 @@
+#pragma once
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "atb/allocator.h"
+#include "atb/error.h"
+#include "atb/macro.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/// Capacity of a struct of arrays after its first allocation
+#define K_ATB_SOA_MIN_CAPACITY 8
+
+/// Declare a struct of arrays named \a NAME, and all its associated functions.
+/// All functions are declared using \a SPECIFIER as specifiers.
+///
+/// Each variadic argument describes a column (up to 16) as a tuple
+/// `(T, FIELD, SPAN)`: elements of type T stored in a column named FIELD,
+/// with SPAN the span type (see ATB_SPAN_DECLARE) associated to T, used to
+/// expose the column. FIELD can't be size, capacity or allocator.
+///
+/// Each column is a separate contiguous array from struct atb_Allocator, all
+/// columns having the same size/capacity: loops touching a few fields only
+/// load the cache lines of these fields, instead of the whole elements.
+///
+/// Functions declared are the following:
+/// - `_Init(self, allocator)`: Initialize an EMPTY struct of arrays;
+/// - `_Destroy(self)`: Release the storage of all columns;
+/// - `_Clear(self)`: Remove all elements (keeping the storage);
+/// - `_Size(self) -> size_t`: Number of elements (rows);
+/// - `_Capacity(self) -> size_t`: Number of elements that can be stored
+///   without growing;
+/// - `_Reserve(self, capacity, err) -> bool`: Make sure all columns can hold
+///   capacity elements without growing;
+/// - `_PushBack(self, FIELD..., err) -> bool`: Add an element at the end,
+///   given the value of each column (in declaration order);
+/// - `_PopBack(self) -> bool`: Remove the last element. False when empty;
+/// - `_Erase(self, i)`: Remove the i-th element, keeping the order of the
+///   following ones (O(size));
+/// - `_SwapErase(self, i)`: Remove the i-th element, replacing it by the last
+///   one (O(1));
+/// - `_Column_FIELD(self) -> SPAN`: Content of the column FIELD (the span
+///   data is NULL as long as nothing was allocated);
+///
+/// Example:
+///
+/// ATB_SOA_DECLARE(static, Particles, (int32_t, x, atb_Span_i32),
+///                 (int32_t, y, atb_Span_i32), (uint32_t, id, atb_Span_u32));
+/// ATB_SOA_DEFINE(static, Particles, (int32_t, x, atb_Span_i32),
+///                (int32_t, y, atb_Span_i32), (uint32_t, id, atb_Span_u32));
+///
+/// Particles_PushBack(&particles, 1, 2, 42, &err);
+///
+/// struct atb_Span_i32 const x = Particles_Column_x(&particles);
+/// for (size_t i = 0; i < x.size; ++i) x.data[i] += dx;
+#define ATB_SOA_DECLARE(SPECIFIER, NAME, ...)                              \
+  struct NAME {                                                            \
+    ATB_FOR_EACH(ATB_INTERNAL_SOA_MEMBER, (SPECIFIER, NAME), __VA_ARGS__)  \
+    size_t size;                                                           \
+    size_t capacity;                                                       \
+    struct atb_Allocator const *allocator;                                 \
+  };                                                                       \
+                                                                           \
+  SPECIFIER void NAME##_Init(struct NAME *const self,                      \
+                             struct atb_Allocator const *const allocator); \
+  SPECIFIER void NAME##_Destroy(struct NAME *const self);                  \
+  SPECIFIER void NAME##_Clear(struct NAME *const self);                    \
+  SPECIFIER size_t NAME##_Size(struct NAME const *const self);             \
+  SPECIFIER size_t NAME##_Capacity(struct NAME const *const self);         \
+  SPECIFIER bool NAME##_Reserve(struct NAME *const self, size_t capacity,  \
+                                struct atb_Error *const err);              \
+  SPECIFIER bool NAME##_PushBack(                                          \
+      struct NAME *const self,                                             \
+      ATB_FOR_EACH(ATB_INTERNAL_SOA_PARAM, (SPECIFIER, NAME), __VA_ARGS__) \
+          struct atb_Error *const err);                                    \
+  SPECIFIER bool NAME##_PopBack(struct NAME *const self);                  \
+  SPECIFIER void NAME##_Erase(struct NAME *const self, size_t i);          \
+  SPECIFIER void NAME##_SwapErase(struct NAME *const self, size_t i);      \
+  ATB_FOR_EACH(ATB_INTERNAL_SOA_COLUMN_DECLARE, (SPECIFIER, NAME),         \
+               __VA_ARGS__)                                                \
+  static_assert(true, "SEMI-COLON NEEDED HERE")
+
+/// Define all functions associated to a struct of arrays named \a NAME
+/// (struct needs to be declared beforehands using ATB_SOA_DECLARE, with the
+/// SAME columns). All functions are defined using \a SPECIFIER as specifiers.
+///
+/// See ATB_SOA_DECLARE for the list of functions defined.
+#define ATB_SOA_DEFINE(SPECIFIER, NAME, ...)                                   \
+  SPECIFIER void NAME##_Init(struct NAME *const self,                          \
+                             struct atb_Allocator const *const allocator) {    \
+    assert(self != NULL);                                                      \
+    assert(allocator != NULL);                                                 \
+                                                                               \
+    ATB_FOR_EACH(ATB_INTERNAL_SOA_INIT, (SPECIFIER, NAME), __VA_ARGS__)        \
+    self->size = 0;                                                            \
+    self->capacity = 0;                                                        \
+    self->allocator = allocator;                                               \
+  }                                                                            \
+                                                                               \
+  SPECIFIER void NAME##_Destroy(struct NAME *const self) {                     \
+    assert(self != NULL);                                                      \
+                                                                               \
+    ATB_FOR_EACH(ATB_INTERNAL_SOA_RELEASE, (SPECIFIER, NAME), __VA_ARGS__)     \
+    self->size = 0;                                                            \
+    self->capacity = 0;                                                        \
+  }                                                                            \
+                                                                               \
+  SPECIFIER void NAME##_Clear(struct NAME *const self) {                       \
+    assert(self != NULL);                                                      \
+    self->size = 0;                                                            \
+  }                                                                            \
+                                                                               \
+  SPECIFIER size_t NAME##_Size(struct NAME const *const self) {                \
+    assert(self != NULL);                                                      \
+    return self->size;                                                         \
+  }                                                                            \
+                                                                               \
+  SPECIFIER size_t NAME##_Capacity(struct NAME const *const self) {            \
+    assert(self != NULL);                                                      \
+    return self->capacity;                                                     \
+  }                                                                            \
+                                                                               \
+  /* Columns are grown one after the other: on failure, the first ones might   \
+   * be larger than capacity, which is harmless (capacity is unchanged) */     \
+  SPECIFIER bool NAME##_Reserve(struct NAME *const self, size_t capacity,      \
+                                struct atb_Error *const err) {                 \
+    assert(self != NULL);                                                      \
+                                                                               \
+    if (capacity <= self->capacity) return true;                               \
+                                                                               \
+    size_t new_capacity = (self->capacity == 0) ? K_ATB_SOA_MIN_CAPACITY       \
+                                                : (self->capacity * 2);        \
+                                                                               \
+    if (new_capacity < capacity) new_capacity = capacity;                      \
+                                                                               \
+    ATB_FOR_EACH(ATB_INTERNAL_SOA_GROW, (SPECIFIER, NAME), __VA_ARGS__)        \
+    self->capacity = new_capacity;                                             \
+                                                                               \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  SPECIFIER bool NAME##_PushBack(                                              \
+      struct NAME *const self,                                                 \
+      ATB_FOR_EACH(ATB_INTERNAL_SOA_PARAM, (SPECIFIER, NAME), __VA_ARGS__)     \
+          struct atb_Error *const err) {                                       \
+    assert(self != NULL);                                                      \
+                                                                               \
+    if ((self->size == self->capacity) &&                                      \
+        !NAME##_Reserve(self, self->size + 1, err)) {                          \
+      return false;                                                            \
+    }                                                                          \
+                                                                               \
+    ATB_FOR_EACH(ATB_INTERNAL_SOA_STORE, (SPECIFIER, NAME), __VA_ARGS__)       \
+    self->size += 1;                                                           \
+                                                                               \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  SPECIFIER bool NAME##_PopBack(struct NAME *const self) {                     \
+    assert(self != NULL);                                                      \
+                                                                               \
+    if (self->size == 0) return false;                                         \
+                                                                               \
+    self->size -= 1;                                                           \
+    return true;                                                               \
+  }                                                                            \
+                                                                               \
+  SPECIFIER void NAME##_Erase(struct NAME *const self, size_t i) {             \
+    assert(self != NULL);                                                      \
+    assert(i < self->size);                                                    \
+                                                                               \
+    ATB_FOR_EACH(ATB_INTERNAL_SOA_ERASE, (SPECIFIER, NAME), __VA_ARGS__)       \
+    self->size -= 1;                                                           \
+  }                                                                            \
+                                                                               \
+  SPECIFIER void NAME##_SwapErase(struct NAME *const self, size_t i) {         \
+    assert(self != NULL);                                                      \
+    assert(i < self->size);                                                    \
+                                                                               \
+    ATB_FOR_EACH(ATB_INTERNAL_SOA_SWAP_ERASE, (SPECIFIER, NAME), __VA_ARGS__)  \
+    self->size -= 1;                                                           \
+  }                                                                            \
+                                                                               \
+  ATB_FOR_EACH(ATB_INTERNAL_SOA_COLUMN_DEFINE, (SPECIFIER, NAME), __VA_ARGS__) \
+                                                                               \
+  static_assert(true, "SEMI-COLON NEEDED HERE")
+
+/* Implementation details ***************************************************/
+
+/* Invoke M(SPECIFIER, NAME, T, FIELD, SPAN) from the tuples CTX and COL */
+#define ATB_INTERNAL_SOA_APPLY(M, CTX, COL)              \
+  ATB_INTERNAL_SOA_APPLY_IMPL(M, ATB_INTERNAL_UNPACK CTX, \
+                              ATB_INTERNAL_UNPACK COL)
+#define ATB_INTERNAL_SOA_APPLY_IMPL(M, ...) M(__VA_ARGS__)
+
+#define ATB_INTERNAL_SOA_MEMBER(CTX, COL) \
+  ATB_INTERNAL_SOA_APPLY(ATB_INTERNAL_SOA_MEMBER_IMPL, CTX, COL)
+#define ATB_INTERNAL_SOA_MEMBER_IMPL(SPECIFIER, NAME, T, FIELD, SPAN) \
+  T *FIELD;
+
+#define ATB_INTERNAL_SOA_PARAM(CTX, COL) \
+  ATB_INTERNAL_SOA_APPLY(ATB_INTERNAL_SOA_PARAM_IMPL, CTX, COL)
+#define ATB_INTERNAL_SOA_PARAM_IMPL(SPECIFIER, NAME, T, FIELD, SPAN) T FIELD,
+
+#define ATB_INTERNAL_SOA_INIT(CTX, COL) \
+  ATB_INTERNAL_SOA_APPLY(ATB_INTERNAL_SOA_INIT_IMPL, CTX, COL)
+#define ATB_INTERNAL_SOA_INIT_IMPL(SPECIFIER, NAME, T, FIELD, SPAN) \
+  self->FIELD = NULL;
+
+#define ATB_INTERNAL_SOA_RELEASE(CTX, COL) \
+  ATB_INTERNAL_SOA_APPLY(ATB_INTERNAL_SOA_RELEASE_IMPL, CTX, COL)
+#define ATB_INTERNAL_SOA_RELEASE_IMPL(SPECIFIER, NAME, T, FIELD, SPAN)    \
+  if (self->FIELD != NULL) {                                              \
+    (void)atb_Allocator_Release(self->allocator, (void **)&(self->FIELD), \
+                                K_ATB_ERROR_IGNORED);                     \
+  }
+
+#define ATB_INTERNAL_SOA_GROW(CTX, COL) \
+  ATB_INTERNAL_SOA_APPLY(ATB_INTERNAL_SOA_GROW_IMPL, CTX, COL)
+#define ATB_INTERNAL_SOA_GROW_IMPL(SPECIFIER, NAME, T, FIELD, SPAN)   \
+  {                                                                   \
+    if (new_capacity > (SIZE_MAX / sizeof(T))) {                      \
+      atb_GenericError_Set(err, K_ATB_ERROR_GENERIC_VALUE_TOO_LARGE); \
+      return false;                                                   \
+    }                                                                 \
+                                                                      \
+    T *const column = (T *)atb_Allocator_Alloc(                       \
+        self->allocator, self->FIELD, new_capacity * sizeof(T), err); \
+                                                                      \
+    if (column == NULL) return false;                                 \
+    self->FIELD = column;                                             \
+  }
+
+#define ATB_INTERNAL_SOA_STORE(CTX, COL) \
+  ATB_INTERNAL_SOA_APPLY(ATB_INTERNAL_SOA_STORE_IMPL, CTX, COL)
+#define ATB_INTERNAL_SOA_STORE_IMPL(SPECIFIER, NAME, T, FIELD, SPAN) \
+  self->FIELD[self->size] = FIELD;
+
+#define ATB_INTERNAL_SOA_ERASE(CTX, COL) \
+  ATB_INTERNAL_SOA_APPLY(ATB_INTERNAL_SOA_ERASE_IMPL, CTX, COL)
+#define ATB_INTERNAL_SOA_ERASE_IMPL(SPECIFIER, NAME, T, FIELD, SPAN) \
+  memmove(&(self->FIELD[i]), &(self->FIELD[i + 1]),                  \
+          (self->size - i - 1) * sizeof(T));
+
+#define ATB_INTERNAL_SOA_SWAP_ERASE(CTX, COL) \
+  ATB_INTERNAL_SOA_APPLY(ATB_INTERNAL_SOA_SWAP_ERASE_IMPL, CTX, COL)
+#define ATB_INTERNAL_SOA_SWAP_ERASE_IMPL(SPECIFIER, NAME, T, FIELD, SPAN) \
+  self->FIELD[i] = self->FIELD[self->size - 1];
+
+#define ATB_INTERNAL_SOA_COLUMN_DECLARE(CTX, COL) \
+  ATB_INTERNAL_SOA_APPLY(ATB_INTERNAL_SOA_COLUMN_DECLARE_IMPL, CTX, COL)
+#define ATB_INTERNAL_SOA_COLUMN_DECLARE_IMPL(SPECIFIER, NAME, T, FIELD, SPAN) \
+  SPECIFIER struct SPAN NAME##_Column_##FIELD(struct NAME const *const self);
+
+#define ATB_INTERNAL_SOA_COLUMN_DEFINE(CTX, COL) \
+  ATB_INTERNAL_SOA_APPLY(ATB_INTERNAL_SOA_COLUMN_DEFINE_IMPL, CTX, COL)
+#define ATB_INTERNAL_SOA_COLUMN_DEFINE_IMPL(SPECIFIER, NAME, T, FIELD, SPAN)   \
+  SPECIFIER struct SPAN NAME##_Column_##FIELD(struct NAME const *const self) { \
+    assert(self != NULL);                                                      \
+                                                                               \
+    struct SPAN span;                                                          \
+    span.data = self->FIELD;                                                   \
+    span.size = self->size;                                                    \
+                                                                               \
+    return span;                                                               \
+  }
+
+#if defined(__cplusplus)
+} /* extern "C" */
+#endif
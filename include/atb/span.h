@@ -9,6 +9,10 @@
 #include "atb/array.h"
 #include "atb/compare.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #if defined(__cplusplus)
 extern "C" {
 #endif
@@ -52,6 +56,74 @@ static inline bool ATB_SPAN_SHRINK_DIR_IsValid(ATB_SPAN_SHRINK_DIR v) {
   return false;
 }
 
+/**
+ * \brief Fill \a count elements of \a size bytes starting at \a data with
+ *        copies of \a value (used by SPAN_Fill)
+ *
+ * Patterns which bytes are all identical (any char, 0, -1, ...) are filled
+ * using memset. Elements of 2, 4, 8 or 16 bytes are broadcast into a 16
+ * bytes pattern, stored 16 bytes at a time (SSE2 when available). Other sizes
+ * are filled by repeatedly copying the already filled (cache hot) prefix.
+ *
+ * \pre (count == 0) || (data != NULL)
+ * \pre value != NULL
+ * \pre size > 0
+ */
+static inline void atb_AnySpan_Fill(void *const data, size_t count,
+                                    void const *const value, size_t size) {
+  assert((count == 0) || (data != NULL));
+  assert(value != NULL);
+  assert(size > 0);
+
+  uint8_t *dest = (uint8_t *)data;
+  uint8_t const *const v = (uint8_t const *)value;
+  size_t bytes = count * size;
+
+  if (bytes == 0) return;
+
+  bool uniform = true;
+  for (size_t i = 1; i < size; ++i) uniform = uniform && (v[i] == v[0]);
+
+  if (uniform) {
+    memset(dest, v[0], bytes);
+  } else if ((size <= 16) && ((16 % size) == 0)) {
+    uint8_t pattern[16];
+    for (size_t i = 0; i < 16; i += size) memcpy(pattern + i, v, size);
+
+#if defined(__SSE2__)
+    __m128i const p = _mm_loadu_si128((__m128i const *)pattern);
+
+    for (; bytes >= 64; bytes -= 64, dest += 64) {
+      _mm_storeu_si128((__m128i *)dest, p);
+      _mm_storeu_si128((__m128i *)(dest + 16), p);
+      _mm_storeu_si128((__m128i *)(dest + 32), p);
+      _mm_storeu_si128((__m128i *)(dest + 48), p);
+    }
+    for (; bytes >= 16; bytes -= 16, dest += 16) {
+      _mm_storeu_si128((__m128i *)dest, p);
+    }
+#else
+    for (; bytes >= 16; bytes -= 16, dest += 16) memcpy(dest, pattern, 16);
+#endif
+
+    /* Remaining bytes are whole elements: still aligned on the pattern */
+    memcpy(dest, pattern, bytes);
+  } else {
+    /* Chunks copied are capped to stay in cache */
+    size_t const max_chunk = (size < 4096) ? ((4096 / size) * size) : size;
+    size_t filled = size;
+
+    memcpy(dest, v, size);
+    while (filled < bytes) {
+      size_t chunk = (filled < max_chunk) ? filled : max_chunk;
+      if (chunk > (bytes - filled)) chunk = bytes - filled;
+
+      memcpy(dest + filled, dest, chunk);
+      filled += chunk;
+    }
+  }
+}
+
 /// Options used to configure VIEW_Copy
 typedef struct atb_View_Copy_Opt {
   unsigned truncate : 1; /*!< Truncate the input view to fit the dest buffer */
@@ -240,7 +312,8 @@ typedef struct atb_View_Copy_Opt {
 /// - `_[Eq, Ne, Lt, Gt, Le, Ge](span, span) -> bool`: Compare 2 spans;
 ///
 /// Functions declared only for SPAN ONLY:
-/// - `_Fill(span, value) -> void`: Fill the span with copy of value;
+/// - `_Fill(span, value) -> void`: Fill the span with copy of value (see
+///   atb_AnySpan_Fill);
 ///
 /// Functions declared only for VIEW ONLY:
 /// - `_From_Span(span) -> view`: Create a view from given span;
@@ -282,7 +355,8 @@ typedef struct atb_View_Copy_Opt {
 /// - `_[Eq, Ne, Lt, Gt, Le, Ge](span, span) -> bool`: Compare 2 spans;
 ///
 /// Functions defined only for SPAN ONLY:
-/// - `_Fill(span, value) -> void`: Fill the span with copy of value;
+/// - `_Fill(span, value) -> void`: Fill the span with copy of value (see
+///   atb_AnySpan_Fill);
 ///
 /// Functions defined for VIEW ONLY:
 /// - `_From_Span(span) -> view`: Create a view from given span;
@@ -296,8 +370,7 @@ typedef struct atb_View_Copy_Opt {
     assert(SPAN##_IsValid(span));                                         \
     assert(v != NULL);                                                    \
                                                                           \
-    T *elem = NULL;                                                       \
-    atb_AnySpan_ForEach(elem, span) { memcpy(elem, v, sizeof(T)); }       \
+    atb_AnySpan_Fill(span.data, span.size, v, sizeof(T));                 \
   }                                                                       \
                                                                           \
   ATB_SPAN_DEFINE(SPECIFIER, VIEW, const T);                              \
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "atb/allocator.h"
+#include "atb/error.h"
 #include "atb/export.h"
 #include "atb/ints.h"
 #include "atb/span.h"
@@ -136,6 +138,359 @@ ATB_PUBLIC extern struct atb_View_u64 atb_View_u64_From_u32(
     struct atb_View_u32 other);
 /**@}*/
 
+/**@{*/
+/**
+ * \brief Index of the first element differing between \a lhs and \a rhs
+ *
+ * Elements are compared 16 bytes at a time (SSE2 when available, 8 bytes
+ * otherwise).
+ *
+ * \param[in] lhs First view to compare
+ * \param[in] rhs Second view to compare
+ *
+ * \returns size_t Index of the first mismatch. When none, the size of the
+ *                 smallest view.
+ *
+ * \pre IsValid(lhs)
+ * \pre IsValid(rhs)
+ */
+#define _ATB_DECLARE_INT_MISMATCH(T, NAME, ...)        \
+  ATB_PUBLIC extern size_t atb_View_##NAME##_Mismatch( \
+      struct atb_View_##NAME lhs, struct atb_View_##NAME rhs);
+
+ATB_INTS_X_FOREACH(_ATB_DECLARE_INT_MISMATCH)
+
+#undef _ATB_DECLARE_INT_MISMATCH
+/**@}*/
+
+/**@{*/
+/**
+ * \brief Three-way lexicographical comparison of the VALUES of \a lhs and
+ *        \a rhs (unlike _Compare, ordering by size first, then by bytes)
+ *
+ * The first mismatching elements (see _Mismatch) are compared as integers
+ * (taking their sign into account). When one view is a prefix of the other,
+ * the shortest one is ordered first.
+ *
+ * \param[in] lhs First view to compare
+ * \param[in] rhs Second view to compare
+ *
+ * \returns atb_Cmp_t Ordering of \a lhs relatively to \a rhs
+ *
+ * \pre IsValid(lhs)
+ * \pre IsValid(rhs)
+ */
+#define _ATB_DECLARE_INT_COMPARE_VALUES(T, NAME, ...)          \
+  ATB_PUBLIC extern atb_Cmp_t atb_View_##NAME##_CompareValues( \
+      struct atb_View_##NAME lhs, struct atb_View_##NAME rhs);
+
+ATB_INTS_X_FOREACH(_ATB_DECLARE_INT_COMPARE_VALUES)
+
+#undef _ATB_DECLARE_INT_COMPARE_VALUES
+/**@}*/
+
+/**@{*/
+/**
+ * \brief Search the FIRST (_Find) or LAST (_RFind) element of \a view equal
+ *        to \a value
+ *
+ * 16 bytes of elements are compared at once (SSE2 compare + movemask when
+ * available).
+ *
+ * \param[in] view View we wish to search into
+ * \param[in] value Value we are looking for
+ * \param[out] where Optionally (when not NULL), set to the index of the
+ *                   element found
+ *
+ * \returns bool True on success. False otherwise, \a where is left untouched.
+ *
+ * \pre IsValid(view)
+ */
+/**
+ * \brief Count the elements of \a view equal to \a value
+ *
+ * \pre IsValid(view)
+ */
+/**
+ * \brief Indicates if \a view holds an element equal to \a value
+ *
+ * \pre IsValid(view)
+ */
+#define _ATB_DECLARE_INT_SEARCH(T, NAME, ...)                     \
+  ATB_PUBLIC extern bool atb_View_##NAME##_Find(                  \
+      struct atb_View_##NAME view, T value, size_t *const where); \
+  ATB_PUBLIC extern bool atb_View_##NAME##_RFind(                 \
+      struct atb_View_##NAME view, T value, size_t *const where); \
+  ATB_PUBLIC extern size_t atb_View_##NAME##_Count(               \
+      struct atb_View_##NAME view, T value);                      \
+  ATB_PUBLIC extern bool atb_View_##NAME##_Contains(              \
+      struct atb_View_##NAME view, T value);
+
+ATB_INTS_X_FOREACH(_ATB_DECLARE_INT_SEARCH)
+
+#undef _ATB_DECLARE_INT_SEARCH
+/**@}*/
+
+/**@{*/
+/**
+ * \brief Sum of all elements of \a view (0 when empty), following the same
+ *        overflow policies as atb_Add_<POLICY>_<INT> (see atb/ints.h)
+ *
+ * The overflow is checked on the EXACT sum of the elements, whatever the
+ * order in which they are added: intermediate overflows that cancel out
+ * don't fail (e.g. {MAX, 1, -1}).
+ *
+ * Elements are summed 16 bytes at a time (SSE2 when available) into wider
+ * accumulators, such that checking the overflow costs little over _Unsafe.
+ *
+ * \param[in] view View we wish to sum
+ * \param[out] dest Sum of the elements:
+ *                  - _Unsafe: wrapped around on overflows/underflows;
+ *                  - _Safely: left unchanged on overflows/underflows;
+ *                  - _Saturate: set to MAX/MIN on overflows/underflows.
+ *
+ * \returns bool True whenever the sum fits the int type (always for
+ *               _Unsafe). False otherwise.
+ *
+ * \pre IsValid(view)
+ * \pre dest != NULL
+ */
+#define _ATB_DECLARE_INT_SUM(T, NAME, ...)               \
+  ATB_PUBLIC extern bool atb_View_##NAME##_Sum_Unsafe(   \
+      struct atb_View_##NAME view, T *const dest);       \
+  ATB_PUBLIC extern bool atb_View_##NAME##_Sum_Safely(   \
+      struct atb_View_##NAME view, T *const dest);       \
+  ATB_PUBLIC extern bool atb_View_##NAME##_Sum_Saturate( \
+      struct atb_View_##NAME view, T *const dest);
+
+ATB_INTS_X_FOREACH(_ATB_DECLARE_INT_SUM)
+
+#undef _ATB_DECLARE_INT_SUM
+/**@}*/
+
+/**@{*/
+/**
+ * \brief Smallest (_Min), largest (_Max) or both (_MinMax) elements of
+ *        \a view
+ *
+ * Elements are compared 16 bytes at a time (SSE2 when available, except for
+ * 64 bits ints which SSE2 can't compare).
+ *
+ * \param[in] view View we wish to reduce
+ * \param[out] dest (min, max) Smallest/largest element, left unchanged when
+ *                  \a view is empty
+ *
+ * \returns bool True on success. False when \a view is empty.
+ *
+ * \pre IsValid(view)
+ * \pre dest != NULL (min != NULL, max != NULL)
+ */
+#define _ATB_DECLARE_INT_MINMAX(T, NAME, ...)                               \
+  ATB_PUBLIC extern bool atb_View_##NAME##_Min(struct atb_View_##NAME view, \
+                                               T *const dest);              \
+  ATB_PUBLIC extern bool atb_View_##NAME##_Max(struct atb_View_##NAME view, \
+                                               T *const dest);              \
+  ATB_PUBLIC extern bool atb_View_##NAME##_MinMax(                          \
+      struct atb_View_##NAME view, T *const min, T *const max);
+
+ATB_INTS_X_FOREACH(_ATB_DECLARE_INT_MINMAX)
+
+#undef _ATB_DECLARE_INT_MINMAX
+/**@}*/
+
+/**@{*/
+/**
+ * \brief Element-wise operation (+, -, *) between \a lhs and \a rhs (either
+ *        a view or a scalar), written into \a dest
+ *
+ * Each element follows exactly the same policy as atb_<OP>_<POLICY>_<INT>
+ * (see atb/ints.h):
+ * - _Unsafe: elements which would underflow/overflow wrap around (unlike
+ *   atb_<OP>_Unsafe_<INT>, this is NOT UB);
+ * - _Safely: elements which would underflow/overflow are left UNCHANGED in
+ *   \a dest;
+ * - _Saturate: elements which would underflow/overflow are set to MIN/MAX.
+ *
+ * 16 bytes of elements are processed at once with SSE2 when available
+ * (except for 32/64 bits multiplications, which SSE2 lacks).
+ *
+ * \param[out] dest Span written (might be \a lhs or \a rhs themselves)
+ * \param[in] lhs, rhs Operands of the underlying operation
+ *
+ * \returns bool True whenever the operation succeed for ALL elements. False
+ *               otherwise.
+ *
+ * \pre IsValid(dest)
+ * \pre IsValid(lhs) && (lhs.size == dest.size)
+ * \pre IsValid(rhs) && (rhs.size == dest.size) (views only)
+ */
+#define _ATB_DECLARE_INT_ELEMENTWISE(OP, POLICY, T, NAME)              \
+  ATB_PUBLIC extern bool atb_Span_##NAME##_##OP##_##POLICY(            \
+      struct atb_Span_##NAME dest, struct atb_View_##NAME lhs,         \
+      struct atb_View_##NAME rhs);                                     \
+  ATB_PUBLIC extern bool atb_Span_##NAME##_##OP##Scalar_##POLICY(      \
+      struct atb_Span_##NAME dest, struct atb_View_##NAME lhs, T rhs);
+
+#define _ATB_DECLARE_INT_ELEMENTWISE_ALL(T, NAME, ...) \
+  _ATB_DECLARE_INT_ELEMENTWISE(Add, Unsafe, T, NAME)   \
+  _ATB_DECLARE_INT_ELEMENTWISE(Add, Safely, T, NAME)   \
+  _ATB_DECLARE_INT_ELEMENTWISE(Add, Saturate, T, NAME) \
+  _ATB_DECLARE_INT_ELEMENTWISE(Sub, Unsafe, T, NAME)   \
+  _ATB_DECLARE_INT_ELEMENTWISE(Sub, Safely, T, NAME)   \
+  _ATB_DECLARE_INT_ELEMENTWISE(Sub, Saturate, T, NAME) \
+  _ATB_DECLARE_INT_ELEMENTWISE(Mul, Unsafe, T, NAME)   \
+  _ATB_DECLARE_INT_ELEMENTWISE(Mul, Safely, T, NAME)   \
+  _ATB_DECLARE_INT_ELEMENTWISE(Mul, Saturate, T, NAME)
+
+ATB_INTS_X_FOREACH(_ATB_DECLARE_INT_ELEMENTWISE_ALL)
+
+#undef _ATB_DECLARE_INT_ELEMENTWISE_ALL
+#undef _ATB_DECLARE_INT_ELEMENTWISE
+/**@}*/
+
+/// X-Macro iterating over all LOSSLESS int conversions (widening)
+///
+/// DO(ST, SRC, SSIZE, DT, DST, DSIZE, SIGNED) With:
+///  - ST, SRC, SSIZE: Type, abbrev and size (in bits) of the source ints
+///  - DT, DST, DSIZE: Type, abbrev and size (in bits) of the dest ints
+///  - SIGNED        : true if the source ints are sign extended
+#define _ATB_INTS_X_FOREACH_WIDENING(DO)          \
+  DO(int8_t, i8, 8, int16_t, i16, 16, true)       \
+  DO(int8_t, i8, 8, int32_t, i32, 32, true)       \
+  DO(int8_t, i8, 8, int64_t, i64, 64, true)       \
+  DO(int16_t, i16, 16, int32_t, i32, 32, true)    \
+  DO(int16_t, i16, 16, int64_t, i64, 64, true)    \
+  DO(int32_t, i32, 32, int64_t, i64, 64, true)    \
+  DO(uint8_t, u8, 8, uint16_t, u16, 16, false)    \
+  DO(uint8_t, u8, 8, uint32_t, u32, 32, false)    \
+  DO(uint8_t, u8, 8, uint64_t, u64, 64, false)    \
+  DO(uint16_t, u16, 16, uint32_t, u32, 32, false) \
+  DO(uint16_t, u16, 16, uint64_t, u64, 64, false) \
+  DO(uint32_t, u32, 32, uint64_t, u64, 64, false) \
+  DO(uint8_t, u8, 8, int16_t, i16, 16, false)     \
+  DO(uint8_t, u8, 8, int32_t, i32, 32, false)     \
+  DO(uint8_t, u8, 8, int64_t, i64, 64, false)     \
+  DO(uint16_t, u16, 16, int32_t, i32, 32, false)  \
+  DO(uint16_t, u16, 16, int64_t, i64, 64, false)  \
+  DO(uint32_t, u32, 32, int64_t, i64, 64, false)
+
+/// X-Macro iterating over all int conversions which might overflow/underflow
+/// (narrowing)
+///
+/// DO(ST, SRC, SSIZE, DT, DST, DSIZE, SSIGN, DMIN, DMAX) With:
+///  - ST, SRC, SSIZE: Type, abbrev and size (in bits) of the source ints
+///  - DT, DST, DSIZE: Type, abbrev and size (in bits) of the dest ints
+///  - SSIGN         : i (signed) or u (unsigned) source ints
+///  - DMIN, DMAX    : Range of the dest ints
+#define _ATB_INTS_X_FOREACH_NARROWING(DO)                         \
+  DO(int16_t, i16, 16, int8_t, i8, 8, i, INT8_MIN, INT8_MAX)      \
+  DO(int32_t, i32, 32, int8_t, i8, 8, i, INT8_MIN, INT8_MAX)      \
+  DO(int32_t, i32, 32, int16_t, i16, 16, i, INT16_MIN, INT16_MAX) \
+  DO(int64_t, i64, 64, int8_t, i8, 8, i, INT8_MIN, INT8_MAX)      \
+  DO(int64_t, i64, 64, int16_t, i16, 16, i, INT16_MIN, INT16_MAX) \
+  DO(int64_t, i64, 64, int32_t, i32, 32, i, INT32_MIN, INT32_MAX) \
+  DO(uint16_t, u16, 16, uint8_t, u8, 8, u, 0, UINT8_MAX)          \
+  DO(uint32_t, u32, 32, uint8_t, u8, 8, u, 0, UINT8_MAX)          \
+  DO(uint32_t, u32, 32, uint16_t, u16, 16, u, 0, UINT16_MAX)      \
+  DO(uint64_t, u64, 64, uint8_t, u8, 8, u, 0, UINT8_MAX)          \
+  DO(uint64_t, u64, 64, uint16_t, u16, 16, u, 0, UINT16_MAX)      \
+  DO(uint64_t, u64, 64, uint32_t, u32, 32, u, 0, UINT32_MAX)      \
+  DO(int16_t, i16, 16, uint8_t, u8, 8, i, 0, UINT8_MAX)           \
+  DO(int32_t, i32, 32, uint8_t, u8, 8, i, 0, UINT8_MAX)           \
+  DO(int32_t, i32, 32, uint16_t, u16, 16, i, 0, UINT16_MAX)       \
+  DO(int64_t, i64, 64, uint8_t, u8, 8, i, 0, UINT8_MAX)           \
+  DO(int64_t, i64, 64, uint16_t, u16, 16, i, 0, UINT16_MAX)       \
+  DO(int64_t, i64, 64, uint32_t, u32, 32, i, 0, UINT32_MAX)
+
+/**@{*/
+/**
+ * \brief Convert the VALUES of \a src into a wider int type (unlike _From_,
+ *        which only reinterprets the bytes): signed ints are sign extended,
+ *        unsigned ones zero extended
+ *
+ * 16 bytes of elements are converted at once (SSE2 unpack when available).
+ *
+ * \param[out] dest Span written
+ * \param[in] src Values to convert
+ *
+ * \pre IsValid(dest)
+ * \pre IsValid(src) && (src.size == dest.size)
+ */
+#define _ATB_DECLARE_INT_WIDEN(ST, SRC, SSIZE, DT, DST, ...)  \
+  ATB_PUBLIC extern void atb_Span_##DST##_Widen_##SRC(        \
+      struct atb_Span_##DST dest, struct atb_View_##SRC src);
+
+_ATB_INTS_X_FOREACH_WIDENING(_ATB_DECLARE_INT_WIDEN)
+
+#undef _ATB_DECLARE_INT_WIDEN
+/**@}*/
+
+/**@{*/
+/**
+ * \brief Convert the VALUES of \a src into a narrower int type, following a
+ *        policy for the values out of the dest range:
+ *        - _Truncate: only the lower bits are kept (like a cast);
+ *        - _Saturate: set to the MIN/MAX dest value;
+ *        - _Safely: left UNCHANGED in \a dest.
+ *
+ * 16 bytes of elements are converted at once (SSE2 pack when available).
+ *
+ * \param[out] dest Span written
+ * \param[in] src Values to convert
+ *
+ * \returns bool True whenever ALL values are in the dest range (always for
+ *               _Truncate). False otherwise.
+ *
+ * \pre IsValid(dest)
+ * \pre IsValid(src) && (src.size == dest.size)
+ */
+#define _ATB_DECLARE_INT_NARROW(ST, SRC, SSIZE, DT, DST, ...)      \
+  ATB_PUBLIC extern bool atb_Span_##DST##_Narrow_##SRC##_Truncate( \
+      struct atb_Span_##DST dest, struct atb_View_##SRC src);      \
+  ATB_PUBLIC extern bool atb_Span_##DST##_Narrow_##SRC##_Saturate( \
+      struct atb_Span_##DST dest, struct atb_View_##SRC src);      \
+  ATB_PUBLIC extern bool atb_Span_##DST##_Narrow_##SRC##_Safely(   \
+      struct atb_Span_##DST dest, struct atb_View_##SRC src);
+
+_ATB_INTS_X_FOREACH_NARROWING(_ATB_DECLARE_INT_NARROW)
+
+#undef _ATB_DECLARE_INT_NARROW
+/**@}*/
+
+/**@{*/
+/**
+ * \brief Sort (ascending order) the elements of \a span, using a LSD radix
+ *        sort (1 byte digits)
+ *
+ * The histograms of all digits are computed in a single read of \a span:
+ * passes for which the digit is the same for all elements are skipped (e.g.
+ * small values stored in 64 bits ints). Signed ints are ordered by flipping
+ * their sign bit. Small spans are sorted in place (insertion sort).
+ *
+ * \param[in] span Span to sort
+ * \param[in] allocator Used for the scratch memory (as many elements as
+ *                      \a span, released before returning)
+ * \param[out] err Optional. Error set whenever the operation failed.
+ *
+ * \returns bool False when memory allocation failed (span left untouched).
+ *               True otherwise.
+ *
+ * \pre IsValid(span)
+ * \pre allocator != NULL
+ *
+ * \note Complexity: O(n * sizeof(T)), stable
+ */
+#define _ATB_DECLARE_INT_RADIX_SORT(T, NAME, ...)     \
+  ATB_PUBLIC extern bool atb_Span_##NAME##_RadixSort( \
+      struct atb_Span_##NAME span,                    \
+      struct atb_Allocator const *const allocator,    \
+      struct atb_Error *const err);
+
+ATB_INTS_X_FOREACH(_ATB_DECLARE_INT_RADIX_SORT)
+
+#undef _ATB_DECLARE_INT_RADIX_SORT
+/**@}*/
+
 #if defined(__cplusplus)
 }
 #endif
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "atb/allocator.h"
+#include "atb/error.h"
+#include "atb/export.h"
+#include "atb/span/ints.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ *  \brief Sparse set of uint32_t ids: O(1) insert/erase/membership, with the
+ *         members stored contiguously (O(size) iteration, O(1) clear)
+ *
+ *  Members are stored inside a dense array, while a sparse array (indexed by
+ *  id, covering all ids inserted so far) holds the position of each id inside
+ *  the dense one. An id is a member when both arrays point to each other,
+ *  such that stale sparse entries never need to be reset.
+ *
+ *  Memory is O(max id + size): the sparse array grows (geometrically) up to the
+ *  largest id inserted.
+ *
+ *  Example:
+ *  struct atb_SparseSet active;
+ *  atb_SparseSet_Init(&active, atb_DefaultAllocator());
+ *
+ *  atb_SparseSet_Insert(&active, 1000000, &err);
+ *  atb_SparseSet_Insert(&active, 42, &err);
+ *
+ *  struct atb_View_u32 const ids = atb_SparseSet_Members(&active);
+ *  for (size_t i = 0; i < ids.size; ++i) { ... ids.data[i] ... }
+ *
+ *  atb_SparseSet_Clear(&active);
+ *  atb_SparseSet_Destroy(&active);
+ */
+struct atb_SparseSet {
+  uint32_t *dense;  /*!< Members (size of them, unordered) */
+  uint32_t *sparse; /*!< Position inside dense, indexed by id */
+  size_t size;      /*!< Number of members */
+  size_t capacity;  /*!< Number of members allocated (dense) */
+  size_t universe;  /*!< Number of ids allocated (sparse) */
+  struct atb_Allocator const *allocator; /*!< Used for both arrays */
+};
+
+/* Init *********************************************************************/
+
+/**
+ *  \brief Initialize an EMPTY set (nothing is allocated)
+ *
+ *  \pre self != NULL
+ *  \pre allocator != NULL
+ */
+ATB_PUBLIC extern void atb_SparseSet_Init(
+    struct atb_SparseSet *const self,
+    struct atb_Allocator const *const allocator);
+
+/**
+ *  \brief Release the storage of the set
+ *
+ *  \pre self != NULL
+ */
+ATB_PUBLIC extern void atb_SparseSet_Destroy(struct atb_SparseSet *const self);
+
+/**
+ *  \brief Make sure ids in [0, universe) can be inserted, until the set holds
+ *         capacity members, without allocating
+ *
+ *  \return False when memory allocation failed (set unchanged)
+ *
+ *  \pre self != NULL
+ *  \pre universe <= (UINT32_MAX + 1)
+ */
+ATB_PUBLIC extern bool atb_SparseSet_Reserve(struct atb_SparseSet *const self,
+                                             size_t universe, size_t capacity,
+                                             struct atb_Error *const err);
+
+/* Access *******************************************************************/
+
+/**
+ *  \return Number of members of the set
+ *
+ *  \pre self != NULL
+ */
+static inline size_t atb_SparseSet_Size(struct atb_SparseSet const *const self);
+
+/**
+ *  \return True when \a id is a member of the set
+ *
+ *  \pre self != NULL
+ *
+ *  \note Complexity: O(1)
+ */
+static inline bool atb_SparseSet_Contains(
+    struct atb_SparseSet const *const self, uint32_t id);
+
+/**
+ *  \return All members of the set, contiguous (unordered). Invalidated by
+ *          any modification of the set.
+ *
+ *  \pre self != NULL
+ */
+static inline struct atb_View_u32 atb_SparseSet_Members(
+    struct atb_SparseSet const *const self);
+
+/* Modifiers ****************************************************************/
+
+/**
+ *  \brief Add \a id to the set (nothing done when already a member)
+ *
+ *  \return False when memory allocation failed, or when \a id can't be
+ *          indexed on this platform (VALUE_TOO_LARGE) (set unchanged)
+ *
+ *  \pre self != NULL
+ *
+ *  \note Complexity: O(1) (amortized)
+ */
+ATB_PUBLIC extern bool atb_SparseSet_Insert(struct atb_SparseSet *const self,
+                                            uint32_t id,
+                                            struct atb_Error *const err);
+
+/**
+ *  \brief Remove \a id from the set. The last member takes its position.
+ *
+ *  \return False when \a id is not a member of the set
+ *
+ *  \pre self != NULL
+ *
+ *  \note Complexity: O(1)
+ */
+ATB_PUBLIC extern bool atb_SparseSet_Erase(struct atb_SparseSet *const self,
+                                           uint32_t id);
+
+/**
+ *  \brief Remove all members (keeping the storage)
+ *
+ *  \pre self != NULL
+ *
+ *  \note Complexity: O(1)
+ */
+static inline void atb_SparseSet_Clear(struct atb_SparseSet *const self);
+
+/***************************************************************************/
+/*                           Inline definitions                            */
+/***************************************************************************/
+
+static inline size_t atb_SparseSet_Size(
+    struct atb_SparseSet const *const self) {
+  assert(self != NULL);
+  return self->size;
+}
+
+static inline bool atb_SparseSet_Contains(
+    struct atb_SparseSet const *const self, uint32_t id) {
+  assert(self != NULL);
+
+  if (id >= self->universe) return false;
+
+  uint32_t const position = self->sparse[id];
+  return (position < self->size) && (self->dense[position] == id);
+}
+
+static inline struct atb_View_u32 atb_SparseSet_Members(
+    struct atb_SparseSet const *const self) {
+  assert(self != NULL);
+
+  struct atb_View_u32 members;
+  members.data = self->dense;
+  members.size = self->size;
+  return members;
+}
+
+static inline void atb_SparseSet_Clear(struct atb_SparseSet *const self) {
+  assert(self != NULL);
+  self->size = 0;
+}
+
+#if defined(__cplusplus)
+} /* extern "C" */
+#endif
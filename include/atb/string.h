@@ -1,8 +1,11 @@
 #pragma once
 
+#include <assert.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
+#include "atb/allocator.h"
 #include "atb/error.h"
 #include "atb/export.h"
 #include "atb/span/string.h"
@@ -86,6 +89,207 @@ ATB_PUBLIC bool atb_String_FromInt_i(intmax_t value, ATB_INT_BASE base,
                                      struct atb_Error *const err);
 /**@}*/
 
+/* Owned string *************************************************************/
+
+/// Number of chars stored inline (without allocating) by struct atb_String
+#define K_ATB_STRING_INLINE_CAPACITY 22
+
+/// Value of the tag byte of struct atb_String when its chars are on the heap
+#define K_ATB_STRING_HEAP_TAG 0xFF
+
+/**
+ * \brief Owned, null terminated string with small-string optimization
+ *
+ * Up to K_ATB_STRING_INLINE_CAPACITY chars are stored inside the struct
+ * itself, longer strings fall back on a buffer obtained through the allocator
+ * (the heap capacity is stored in front of that buffer).
+ *
+ * The last byte of storage.local is the tag: the size of the string while
+ * stored inline, K_ATB_STRING_HEAP_TAG otherwise.
+ *
+ * Example:
+ * struct atb_String label;
+ * atb_String_Init(&label, atb_DefaultAllocator());
+ *
+ * atb_String_Assign(&label, atb_StrView_From_StrLiteral("key"), &err);
+ * atb_String_Append(&label, atb_StrView_From_StrLiteral("_0"), &err);
+ * printf(K_ATB_FMT_STRSPAN, ATB_FMT_VA_ARG_STRSPAN(atb_String_View(&label)));
+ *
+ * atb_String_Destroy(&label);
+ */
+struct atb_String {
+  union atb_String_Storage {
+    struct atb_String_Heap {
+      char *data;  /*!< Null terminated chars (allocated) */
+      size_t size; /*!< Number of chars (excluding the null terminator) */
+    } heap;
+    char local[K_ATB_STRING_INLINE_CAPACITY + 2]; /*!< Chars, null, tag */
+  } storage;
+  struct atb_Allocator const *allocator; /*!< Used for the heap fallback */
+};
+
+/**
+ * \brief Initialize an EMPTY string (nothing is allocated)
+ *
+ * \param[out] self String to initialize
+ * \param[in] allocator Allocator used when the string outgrows its inline
+ *                      storage
+ *
+ * \pre self != NULL
+ * \pre allocator != NULL
+ */
+ATB_PUBLIC extern void atb_String_Init(
+    struct atb_String *const self, struct atb_Allocator const *const allocator);
+
+/**
+ * \brief Release the heap storage of \a self (if any), leaving it EMPTY
+ *
+ * \pre self != NULL
+ */
+ATB_PUBLIC extern void atb_String_Destroy(struct atb_String *const self);
+
+/**
+ * \brief Indicates if the chars of \a self are stored inline
+ *
+ * \pre self != NULL
+ */
+static inline bool atb_String_IsInline(struct atb_String const *const self);
+
+/**
+ * \returns size_t Number of chars of \a self (excluding the null terminator)
+ *
+ * \pre self != NULL
+ */
+static inline size_t atb_String_Size(struct atb_String const *const self);
+
+/**
+ * \returns size_t Number of chars \a self can hold without allocating
+ *
+ * \pre self != NULL
+ */
+ATB_PUBLIC extern size_t atb_String_Capacity(
+    struct atb_String const *const self);
+
+/**
+ * \returns char const* Null terminated chars of \a self
+ *
+ * \pre self != NULL
+ */
+static inline char const *atb_String_CStr(struct atb_String const *const self);
+
+/**@{*/
+/**
+ * \brief View/Span over the chars of \a self (excluding the null terminator)
+ *
+ * \important Invalidated by any operation modifying the size of \a self
+ *
+ * \pre self != NULL
+ */
+static inline struct atb_StrView atb_String_View(
+    struct atb_String const *const self);
+
+static inline struct atb_StrSpan atb_String_Span(struct atb_String *const self);
+/**@}*/
+
+/**
+ * \brief Make sure \a self can hold \a capacity chars without allocating
+ *
+ * \param[in] self String to grow
+ * \param[in] capacity Minimum number of chars (excluding the null terminator)
+ * \param[out] err Optional. Error set whenever the operation failed.
+ *                 Possible values are:
+ *                 - GENERIC_VALUE_TOO_LARGE: \a capacity is not representable
+ *                 - Any error from the allocator
+ *
+ * \returns bool True on success. False otherwise, \a self remains untouched.
+ *
+ * \pre self != NULL
+ */
+ATB_PUBLIC extern bool atb_String_Reserve(struct atb_String *const self,
+                                          size_t capacity,
+                                          struct atb_Error *const err);
+
+/**
+ * \brief Replace the content of \a self by a copy of \a str
+ *
+ * \param[in] self String to modify
+ * \param[in] str Chars to copy (may be part of \a self)
+ * \param[out] err Optional. Error set whenever the operation failed (see
+ *                 atb_String_Reserve).
+ *
+ * \returns bool True on success. False otherwise, \a self remains untouched.
+ *
+ * \pre self != NULL
+ * \pre (str.size == 0) || (str.data != NULL)
+ */
+ATB_PUBLIC extern bool atb_String_Assign(struct atb_String *const self,
+                                         struct atb_StrView str,
+                                         struct atb_Error *const err);
+
+/**
+ * \brief Append a copy of \a str at the end of \a self (the storage grows
+ *        geometrically)
+ *
+ * \param[in] self String to modify
+ * \param[in] str Chars to copy (may be part of \a self)
+ * \param[out] err Optional. Error set whenever the operation failed (see
+ *                 atb_String_Reserve).
+ *
+ * \returns bool True on success. False otherwise, \a self remains untouched.
+ *
+ * \pre self != NULL
+ * \pre (str.size == 0) || (str.data != NULL)
+ */
+ATB_PUBLIC extern bool atb_String_Append(struct atb_String *const self,
+                                         struct atb_StrView str,
+                                         struct atb_Error *const err);
+
+/**
+ * \brief Remove all chars of \a self (keeping its storage)
+ *
+ * \pre self != NULL
+ */
+ATB_PUBLIC extern void atb_String_Clear(struct atb_String *const self);
+
+/***************************************************************************/
+/*                           Inline definitions                            */
+/***************************************************************************/
+
+static inline bool atb_String_IsInline(struct atb_String const *const self) {
+  assert(self != NULL);
+  return (unsigned char)self->storage.local[K_ATB_STRING_INLINE_CAPACITY + 1] !=
+         K_ATB_STRING_HEAP_TAG;
+}
+
+static inline size_t atb_String_Size(struct atb_String const *const self) {
+  return atb_String_IsInline(self)
+             ? (unsigned char)
+                   self->storage.local[K_ATB_STRING_INLINE_CAPACITY + 1]
+             : self->storage.heap.size;
+}
+
+static inline char const *atb_String_CStr(struct atb_String const *const self) {
+  return atb_String_IsInline(self) ? self->storage.local
+                                   : self->storage.heap.data;
+}
+
+static inline struct atb_StrView atb_String_View(
+    struct atb_String const *const self) {
+  struct atb_StrView view;
+  view.data = atb_String_CStr(self);
+  view.size = atb_String_Size(self);
+  return view;
+}
+
+static inline struct atb_StrSpan atb_String_Span(
+    struct atb_String *const self) {
+  struct atb_StrSpan span;
+  span.data = atb_String_IsInline(self) ? self->storage.local
+                                        : self->storage.heap.data;
+  span.size = atb_String_Size(self);
+  return span;
+}
+
 #if defined(__cplusplus)
 }
 #endif
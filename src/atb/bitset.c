@@ -0,0 +1,193 @@
+#include "atb/bitset.h"
+
+/// Mask of the bits [lo, hi) of a word
+static uint64_t Bitset_Mask(size_t lo, size_t hi) {
+  assert(lo < hi);
+  assert(hi <= K_ATB_BITSET_WORD_BITS);
+
+  return (UINT64_MAX << lo) & (UINT64_MAX >> (K_ATB_BITSET_WORD_BITS - hi));
+}
+
+/// Split the bit range [first, first + count) (count > 0) into: a partial head
+/// word, full words in between, and a partial tail word (which may be the same
+/// as the head word).
+struct Bitset_Range {
+  size_t head;        /*!< Index of the first word */
+  size_t tail;        /*!< Index of the last word */
+  uint64_t head_mask; /*!< Bits of the range inside the first word */
+  uint64_t tail_mask; /*!< Bits of the range inside the last word */
+};
+
+static struct Bitset_Range Bitset_Range_Of(struct atb_Bitset self,
+                                           size_t first, size_t count) {
+  assert(count > 0);
+  assert(first <= self.size);
+  assert(count <= (self.size - first));
+  (void)self;
+
+  size_t const last = first + count - 1;
+
+  struct Bitset_Range range;
+  range.head = first / K_ATB_BITSET_WORD_BITS;
+  range.tail = last / K_ATB_BITSET_WORD_BITS;
+  range.head_mask =
+      Bitset_Mask(first % K_ATB_BITSET_WORD_BITS, K_ATB_BITSET_WORD_BITS);
+  range.tail_mask = Bitset_Mask(0, (last % K_ATB_BITSET_WORD_BITS) + 1);
+
+  if (range.head == range.tail) {
+    range.head_mask &= range.tail_mask;
+    range.tail_mask = range.head_mask;
+  }
+
+  return range;
+}
+
+void atb_Bitset_SetRange(struct atb_Bitset self, size_t first, size_t count) {
+  if (count == 0) return;
+
+  struct Bitset_Range const range = Bitset_Range_Of(self, first, count);
+  uint64_t *const words = self.words.data;
+
+  words[range.head] |= range.head_mask;
+  for (size_t w = range.head + 1; w < range.tail; ++w) words[w] = UINT64_MAX;
+  words[range.tail] |= range.tail_mask;
+}
+
+void atb_Bitset_ClearRange(struct atb_Bitset self, size_t first,
+                           size_t count) {
+  if (count == 0) return;
+
+  struct Bitset_Range const range = Bitset_Range_Of(self, first, count);
+  uint64_t *const words = self.words.data;
+
+  words[range.head] &= ~range.head_mask;
+  for (size_t w = range.head + 1; w < range.tail; ++w) words[w] = 0;
+  words[range.tail] &= ~range.tail_mask;
+}
+
+bool atb_Bitset_TestAll(struct atb_Bitset self, size_t first, size_t count) {
+  if (count == 0) return true;
+
+  struct Bitset_Range const range = Bitset_Range_Of(self, first, count);
+  uint64_t const *const words = self.words.data;
+
+  if ((words[range.head] & range.head_mask) != range.head_mask) return false;
+  if ((words[range.tail] & range.tail_mask) != range.tail_mask) return false;
+
+  for (size_t w = range.head + 1; w < range.tail; ++w) {
+    if (words[w] != UINT64_MAX) return false;
+  }
+
+  return true;
+}
+
+bool atb_Bitset_TestAny(struct atb_Bitset self, size_t first, size_t count) {
+  if (count == 0) return false;
+
+  struct Bitset_Range const range = Bitset_Range_Of(self, first, count);
+  uint64_t const *const words = self.words.data;
+
+  if ((words[range.head] & range.head_mask) != 0) return true;
+  if ((words[range.tail] & range.tail_mask) != 0) return true;
+
+  for (size_t w = range.head + 1; w < range.tail; ++w) {
+    if (words[w] != 0) return true;
+  }
+
+  return false;
+}
+
+size_t atb_Bitset_CountRange(struct atb_Bitset self, size_t first,
+                             size_t count) {
+  if (count == 0) return 0;
+
+  struct Bitset_Range const range = Bitset_Range_Of(self, first, count);
+  uint64_t const *const words = self.words.data;
+
+  size_t total = atb_Bits_Popcount_u64(words[range.head] & range.head_mask);
+  if (range.tail == range.head) return total;
+
+  /* Independent accumulators break the dependency chain between words, which
+   * lets the compiler interleave (or vectorize) the popcounts */
+  size_t acc[4] = {0, 0, 0, 0};
+  size_t w = range.head + 1;
+
+  for (; (w + 4) <= range.tail; w += 4) {
+    acc[0] += atb_Bits_Popcount_u64(words[w + 0]);
+    acc[1] += atb_Bits_Popcount_u64(words[w + 1]);
+    acc[2] += atb_Bits_Popcount_u64(words[w + 2]);
+    acc[3] += atb_Bits_Popcount_u64(words[w + 3]);
+  }
+
+  for (; w < range.tail; ++w) acc[0] += atb_Bits_Popcount_u64(words[w]);
+
+  total += acc[0] + acc[1] + acc[2] + acc[3];
+  total += atb_Bits_Popcount_u64(words[range.tail] & range.tail_mask);
+
+  return total;
+}
+
+size_t atb_Bitset_FindNext(struct atb_Bitset self, size_t from) {
+  assert(from <= self.size);
+
+  if (from == self.size) return self.size;
+
+  uint64_t const *const words = self.words.data;
+  size_t const word_count = ATB_BITSET_WORDS_FOR(self.size);
+
+  size_t w = from / K_ATB_BITSET_WORD_BITS;
+  uint64_t word = words[w] & (UINT64_MAX << (from % K_ATB_BITSET_WORD_BITS));
+
+  while (word == 0) {
+    if (++w == word_count) return self.size;
+    word = words[w];
+  }
+
+  size_t const found = (w * K_ATB_BITSET_WORD_BITS) + atb_Bits_Ctz_u64(word);
+
+  /* Bits past the end of the last word are not part of the bitset */
+  return (found < self.size) ? found : self.size;
+}
+
+/// Apply `dest = lhs OP rhs` on all words, leaving the bits of the last word
+/// beyond size untouched
+#define BITSET_BINARY_OP(dest, lhs, rhs, OP)                                  \
+  do {                                                                        \
+    assert((dest).size == (lhs).size);                                        \
+    assert((dest).size == (rhs).size);                                        \
+                                                                              \
+    if ((dest).size == 0) break;                                              \
+                                                                              \
+    uint64_t *const d = (dest).words.data;                                    \
+    uint64_t const *const l = (lhs).words.data;                               \
+    uint64_t const *const r = (rhs).words.data;                               \
+    size_t const last = ATB_BITSET_WORDS_FOR((dest).size) - 1;                \
+                                                                              \
+    for (size_t w = 0; w < last; ++w) d[w] = l[w] OP r[w];                    \
+                                                                              \
+    uint64_t const mask =                                                     \
+        Bitset_Mask(0, (((dest).size - 1) % K_ATB_BITSET_WORD_BITS) + 1);     \
+    d[last] = (d[last] & ~mask) | ((l[last] OP r[last]) & mask);              \
+  } while (0)
+
+void atb_Bitset_And(struct atb_Bitset dest, struct atb_Bitset lhs,
+                    struct atb_Bitset rhs) {
+  BITSET_BINARY_OP(dest, lhs, rhs, &);
+}
+
+void atb_Bitset_Or(struct atb_Bitset dest, struct atb_Bitset lhs,
+                   struct atb_Bitset rhs) {
+  BITSET_BINARY_OP(dest, lhs, rhs, |);
+}
+
+void atb_Bitset_Xor(struct atb_Bitset dest, struct atb_Bitset lhs,
+                    struct atb_Bitset rhs) {
+  BITSET_BINARY_OP(dest, lhs, rhs, ^);
+}
+
+void atb_Bitset_AndNot(struct atb_Bitset dest, struct atb_Bitset lhs,
+                       struct atb_Bitset rhs) {
+  BITSET_BINARY_OP(dest, lhs, rhs, &~);
+}
+
+#undef BITSET_BINARY_OP
@@ -0,0 +1,111 @@
+#include "atb/bloom.h"
+
+#include <string.h>
+
+/// Number of keys ahead of the current one whose block is prefetched
+#define K_BLOOM_PREFETCH_DISTANCE 8
+
+#if defined(__GNUC__) || defined(__clang__)
+#define BLOOM_PREFETCH(addr, rw) __builtin_prefetch((addr), (rw))
+#else
+#define BLOOM_PREFETCH(addr, rw) ((void)(addr), (void)(rw))
+#endif
+
+/// Number of keys hashed at once by the StrView batches
+#define K_BLOOM_STRS_CHUNK 64
+
+void atb_Bloom_Clear(struct atb_Bloom self) {
+  memset(self.words.data, 0, self.words.size * sizeof(uint64_t));
+}
+
+void atb_Bloom_InsertBatch(struct atb_Bloom self,
+                           struct atb_View_u64 hashes) {
+  assert(atb_View_u64_IsValid(hashes));
+
+  for (size_t i = 0; i < hashes.size; ++i) {
+    if ((i + K_BLOOM_PREFETCH_DISTANCE) < hashes.size) {
+      BLOOM_PREFETCH(atb_Bloom_BlockOf(
+                         self, hashes.data[i + K_BLOOM_PREFETCH_DISTANCE]),
+                     1);
+    }
+
+    atb_Bloom_Insert(self, hashes.data[i]);
+  }
+}
+
+size_t atb_Bloom_QueryBatch(struct atb_Bloom self, struct atb_View_u64 hashes,
+                            struct atb_Span_u8 results) {
+  assert(atb_View_u64_IsValid(hashes));
+  assert(atb_Span_u8_IsValid(results));
+  assert(results.size >= hashes.size);
+
+  size_t count = 0;
+
+  for (size_t i = 0; i < hashes.size; ++i) {
+    if ((i + K_BLOOM_PREFETCH_DISTANCE) < hashes.size) {
+      BLOOM_PREFETCH(atb_Bloom_BlockOf(
+                         self, hashes.data[i + K_BLOOM_PREFETCH_DISTANCE]),
+                     0);
+    }
+
+    bool const hit = atb_Bloom_MayContain(self, hashes.data[i]);
+    results.data[i] = hit ? 1 : 0;
+    count += hit ? 1 : 0;
+  }
+
+  return count;
+}
+
+/// Hash keys[0, count) into hashes (count <= K_BLOOM_STRS_CHUNK)
+static struct atb_View_u64 Bloom_HashStrs(struct atb_StrView const *keys,
+                                          size_t count, uint64_t *hashes) {
+  assert(count <= K_BLOOM_STRS_CHUNK);
+
+  for (size_t i = 0; i < count; ++i) {
+    hashes[i] = atb_Hash_StrView(keys[i], K_ATB_HASH_SEED);
+  }
+
+  struct atb_View_u64 view;
+  view.data = hashes;
+  view.size = count;
+  return view;
+}
+
+void atb_Bloom_InsertStrs(struct atb_Bloom self,
+                          struct atb_StrView const *keys, size_t count) {
+  assert((keys != NULL) || (count == 0));
+
+  uint64_t hashes[K_BLOOM_STRS_CHUNK];
+
+  for (size_t i = 0; i < count; i += K_BLOOM_STRS_CHUNK) {
+    size_t const n = ((count - i) < K_BLOOM_STRS_CHUNK) ? (count - i)
+                                                        : K_BLOOM_STRS_CHUNK;
+
+    atb_Bloom_InsertBatch(self, Bloom_HashStrs(&(keys[i]), n, hashes));
+  }
+}
+
+size_t atb_Bloom_QueryStrs(struct atb_Bloom self,
+                           struct atb_StrView const *keys, size_t count,
+                           struct atb_Span_u8 results) {
+  assert((keys != NULL) || (count == 0));
+  assert(atb_Span_u8_IsValid(results));
+  assert(results.size >= count);
+
+  uint64_t hashes[K_BLOOM_STRS_CHUNK];
+  size_t hits = 0;
+
+  for (size_t i = 0; i < count; i += K_BLOOM_STRS_CHUNK) {
+    size_t const n = ((count - i) < K_BLOOM_STRS_CHUNK) ? (count - i)
+                                                        : K_BLOOM_STRS_CHUNK;
+
+    struct atb_Span_u8 chunk;
+    chunk.data = results.data + i;
+    chunk.size = n;
+
+    hits += atb_Bloom_QueryBatch(self, Bloom_HashStrs(&(keys[i]), n, hashes),
+                                 chunk);
+  }
+
+  return hits;
+}
@@ -0,0 +1,98 @@
+#include "atb/countmin.h"
+
+#include <string.h>
+
+/// Index of the counter of hash inside the row (double hashing: each row
+/// uses h1 + row * h2, reduced to [0, width) without modulo)
+static size_t CountMin_Column(struct atb_CountMin const *const self,
+                              uint64_t hash, size_t row) {
+  uint32_t const h1 = (uint32_t)hash;
+  uint32_t const h2 = (uint32_t)(hash >> 32) | 0x1;
+  uint32_t const h = h1 + ((uint32_t)row * h2);
+
+  return (size_t)(((uint64_t)h * self->width) >> 32);
+}
+
+void atb_CountMin_Clear(struct atb_CountMin *const self) {
+  assert(self != NULL);
+
+  memset(self->counters.data, 0, self->counters.size * sizeof(uint32_t));
+  self->total = 0;
+}
+
+void atb_CountMin_Add(struct atb_CountMin *const self, uint64_t hash,
+                      uint32_t count) {
+  assert(self != NULL);
+
+  for (size_t row = 0; row < self->depth; ++row) {
+    uint32_t *const counter =
+        &(self->counters
+              .data[(row * self->width) + CountMin_Column(self, hash, row)]);
+
+    *counter = ((UINT32_MAX - *counter) < count) ? UINT32_MAX
+                                                 : (*counter + count);
+  }
+
+  self->total += count;
+}
+
+void atb_CountMin_AddHashes(struct atb_CountMin *const self,
+                            struct atb_View_u64 hashes) {
+  assert(atb_View_u64_IsValid(hashes));
+
+  for (size_t i = 0; i < hashes.size; ++i) {
+    atb_CountMin_Add(self, hashes.data[i], 1);
+  }
+}
+
+void atb_CountMin_AddInts(struct atb_CountMin *const self,
+                          struct atb_View_u64 values) {
+  assert(atb_View_u64_IsValid(values));
+
+  for (size_t i = 0; i < values.size; ++i) {
+    atb_CountMin_Add(self, atb_Hash_u64(values.data[i]), 1);
+  }
+}
+
+void atb_CountMin_AddStrs(struct atb_CountMin *const self,
+                          struct atb_StrView const *keys, size_t count) {
+  assert((keys != NULL) || (count == 0));
+
+  for (size_t i = 0; i < count; ++i) {
+    atb_CountMin_Add(self, atb_Hash_StrView(keys[i], K_ATB_HASH_SEED), 1);
+  }
+}
+
+void atb_CountMin_Merge(struct atb_CountMin *const self,
+                        struct atb_CountMin const *const other) {
+  assert(self != NULL);
+  assert(other != NULL);
+  assert((self->width == other->width) && (self->depth == other->depth));
+
+  uint32_t *const dest = self->counters.data;
+  uint32_t const *const src = other->counters.data;
+
+  for (size_t i = 0; i < self->counters.size; ++i) {
+    dest[i] = ((UINT32_MAX - dest[i]) < src[i]) ? UINT32_MAX
+                                                : (dest[i] + src[i]);
+  }
+
+  self->total += other->total;
+}
+
+uint32_t atb_CountMin_Estimate(struct atb_CountMin const *const self,
+                               uint64_t hash) {
+  assert(self != NULL);
+
+  uint32_t estimate = UINT32_MAX;
+
+  for (size_t row = 0; row < self->depth; ++row) {
+    uint32_t const counter =
+        self->counters
+            .data[(row * self->width) + CountMin_Column(self, hash, row)];
+
+    estimate = (counter < estimate) ? counter : estimate;
+  }
+
+  return estimate;
+}
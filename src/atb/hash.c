@@ -0,0 +1,42 @@
+#include "atb/hash.h"
+
+#include <string.h> /* memcpy */
+
+/* MurmurHash64A (public domain, Austin Appleby), reading words through memcpy
+ * to support unaligned data */
+uint64_t atb_Hash_Bytes(void const *data, size_t size, uint64_t seed) {
+  assert((data != NULL) || (size == 0));
+
+  uint64_t const m = 0xC6A4A7935BD1E995ULL;
+  int const r = 47;
+
+  unsigned char const *bytes = (unsigned char const *)data;
+  uint64_t hash = seed ^ ((uint64_t)size * m);
+
+  for (size_t i = 0; i < (size / 8); ++i) {
+    uint64_t word;
+    memcpy(&word, bytes, sizeof(word));
+    bytes += sizeof(word);
+
+    word *= m;
+    word ^= word >> r;
+    word *= m;
+
+    hash ^= word;
+    hash *= m;
+  }
+
+  size_t const tail = size % 8;
+  if (tail != 0) {
+    for (size_t i = tail; i > 0; --i) {
+      hash ^= (uint64_t)bytes[i - 1] << (8 * (i - 1));
+    }
+    hash *= m;
+  }
+
+  hash ^= hash >> r;
+  hash *= m;
+  hash ^= hash >> r;
+
+  return hash;
+}
@@ -0,0 +1,161 @@
+#include "atb/heap.h"
+
+static bool Heap_IsBefore(struct atb_Heap const *const self,
+                          struct atb_Heap_Node const *const lhs,
+                          struct atb_Heap_Node const *const rhs) {
+  return ATB_INVOKE_UNSAFELY(self->compare, lhs, rhs) < 0;
+}
+
+/// Link 2 ROOTS (i.e. without siblings) together and returns the new root
+static struct atb_Heap_Node *Heap_Meld(struct atb_Heap const *const self,
+                                       struct atb_Heap_Node *lhs,
+                                       struct atb_Heap_Node *rhs) {
+  assert(lhs != NULL);
+  assert(rhs != NULL);
+
+  if (Heap_IsBefore(self, rhs, lhs)) {
+    struct atb_Heap_Node *const tmp = lhs;
+    lhs = rhs;
+    rhs = tmp;
+  }
+
+  /* rhs becomes the first child of lhs */
+  rhs->prev = lhs;
+  rhs->next = lhs->child;
+  if (lhs->child != NULL) {
+    lhs->child->prev = rhs;
+  }
+  lhs->child = rhs;
+
+  return lhs;
+}
+
+/// Standard 'two-pass' pairing: meld siblings 2 by 2 from left to right, then
+/// meld the resulting heaps from right to left into a single root.
+static struct atb_Heap_Node *Heap_MergeSiblings(
+    struct atb_Heap const *const self, struct atb_Heap_Node *first) {
+  struct atb_Heap_Node *pairs = NULL; /* Reversed list, linked using ->next */
+
+  while (first != NULL) {
+    struct atb_Heap_Node *const lhs = first;
+    struct atb_Heap_Node *const rhs = first->next;
+
+    if (rhs == NULL) {
+      first = NULL;
+      lhs->prev = NULL;
+      lhs->next = pairs;
+      pairs = lhs;
+    } else {
+      first = rhs->next;
+      lhs->next = lhs->prev = NULL;
+      rhs->next = rhs->prev = NULL;
+
+      struct atb_Heap_Node *const melded = Heap_Meld(self, lhs, rhs);
+      melded->next = pairs;
+      pairs = melded;
+    }
+  }
+
+  struct atb_Heap_Node *root = NULL;
+
+  while (pairs != NULL) {
+    struct atb_Heap_Node *const next = pairs->next;
+    pairs->next = NULL;
+
+    root = (root == NULL) ? pairs : Heap_Meld(self, root, pairs);
+    pairs = next;
+  }
+
+  return root;
+}
+
+/// Unlink a NON-ROOT node from its parent/siblings (keeping its childs)
+static void Heap_Detach(struct atb_Heap_Node *const node) {
+  assert(node->prev != NULL);
+
+  if (node->prev->child == node) {
+    node->prev->child = node->next;
+  } else {
+    node->prev->next = node->next;
+  }
+
+  if (node->next != NULL) {
+    node->next->prev = node->prev;
+  }
+
+  node->next = NULL;
+  node->prev = NULL;
+}
+
+void atb_Heap_Insert(struct atb_Heap *const self,
+                     struct atb_Heap_Node *const node) {
+  assert(self != NULL);
+  assert(node != NULL);
+
+  atb_Heap_Node_Init(node);
+
+  self->root = (self->root == NULL) ? node : Heap_Meld(self, self->root, node);
+  self->size += 1;
+}
+
+struct atb_Heap_Node *atb_Heap_Pop(struct atb_Heap *const self) {
+  assert(self != NULL);
+
+  struct atb_Heap_Node *const top = self->root;
+
+  if (top != NULL) {
+    self->root = Heap_MergeSiblings(self, top->child);
+    self->size -= 1;
+    atb_Heap_Node_Init(top);
+  }
+
+  return top;
+}
+
+void atb_Heap_Remove(struct atb_Heap *const self,
+                     struct atb_Heap_Node *const node) {
+  assert(self != NULL);
+  assert(node != NULL);
+  assert(self->size > 0);
+
+  if (node == self->root) {
+    (void)atb_Heap_Pop(self);
+  } else {
+    Heap_Detach(node);
+
+    struct atb_Heap_Node *const childs = Heap_MergeSiblings(self, node->child);
+    if (childs != NULL) {
+      self->root = Heap_Meld(self, self->root, childs);
+    }
+
+    self->size -= 1;
+    atb_Heap_Node_Init(node);
+  }
+}
+
+void atb_Heap_DecreaseKey(struct atb_Heap *const self,
+                          struct atb_Heap_Node *const node) {
+  assert(self != NULL);
+  assert(node != NULL);
+  assert(self->size > 0);
+
+  if (node != self->root) {
+    Heap_Detach(node);
+    self->root = Heap_Meld(self, self->root, node);
+  }
+}
+
+void atb_Heap_Merge(struct atb_Heap *const self, struct atb_Heap *const other) {
+  assert(self != NULL);
+  assert(other != NULL);
+
+  if (other->root != NULL) {
+    self->root = (self->root == NULL)
+                     ? other->root
+                     : Heap_Meld(self, self->root, other->root);
+    self->size += other->size;
+
+    other->root = NULL;
+    other->size = 0;
+  }
+}
@@ -0,0 +1,87 @@
+#include "atb/hyperloglog.h"
+
+#include <math.h>
+#include <string.h>
+
+void atb_HyperLogLog_Clear(struct atb_HyperLogLog self) {
+  memset(self.registers.data, 0, self.registers.size);
+}
+
+void atb_HyperLogLog_AddHashes(struct atb_HyperLogLog self,
+                               struct atb_View_u64 hashes) {
+  assert(atb_View_u64_IsValid(hashes));
+
+  for (size_t i = 0; i < hashes.size; ++i) {
+    atb_HyperLogLog_Add(self, hashes.data[i]);
+  }
+}
+
+void atb_HyperLogLog_AddInts(struct atb_HyperLogLog self,
+                             struct atb_View_u64 values) {
+  assert(atb_View_u64_IsValid(values));
+
+  for (size_t i = 0; i < values.size; ++i) {
+    atb_HyperLogLog_Add(self, atb_Hash_u64(values.data[i]));
+  }
+}
+
+void atb_HyperLogLog_AddStrs(struct atb_HyperLogLog self,
+                             struct atb_StrView const *keys, size_t count) {
+  assert((keys != NULL) || (count == 0));
+
+  for (size_t i = 0; i < count; ++i) {
+    atb_HyperLogLog_Add(self, atb_Hash_StrView(keys[i], K_ATB_HASH_SEED));
+  }
+}
+
+void atb_HyperLogLog_Merge(struct atb_HyperLogLog self,
+                           struct atb_HyperLogLog other) {
+  assert(self.precision == other.precision);
+
+  uint8_t *const dest = self.registers.data;
+  uint8_t const *const src = other.registers.data;
+
+  for (size_t i = 0; i < self.registers.size; ++i) {
+    dest[i] = (dest[i] < src[i]) ? src[i] : dest[i];
+  }
+}
+
+/// Bias correction constant (from the original HyperLogLog paper)
+static double HyperLogLog_Alpha(size_t m) {
+  switch (m) {
+    case 16:
+      return 0.673;
+    case 32:
+      return 0.697;
+    case 64:
+      return 0.709;
+    default:
+      return 0.7213 / (1.0 + (1.079 / (double)m));
+  }
+}
+
+uint64_t atb_HyperLogLog_Estimate(struct atb_HyperLogLog self) {
+  size_t const m = self.registers.size;
+
+  /* Histogram of the ranks, such that the harmonic mean only needs one
+   * multiplication per possible rank */
+  size_t histogram[65] = {0};
+  for (size_t i = 0; i < m; ++i) histogram[self.registers.data[i]] += 1;
+
+  double sum = 0.0;
+  double weight = 1.0;
+  for (size_t rank = 0; rank < 65; ++rank) {
+    sum += (double)histogram[rank] * weight;
+    weight *= 0.5;
+  }
+
+  double const md = (double)m;
+  double estimate = (HyperLogLog_Alpha(m) * md * md) / sum;
+
+  /* Small range correction: linear counting */
+  if ((estimate <= (2.5 * md)) && (histogram[0] != 0)) {
+    estimate = md * log(md / (double)histogram[0]);
+  }
+
+  return (uint64_t)(estimate + 0.5);
+}
@@ -0,0 +1,238 @@
+#include "atb/lru.h"
+
+#include <stdint.h> /* SIZE_MAX */
+
+/// Number of buckets allocated on the first insertion
+static const size_t K_LRU_MIN_BUCKETS = 16;
+
+static struct atb_Lru_Node *Lru_Node_From(struct atb_List const *const node) {
+  return atb_Lru_Entry(node, struct atb_Lru_Node, recency);
+}
+
+static struct atb_Lru_Node **Lru_Bucket(struct atb_Lru const *const self,
+                                        uint64_t hash) {
+  return &(self->buckets[hash & (self->bucket_count - 1)]);
+}
+
+/// Link (inside its bucket) pointing to the node matching key, NULL when the
+/// key isn't part of the cache
+static struct atb_Lru_Node **Lru_Lookup(struct atb_Lru const *const self,
+                                        uint64_t hash, void const *key) {
+  if (self->bucket_count == 0) return NULL;
+
+  struct atb_Lru_Node **link = Lru_Bucket(self, hash);
+
+  for (; *link != NULL; link = &((*link)->chain)) {
+    if (((*link)->hash == hash) &&
+        ATB_INVOKE_UNSAFELY(self->match, *link, key)) {
+      return link;
+    }
+  }
+
+  return NULL;
+}
+
+/// Double the number of buckets, re-indexing all nodes
+static bool Lru_Grow(struct atb_Lru *const self, struct atb_Error *const err) {
+  size_t const count = (self->bucket_count == 0) ? K_LRU_MIN_BUCKETS
+                                                 : (self->bucket_count * 2);
+
+  if ((count < self->bucket_count) ||
+      (count > (SIZE_MAX / sizeof(struct atb_Lru_Node *)))) {
+    atb_GenericError_Set(err, K_ATB_ERROR_GENERIC_VALUE_TOO_LARGE);
+    return false;
+  }
+
+  struct atb_Lru_Node **buckets = (struct atb_Lru_Node **)atb_Allocator_Alloc(
+      self->allocator, NULL, count * sizeof(struct atb_Lru_Node *), err);
+
+  if (buckets == NULL) return false;
+
+  for (size_t i = 0; i < count; ++i) buckets[i] = NULL;
+
+  for (size_t i = 0; i < self->bucket_count; ++i) {
+    struct atb_Lru_Node *node = self->buckets[i];
+
+    while (node != NULL) {
+      struct atb_Lru_Node *const next = node->chain;
+      struct atb_Lru_Node **const bucket =
+          &(buckets[node->hash & (count - 1)]);
+
+      node->chain = *bucket;
+      *bucket = node;
+      node = next;
+    }
+  }
+
+  if (self->buckets != NULL) {
+    (void)atb_Allocator_Release(self->allocator, (void **)&(self->buckets),
+                                K_ATB_ERROR_IGNORED);
+  }
+
+  self->buckets = buckets;
+  self->bucket_count = count;
+
+  return true;
+}
+
+static void Lru_Unlink(struct atb_Lru *const self,
+                       struct atb_Lru_Node *const node) {
+  struct atb_Lru_Node **link = Lru_Bucket(self, node->hash);
+
+  while (*link != node) {
+    assert(*link != NULL);
+    link = &((*link)->chain);
+  }
+
+  *link = node->chain;
+  node->chain = NULL;
+
+  atb_List_Pop(&(node->recency));
+
+  self->size -= 1;
+  self->bytes -= node->bytes;
+}
+
+static void Lru_Evict(struct atb_Lru *const self,
+                      struct atb_Lru_Node *const node) {
+  Lru_Unlink(self, node);
+
+  ATB_INVOKE(self->evict, node);
+}
+
+static bool Lru_IsOverLimits(struct atb_Lru const *const self) {
+  return ((self->limits.entries != 0) &&
+          (self->size > self->limits.entries)) ||
+         ((self->limits.bytes != 0) && (self->bytes > self->limits.bytes));
+}
+
+/// Evict least recently used nodes until the limits are respected, without
+/// evicting keep
+static void Lru_Shrink(struct atb_Lru *const self,
+                       struct atb_Lru_Node const *const keep) {
+  while (Lru_IsOverLimits(self) && (self->recency.prev != &(self->recency))) {
+    struct atb_Lru_Node *const lru = Lru_Node_From(self->recency.prev);
+
+    if (lru == keep) break;
+
+    Lru_Evict(self, lru);
+  }
+}
+
+void atb_Lru_Init(struct atb_Lru *const self,
+                  struct atb_Allocator const *const allocator,
+                  struct atb_Lru_Limits limits, struct atb_Lru_Match match,
+                  struct atb_Lru_Evict evict) {
+  assert(self != NULL);
+  assert(allocator != NULL);
+  assert(ATB_CALLABLE_IS_VALID(match));
+
+  atb_List_Init(&(self->recency));
+  self->buckets = NULL;
+  self->bucket_count = 0;
+  self->size = 0;
+  self->bytes = 0;
+  self->limits = limits;
+  self->match = match;
+  self->evict = evict;
+  self->allocator = allocator;
+}
+
+void atb_Lru_Destroy(struct atb_Lru *const self) {
+  assert(self != NULL);
+
+  while (self->recency.next != &(self->recency)) {
+    struct atb_Lru_Node *const node = Lru_Node_From(self->recency.next);
+
+    atb_List_Pop(&(node->recency));
+    node->chain = NULL;
+
+    ATB_INVOKE(self->evict, node);
+  }
+
+  if (self->buckets != NULL) {
+    (void)atb_Allocator_Release(self->allocator, (void **)&(self->buckets),
+                                K_ATB_ERROR_IGNORED);
+  }
+
+  self->buckets = NULL;
+  self->bucket_count = 0;
+  self->size = 0;
+  self->bytes = 0;
+}
+
+struct atb_Lru_Node *atb_Lru_Find(struct atb_Lru *const self, uint64_t hash,
+                                  void const *key) {
+  assert(self != NULL);
+
+  struct atb_Lru_Node **const link = Lru_Lookup(self, hash, key);
+
+  if (link == NULL) return NULL;
+
+  struct atb_Lru_Node *const node = *link;
+
+  /* Move to front */
+  atb_List_Pop(&(node->recency));
+  atb_List_InsertAfter(&(node->recency), &(self->recency));
+
+  return node;
+}
+
+struct atb_Lru_Node *atb_Lru_Peek(struct atb_Lru const *const self,
+                                  uint64_t hash, void const *key) {
+  assert(self != NULL);
+
+  struct atb_Lru_Node **const link = Lru_Lookup(self, hash, key);
+
+  return (link == NULL) ? NULL : *link;
+}
+
+bool atb_Lru_Insert(struct atb_Lru *const self,
+                    struct atb_Lru_Node *const node, uint64_t hash,
+                    void const *key, size_t bytes,
+                    struct atb_Error *const err) {
+  assert(self != NULL);
+  assert(node != NULL);
+
+  /* Keep a load factor <= 1 */
+  if ((self->size >= self->bucket_count) && !Lru_Grow(self, err)) {
+    return false;
+  }
+
+  struct atb_Lru_Node **const existing = Lru_Lookup(self, hash, key);
+  if (existing != NULL) {
+    Lru_Evict(self, *existing);
+  }
+
+  struct atb_Lru_Node **const bucket = Lru_Bucket(self, hash);
+
+  node->hash = hash;
+  node->bytes = bytes;
+  node->chain = *bucket;
+  *bucket = node;
+
+  atb_List_InsertAfter(&(node->recency), &(self->recency));
+  self->size += 1;
+  self->bytes += bytes;
+
+  Lru_Shrink(self, node);
+
+  return true;
+}
+
+void atb_Lru_Remove(struct atb_Lru *const self,
+                    struct atb_Lru_Node *const node) {
+  assert(self != NULL);
+  assert(node != NULL);
+  assert(self->size > 0);
+
+  Lru_Unlink(self, node);
+}
+
+void atb_Lru_SetLimits(struct atb_Lru *const self,
+                       struct atb_Lru_Limits limits) {
+  assert(self != NULL);
+
+  self->limits = limits;
+  Lru_Shrink(self, NULL);
+}
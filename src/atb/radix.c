@@ -0,0 +1,472 @@
+#include "atb/radix.h"
+
+#include <stdint.h> /* SIZE_MAX */
+#include <string.h>
+
+/// Maximum number of children of a node (one per possible first byte)
+#define K_RADIX_MAX_CHILDREN 256
+
+/// Number of children allocated on the first insertion
+static const size_t K_RADIX_MIN_CHILDREN = 2;
+
+struct atb_Radix_Node {
+  /// child_capacity pointers, followed by child_capacity bytes: the first
+  /// byte of each child label (sorted), searched with memchr
+  struct atb_Radix_Node **children;
+  void *value;             /*!< Value of the key ending here, if has_value */
+  size_t label_size;       /*!< Size of label */
+  uint16_t child_count;    /*!< Number of children */
+  uint16_t child_capacity; /*!< Number of children allocated */
+  bool has_value;          /*!< A key ends on this node */
+  char label[];            /*!< Edge label from the parent (not \0 ended) */
+};
+
+static unsigned char *Node_Firsts(struct atb_Radix_Node const *const node) {
+  return (unsigned char *)(node->children + node->child_capacity);
+}
+
+/// Node without children nor value, which label is a copy of label (left
+/// uninitialized when NULL)
+static struct atb_Radix_Node *Node_New(
+    struct atb_Allocator const *const allocator, char const *label,
+    size_t label_size, struct atb_Error *const err) {
+  if (label_size > (SIZE_MAX - sizeof(struct atb_Radix_Node))) {
+    atb_GenericError_Set(err, K_ATB_ERROR_GENERIC_VALUE_TOO_LARGE);
+    return NULL;
+  }
+
+  struct atb_Radix_Node *const node =
+      (struct atb_Radix_Node *)atb_Allocator_Alloc(
+          allocator, NULL, sizeof(struct atb_Radix_Node) + label_size, err);
+
+  if (node == NULL) return NULL;
+
+  node->children = NULL;
+  node->value = NULL;
+  node->label_size = label_size;
+  node->child_count = 0;
+  node->child_capacity = 0;
+  node->has_value = false;
+  if ((label != NULL) && (label_size > 0)) {
+    memcpy(node->label, label, label_size);
+  }
+
+  return node;
+}
+
+/// Release node (NOT its children)
+static void Node_Delete(struct atb_Allocator const *const allocator,
+                        struct atb_Radix_Node *node) {
+  if (node->children != NULL) {
+    (void)atb_Allocator_Release(allocator, (void **)&(node->children),
+                                K_ATB_ERROR_IGNORED);
+  }
+
+  (void)atb_Allocator_Release(allocator, (void **)&node, K_ATB_ERROR_IGNORED);
+}
+
+/// Release node and ALL its descendants
+static void Node_DeleteAll(struct atb_Allocator const *const allocator,
+                           struct atb_Radix_Node *const node) {
+  for (size_t i = 0; i < node->child_count; ++i) {
+    Node_DeleteAll(allocator, node->children[i]);
+  }
+
+  Node_Delete(allocator, node);
+}
+
+/// Index of the child whose label starts with c, child_count when none
+static size_t Node_FindChild(struct atb_Radix_Node const *const node,
+                             char c) {
+  if (node->child_count == 0) return 0;
+
+  unsigned char const *const firsts = Node_Firsts(node);
+  unsigned char const *const found =
+      (unsigned char const *)memchr(firsts, (unsigned char)c,
+                                    node->child_count);
+
+  return (found == NULL) ? node->child_count : (size_t)(found - firsts);
+}
+
+/// Ensure node has room for one more child
+static bool Node_ReserveChild(struct atb_Allocator const *const allocator,
+                              struct atb_Radix_Node *const node,
+                              struct atb_Error *const err) {
+  if (node->child_count < node->child_capacity) return true;
+
+  size_t capacity = (size_t)node->child_capacity * 2;
+  if (capacity < K_RADIX_MIN_CHILDREN) capacity = K_RADIX_MIN_CHILDREN;
+  if (capacity > K_RADIX_MAX_CHILDREN) capacity = K_RADIX_MAX_CHILDREN;
+
+  struct atb_Radix_Node **const children =
+      (struct atb_Radix_Node **)atb_Allocator_Alloc(
+          allocator, NULL,
+          capacity * (sizeof(struct atb_Radix_Node *) + sizeof(char)), err);
+
+  if (children == NULL) return false;
+
+  if (node->children != NULL) {
+    memcpy(children, node->children,
+           node->child_count * sizeof(struct atb_Radix_Node *));
+    memcpy(children + capacity, Node_Firsts(node), node->child_count);
+
+    (void)atb_Allocator_Release(allocator, (void **)&(node->children),
+                                K_ATB_ERROR_IGNORED);
+  }
+
+  node->children = children;
+  node->child_capacity = (uint16_t)capacity;
+
+  return true;
+}
+
+/// Insert child (sorted by first byte), node having enough capacity
+static void Node_AddChild(struct atb_Radix_Node *const node,
+                          struct atb_Radix_Node *const child) {
+  assert(node->child_count < node->child_capacity);
+  assert(child->label_size > 0);
+
+  unsigned char *const firsts = Node_Firsts(node);
+  unsigned char const first = (unsigned char)child->label[0];
+  size_t i = 0;
+
+  while ((i < node->child_count) && (firsts[i] < first)) ++i;
+
+  memmove(&(node->children[i + 1]), &(node->children[i]),
+          (node->child_count - i) * sizeof(struct atb_Radix_Node *));
+  memmove(&(firsts[i + 1]), &(firsts[i]), node->child_count - i);
+
+  node->children[i] = child;
+  firsts[i] = first;
+  node->child_count = (uint16_t)(node->child_count + 1);
+}
+
+static void Node_RemoveChild(struct atb_Radix_Node *const node, size_t i) {
+  assert(i < node->child_count);
+
+  unsigned char *const firsts = Node_Firsts(node);
+
+  memmove(&(node->children[i]), &(node->children[i + 1]),
+          (node->child_count - i - 1) * sizeof(struct atb_Radix_Node *));
+  memmove(&(firsts[i]), &(firsts[i + 1]), node->child_count - i - 1);
+
+  node->child_count = (uint16_t)(node->child_count - 1);
+}
+
+/// Child of node whose label is a prefix of key[depth, key.size), NULL when
+/// none
+static struct atb_Radix_Node *Node_Descend(
+    struct atb_Radix_Node const *const node, struct atb_StrView key,
+    size_t depth) {
+  assert(depth < key.size);
+
+  size_t const i = Node_FindChild(node, key.data[depth]);
+  if (i == node->child_count) return NULL;
+
+  struct atb_Radix_Node *const child = node->children[i];
+
+  if ((child->label_size > (key.size - depth)) ||
+      (memcmp(child->label, &(key.data[depth]), child->label_size) != 0)) {
+    return NULL;
+  }
+
+  return child;
+}
+
+/// Replace parent->children[i] (no value, a single child) by the
+/// concatenation of it and its child. Failing to do so is not an error: the
+/// tree is only less compact.
+static void Radix_Merge(struct atb_Allocator const *const allocator,
+                        struct atb_Radix_Node *const parent, size_t i) {
+  struct atb_Radix_Node *const node = parent->children[i];
+
+  assert(!node->has_value);
+  assert(node->child_count == 1);
+
+  struct atb_Radix_Node *const child = node->children[0];
+
+  if (node->label_size > (SIZE_MAX - child->label_size)) return;
+
+  struct atb_Radix_Node *const merged =
+      Node_New(allocator, NULL, node->label_size + child->label_size,
+               K_ATB_ERROR_IGNORED);
+
+  if (merged == NULL) return;
+
+  memcpy(merged->label, node->label, node->label_size);
+  memcpy(merged->label + node->label_size, child->label, child->label_size);
+  merged->children = child->children;
+  merged->child_count = child->child_count;
+  merged->child_capacity = child->child_capacity;
+  merged->value = child->value;
+  merged->has_value = child->has_value;
+
+  child->children = NULL;
+  Node_Delete(allocator, child);
+  Node_Delete(allocator, node);
+
+  parent->children[i] = merged;
+}
+
+void atb_Radix_Init(struct atb_Radix *const self,
+                    struct atb_Allocator const *const allocator) {
+  assert(self != NULL);
+  assert(allocator != NULL);
+
+  self->root = NULL;
+  self->size = 0;
+  self->allocator = allocator;
+}
+
+void atb_Radix_Destroy(struct atb_Radix *const self) {
+  assert(self != NULL);
+
+  if (self->root != NULL) Node_DeleteAll(self->allocator, self->root);
+
+  self->root = NULL;
+  self->size = 0;
+}
+
+/// Add a leaf labelled \a label (holding value) to parent
+static bool Radix_AddLeaf(struct atb_Radix *const self,
+                          struct atb_Radix_Node *const parent,
+                          struct atb_StrView label, void *value,
+                          struct atb_Error *const err) {
+  struct atb_Radix_Node *const leaf =
+      Node_New(self->allocator, label.data, label.size, err);
+
+  if (leaf == NULL) return false;
+
+  if (!Node_ReserveChild(self->allocator, parent, err)) {
+    Node_Delete(self->allocator, leaf);
+    return false;
+  }
+
+  leaf->value = value;
+  leaf->has_value = true;
+  Node_AddChild(parent, leaf);
+  self->size += 1;
+
+  return true;
+}
+
+/// Split parent->children[i] after its common first bytes with rest, then
+/// insert rest (holding value) below the split
+static bool Radix_Split(struct atb_Radix *const self,
+                        struct atb_Radix_Node *const parent, size_t i,
+                        size_t common, struct atb_StrView rest, void *value,
+                        struct atb_Error *const err) {
+  struct atb_Radix_Node *const child = parent->children[i];
+
+  assert(common > 0);
+  assert(common < child->label_size);
+  assert(common <= rest.size);
+
+  /* Allocate everything first, such that the tree is unchanged on failure */
+  struct atb_Radix_Node *const mid =
+      Node_New(self->allocator, child->label, common, err);
+
+  if (mid == NULL) return false;
+
+  struct atb_Radix_Node *leaf = NULL;
+
+  if (!Node_ReserveChild(self->allocator, mid, err) ||
+      ((common < rest.size) &&
+       ((leaf = Node_New(self->allocator, rest.data + common,
+                         rest.size - common, err)) == NULL))) {
+    Node_Delete(self->allocator, mid);
+    return false;
+  }
+
+  memmove(child->label, child->label + common, child->label_size - common);
+  child->label_size -= common;
+  Node_AddChild(mid, child);
+  parent->children[i] = mid;
+
+  if (leaf != NULL) {
+    leaf->value = value;
+    leaf->has_value = true;
+    Node_AddChild(mid, leaf);
+  } else {
+    mid->value = value;
+    mid->has_value = true;
+  }
+
+  self->size += 1;
+
+  return true;
+}
+
+bool atb_Radix_Insert(struct atb_Radix *const self, struct atb_StrView key,
+                      void *value, struct atb_Error *const err) {
+  assert(self != NULL);
+  assert(atb_StrView_IsValid(key));
+
+  if (self->root == NULL) {
+    self->root = Node_New(self->allocator, NULL, 0, err);
+    if (self->root == NULL) return false;
+  }
+
+  struct atb_Radix_Node *node = self->root;
+  size_t depth = 0;
+
+  while (depth < key.size) {
+    struct atb_StrView rest;
+    rest.data = &(key.data[depth]);
+    rest.size = key.size - depth;
+
+    size_t const i = Node_FindChild(node, rest.data[0]);
+
+    if (i == node->child_count) {
+      return Radix_AddLeaf(self, node, rest, value, err);
+    }
+
+    struct atb_Radix_Node *const child = node->children[i];
+    size_t common = 1;
+
+    while ((common < child->label_size) && (common < rest.size) &&
+           (child->label[common] == rest.data[common])) {
+      ++common;
+    }
+
+    if (common < child->label_size) {
+      return Radix_Split(self, node, i, common, rest, value, err);
+    }
+
+    node = child;
+    depth += common;
+  }
+
+  if (!node->has_value) {
+    node->has_value = true;
+    self->size += 1;
+  }
+  node->value = value;
+
+  return true;
+}
+
+bool atb_Radix_Remove(struct atb_Radix *const self, struct atb_StrView key,
+                      void **value) {
+  assert(self != NULL);
+  assert(atb_StrView_IsValid(key));
+
+  /* Keep track of the 2 previous nodes, needed to re-compact the tree */
+  struct atb_Radix_Node *grand_parent = NULL;
+  struct atb_Radix_Node *parent = NULL;
+  struct atb_Radix_Node *node = self->root;
+  size_t depth = 0;
+
+  while ((node != NULL) && (depth < key.size)) {
+    grand_parent = parent;
+    parent = node;
+    node = Node_Descend(node, key, depth);
+    if (node != NULL) depth += node->label_size;
+  }
+
+  if ((node == NULL) || !node->has_value) return false;
+
+  if (value != NULL) *value = node->value;
+
+  node->has_value = false;
+  node->value = NULL;
+  self->size -= 1;
+
+  if (parent == NULL) return true; /* Root */
+
+  size_t const i = Node_FindChild(parent, node->label[0]);
+
+  if (node->child_count == 0) {
+    Node_RemoveChild(parent, i);
+    Node_Delete(self->allocator, node);
+
+    if ((grand_parent != NULL) && !parent->has_value &&
+        (parent->child_count == 1)) {
+      Radix_Merge(self->allocator, grand_parent,
+                  Node_FindChild(grand_parent, parent->label[0]));
+    }
+  } else if (node->child_count == 1) {
+    Radix_Merge(self->allocator, parent, i);
+  }
+
+  return true;
+}
+
+bool atb_Radix_Find(struct atb_Radix const *const self, struct atb_StrView key,
+                    void **value) {
+  assert(self != NULL);
+  assert(atb_StrView_IsValid(key));
+
+  struct atb_Radix_Node const *node = self->root;
+  size_t depth = 0;
+
+  while ((node != NULL) && (depth < key.size)) {
+    node = Node_Descend(node, key, depth);
+    if (node != NULL) depth += node->label_size;
+  }
+
+  if ((node == NULL) || !node->has_value) return false;
+
+  if (value != NULL) *value = node->value;
+
+  return true;
+}
+
+bool atb_Radix_LongestPrefix(struct atb_Radix const *const self,
+                             struct atb_StrView key, size_t *length,
+                             void **value) {
+  assert(self != NULL);
+  assert(atb_StrView_IsValid(key));
+
+  struct atb_Radix_Node const *node = self->root;
+  struct atb_Radix_Node const *longest = NULL;
+  size_t longest_size = 0;
+  size_t depth = 0;
+
+  while (node != NULL) {
+    if (node->has_value) {
+      longest = node;
+      longest_size = depth;
+    }
+
+    if (depth == key.size) break;
+
+    node = Node_Descend(node, key, depth);
+    if (node != NULL) depth += node->label_size;
+  }
+
+  if (longest == NULL) return false;
+
+  if (length != NULL) *length = longest_size;
+  if (value != NULL) *value = longest->value;
+
+  return true;
+}
+
+bool atb_Radix_AllPrefixes(struct atb_Radix const *const self,
+                           struct atb_StrView key,
+                           struct atb_Radix_Visit visit) {
+  assert(self != NULL);
+  assert(atb_StrView_IsValid(key));
+  assert(ATB_CALLABLE_IS_VALID(visit));
+
+  struct atb_Radix_Node const *node = self->root;
+  size_t depth = 0;
+
+  while (node != NULL) {
+    if (node->has_value) {
+      struct atb_StrView prefix;
+      prefix.data = key.data;
+      prefix.size = depth;
+
+      if (!ATB_INVOKE_UNSAFELY(visit, prefix, node->value)) return false;
+    }
+
+    if (depth == key.size) break;
+
+    node = Node_Descend(node, key, depth);
+    if (node != NULL) depth += node->label_size;
+  }
+
+  return true;
+}
@@ -0,0 +1,1290 @@
+#include "atb/roaring.h"
+
+#include <stdint.h> /* SIZE_MAX */
+#include <string.h>
+
+#include "atb/bits.h"
+#include "atb/bitset.h"
+
+/// Number of values covered by a container
+#define K_ROARING_CHUNK_SIZE 65536
+
+/// Maximum number of runs of a container (every other value set)
+#define K_ROARING_MAX_RUNS (K_ROARING_CHUNK_SIZE / 2)
+
+/// Number of containers allocated on the first insertion
+static const size_t K_ROARING_MIN_CONTAINERS = 4;
+
+/// Number of elements allocated by a container on its first insertion
+static const size_t K_ROARING_MIN_ELEMENTS = 4;
+
+/// Size of an element of data, indexed by enum atb_Roaring_Kind
+static const size_t K_ROARING_ELEMENT_SIZE[] = {
+    sizeof(uint16_t),
+    sizeof(uint64_t),
+    sizeof(struct atb_Roaring_Run),
+};
+
+/// Serialized header
+struct Roaring_Header {
+  uint32_t magic;
+  uint32_t count;
+};
+
+/// Serialized container descriptor
+struct Roaring_Descriptor {
+  uint16_t key;
+  uint16_t kind;
+  uint32_t size;
+  uint32_t cardinality;
+  uint32_t offset;
+};
+
+static uint16_t Roaring_High(uint32_t value) {
+  return (uint16_t)(value >> 16);
+}
+
+static uint16_t Roaring_Low(uint32_t value) {
+  return (uint16_t)(value & 0xFFFF);
+}
+
+static size_t Roaring_Align8(size_t size) { return (size + 7) & ~(size_t)7; }
+
+/***************************************************************************/
+/*                                Container                                */
+/***************************************************************************/
+
+static struct atb_Roaring_Container Container_Empty(uint16_t key,
+                                                    uint8_t kind) {
+  struct atb_Roaring_Container c;
+  c.data = NULL;
+  c.size = 0;
+  c.capacity = 0;
+  c.cardinality = 0;
+  c.key = key;
+  c.kind = kind;
+  return c;
+}
+
+static struct atb_Bitset Container_Bitset(
+    struct atb_Roaring_Container const *const c) {
+  assert(c->kind == K_ATB_ROARING_BITMAP);
+
+  struct atb_Span_u64 words;
+  words.data = (uint64_t *)c->data;
+  words.size = K_ATB_ROARING_BITMAP_WORDS;
+
+  return atb_Bitset_From(words, K_ROARING_CHUNK_SIZE);
+}
+
+static void Container_Release(struct atb_Allocator const *const allocator,
+                              struct atb_Roaring_Container *const c) {
+  if (c->capacity != 0) {
+    (void)atb_Allocator_Release(allocator, &(c->data), K_ATB_ERROR_IGNORED);
+  }
+
+  c->data = NULL;
+  c->size = 0;
+  c->capacity = 0;
+}
+
+/// Ensure c owns its data (copying borrowed data) and has room for at least
+/// count elements
+static bool Container_Reserve(struct atb_Allocator const *const allocator,
+                              struct atb_Roaring_Container *const c,
+                              size_t count, struct atb_Error *const err) {
+  if ((c->capacity != 0) && (c->capacity >= count)) return true;
+  if (count < c->size) count = c->size;
+
+  size_t const element_size = K_ROARING_ELEMENT_SIZE[c->kind];
+  void *const orig = (c->capacity == 0) ? NULL : c->data;
+  void *const data =
+      atb_Allocator_Alloc(allocator, orig, count * element_size, err);
+
+  if (data == NULL) return false;
+
+  if ((orig == NULL) && (c->size != 0)) {
+    memcpy(data, c->data, c->size * element_size);
+  }
+
+  c->data = data;
+  c->capacity = (uint32_t)count;
+
+  return true;
+}
+
+/// Same as Container_Reserve, growing geometrically up to max elements
+static bool Container_Grow(struct atb_Allocator const *const allocator,
+                           struct atb_Roaring_Container *const c,
+                           size_t needed, size_t max,
+                           struct atb_Error *const err) {
+  if (c->capacity >= needed) return true;
+
+  size_t count = (size_t)c->capacity * 2;
+  if (count < K_ROARING_MIN_ELEMENTS) count = K_ROARING_MIN_ELEMENTS;
+  if (count > max) count = max;
+  if (count < needed) count = needed;
+
+  return Container_Reserve(allocator, c, count, err);
+}
+
+/// Index of the first value >= low
+static size_t Array_LowerBound(uint16_t const *const values, size_t size,
+                               uint16_t low) {
+  size_t first = 0;
+
+  while (size > 0) {
+    size_t const half = size / 2;
+
+    if (values[first + half] < low) {
+      first += half + 1;
+      size -= half + 1;
+    } else {
+      size = half;
+    }
+  }
+
+  return first;
+}
+
+/// Index of the first run ending at or after low
+static size_t Run_LowerBound(struct atb_Roaring_Run const *const runs,
+                             size_t size, uint16_t low) {
+  size_t first = 0;
+
+  while (size > 0) {
+    size_t const half = size / 2;
+
+    if (runs[first + half].last < low) {
+      first += half + 1;
+      size -= half + 1;
+    } else {
+      size = half;
+    }
+  }
+
+  return first;
+}
+
+static bool Container_Contains(struct atb_Roaring_Container const *const c,
+                               uint16_t low) {
+  switch (c->kind) {
+    case K_ATB_ROARING_ARRAY: {
+      uint16_t const *const values = (uint16_t const *)c->data;
+      size_t const i = Array_LowerBound(values, c->size, low);
+      return (i < c->size) && (values[i] == low);
+    }
+    case K_ATB_ROARING_BITMAP:
+      return atb_Bitset_Test(Container_Bitset(c), low);
+    default: {
+      struct atb_Roaring_Run const *const runs =
+          (struct atb_Roaring_Run const *)c->data;
+      size_t const i = Run_LowerBound(runs, c->size, low);
+      return (i < c->size) && (runs[i].start <= low);
+    }
+  }
+}
+
+/// Invoked on each value of a container, returns false to stop
+typedef bool (*Container_Visit)(void *ctx, uint16_t low);
+
+static bool Container_ForEach(struct atb_Roaring_Container const *const c,
+                              Container_Visit visit, void *ctx) {
+  switch (c->kind) {
+    case K_ATB_ROARING_ARRAY: {
+      uint16_t const *const values = (uint16_t const *)c->data;
+      for (size_t i = 0; i < c->size; ++i) {
+        if (!visit(ctx, values[i])) return false;
+      }
+      break;
+    }
+    case K_ATB_ROARING_BITMAP: {
+      uint64_t const *const words = (uint64_t const *)c->data;
+      for (size_t w = 0; w < K_ATB_ROARING_BITMAP_WORDS; ++w) {
+        for (uint64_t word = words[w]; word != 0; word &= (word - 1)) {
+          size_t const bit = (w * 64) + atb_Bits_Ctz_u64(word);
+          if (!visit(ctx, (uint16_t)bit)) return false;
+        }
+      }
+      break;
+    }
+    default: {
+      struct atb_Roaring_Run const *const runs =
+          (struct atb_Roaring_Run const *)c->data;
+      for (size_t i = 0; i < c->size; ++i) {
+        for (uint32_t v = runs[i].start; v <= runs[i].last; ++v) {
+          if (!visit(ctx, (uint16_t)v)) return false;
+        }
+      }
+      break;
+    }
+  }
+
+  return true;
+}
+
+static size_t Container_CountRuns(struct atb_Roaring_Container const *const c) {
+  switch (c->kind) {
+    case K_ATB_ROARING_ARRAY: {
+      uint16_t const *const values = (uint16_t const *)c->data;
+      size_t runs = (c->size == 0) ? 0 : 1;
+      for (size_t i = 1; i < c->size; ++i) {
+        runs += (values[i] != (values[i - 1] + 1)) ? 1 : 0;
+      }
+      return runs;
+    }
+    case K_ATB_ROARING_BITMAP: {
+      /* A run starts at each bit set whose predecessor is not */
+      uint64_t const *const words = (uint64_t const *)c->data;
+      uint64_t carry = 0;
+      size_t runs = 0;
+      for (size_t w = 0; w < K_ATB_ROARING_BITMAP_WORDS; ++w) {
+        runs += atb_Bits_Popcount_u64(words[w] & ~((words[w] << 1) | carry));
+        carry = words[w] >> 63;
+      }
+      return runs;
+    }
+    default:
+      return c->size;
+  }
+}
+
+/// Append low (greater than all values of c) to c, which has enough capacity
+static bool Container_Append(void *ctx, uint16_t low) {
+  struct atb_Roaring_Container *const c = (struct atb_Roaring_Container *)ctx;
+
+  switch (c->kind) {
+    case K_ATB_ROARING_ARRAY:
+      assert(c->size < c->capacity);
+      ((uint16_t *)c->data)[c->size++] = low;
+      break;
+    case K_ATB_ROARING_BITMAP:
+      atb_Bitset_Set(Container_Bitset(c), low);
+      break;
+    default: {
+      struct atb_Roaring_Run *const runs = (struct atb_Roaring_Run *)c->data;
+      if ((c->size > 0) && ((runs[c->size - 1].last + 1) == low)) {
+        runs[c->size - 1].last = low;
+      } else {
+        assert(c->size < c->capacity);
+        runs[c->size].start = low;
+        runs[c->size].last = low;
+        c->size += 1;
+      }
+      break;
+    }
+  }
+
+  c->cardinality += 1;
+  return true;
+}
+
+/// Allocate an EMPTY container able to hold count elements
+static bool Container_Make(struct atb_Allocator const *const allocator,
+                           uint16_t key, uint8_t kind, size_t count,
+                           struct atb_Roaring_Container *const out,
+                           struct atb_Error *const err) {
+  *out = Container_Empty(key, kind);
+
+  if (!Container_Reserve(allocator, out, count, err)) return false;
+
+  if (kind == K_ATB_ROARING_BITMAP) {
+    memset(out->data, 0, K_ATB_ROARING_BITMAP_WORDS * sizeof(uint64_t));
+    out->size = K_ATB_ROARING_BITMAP_WORDS;
+  }
+
+  return true;
+}
+
+/// Convert c to another representation (c is unchanged on failure)
+static bool Container_Convert(struct atb_Allocator const *const allocator,
+                              struct atb_Roaring_Container *const c,
+                              uint8_t kind, struct atb_Error *const err) {
+  assert(c->kind != kind);
+
+  size_t count = K_ATB_ROARING_BITMAP_WORDS;
+  if (kind == K_ATB_ROARING_ARRAY) count = c->cardinality;
+  if (kind == K_ATB_ROARING_RUN) count = Container_CountRuns(c);
+
+  struct atb_Roaring_Container out;
+  if (!Container_Make(allocator, c->key, kind, count, &out, err)) {
+    return false;
+  }
+
+  if ((c->kind == K_ATB_ROARING_RUN) && (kind == K_ATB_ROARING_BITMAP)) {
+    struct atb_Roaring_Run const *const runs =
+        (struct atb_Roaring_Run const *)c->data;
+
+    for (size_t i = 0; i < c->size; ++i) {
+      atb_Bitset_SetRange(Container_Bitset(&out), runs[i].start,
+                          (size_t)(runs[i].last - runs[i].start) + 1);
+    }
+    out.cardinality = c->cardinality;
+  } else {
+    (void)Container_ForEach(c, Container_Append, &out);
+  }
+
+  assert(out.cardinality == c->cardinality);
+
+  Container_Release(allocator, c);
+  *c = out;
+
+  return true;
+}
+
+/// Convert a BITMAP container to an ARRAY one when small enough. Failing to do
+/// so is not an error: the representation is only an optimization.
+static void Container_Shrink(struct atb_Allocator const *const allocator,
+                             struct atb_Roaring_Container *const c) {
+  if ((c->kind == K_ATB_ROARING_BITMAP) && (c->cardinality > 0) &&
+      (c->cardinality <= K_ATB_ROARING_ARRAY_MAX_SIZE)) {
+    (void)Container_Convert(allocator, c, K_ATB_ROARING_ARRAY,
+                            K_ATB_ERROR_IGNORED);
+  }
+}
+
+static bool Container_Add(struct atb_Allocator const *const allocator,
+                          struct atb_Roaring_Container *const c, uint16_t low,
+                          struct atb_Error *const err) {
+  if (Container_Contains(c, low)) return true;
+
+  switch (c->kind) {
+    case K_ATB_ROARING_ARRAY: {
+      if (c->size == K_ATB_ROARING_ARRAY_MAX_SIZE) {
+        if (!Container_Convert(allocator, c, K_ATB_ROARING_BITMAP, err)) {
+          return false;
+        }
+        return Container_Add(allocator, c, low, err);
+      }
+
+      if (!Container_Grow(allocator, c, (size_t)c->size + 1,
+                          K_ATB_ROARING_ARRAY_MAX_SIZE, err)) {
+        return false;
+      }
+
+      uint16_t *const values = (uint16_t *)c->data;
+      size_t const i = Array_LowerBound(values, c->size, low);
+      memmove(&(values[i + 1]), &(values[i]),
+              (c->size - i) * sizeof(uint16_t));
+      values[i] = low;
+      c->size += 1;
+      break;
+    }
+    case K_ATB_ROARING_BITMAP:
+      if (!Container_Reserve(allocator, c, c->size, err)) return false;
+      atb_Bitset_Set(Container_Bitset(c), low);
+      break;
+    default: {
+      size_t const i = Run_LowerBound((struct atb_Roaring_Run *)c->data,
+                                      c->size, low);
+      struct atb_Roaring_Run const *const runs =
+          (struct atb_Roaring_Run const *)c->data;
+      bool const prev = (i > 0) && ((runs[i - 1].last + 1) == low);
+      bool const next = (i < c->size) && (runs[i].start == (low + 1));
+      bool const insert = !prev && !next;
+
+      if (insert ? !Container_Grow(allocator, c, (size_t)c->size + 1,
+                                   K_ROARING_MAX_RUNS, err)
+                 : !Container_Reserve(allocator, c, c->size, err)) {
+        return false;
+      }
+
+      struct atb_Roaring_Run *const owned = (struct atb_Roaring_Run *)c->data;
+
+      if (prev && next) {
+        owned[i - 1].last = owned[i].last;
+        memmove(&(owned[i]), &(owned[i + 1]),
+                (c->size - i - 1) * sizeof(struct atb_Roaring_Run));
+        c->size -= 1;
+      } else if (prev) {
+        owned[i - 1].last = low;
+      } else if (next) {
+        owned[i].start = low;
+      } else {
+        memmove(&(owned[i + 1]), &(owned[i]),
+                (c->size - i) * sizeof(struct atb_Roaring_Run));
+        owned[i].start = low;
+        owned[i].last = low;
+        c->size += 1;
+      }
+      break;
+    }
+  }
+
+  c->cardinality += 1;
+  return true;
+}
+
+static bool Container_Remove(struct atb_Allocator const *const allocator,
+                             struct atb_Roaring_Container *const c,
+                             uint16_t low, struct atb_Error *const err) {
+  if (!Container_Contains(c, low)) return true;
+
+  switch (c->kind) {
+    case K_ATB_ROARING_ARRAY: {
+      if (!Container_Reserve(allocator, c, c->size, err)) return false;
+
+      uint16_t *const values = (uint16_t *)c->data;
+      size_t const i = Array_LowerBound(values, c->size, low);
+      memmove(&(values[i]), &(values[i + 1]),
+              (c->size - i - 1) * sizeof(uint16_t));
+      c->size -= 1;
+      break;
+    }
+    case K_ATB_ROARING_BITMAP:
+      if (!Container_Reserve(allocator, c, c->size, err)) return false;
+      atb_Bitset_Clear(Container_Bitset(c), low);
+      break;
+    default: {
+      size_t const i = Run_LowerBound((struct atb_Roaring_Run *)c->data,
+                                      c->size, low);
+      struct atb_Roaring_Run const run = ((struct atb_Roaring_Run *)c->data)[i];
+      bool const split = (run.start < low) && (low < run.last);
+
+      if (split ? !Container_Grow(allocator, c, (size_t)c->size + 1,
+                                  K_ROARING_MAX_RUNS, err)
+                : !Container_Reserve(allocator, c, c->size, err)) {
+        return false;
+      }
+
+      struct atb_Roaring_Run *const runs = (struct atb_Roaring_Run *)c->data;
+
+      if (split) {
+        memmove(&(runs[i + 1]), &(runs[i]),
+                (c->size - i) * sizeof(struct atb_Roaring_Run));
+        runs[i].last = (uint16_t)(low - 1);
+        runs[i + 1].start = (uint16_t)(low + 1);
+        c->size += 1;
+      } else if (run.start == run.last) {
+        memmove(&(runs[i]), &(runs[i + 1]),
+                (c->size - i - 1) * sizeof(struct atb_Roaring_Run));
+        c->size -= 1;
+      } else if (run.start == low) {
+        runs[i].start = (uint16_t)(low + 1);
+      } else {
+        runs[i].last = (uint16_t)(low - 1);
+      }
+      break;
+    }
+  }
+
+  c->cardinality -= 1;
+  Container_Shrink(allocator, c);
+  return true;
+}
+
+/// Add the values of c to a 65536 bits bitset
+static void Container_OrInto(struct atb_Roaring_Container const *const c,
+                             struct atb_Bitset dest) {
+  switch (c->kind) {
+    case K_ATB_ROARING_ARRAY: {
+      uint16_t const *const values = (uint16_t const *)c->data;
+      for (size_t i = 0; i < c->size; ++i) atb_Bitset_Set(dest, values[i]);
+      break;
+    }
+    case K_ATB_ROARING_BITMAP:
+      atb_Bitset_Or(dest, dest, Container_Bitset(c));
+      break;
+    default: {
+      struct atb_Roaring_Run const *const runs =
+          (struct atb_Roaring_Run const *)c->data;
+      for (size_t i = 0; i < c->size; ++i) {
+        atb_Bitset_SetRange(dest, runs[i].start,
+                            (size_t)(runs[i].last - runs[i].start) + 1);
+      }
+      break;
+    }
+  }
+}
+
+/// Keep only the values of a 65536 bits bitset that are part of c (c being a
+/// BITMAP or RUN container)
+static void Container_AndInto(struct atb_Roaring_Container const *const c,
+                              struct atb_Bitset dest) {
+  if (c->kind == K_ATB_ROARING_BITMAP) {
+    atb_Bitset_And(dest, dest, Container_Bitset(c));
+    return;
+  }
+
+  assert(c->kind == K_ATB_ROARING_RUN);
+
+  struct atb_Roaring_Run const *const runs =
+      (struct atb_Roaring_Run const *)c->data;
+  size_t gap = 0;
+
+  for (size_t i = 0; i < c->size; ++i) {
+    atb_Bitset_ClearRange(dest, gap, runs[i].start - gap);
+    gap = (size_t)runs[i].last + 1;
+  }
+
+  atb_Bitset_ClearRange(dest, gap, K_ROARING_CHUNK_SIZE - gap);
+}
+
+static bool Container_Union(struct atb_Allocator const *const allocator,
+                            struct atb_Roaring_Container const *const lhs,
+                            struct atb_Roaring_Container const *const rhs,
+                            struct atb_Roaring_Container *const out,
+                            struct atb_Error *const err) {
+  if ((lhs->kind == K_ATB_ROARING_ARRAY) &&
+      (rhs->kind == K_ATB_ROARING_ARRAY)) {
+    if (!Container_Make(allocator, lhs->key, K_ATB_ROARING_ARRAY,
+                        (size_t)lhs->size + rhs->size, out, err)) {
+      return false;
+    }
+
+    uint16_t const *const l = (uint16_t const *)lhs->data;
+    uint16_t const *const r = (uint16_t const *)rhs->data;
+    uint16_t *const values = (uint16_t *)out->data;
+    size_t i = 0;
+    size_t j = 0;
+    size_t n = 0;
+
+    while ((i < lhs->size) && (j < rhs->size)) {
+      uint16_t const value = (l[i] <= r[j]) ? l[i] : r[j];
+      i += (l[i] == value) ? 1 : 0;
+      j += (r[j] == value) ? 1 : 0;
+      values[n++] = value;
+    }
+    while (i < lhs->size) values[n++] = l[i++];
+    while (j < rhs->size) values[n++] = r[j++];
+
+    out->size = (uint32_t)n;
+    out->cardinality = (uint32_t)n;
+
+    if ((n > K_ATB_ROARING_ARRAY_MAX_SIZE) &&
+        !Container_Convert(allocator, out, K_ATB_ROARING_BITMAP, err)) {
+      Container_Release(allocator, out);
+      return false;
+    }
+
+    return true;
+  }
+
+  if (!Container_Make(allocator, lhs->key, K_ATB_ROARING_BITMAP,
+                      K_ATB_ROARING_BITMAP_WORDS, out, err)) {
+    return false;
+  }
+
+  struct atb_Bitset const bitset = Container_Bitset(out);
+  Container_OrInto(lhs, bitset);
+  Container_OrInto(rhs, bitset);
+  out->cardinality = (uint32_t)atb_Bitset_Count(bitset);
+
+  Container_Shrink(allocator, out);
+  return true;
+}
+
+static bool Container_Intersection(
+    struct atb_Allocator const *const allocator,
+    struct atb_Roaring_Container const *lhs,
+    struct atb_Roaring_Container const *rhs,
+    struct atb_Roaring_Container *const out, struct atb_Error *const err) {
+  if (rhs->kind == K_ATB_ROARING_ARRAY) {
+    struct atb_Roaring_Container const *const tmp = lhs;
+    lhs = rhs;
+    rhs = tmp;
+  }
+
+  if (lhs->kind == K_ATB_ROARING_ARRAY) {
+    if (!Container_Make(allocator, lhs->key, K_ATB_ROARING_ARRAY, lhs->size,
+                        out, err)) {
+      return false;
+    }
+
+    uint16_t const *const values = (uint16_t const *)lhs->data;
+    for (size_t i = 0; i < lhs->size; ++i) {
+      if (Container_Contains(rhs, values[i])) {
+        (void)Container_Append(out, values[i]);
+      }
+    }
+
+    return true;
+  }
+
+  if (!Container_Make(allocator, lhs->key, K_ATB_ROARING_BITMAP,
+                      K_ATB_ROARING_BITMAP_WORDS, out, err)) {
+    return false;
+  }
+
+  struct atb_Bitset const bitset = Container_Bitset(out);
+  Container_OrInto(lhs, bitset);
+  Container_AndInto(rhs, bitset);
+  out->cardinality = (uint32_t)atb_Bitset_Count(bitset);
+
+  Container_Shrink(allocator, out);
+  return true;
+}
+
+static size_t Container_IntersectionCardinality(
+    struct atb_Roaring_Container const *lhs,
+    struct atb_Roaring_Container const *rhs) {
+  if ((rhs->kind == K_ATB_ROARING_ARRAY) ||
+      ((rhs->kind == K_ATB_ROARING_BITMAP) &&
+       (lhs->kind == K_ATB_ROARING_RUN))) {
+    struct atb_Roaring_Container const *const tmp = lhs;
+    lhs = rhs;
+    rhs = tmp;
+  }
+
+  size_t count = 0;
+
+  if (lhs->kind == K_ATB_ROARING_ARRAY) {
+    uint16_t const *const values = (uint16_t const *)lhs->data;
+    for (size_t i = 0; i < lhs->size; ++i) {
+      count += Container_Contains(rhs, values[i]) ? 1 : 0;
+    }
+  } else if (lhs->kind == K_ATB_ROARING_BITMAP) {
+    if (rhs->kind == K_ATB_ROARING_BITMAP) {
+      uint64_t const *const l = (uint64_t const *)lhs->data;
+      uint64_t const *const r = (uint64_t const *)rhs->data;
+      for (size_t w = 0; w < K_ATB_ROARING_BITMAP_WORDS; ++w) {
+        count += atb_Bits_Popcount_u64(l[w] & r[w]);
+      }
+    } else {
+      struct atb_Roaring_Run const *const runs =
+          (struct atb_Roaring_Run const *)rhs->data;
+      for (size_t i = 0; i < rhs->size; ++i) {
+        count += atb_Bitset_CountRange(
+            Container_Bitset(lhs), runs[i].start,
+            (size_t)(runs[i].last - runs[i].start) + 1);
+      }
+    }
+  } else {
+    struct atb_Roaring_Run const *const l =
+        (struct atb_Roaring_Run const *)lhs->data;
+    struct atb_Roaring_Run const *const r =
+        (struct atb_Roaring_Run const *)rhs->data;
+    size_t i = 0;
+    size_t j = 0;
+
+    while ((i < lhs->size) && (j < rhs->size)) {
+      uint16_t const start =
+          (l[i].start > r[j].start) ? l[i].start : r[j].start;
+      uint16_t const last = (l[i].last < r[j].last) ? l[i].last : r[j].last;
+
+      if (start <= last) count += (size_t)(last - start) + 1;
+
+      if (l[i].last < r[j].last) {
+        ++i;
+      } else {
+        ++j;
+      }
+    }
+  }
+
+  return count;
+}
+
+/***************************************************************************/
+/*                                 Roaring                                 */
+/***************************************************************************/
+
+/// Index of the first container whose key is >= key
+static size_t Roaring_LowerBound(struct atb_Roaring const *const self,
+                                 uint16_t key) {
+  size_t first = 0;
+  size_t size = self->size;
+
+  while (size > 0) {
+    size_t const half = size / 2;
+
+    if (self->containers[first + half].key < key) {
+      first += half + 1;
+      size -= half + 1;
+    } else {
+      size = half;
+    }
+  }
+
+  return first;
+}
+
+static struct atb_Roaring_Container const *Roaring_Find(
+    struct atb_Roaring const *const self, uint16_t key) {
+  size_t const i = Roaring_LowerBound(self, key);
+
+  return ((i < self->size) && (self->containers[i].key == key))
+             ? &(self->containers[i])
+             : NULL;
+}
+
+static bool Roaring_Reserve(struct atb_Roaring *const self, size_t needed,
+                            struct atb_Error *const err) {
+  if (self->capacity >= needed) return true;
+
+  size_t capacity = (self->capacity == 0) ? K_ROARING_MIN_CONTAINERS
+                                          : (self->capacity * 2);
+  if (capacity < needed) capacity = needed;
+
+  if (capacity > (SIZE_MAX / sizeof(struct atb_Roaring_Container))) {
+    atb_GenericError_Set(err, K_ATB_ERROR_GENERIC_VALUE_TOO_LARGE);
+    return false;
+  }
+
+  struct atb_Roaring_Container *const containers =
+      (struct atb_Roaring_Container *)atb_Allocator_Alloc(
+          self->allocator, self->containers,
+          capacity * sizeof(struct atb_Roaring_Container), err);
+
+  if (containers == NULL) return false;
+
+  self->containers = containers;
+  self->capacity = capacity;
+
+  return true;
+}
+
+/// Insert an EMPTY container at index i
+static bool Roaring_Insert(struct atb_Roaring *const self, size_t i,
+                           uint16_t key, uint8_t kind,
+                           struct atb_Error *const err) {
+  if (!Roaring_Reserve(self, self->size + 1, err)) return false;
+
+  memmove(&(self->containers[i + 1]), &(self->containers[i]),
+          (self->size - i) * sizeof(struct atb_Roaring_Container));
+  self->containers[i] = Container_Empty(key, kind);
+  self->size += 1;
+
+  return true;
+}
+
+static void Roaring_Erase(struct atb_Roaring *const self, size_t i) {
+  Container_Release(self->allocator, &(self->containers[i]));
+
+  memmove(&(self->containers[i]), &(self->containers[i + 1]),
+          (self->size - i - 1) * sizeof(struct atb_Roaring_Container));
+  self->size -= 1;
+}
+
+/// Append c (taking ownership of it) to self
+static bool Roaring_Push(struct atb_Roaring *const self,
+                         struct atb_Roaring_Container *const c,
+                         struct atb_Error *const err) {
+  assert((self->size == 0) || (self->containers[self->size - 1].key < c->key));
+
+  if (c->cardinality == 0) {
+    Container_Release(self->allocator, c);
+    return true;
+  }
+
+  if (!Roaring_Reserve(self, self->size + 1, err)) {
+    Container_Release(self->allocator, c);
+    return false;
+  }
+
+  self->containers[self->size] = *c;
+  self->size += 1;
+
+  return true;
+}
+
+/// Append a copy of c to self
+static bool Roaring_PushCopy(struct atb_Roaring *const self,
+                             struct atb_Roaring_Container const *const c,
+                             struct atb_Error *const err) {
+  struct atb_Roaring_Container copy = *c;
+  copy.capacity = 0;
+
+  if (!Container_Reserve(self->allocator, &copy, copy.size, err)) {
+    return false;
+  }
+
+  return Roaring_Push(self, &copy, err);
+}
+
+void atb_Roaring_Init(struct atb_Roaring *const self,
+                      struct atb_Allocator const *const allocator) {
+  assert(self != NULL);
+  assert(allocator != NULL);
+
+  self->containers = NULL;
+  self->size = 0;
+  self->capacity = 0;
+  self->allocator = allocator;
+}
+
+void atb_Roaring_Destroy(struct atb_Roaring *const self) {
+  assert(self != NULL);
+
+  for (size_t i = 0; i < self->size; ++i) {
+    Container_Release(self->allocator, &(self->containers[i]));
+  }
+
+  if (self->containers != NULL) {
+    (void)atb_Allocator_Release(self->allocator, (void **)&(self->containers),
+                                K_ATB_ERROR_IGNORED);
+  }
+
+  self->containers = NULL;
+  self->size = 0;
+  self->capacity = 0;
+}
+
+uint64_t atb_Roaring_Cardinality(struct atb_Roaring const *const self) {
+  assert(self != NULL);
+
+  uint64_t cardinality = 0;
+
+  for (size_t i = 0; i < self->size; ++i) {
+    cardinality += self->containers[i].cardinality;
+  }
+
+  return cardinality;
+}
+
+bool atb_Roaring_Contains(struct atb_Roaring const *const self,
+                          uint32_t value) {
+  assert(self != NULL);
+
+  struct atb_Roaring_Container const *const c =
+      Roaring_Find(self, Roaring_High(value));
+
+  return (c != NULL) && Container_Contains(c, Roaring_Low(value));
+}
+
+/// Context of Roaring_Visit
+struct Roaring_VisitCtx {
+  uint32_t high;
+  struct atb_Roaring_Visit visit;
+};
+
+static bool Roaring_Visit(void *ctx, uint16_t low) {
+  struct Roaring_VisitCtx const *const visit_ctx =
+      (struct Roaring_VisitCtx const *)ctx;
+
+  return ATB_INVOKE_UNSAFELY(visit_ctx->visit, visit_ctx->high | low);
+}
+
+bool atb_Roaring_ForEach(struct atb_Roaring const *const self,
+                         struct atb_Roaring_Visit visit) {
+  assert(self != NULL);
+  assert(ATB_CALLABLE_IS_VALID(visit));
+
+  struct Roaring_VisitCtx ctx;
+  ctx.visit = visit;
+
+  for (size_t i = 0; i < self->size; ++i) {
+    ctx.high = (uint32_t)self->containers[i].key << 16;
+
+    if (!Container_ForEach(&(self->containers[i]), Roaring_Visit, &ctx)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool atb_Roaring_Add(struct atb_Roaring *const self, uint32_t value,
+                     struct atb_Error *const err) {
+  assert(self != NULL);
+
+  uint16_t const key = Roaring_High(value);
+  size_t const i = Roaring_LowerBound(self, key);
+
+  if (((i == self->size) || (self->containers[i].key != key)) &&
+      !Roaring_Insert(self, i, key, K_ATB_ROARING_ARRAY, err)) {
+    return false;
+  }
+
+  if (!Container_Add(self->allocator, &(self->containers[i]),
+                     Roaring_Low(value), err)) {
+    if (self->containers[i].cardinality == 0) Roaring_Erase(self, i);
+    return false;
+  }
+
+  return true;
+}
+
+/// Add [first, last] to the container associated to key
+static bool Roaring_AddChunkRange(struct atb_Roaring *const self,
+                                  uint16_t key, uint16_t first, uint16_t last,
+                                  struct atb_Error *const err) {
+  size_t const i = Roaring_LowerBound(self, key);
+  bool const exists = (i < self->size) && (self->containers[i].key == key);
+  bool const full = (first == 0) && (last == (K_ROARING_CHUNK_SIZE - 1));
+
+  if (!exists || full) {
+    /* Fresh container: a single run */
+    struct atb_Roaring_Container run;
+    if (!Container_Make(self->allocator, key, K_ATB_ROARING_RUN, 1, &run,
+                        err)) {
+      return false;
+    }
+
+    if (!exists && !Roaring_Insert(self, i, key, K_ATB_ROARING_RUN, err)) {
+      Container_Release(self->allocator, &run);
+      return false;
+    }
+
+    struct atb_Roaring_Run *const runs = (struct atb_Roaring_Run *)run.data;
+    runs[0].start = first;
+    runs[0].last = last;
+    run.size = 1;
+    run.cardinality = (uint32_t)(last - first) + 1;
+
+    Container_Release(self->allocator, &(self->containers[i]));
+    self->containers[i] = run;
+
+    return true;
+  }
+
+  struct atb_Roaring_Container *const c = &(self->containers[i]);
+
+  if (c->kind != K_ATB_ROARING_BITMAP) {
+    if (!Container_Convert(self->allocator, c, K_ATB_ROARING_BITMAP, err)) {
+      return false;
+    }
+  } else if (!Container_Reserve(self->allocator, c, c->size, err)) {
+    return false;
+  }
+
+  struct atb_Bitset const bitset = Container_Bitset(c);
+  atb_Bitset_SetRange(bitset, first, (size_t)(last - first) + 1);
+  c->cardinality = (uint32_t)atb_Bitset_Count(bitset);
+
+  Container_Shrink(self->allocator, c);
+  return true;
+}
+
+bool atb_Roaring_AddRange(struct atb_Roaring *const self, uint32_t first,
+                          uint32_t last, struct atb_Error *const err) {
+  assert(self != NULL);
+  assert(first <= last);
+
+  uint16_t const first_key = Roaring_High(first);
+  uint16_t const last_key = Roaring_High(last);
+
+  for (uint32_t key = first_key; key <= last_key; ++key) {
+    uint16_t const lo = (key == first_key) ? Roaring_Low(first) : 0;
+    uint16_t const hi = (key == last_key) ? Roaring_Low(last) : UINT16_MAX;
+
+    if (!Roaring_AddChunkRange(self, (uint16_t)key, lo, hi, err)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool atb_Roaring_Remove(struct atb_Roaring *const self, uint32_t value,
+                        struct atb_Error *const err) {
+  assert(self != NULL);
+
+  uint16_t const key = Roaring_High(value);
+  size_t const i = Roaring_LowerBound(self, key);
+
+  if ((i == self->size) || (self->containers[i].key != key)) return true;
+
+  if (!Container_Remove(self->allocator, &(self->containers[i]),
+                        Roaring_Low(value), err)) {
+    return false;
+  }
+
+  if (self->containers[i].cardinality == 0) Roaring_Erase(self, i);
+
+  return true;
+}
+
+bool atb_Roaring_Optimize(struct atb_Roaring *const self,
+                          struct atb_Error *const err) {
+  assert(self != NULL);
+
+  for (size_t i = 0; i < self->size; ++i) {
+    struct atb_Roaring_Container *const c = &(self->containers[i]);
+
+    size_t const run_bytes =
+        Container_CountRuns(c) * sizeof(struct atb_Roaring_Run);
+    size_t const array_bytes =
+        (c->cardinality <= K_ATB_ROARING_ARRAY_MAX_SIZE)
+            ? (c->cardinality * sizeof(uint16_t))
+            : SIZE_MAX;
+    size_t const bitmap_bytes = K_ATB_ROARING_BITMAP_WORDS * sizeof(uint64_t);
+
+    uint8_t kind = (array_bytes <= bitmap_bytes) ? K_ATB_ROARING_ARRAY
+                                                 : K_ATB_ROARING_BITMAP;
+    if (run_bytes < ((array_bytes < bitmap_bytes) ? array_bytes
+                                                  : bitmap_bytes)) {
+      kind = K_ATB_ROARING_RUN;
+    }
+
+    if ((kind != c->kind) &&
+        !Container_Convert(self->allocator, c, kind, err)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool atb_Roaring_Union(struct atb_Roaring *const dest,
+                       struct atb_Roaring const *const lhs,
+                       struct atb_Roaring const *const rhs,
+                       struct atb_Error *const err) {
+  assert(dest != NULL);
+  assert(lhs != NULL);
+  assert(rhs != NULL);
+  assert((dest != lhs) && (dest != rhs));
+
+  atb_Roaring_Destroy(dest);
+
+  size_t i = 0;
+  size_t j = 0;
+  bool success = true;
+
+  while (success && ((i < lhs->size) || (j < rhs->size))) {
+    struct atb_Roaring_Container const *const l =
+        (i < lhs->size) ? &(lhs->containers[i]) : NULL;
+    struct atb_Roaring_Container const *const r =
+        (j < rhs->size) ? &(rhs->containers[j]) : NULL;
+
+    if ((r == NULL) || ((l != NULL) && (l->key < r->key))) {
+      success = Roaring_PushCopy(dest, l, err);
+      ++i;
+    } else if ((l == NULL) || (r->key < l->key)) {
+      success = Roaring_PushCopy(dest, r, err);
+      ++j;
+    } else {
+      struct atb_Roaring_Container c;
+      success = Container_Union(dest->allocator, l, r, &c, err) &&
+                Roaring_Push(dest, &c, err);
+      ++i;
+      ++j;
+    }
+  }
+
+  if (!success) atb_Roaring_Destroy(dest);
+
+  return success;
+}
+
+bool atb_Roaring_Intersection(struct atb_Roaring *const dest,
+                              struct atb_Roaring const *const lhs,
+                              struct atb_Roaring const *const rhs,
+                              struct atb_Error *const err) {
+  assert(dest != NULL);
+  assert(lhs != NULL);
+  assert(rhs != NULL);
+  assert((dest != lhs) && (dest != rhs));
+
+  atb_Roaring_Destroy(dest);
+
+  size_t i = 0;
+  size_t j = 0;
+  bool success = true;
+
+  while (success && (i < lhs->size) && (j < rhs->size)) {
+    struct atb_Roaring_Container const *const l = &(lhs->containers[i]);
+    struct atb_Roaring_Container const *const r = &(rhs->containers[j]);
+
+    if (l->key < r->key) {
+      ++i;
+    } else if (r->key < l->key) {
+      ++j;
+    } else {
+      struct atb_Roaring_Container c;
+      success = Container_Intersection(dest->allocator, l, r, &c, err) &&
+                Roaring_Push(dest, &c, err);
+      ++i;
+      ++j;
+    }
+  }
+
+  if (!success) atb_Roaring_Destroy(dest);
+
+  return success;
+}
+
+uint64_t atb_Roaring_IntersectionCardinality(
+    struct atb_Roaring const *const lhs, struct atb_Roaring const *const rhs) {
+  assert(lhs != NULL);
+  assert(rhs != NULL);
+
+  uint64_t cardinality = 0;
+  size_t i = 0;
+  size_t j = 0;
+
+  while ((i < lhs->size) && (j < rhs->size)) {
+    struct atb_Roaring_Container const *const l = &(lhs->containers[i]);
+    struct atb_Roaring_Container const *const r = &(rhs->containers[j]);
+
+    if (l->key < r->key) {
+      ++i;
+    } else if (r->key < l->key) {
+      ++j;
+    } else {
+      cardinality += Container_IntersectionCardinality(l, r);
+      ++i;
+      ++j;
+    }
+  }
+
+  return cardinality;
+}
+
+/***************************************************************************/
+/*                              Serialization                              */
+/***************************************************************************/
+
+static size_t Roaring_DescriptorsEnd(size_t count) {
+  return Roaring_Align8(sizeof(struct Roaring_Header) +
+                        (count * sizeof(struct Roaring_Descriptor)));
+}
+
+size_t atb_Roaring_SerializedSize(struct atb_Roaring const *const self) {
+  assert(self != NULL);
+
+  size_t size = Roaring_DescriptorsEnd(self->size);
+
+  for (size_t i = 0; i < self->size; ++i) {
+    struct atb_Roaring_Container const *const c = &(self->containers[i]);
+    size += Roaring_Align8(c->size * K_ROARING_ELEMENT_SIZE[c->kind]);
+  }
+
+  return size;
+}
+
+bool atb_Roaring_Serialize(struct atb_Roaring const *const self,
+                           struct atb_Span_u8 buffer,
+                           struct atb_Error *const err) {
+  assert(self != NULL);
+  assert(atb_Span_u8_IsValid(buffer));
+  assert(((uintptr_t)buffer.data % 8) == 0);
+
+  size_t const size = atb_Roaring_SerializedSize(self);
+
+  if ((buffer.size < size) || (size > UINT32_MAX)) {
+    atb_GenericError_Set(err, K_ATB_ERROR_GENERIC_NO_BUFFER_SPACE);
+    return false;
+  }
+
+  memset(buffer.data, 0, size);
+
+  struct Roaring_Header header;
+  header.magic = K_ATB_ROARING_MAGIC;
+  header.count = (uint32_t)self->size;
+  memcpy(buffer.data, &header, sizeof(header));
+
+  size_t offset = Roaring_DescriptorsEnd(self->size);
+
+  for (size_t i = 0; i < self->size; ++i) {
+    struct atb_Roaring_Container const *const c = &(self->containers[i]);
+    size_t const bytes = c->size * K_ROARING_ELEMENT_SIZE[c->kind];
+
+    struct Roaring_Descriptor descriptor;
+    descriptor.key = c->key;
+    descriptor.kind = c->kind;
+    descriptor.size = c->size;
+    descriptor.cardinality = c->cardinality;
+    descriptor.offset = (uint32_t)offset;
+
+    memcpy(buffer.data + sizeof(header) + (i * sizeof(descriptor)),
+           &descriptor, sizeof(descriptor));
+    memcpy(buffer.data + offset, c->data, bytes);
+
+    offset += Roaring_Align8(bytes);
+  }
+
+  return true;
+}
+
+/// Validate the content of a container, such that no operation can read or
+/// write out of its bounds
+static bool Container_IsValid(struct atb_Roaring_Container const *const c) {
+  switch (c->kind) {
+    case K_ATB_ROARING_ARRAY: {
+      uint16_t const *const values = (uint16_t const *)c->data;
+      if (c->size > K_ATB_ROARING_ARRAY_MAX_SIZE) return false;
+      if (c->size != c->cardinality) return false;
+      for (size_t i = 1; i < c->size; ++i) {
+        if (values[i - 1] >= values[i]) return false;
+      }
+      return true;
+    }
+    case K_ATB_ROARING_BITMAP:
+      return (c->size == K_ATB_ROARING_BITMAP_WORDS) &&
+             (atb_Bitset_Count(Container_Bitset(c)) == c->cardinality);
+    default: {
+      struct atb_Roaring_Run const *const runs =
+          (struct atb_Roaring_Run const *)c->data;
+      size_t cardinality = 0;
+      for (size_t i = 0; i < c->size; ++i) {
+        if (runs[i].start > runs[i].last) return false;
+        if ((i > 0) && ((runs[i - 1].last + 1) >= runs[i].start)) {
+          return false;
+        }
+        cardinality += (size_t)(runs[i].last - runs[i].start) + 1;
+      }
+      return cardinality == c->cardinality;
+    }
+  }
+}
+
+/// Reference the containers described by bytes from self (EMPTY with enough
+/// capacity), returns false when they are invalid
+static bool Roaring_ViewContainers(struct atb_Roaring *const self,
+                                   struct atb_View_u8 bytes, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    struct Roaring_Descriptor descriptor;
+    memcpy(&descriptor,
+           bytes.data + sizeof(struct Roaring_Header) +
+               (i * sizeof(descriptor)),
+           sizeof(descriptor));
+
+    if ((descriptor.kind > K_ATB_ROARING_RUN) || (descriptor.size == 0) ||
+        (descriptor.size > K_ROARING_CHUNK_SIZE) ||
+        (descriptor.cardinality == 0) ||
+        (descriptor.cardinality > K_ROARING_CHUNK_SIZE) ||
+        ((descriptor.offset % 8) != 0) || (descriptor.offset > bytes.size) ||
+        (((bytes.size - descriptor.offset) /
+          K_ROARING_ELEMENT_SIZE[descriptor.kind]) < descriptor.size) ||
+        ((i > 0) && (self->containers[i - 1].key >= descriptor.key))) {
+      return false;
+    }
+
+    struct atb_Roaring_Container *const c = &(self->containers[i]);
+    *c = Container_Empty(descriptor.key, (uint8_t)descriptor.kind);
+    c->data = (void *)(uintptr_t)(bytes.data + descriptor.offset);
+    c->size = descriptor.size;
+    c->cardinality = descriptor.cardinality;
+    self->size += 1;
+
+    if (!Container_IsValid(c)) return false;
+  }
+
+  return true;
+}
+
+bool atb_Roaring_View(struct atb_Roaring *const self,
+                      struct atb_Allocator const *const allocator,
+                      struct atb_View_u8 bytes, struct atb_Error *const err) {
+  assert(self != NULL);
+  assert(allocator != NULL);
+  assert(atb_View_u8_IsValid(bytes));
+
+  atb_Roaring_Init(self, allocator);
+
+  struct Roaring_Header header;
+  bool valid =
+      (((uintptr_t)bytes.data % 8) == 0) && (bytes.size >= sizeof(header));
+
+  if (valid) {
+    memcpy(&header, bytes.data, sizeof(header));
+
+    valid = (header.magic == K_ATB_ROARING_MAGIC) &&
+            (header.count <= K_ROARING_CHUNK_SIZE) &&
+            (bytes.size >= Roaring_DescriptorsEnd(header.count));
+  }
+
+  if (valid) {
+    if (!Roaring_Reserve(self, header.count, err)) return false;
+
+    valid = Roaring_ViewContainers(self, bytes, header.count);
+  }
+
+  if (!valid) {
+    atb_Roaring_Destroy(self);
+    atb_GenericError_Set(err, K_ATB_ERROR_GENERIC_BAD_MESSAGE);
+  }
+
+  return valid;
+}
@@ -0,0 +1,410 @@
+#include "atb/rope.h"
+
+#include <assert.h>
+#include <string.h>
+
+#include "atb/hash.h"
+
+struct atb_Rope_Node {
+  struct atb_Rope_Node *left;       /*!< Chunks before this one */
+  struct atb_Rope_Node *right;      /*!< Chunks after this one */
+  size_t size;                      /*!< Number of chars of the subtree */
+  uint32_t priority;                /*!< Max-heap ordered (treap) */
+  uint16_t length;                  /*!< Number of chars of the chunk */
+  char data[K_ATB_ROPE_CHUNK_SIZE]; /*!< Chars of the chunk */
+};
+
+/***************************************************************************/
+/*                                  Node                                   */
+/***************************************************************************/
+
+static size_t Node_Size(struct atb_Rope_Node const *const node) {
+  return (node == NULL) ? 0 : node->size;
+}
+
+static void Node_Update(struct atb_Rope_Node *const node) {
+  node->size = Node_Size(node->left) + node->length + Node_Size(node->right);
+}
+
+/// Chunk holding the char at offset (NULL when past the end), setting begin
+/// to the position of that char inside the chunk
+static struct atb_Rope_Node *Node_Find(struct atb_Rope_Node *node,
+                                       size_t offset, size_t *const begin) {
+  while (node != NULL) {
+    size_t const left = Node_Size(node->left);
+
+    if (offset < left) {
+      node = node->left;
+    } else if ((offset - left) < node->length) {
+      *begin = offset - left;
+      return node;
+    } else {
+      offset -= left + node->length;
+      node = node->right;
+    }
+  }
+
+  return NULL;
+}
+
+/// Update the size of all nodes on the path to the char at offset, which
+/// chunk has added (then removed) chars
+static void Node_Resize(struct atb_Rope_Node *node, size_t offset,
+                        size_t added, size_t removed) {
+  while (node != NULL) {
+    size_t const left = Node_Size(node->left);
+    node->size = node->size + added - removed;
+
+    if (offset < left) {
+      node = node->left;
+    } else if ((offset - left) < node->length) {
+      return;
+    } else {
+      offset -= left + node->length;
+      node = node->right;
+    }
+  }
+}
+
+static struct atb_Rope_Node *Node_New(struct atb_Rope *const self,
+                                      char const *const data, size_t length,
+                                      struct atb_Error *const err) {
+  assert((0 < length) && (length <= K_ATB_ROPE_CHUNK_SIZE));
+
+  struct atb_Rope_Node *const node =
+      (struct atb_Rope_Node *)atb_Allocator_Alloc(
+          self->allocator, NULL, sizeof(struct atb_Rope_Node), err);
+
+  if (node == NULL) return NULL;
+
+  node->left = NULL;
+  node->right = NULL;
+  node->size = length;
+  node->priority = (uint32_t)(atb_Hash_u64(self->priorities++) >> 32);
+  node->length = (uint16_t)length;
+  memcpy(node->data, data, length);
+
+  return node;
+}
+
+/// Release all nodes of the tree, without recursion (rotating left childs)
+static void Node_Destroy(struct atb_Rope *const self,
+                         struct atb_Rope_Node *node) {
+  while (node != NULL) {
+    struct atb_Rope_Node *next = node->left;
+
+    if (next != NULL) {
+      node->left = next->right;
+      next->right = node;
+    } else {
+      next = node->right;
+      (void)atb_Allocator_Release(self->allocator, (void **)&node,
+                                  K_ATB_ERROR_IGNORED);
+    }
+
+    node = next;
+  }
+}
+
+/// Tree holding the chunks of left followed by the ones of right
+static struct atb_Rope_Node *Node_Merge(struct atb_Rope_Node *const left,
+                                        struct atb_Rope_Node *const right) {
+  if (left == NULL) return right;
+  if (right == NULL) return left;
+
+  if (left->priority >= right->priority) {
+    left->right = Node_Merge(left->right, right);
+    Node_Update(left);
+    return left;
+  }
+
+  right->left = Node_Merge(left, right->left);
+  Node_Update(right);
+  return right;
+}
+
+/// Split the tree at a chunk boundary (no allocation): left holds the chunks
+/// starting before offset (such that the last one might hold offset)
+static void Node_SplitChunks(struct atb_Rope_Node *const node, size_t offset,
+                             struct atb_Rope_Node **const left,
+                             struct atb_Rope_Node **const right) {
+  if (node == NULL) {
+    *left = NULL;
+    *right = NULL;
+    return;
+  }
+
+  size_t const before = Node_Size(node->left);
+  struct atb_Rope_Node *l = NULL;
+  struct atb_Rope_Node *r = NULL;
+
+  if (offset <= before) {
+    Node_SplitChunks(node->left, offset, &l, &r);
+
+    node->left = r;
+    Node_Update(node);
+    *left = l;
+    *right = node;
+  } else {
+    size_t const after = offset - before;
+    Node_SplitChunks(node->right,
+                     (after > node->length) ? (after - node->length) : 0, &l,
+                     &r);
+
+    node->right = l;
+    Node_Update(node);
+    *left = node;
+    *right = r;
+  }
+}
+
+/// Split the tree such that left holds the first offset chars. At most one
+/// chunk (the one holding offset) is split in two, requiring an allocation:
+/// the tree is untouched when it fails.
+static bool Node_Split(struct atb_Rope *const self,
+                       struct atb_Rope_Node *const node, size_t offset,
+                       struct atb_Rope_Node **const left,
+                       struct atb_Rope_Node **const right,
+                       struct atb_Error *const err) {
+  size_t begin = 0;
+  struct atb_Rope_Node *const chunk = Node_Find(node, offset, &begin);
+  struct atb_Rope_Node *tail = NULL;
+
+  if ((chunk != NULL) && (begin > 0)) {
+    tail = Node_New(self, chunk->data + begin, chunk->length - begin, err);
+    if (tail == NULL) return false;
+  }
+
+  Node_SplitChunks(node, offset, left, right);
+
+  if (tail != NULL) {
+    // chunk is the last one of left, its end moves to the front of right
+    Node_Resize(*left, Node_Size(*left) - 1, 0, tail->length);
+    chunk->length = (uint16_t)begin;
+
+    // Merged at the top level, keeping the heap order of the priorities
+    *right = Node_Merge(tail, *right);
+  }
+
+  return true;
+}
+
+/// Tree holding a copy of str (split in chunks)
+static bool Node_Build(struct atb_Rope *const self, struct atb_StrView str,
+                       struct atb_Rope_Node **const out,
+                       struct atb_Error *const err) {
+  struct atb_Rope_Node *tree = NULL;
+
+  for (size_t i = 0; i < str.size; i += K_ATB_ROPE_CHUNK_SIZE) {
+    size_t const remaining = str.size - i;
+    struct atb_Rope_Node *const node = Node_New(
+        self, str.data + i,
+        (remaining < K_ATB_ROPE_CHUNK_SIZE) ? remaining : K_ATB_ROPE_CHUNK_SIZE,
+        err);
+
+    if (node == NULL) {
+      Node_Destroy(self, tree);
+      return false;
+    }
+
+    tree = Node_Merge(tree, node);
+  }
+
+  *out = tree;
+  return true;
+}
+
+/// Insert str inside an existing chunk when it fits (no allocation)
+static bool Rope_InsertInPlace(struct atb_Rope *const self, size_t offset,
+                               struct atb_StrView str) {
+  size_t begin = 0;
+  size_t target = offset;
+  struct atb_Rope_Node *node = Node_Find(self->root, target, &begin);
+
+  if (((node == NULL) || (begin == 0)) && (offset > 0)) {
+    // Append to the previous chunk instead
+    size_t prev_begin = 0;
+    struct atb_Rope_Node *const prev =
+        Node_Find(self->root, offset - 1, &prev_begin);
+
+    if ((node == NULL) ||
+        ((prev->length + str.size) <= K_ATB_ROPE_CHUNK_SIZE)) {
+      node = prev;
+      begin = prev_begin + 1;
+      target = offset - 1;
+    }
+  }
+
+  if ((node == NULL) || ((node->length + str.size) > K_ATB_ROPE_CHUNK_SIZE)) {
+    return false;
+  }
+
+  // Resized first: the path is found using the current chunk length
+  Node_Resize(self->root, target, str.size, 0);
+  memmove(node->data + begin + str.size, node->data + begin,
+          node->length - begin);
+  memcpy(node->data + begin, str.data, str.size);
+  node->length = (uint16_t)(node->length + str.size);
+
+  return true;
+}
+
+/// Erase chars from a single chunk when it isn't emptied (no allocation)
+static bool Rope_EraseInPlace(struct atb_Rope *const self, size_t offset,
+                              size_t count) {
+  size_t begin = 0;
+  struct atb_Rope_Node *const node = Node_Find(self->root, offset, &begin);
+
+  if ((count >= node->length) || (count > (node->length - begin))) {
+    return false;
+  }
+
+  Node_Resize(self->root, offset, 0, count);
+  memmove(node->data + begin, node->data + begin + count,
+          node->length - begin - count);
+  node->length = (uint16_t)(node->length - count);
+
+  return true;
+}
+
+/***************************************************************************/
+/*                                  Rope                                   */
+/***************************************************************************/
+
+void atb_Rope_Init(struct atb_Rope *const self,
+                   struct atb_Allocator const *const allocator) {
+  assert(self != NULL);
+  assert(allocator != NULL);
+
+  self->root = NULL;
+  self->priorities = K_ATB_HASH_SEED;
+  self->allocator = allocator;
+}
+
+void atb_Rope_Destroy(struct atb_Rope *const self) {
+  assert(self != NULL);
+
+  Node_Destroy(self, self->root);
+  self->root = NULL;
+}
+
+size_t atb_Rope_Size(struct atb_Rope const *const self) {
+  assert(self != NULL);
+  return Node_Size(self->root);
+}
+
+struct atb_Rope_Iterator atb_Rope_Begin(struct atb_Rope const *const self) {
+  return atb_Rope_At(self, 0);
+}
+
+struct atb_Rope_Iterator atb_Rope_At(struct atb_Rope const *const self,
+                                     size_t offset) {
+  assert(self != NULL);
+  assert(offset <= atb_Rope_Size(self));
+
+  struct atb_Rope_Iterator it;
+  it.rope = self;
+  it.begin = 0;
+  it.offset = offset;
+  it.node = Node_Find(self->root, offset, &(it.begin));
+
+  return it;
+}
+
+bool atb_Rope_Iterator_IsEnd(struct atb_Rope_Iterator it) {
+  return it.node == NULL;
+}
+
+struct atb_Rope_Iterator atb_Rope_Iterator_Next(struct atb_Rope_Iterator it) {
+  assert(!atb_Rope_Iterator_IsEnd(it));
+  return atb_Rope_At(it.rope, it.offset + it.node->length - it.begin);
+}
+
+struct atb_StrView atb_Rope_Iterator_Chunk(struct atb_Rope_Iterator it) {
+  assert(!atb_Rope_Iterator_IsEnd(it));
+
+  struct atb_StrView chunk;
+  chunk.data = it.node->data + it.begin;
+  chunk.size = it.node->length - it.begin;
+  return chunk;
+}
+
+bool atb_Rope_Insert(struct atb_Rope *const self, size_t offset,
+                     struct atb_StrView str, struct atb_Error *const err) {
+  assert(self != NULL);
+  assert(offset <= atb_Rope_Size(self));
+  assert((str.size == 0) || (str.data != NULL));
+
+  if (str.size == 0) return true;
+  if (Rope_InsertInPlace(self, offset, str)) return true;
+
+  struct atb_Rope_Node *middle = NULL;
+  struct atb_Rope_Node *left = NULL;
+  struct atb_Rope_Node *right = NULL;
+
+  if (!Node_Build(self, str, &middle, err)) return false;
+
+  if (!Node_Split(self, self->root, offset, &left, &right, err)) {
+    Node_Destroy(self, middle);
+    return false;
+  }
+
+  self->root = Node_Merge(Node_Merge(left, middle), right);
+  return true;
+}
+
+bool atb_Rope_Erase(struct atb_Rope *const self, size_t offset, size_t count,
+                    struct atb_Error *const err) {
+  assert(self != NULL);
+  assert(offset <= atb_Rope_Size(self));
+  assert(count <= (atb_Rope_Size(self) - offset));
+
+  if (count == 0) return true;
+  if (Rope_EraseInPlace(self, offset, count)) return true;
+
+  struct atb_Rope_Node *left = NULL;
+  struct atb_Rope_Node *right = NULL;
+  struct atb_Rope_Node *middle = NULL;
+
+  if (!Node_Split(self, self->root, offset, &left, &right, err)) return false;
+
+  if (!Node_Split(self, right, count, &middle, &right, err)) {
+    self->root = Node_Merge(left, right);
+    return false;
+  }
+
+  Node_Destroy(self, middle);
+  self->root = Node_Merge(left, right);
+
+  return true;
+}
+
+bool atb_Rope_Split(struct atb_Rope *const self, size_t offset,
+                    struct atb_Rope *const tail, struct atb_Error *const err) {
+  assert(self != NULL);
+  assert(tail != NULL);
+  assert(offset <= atb_Rope_Size(self));
+
+  atb_Rope_Init(tail, self->allocator);
+  tail->priorities = atb_Hash_u64(self->priorities);
+
+  struct atb_Rope_Node *left = NULL;
+  struct atb_Rope_Node *right = NULL;
+
+  if (!Node_Split(self, self->root, offset, &left, &right, err)) return false;
+
+  self->root = left;
+  tail->root = right;
+
+  return true;
+}
+
+void atb_Rope_Concat(struct atb_Rope *const self,
+                     struct atb_Rope *const other) {
+  assert(self != NULL);
+  assert(other != NULL);
+  assert(self->allocator == other->allocator);
+
+  self->root = Node_Merge(self->root, other->root);
+  other->root = NULL;
+}
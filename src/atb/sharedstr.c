@@ -0,0 +1,114 @@
+#include "atb/sharedstr.h"
+
+#include <stdatomic.h>
+#include <stdint.h> /* SIZE_MAX */
+#include <string.h>
+
+struct atb_SharedStr_Block {
+  atomic_size_t refcount;                /*!< Number of slices referencing it */
+  struct atb_Allocator const *allocator; /*!< Used to release the block */
+  char data[];                           /*!< Immutable chars */
+};
+
+static struct atb_SharedStr SharedStr_Empty(void) {
+  struct atb_SharedStr empty;
+  empty.block = NULL;
+  empty.data = NULL;
+  empty.size = 0;
+  return empty;
+}
+
+/// New slice of self, adding a reference to its block
+static struct atb_SharedStr SharedStr_Ref(
+    struct atb_SharedStr const *const self, char const *data, size_t size) {
+  struct atb_SharedStr slice;
+  slice.block = self->block;
+  slice.data = data;
+  slice.size = size;
+
+  if (slice.block != NULL) {
+    // New references are always created from an existing one: no ordering
+    // needed, the block can't be released concurrently
+    atomic_fetch_add_explicit(&(slice.block->refcount), 1,
+                              memory_order_relaxed);
+  }
+
+  return slice;
+}
+
+bool atb_SharedStr_From(struct atb_SharedStr *const self,
+                        struct atb_StrView str,
+                        struct atb_Allocator const *const allocator,
+                        struct atb_Error *const err) {
+  assert(self != NULL);
+  assert(allocator != NULL);
+  assert((str.size == 0) || (str.data != NULL));
+
+  *self = SharedStr_Empty();
+  if (str.size == 0) return true;
+
+  if (str.size > (SIZE_MAX - sizeof(struct atb_SharedStr_Block))) {
+    atb_GenericError_Set(err, K_ATB_ERROR_GENERIC_VALUE_TOO_LARGE);
+    return false;
+  }
+
+  struct atb_SharedStr_Block *const block =
+      (struct atb_SharedStr_Block *)atb_Allocator_Alloc(
+          allocator, NULL, sizeof(struct atb_SharedStr_Block) + str.size, err);
+
+  if (block == NULL) return false;
+
+  atomic_init(&(block->refcount), 1);
+  block->allocator = allocator;
+  memcpy(block->data, str.data, str.size);
+
+  self->block = block;
+  self->data = block->data;
+  self->size = str.size;
+
+  return true;
+}
+
+void atb_SharedStr_Release(struct atb_SharedStr *const self) {
+  assert(self != NULL);
+
+  struct atb_SharedStr_Block *block = self->block;
+  *self = SharedStr_Empty();
+
+  if (block == NULL) return;
+
+  // Release: our reads of the chars happen before the block is freed
+  if (atomic_fetch_sub_explicit(&(block->refcount), 1, memory_order_release) ==
+      1) {
+    // Acquire: the reads done through the other slices as well
+    atomic_thread_fence(memory_order_acquire);
+    (void)atb_Allocator_Release(block->allocator, (void **)&block,
+                                K_ATB_ERROR_IGNORED);
+  }
+}
+
+struct atb_SharedStr atb_SharedStr_Share(
+    struct atb_SharedStr const *const self) {
+  assert(self != NULL);
+  return SharedStr_Ref(self, self->data, self->size);
+}
+
+struct atb_SharedStr atb_SharedStr_Slice(struct atb_SharedStr const *const self,
+                                         size_t offset, size_t size) {
+  assert(self != NULL);
+  assert(offset <= self->size);
+  assert(size <= (self->size - offset));
+
+  if (self->data == NULL) return SharedStr_Empty();
+
+  return SharedStr_Ref(self, self->data + offset, size);
+}
+
+size_t atb_SharedStr_UseCount(struct atb_SharedStr const *const self) {
+  assert(self != NULL);
+
+  return (self->block == NULL)
+             ? 0
+             : atomic_load_explicit(&(self->block->refcount),
+                                    memory_order_relaxed);
+}
@@ -1,5 +1,13 @@
 #include "atb/span/ints.h"
 
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "atb/bits.h"
+
 #define _ATB_DEFINE_INT_SPANS(T, NAME, ...) \
   ATB_SPAN_VIEW_DEFINE(, atb_Span_##NAME, atb_View_##NAME, T);
 
@@ -310,3 +318,1445 @@ struct atb_View_u64 atb_View_u64_From_u32(struct atb_View_u32 other) {
   view.size = other.size / 2;
   return view;
 }
+
+/// Index of the first byte differing between lhs and rhs (size when none)
+static size_t Bytes_Mismatch(uint8_t const *const lhs,
+                             uint8_t const *const rhs, size_t size) {
+  size_t i = 0;
+
+#if defined(__SSE2__)
+  for (; (i + 16) <= size; i += 16) {
+    __m128i const l = _mm_loadu_si128((__m128i const *)(lhs + i));
+    __m128i const r = _mm_loadu_si128((__m128i const *)(rhs + i));
+    unsigned const equal = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(l, r));
+
+    if (equal != 0xFFFF) {
+      return i + atb_Bits_Ctz_u64((uint64_t)(~equal & 0xFFFF));
+    }
+  }
+#endif
+
+  for (; (i + 8) <= size; i += 8) {
+    uint64_t l = 0;
+    uint64_t r = 0;
+    memcpy(&l, lhs + i, sizeof(l));
+    memcpy(&r, rhs + i, sizeof(r));
+
+    if (l != r) break;
+  }
+
+  while ((i < size) && (lhs[i] == rhs[i])) ++i;
+  return i;
+}
+
+#define _ATB_DEFINE_INT_COMPARE(T, NAME, ...)                             \
+  size_t atb_View_##NAME##_Mismatch(struct atb_View_##NAME lhs,           \
+                                    struct atb_View_##NAME rhs) {         \
+    assert(atb_View_##NAME##_IsValid(lhs));                               \
+    assert(atb_View_##NAME##_IsValid(rhs));                               \
+                                                                          \
+    size_t const size = (lhs.size < rhs.size) ? lhs.size : rhs.size;      \
+    return Bytes_Mismatch((uint8_t const *)lhs.data,                      \
+                          (uint8_t const *)rhs.data, size * sizeof(T)) /  \
+           sizeof(T);                                                     \
+  }                                                                       \
+                                                                          \
+  atb_Cmp_t atb_View_##NAME##_CompareValues(struct atb_View_##NAME lhs,   \
+                                            struct atb_View_##NAME rhs) { \
+    size_t const i = atb_View_##NAME##_Mismatch(lhs, rhs);                \
+                                                                          \
+    if ((i < lhs.size) && (i < rhs.size)) {                               \
+      return (lhs.data[i] < rhs.data[i]) ? K_ATB_CMP_LESS                 \
+                                         : K_ATB_CMP_GREATER;             \
+    }                                                                     \
+                                                                          \
+    if (lhs.size == rhs.size) return K_ATB_CMP_EQUAL;                     \
+    return (lhs.size < rhs.size) ? K_ATB_CMP_LESS : K_ATB_CMP_GREATER;    \
+  }
+
+ATB_INTS_X_FOREACH(_ATB_DEFINE_INT_COMPARE)
+
+#undef _ATB_DEFINE_INT_COMPARE
+
+#if defined(__SSE2__)
+
+/// Needle comparing 16 bytes of elements at once
+static __m128i Search_Set1_8(uint8_t value) {
+  return _mm_set1_epi8((char)value);
+}
+static __m128i Search_Set1_16(uint16_t value) {
+  return _mm_set1_epi16((short)value);
+}
+static __m128i Search_Set1_32(uint32_t value) {
+  return _mm_set1_epi32((int)value);
+}
+static __m128i Search_Set1_64(uint64_t value) {
+  return _mm_set1_epi64x((long long)value);
+}
+
+/// Byte mask (1 bit per byte) of the elements (16 bytes) equal to the needle
+static unsigned Search_Match_8(void const *const data, __m128i needle) {
+  __m128i const block = _mm_loadu_si128((__m128i const *)data);
+  return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+}
+static unsigned Search_Match_16(void const *const data, __m128i needle) {
+  __m128i const block = _mm_loadu_si128((__m128i const *)data);
+  return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi16(block, needle));
+}
+static unsigned Search_Match_32(void const *const data, __m128i needle) {
+  __m128i const block = _mm_loadu_si128((__m128i const *)data);
+  return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi32(block, needle));
+}
+static unsigned Search_Match_64(void const *const data, __m128i needle) {
+  // No 64 bits compare with SSE2: both 32 bits halves must be equal
+  __m128i const block = _mm_loadu_si128((__m128i const *)data);
+  __m128i const equal = _mm_cmpeq_epi32(block, needle);
+  return (unsigned)_mm_movemask_epi8(_mm_and_si128(
+      equal, _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1))));
+}
+
+#define _ATB_DEFINE_SEARCH_KERNELS(SIZE)                                   \
+  /* Index of the first element equal to value (size when none) */         \
+  static size_t Search_Find_##SIZE(uint##SIZE##_t const *const data,       \
+                                   size_t size, uint##SIZE##_t value) {    \
+    size_t const lanes = 16 / (SIZE / 8);                                  \
+    __m128i const needle = Search_Set1_##SIZE(value);                      \
+    size_t i = 0;                                                          \
+                                                                           \
+    for (; (i + lanes) <= size; i += lanes) {                              \
+      unsigned const mask = Search_Match_##SIZE(data + i, needle);         \
+      if (mask != 0) return i + (atb_Bits_Ctz_u64(mask) / (SIZE / 8));     \
+    }                                                                      \
+                                                                           \
+    for (; i < size; ++i) {                                                \
+      if (data[i] == value) return i;                                      \
+    }                                                                      \
+                                                                           \
+    return size;                                                           \
+  }                                                                        \
+                                                                           \
+  /* Index of the last element equal to value (size when none) */          \
+  static size_t Search_RFind_##SIZE(uint##SIZE##_t const *const data,      \
+                                    size_t size, uint##SIZE##_t value) {   \
+    size_t const lanes = 16 / (SIZE / 8);                                  \
+    __m128i const needle = Search_Set1_##SIZE(value);                      \
+    size_t i = size;                                                       \
+                                                                           \
+    for (; i >= lanes; i -= lanes) {                                       \
+      unsigned const mask = Search_Match_##SIZE(data + i - lanes, needle); \
+      if (mask != 0) {                                                     \
+        return i - lanes + ((63 - atb_Bits_Clz_u64(mask)) / (SIZE / 8));   \
+      }                                                                    \
+    }                                                                      \
+                                                                           \
+    while (i > 0) {                                                        \
+      if (data[--i] == value) return i;                                    \
+    }                                                                      \
+                                                                           \
+    return size;                                                           \
+  }                                                                        \
+                                                                           \
+  /* Number of elements equal to value */                                  \
+  static size_t Search_Count_##SIZE(uint##SIZE##_t const *const data,      \
+                                    size_t size, uint##SIZE##_t value) {   \
+    size_t const lanes = 16 / (SIZE / 8);                                  \
+    __m128i const needle = Search_Set1_##SIZE(value);                      \
+    size_t count = 0;                                                      \
+    size_t i = 0;                                                          \
+                                                                           \
+    for (; (i + lanes) <= size; i += lanes) {                              \
+      unsigned const mask = Search_Match_##SIZE(data + i, needle);         \
+      count += atb_Bits_Popcount_u64(mask) / (SIZE / 8);                   \
+    }                                                                      \
+                                                                           \
+    for (; i < size; ++i) count += (data[i] == value);                     \
+    return count;                                                          \
+  }
+
+#else
+
+#define _ATB_DEFINE_SEARCH_KERNELS(SIZE)                                 \
+  static size_t Search_Find_##SIZE(uint##SIZE##_t const *const data,     \
+                                   size_t size, uint##SIZE##_t value) {  \
+    for (size_t i = 0; i < size; ++i) {                                  \
+      if (data[i] == value) return i;                                    \
+    }                                                                    \
+    return size;                                                         \
+  }                                                                      \
+                                                                         \
+  static size_t Search_RFind_##SIZE(uint##SIZE##_t const *const data,    \
+                                    size_t size, uint##SIZE##_t value) { \
+    for (size_t i = size; i > 0; --i) {                                  \
+      if (data[i - 1] == value) return i - 1;                            \
+    }                                                                    \
+    return size;                                                         \
+  }                                                                      \
+                                                                         \
+  static size_t Search_Count_##SIZE(uint##SIZE##_t const *const data,    \
+                                    size_t size, uint##SIZE##_t value) { \
+    size_t count = 0;                                                    \
+    for (size_t i = 0; i < size; ++i) count += (data[i] == value);       \
+    return count;                                                        \
+  }
+
+#endif
+
+ATB_INTS_X_FOREACH_SIZES(_ATB_DEFINE_SEARCH_KERNELS)
+
+#undef _ATB_DEFINE_SEARCH_KERNELS
+
+#define _ATB_DEFINE_INT_SEARCH(T, NAME, MIN, MAX, SIZE)                      \
+  bool atb_View_##NAME##_Find(struct atb_View_##NAME view, T value,          \
+                              size_t *const where) {                         \
+    assert(atb_View_##NAME##_IsValid(view));                                 \
+                                                                             \
+    size_t const i = Search_Find_##SIZE((uint##SIZE##_t const *)view.data,   \
+                                        view.size, (uint##SIZE##_t)value);   \
+    if (i == view.size) return false;                                        \
+                                                                             \
+    if (where != NULL) *where = i;                                           \
+    return true;                                                             \
+  }                                                                          \
+                                                                             \
+  bool atb_View_##NAME##_RFind(struct atb_View_##NAME view, T value,         \
+                               size_t *const where) {                        \
+    assert(atb_View_##NAME##_IsValid(view));                                 \
+                                                                             \
+    size_t const i = Search_RFind_##SIZE((uint##SIZE##_t const *)view.data,  \
+                                         view.size, (uint##SIZE##_t)value);  \
+    if (i == view.size) return false;                                        \
+                                                                             \
+    if (where != NULL) *where = i;                                           \
+    return true;                                                             \
+  }                                                                          \
+                                                                             \
+  size_t atb_View_##NAME##_Count(struct atb_View_##NAME view, T value) {     \
+    assert(atb_View_##NAME##_IsValid(view));                                 \
+                                                                             \
+    return Search_Count_##SIZE((uint##SIZE##_t const *)view.data, view.size, \
+                               (uint##SIZE##_t)value);                       \
+  }                                                                          \
+                                                                             \
+  bool atb_View_##NAME##_Contains(struct atb_View_##NAME view, T value) {    \
+    return atb_View_##NAME##_Find(view, value, NULL);                        \
+  }
+
+ATB_INTS_X_FOREACH(_ATB_DEFINE_INT_SEARCH)
+
+#undef _ATB_DEFINE_INT_SEARCH
+
+/// Exact sum of many ints (128 bits, two's complement)
+struct Wide {
+  uint64_t lo; /*!< Lower 64 bits */
+  uint64_t hi; /*!< Upper 64 bits */
+};
+
+static void Wide_Add(struct Wide *const self, uint64_t lo, uint64_t hi) {
+  self->lo += lo;
+  self->hi += hi + (self->lo < lo);
+}
+
+static void Wide_Sub(struct Wide *const self, uint64_t lo, uint64_t hi) {
+  self->hi -= hi + (self->lo < lo);
+  self->lo -= lo;
+}
+
+/// Position of the sum relatively to the [min, max] range of an int type
+/// (given as 64 bits two's complement): < 0 when below, > 0 when above, 0
+/// when inside (sum.lo then holding the value)
+static int Wide_Range(struct Wide sum, uint64_t min, uint64_t max) {
+  if ((sum.hi >> 63) != 0) {
+    return ((min != 0) && (sum.hi == UINT64_MAX) && (sum.lo >= min)) ? 0 : -1;
+  }
+
+  return ((sum.hi == 0) && (sum.lo <= max)) ? 0 : 1;
+}
+
+// Reductions work on KEYS (element ^ flip): flipping the sign bit of signed
+// ints orders (and sums) them as unsigned ones.
+
+#define _ATB_DEFINE_REDUCE_SCALAR(SIZE)                                      \
+  static uint##SIZE##_t Scalar_SumWrap_##SIZE(                               \
+      uint##SIZE##_t const *const data, size_t size) {                       \
+    uint##SIZE##_t sum = 0;                                                  \
+    for (size_t i = 0; i < size; ++i) sum = (uint##SIZE##_t)(sum + data[i]); \
+    return sum;                                                              \
+  }                                                                          \
+                                                                             \
+  static void Scalar_SumExact_##SIZE(uint##SIZE##_t const *const data,       \
+                                     size_t size, uint##SIZE##_t flip,       \
+                                     struct Wide *const sum) {               \
+    for (size_t i = 0; i < size; ++i) {                                      \
+      Wide_Add(sum, (uint##SIZE##_t)(data[i] ^ flip), 0);                    \
+    }                                                                        \
+  }                                                                          \
+                                                                             \
+  static void Scalar_MinMax_##SIZE(uint##SIZE##_t const *const data,         \
+                                   size_t size, uint##SIZE##_t flip,         \
+                                   uint##SIZE##_t *const min,                \
+                                   uint##SIZE##_t *const max) {              \
+    for (size_t i = 0; i < size; ++i) {                                      \
+      uint##SIZE##_t const key = (uint##SIZE##_t)(data[i] ^ flip);           \
+      if (key < *min) *min = key;                                            \
+      if (key > *max) *max = key;                                            \
+    }                                                                        \
+  }
+
+ATB_INTS_X_FOREACH_SIZES(_ATB_DEFINE_REDUCE_SCALAR)
+
+#undef _ATB_DEFINE_REDUCE_SCALAR
+
+#if defined(__SSE2__)
+
+/// Add the 64 bits lanes of lo (with the upper bits in hi) to sum
+static void Reduce_Fold(__m128i lo, __m128i hi, struct Wide *const sum) {
+  uint64_t lanes_lo[2];
+  uint64_t lanes_hi[2];
+  _mm_storeu_si128((__m128i *)lanes_lo, lo);
+  _mm_storeu_si128((__m128i *)lanes_hi, hi);
+
+  Wide_Add(sum, lanes_lo[0], lanes_hi[0]);
+  Wide_Add(sum, lanes_lo[1], lanes_hi[1]);
+}
+
+#define _ATB_DEFINE_REDUCE_SUMWRAP(SIZE)                                     \
+  static uint##SIZE##_t Reduce_SumWrap_##SIZE(                               \
+      uint##SIZE##_t const *const data, size_t size) {                       \
+    size_t const lanes = 16 / (SIZE / 8);                                    \
+    __m128i acc = _mm_setzero_si128();                                       \
+    size_t i = 0;                                                            \
+                                                                             \
+    for (; (i + lanes) <= size; i += lanes) {                                \
+      acc = _mm_add_epi##SIZE(acc,                                           \
+                              _mm_loadu_si128((__m128i const *)(data + i))); \
+    }                                                                        \
+                                                                             \
+    uint##SIZE##_t partial[16 / (SIZE / 8)];                                 \
+    _mm_storeu_si128((__m128i *)partial, acc);                               \
+                                                                             \
+    return (uint##SIZE##_t)(Scalar_SumWrap_##SIZE(partial, lanes) +          \
+                            Scalar_SumWrap_##SIZE(data + i, size - i));      \
+  }
+
+ATB_INTS_X_FOREACH_SIZES(_ATB_DEFINE_REDUCE_SUMWRAP)
+
+#undef _ATB_DEFINE_REDUCE_SUMWRAP
+
+static void Reduce_SumExact_8(uint8_t const *const data, size_t size,
+                              uint8_t flip, struct Wide *const sum) {
+  __m128i const zero = _mm_setzero_si128();
+  __m128i const bias = _mm_set1_epi8((char)flip);
+  __m128i acc = zero;
+  size_t i = 0;
+
+  // Sum of absolute differences with 0: 8 keys summed per 64 bits lane
+  for (; (i + 16) <= size; i += 16) {
+    __m128i const keys =
+        _mm_xor_si128(_mm_loadu_si128((__m128i const *)(data + i)), bias);
+    acc = _mm_add_epi64(acc, _mm_sad_epu8(keys, zero));
+  }
+
+  Reduce_Fold(acc, zero, sum);
+  Scalar_SumExact_8(data + i, size - i, flip, sum);
+}
+
+static void Reduce_SumExact_16(uint16_t const *const data, size_t size,
+                               uint16_t flip, struct Wide *const sum) {
+  __m128i const zero = _mm_setzero_si128();
+  __m128i const bias = _mm_set1_epi16((short)flip);
+  __m128i acc = zero;
+  size_t i = 0;
+
+  while ((i + 8) <= size) {
+    // 32 bits lanes (widened keys) can't overflow for 2^15 iterations
+    size_t const blocks = (size - i) / 8;
+    size_t const end = i + 8 * ((blocks < 0x8000) ? blocks : 0x8000);
+    __m128i acc32 = zero;
+
+    for (; i < end; i += 8) {
+      __m128i const keys =
+          _mm_xor_si128(_mm_loadu_si128((__m128i const *)(data + i)), bias);
+      acc32 = _mm_add_epi32(acc32, _mm_unpacklo_epi16(keys, zero));
+      acc32 = _mm_add_epi32(acc32, _mm_unpackhi_epi16(keys, zero));
+    }
+
+    acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(acc32, zero));
+    acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(acc32, zero));
+  }
+
+  Reduce_Fold(acc, zero, sum);
+  Scalar_SumExact_16(data + i, size - i, flip, sum);
+}
+
+static void Reduce_SumExact_32(uint32_t const *const data, size_t size,
+                               uint32_t flip, struct Wide *const sum) {
+  __m128i const zero = _mm_setzero_si128();
+  __m128i const bias = _mm_set1_epi32((int)flip);
+  size_t i = 0;
+
+  while ((i + 4) <= size) {
+    // 64 bits lanes (widened keys) can't overflow for 2^30 iterations
+    size_t const blocks = (size - i) / 4;
+    size_t const end =
+        i + 4 * ((blocks < 0x40000000) ? blocks : (size_t)0x40000000);
+    __m128i acc = zero;
+
+    for (; i < end; i += 4) {
+      __m128i const keys =
+          _mm_xor_si128(_mm_loadu_si128((__m128i const *)(data + i)), bias);
+      acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(keys, zero));
+      acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(keys, zero));
+    }
+
+    Reduce_Fold(acc, zero, sum);
+  }
+
+  Scalar_SumExact_32(data + i, size - i, flip, sum);
+}
+
+static void Reduce_SumExact_64(uint64_t const *const data, size_t size,
+                               uint64_t flip, struct Wide *const sum) {
+  __m128i const bias = _mm_set1_epi64x((long long)flip);
+  __m128i lo = _mm_setzero_si128();
+  __m128i hi = _mm_setzero_si128();
+  size_t i = 0;
+
+  for (; (i + 2) <= size; i += 2) {
+    __m128i const keys =
+        _mm_xor_si128(_mm_loadu_si128((__m128i const *)(data + i)), bias);
+    __m128i const result = _mm_add_epi64(lo, keys);
+    // Carry out of each lane: MSB of (a & b) | ((a | b) & ~(a + b))
+    __m128i const carry =
+        _mm_or_si128(_mm_and_si128(lo, keys),
+                     _mm_andnot_si128(result, _mm_or_si128(lo, keys)));
+
+    hi = _mm_add_epi64(hi, _mm_srli_epi64(carry, 63));
+    lo = result;
+  }
+
+  Reduce_Fold(lo, hi, sum);
+  Scalar_SumExact_64(data + i, size - i, flip, sum);
+}
+
+// SSE2 only compares unsigned 8 bits and signed 16 bits ints (min/max), and
+// signed 32 bits ones (cmpgt): keys are flipped (once more) to match them.
+
+static __m128i MinMax_Min_8(__m128i lhs, __m128i rhs) {
+  return _mm_min_epu8(lhs, rhs);
+}
+static __m128i MinMax_Max_8(__m128i lhs, __m128i rhs) {
+  return _mm_max_epu8(lhs, rhs);
+}
+static __m128i MinMax_Min_16(__m128i lhs, __m128i rhs) {
+  return _mm_min_epi16(lhs, rhs);
+}
+static __m128i MinMax_Max_16(__m128i lhs, __m128i rhs) {
+  return _mm_max_epi16(lhs, rhs);
+}
+static __m128i MinMax_Min_32(__m128i lhs, __m128i rhs) {
+  __m128i const greater = _mm_cmpgt_epi32(lhs, rhs);
+  return _mm_or_si128(_mm_and_si128(greater, rhs),
+                      _mm_andnot_si128(greater, lhs));
+}
+static __m128i MinMax_Max_32(__m128i lhs, __m128i rhs) {
+  __m128i const greater = _mm_cmpgt_epi32(lhs, rhs);
+  return _mm_or_si128(_mm_and_si128(greater, lhs),
+                      _mm_andnot_si128(greater, rhs));
+}
+
+#define _ATB_DEFINE_REDUCE_MINMAX(SIZE, NATIVE)                                \
+  static void Reduce_MinMax_##SIZE(uint##SIZE##_t const *const data,           \
+                                   size_t size, uint##SIZE##_t flip,           \
+                                   uint##SIZE##_t *const min,                  \
+                                   uint##SIZE##_t *const max) {                \
+    size_t const lanes = 16 / (SIZE / 8);                                      \
+    size_t i = 0;                                                              \
+                                                                               \
+    if (size >= lanes) {                                                       \
+      __m128i const native = Search_Set1_##SIZE(NATIVE);                       \
+      __m128i const bias = _mm_xor_si128(native, Search_Set1_##SIZE(flip));    \
+      __m128i lo =                                                             \
+          _mm_xor_si128(_mm_loadu_si128((__m128i const *)data), bias);         \
+      __m128i hi = lo;                                                         \
+                                                                               \
+      for (i = lanes; (i + lanes) <= size; i += lanes) {                       \
+        __m128i const values =                                                 \
+            _mm_xor_si128(_mm_loadu_si128((__m128i const *)(data + i)), bias); \
+        lo = MinMax_Min_##SIZE(lo, values);                                    \
+        hi = MinMax_Max_##SIZE(hi, values);                                    \
+      }                                                                        \
+                                                                               \
+      /* Back to keys: each lane holds the key of an element */                \
+      uint##SIZE##_t partial[2 * 16 / (SIZE / 8)];                             \
+      _mm_storeu_si128((__m128i *)partial, _mm_xor_si128(lo, native));         \
+      _mm_storeu_si128((__m128i *)(partial + lanes),                           \
+                       _mm_xor_si128(hi, native));                             \
+      Scalar_MinMax_##SIZE(partial, 2 * lanes, 0, min, max);                   \
+    }                                                                          \
+                                                                               \
+    Scalar_MinMax_##SIZE(data + i, size - i, flip, min, max);                  \
+  }
+
+_ATB_DEFINE_REDUCE_MINMAX(8, 0)
+_ATB_DEFINE_REDUCE_MINMAX(16, 0x8000)
+_ATB_DEFINE_REDUCE_MINMAX(32, 0x80000000)
+
+#undef _ATB_DEFINE_REDUCE_MINMAX
+
+static void Reduce_MinMax_64(uint64_t const *const data, size_t size,
+                             uint64_t flip, uint64_t *const min,
+                             uint64_t *const max) {
+  // No 64 bits compare with SSE2
+  Scalar_MinMax_64(data, size, flip, min, max);
+}
+
+#else
+
+#define _ATB_DEFINE_REDUCE_KERNELS(SIZE)                               \
+  static uint##SIZE##_t Reduce_SumWrap_##SIZE(                         \
+      uint##SIZE##_t const *const data, size_t size) {                 \
+    return Scalar_SumWrap_##SIZE(data, size);                          \
+  }                                                                    \
+                                                                       \
+  static void Reduce_SumExact_##SIZE(uint##SIZE##_t const *const data, \
+                                     size_t size, uint##SIZE##_t flip, \
+                                     struct Wide *const sum) {         \
+    Scalar_SumExact_##SIZE(data, size, flip, sum);                     \
+  }                                                                    \
+                                                                       \
+  static void Reduce_MinMax_##SIZE(uint##SIZE##_t const *const data,   \
+                                   size_t size, uint##SIZE##_t flip,   \
+                                   uint##SIZE##_t *const min,          \
+                                   uint##SIZE##_t *const max) {        \
+    Scalar_MinMax_##SIZE(data, size, flip, min, max);                  \
+  }
+
+ATB_INTS_X_FOREACH_SIZES(_ATB_DEFINE_REDUCE_KERNELS)
+
+#undef _ATB_DEFINE_REDUCE_KERNELS
+
+#endif
+
+#define _ATB_DEFINE_INT_REDUCE(T, NAME, MIN, MAX, SIZE)                      \
+  /* Position of the exact sum relatively to [MIN, MAX] (see Wide_Range) */  \
+  static int Reduce_Sum_##NAME(struct atb_View_##NAME view, T *const dest) { \
+    assert(atb_View_##NAME##_IsValid(view));                                 \
+    assert(dest != NULL);                                                    \
+                                                                             \
+    uint##SIZE##_t const flip = (uint##SIZE##_t)(MIN);                       \
+    struct Wide sum = {0, 0};                                                \
+                                                                             \
+    Reduce_SumExact_##SIZE((uint##SIZE##_t const *)view.data, view.size,     \
+                           flip, &sum);                                      \
+    if (flip != 0) {                                                         \
+      /* Sum of the keys: remove the flipped sign bit of each element */     \
+      Wide_Sub(&sum, (uint64_t)view.size << (SIZE - 1),                      \
+               (uint64_t)view.size >> (65 - SIZE));                          \
+    }                                                                        \
+                                                                             \
+    int const range = Wide_Range(sum, (uint64_t)(MIN), (uint64_t)(MAX));     \
+    if (range == 0) *dest = (T)sum.lo;                                       \
+    return range;                                                            \
+  }                                                                          \
+                                                                             \
+  bool atb_View_##NAME##_Sum_Unsafe(struct atb_View_##NAME view,             \
+                                    T *const dest) {                         \
+    assert(atb_View_##NAME##_IsValid(view));                                 \
+    assert(dest != NULL);                                                    \
+                                                                             \
+    *dest = (T)Reduce_SumWrap_##SIZE((uint##SIZE##_t const *)view.data,      \
+                                     view.size);                             \
+    return true;                                                             \
+  }                                                                          \
+                                                                             \
+  bool atb_View_##NAME##_Sum_Safely(struct atb_View_##NAME view,             \
+                                    T *const dest) {                         \
+    return Reduce_Sum_##NAME(view, dest) == 0;                               \
+  }                                                                          \
+                                                                             \
+  bool atb_View_##NAME##_Sum_Saturate(struct atb_View_##NAME view,           \
+                                      T *const dest) {                       \
+    int const range = Reduce_Sum_##NAME(view, dest);                         \
+                                                                             \
+    if (range < 0) *dest = MIN;                                              \
+    if (range > 0) *dest = MAX;                                              \
+    return range == 0;                                                       \
+  }                                                                          \
+                                                                             \
+  bool atb_View_##NAME##_MinMax(struct atb_View_##NAME view, T *const min,   \
+                                T *const max) {                              \
+    assert(atb_View_##NAME##_IsValid(view));                                 \
+    assert(min != NULL);                                                     \
+    assert(max != NULL);                                                     \
+                                                                             \
+    if (view.size == 0) return false;                                        \
+                                                                             \
+    uint##SIZE##_t const flip = (uint##SIZE##_t)(MIN);                       \
+    uint##SIZE##_t const *const data = (uint##SIZE##_t const *)view.data;    \
+    uint##SIZE##_t lo = (uint##SIZE##_t)(data[0] ^ flip);                    \
+    uint##SIZE##_t hi = lo;                                                  \
+                                                                             \
+    Reduce_MinMax_##SIZE(data, view.size, flip, &lo, &hi);                   \
+    *min = (T)(uint##SIZE##_t)(lo ^ flip);                                   \
+    *max = (T)(uint##SIZE##_t)(hi ^ flip);                                   \
+    return true;                                                             \
+  }                                                                          \
+                                                                             \
+  bool atb_View_##NAME##_Min(struct atb_View_##NAME view, T *const dest) {   \
+    T max;                                                                   \
+    return atb_View_##NAME##_MinMax(view, dest, &max);                       \
+  }                                                                          \
+                                                                             \
+  bool atb_View_##NAME##_Max(struct atb_View_##NAME view, T *const dest) {   \
+    T min;                                                                   \
+    return atb_View_##NAME##_MinMax(view, &min, dest);                       \
+  }
+
+ATB_INTS_X_FOREACH(_ATB_DEFINE_INT_REDUCE)
+
+#undef _ATB_DEFINE_INT_REDUCE
+
+#if defined(__SSE2__)
+
+/// Result of an element-wise operation over 16 bytes of elements
+struct Lanes {
+  __m128i value;     /*!< Result (wrapped around) */
+  __m128i failed;    /*!< All bits set for elements underflowing/overflowing */
+  __m128i saturated; /*!< Value of the failed elements once saturated */
+};
+
+static __m128i Lanes_Ones(void) { return _mm_set1_epi32(-1); }
+
+static __m128i Lanes_Not(__m128i value) {
+  return _mm_xor_si128(value, Lanes_Ones());
+}
+
+/// Select lhs where mask bits are set, rhs otherwise
+static __m128i Lanes_Blend(__m128i mask, __m128i lhs, __m128i rhs) {
+  return _mm_or_si128(_mm_and_si128(mask, lhs), _mm_andnot_si128(mask, rhs));
+}
+
+/// All bits set for the elements with their sign bit (MSB) set
+static __m128i Lanes_SignMask_8(__m128i value) {
+  return _mm_cmpgt_epi8(_mm_setzero_si128(), value);
+}
+static __m128i Lanes_SignMask_16(__m128i value) {
+  return _mm_srai_epi16(value, 15);
+}
+static __m128i Lanes_SignMask_32(__m128i value) {
+  return _mm_srai_epi32(value, 31);
+}
+static __m128i Lanes_SignMask_64(__m128i value) {
+  return _mm_shuffle_epi32(_mm_srai_epi32(value, 31), _MM_SHUFFLE(3, 3, 1, 1));
+}
+
+// Overflows are found from the MSB of the operands and wrapped result (see
+// Hacker's Delight 2-13): carry/borrow out for unsigned ints, operands with
+// the same sign giving a result of another sign for signed ones.
+
+#define _ATB_DEFINE_LANES_ADDSUB(SIZE)                                        \
+  /* MAX (sign of the overflowing element clear) or MIN (set) */              \
+  static __m128i Lanes_Saturated_i##SIZE(__m128i sign) {                      \
+    return _mm_xor_si128(Search_Set1_##SIZE((uint##SIZE##_t)INT##SIZE##_MAX), \
+                         Lanes_SignMask_##SIZE(sign));                        \
+  }                                                                           \
+                                                                              \
+  static struct Lanes Lanes_Add_u##SIZE(__m128i lhs, __m128i rhs) {           \
+    struct Lanes lanes;                                                       \
+    lanes.value = _mm_add_epi##SIZE(lhs, rhs);                                \
+    lanes.failed = Lanes_SignMask_##SIZE(                                     \
+        _mm_or_si128(_mm_and_si128(lhs, rhs),                                 \
+                     _mm_andnot_si128(lanes.value, _mm_or_si128(lhs, rhs)))); \
+    lanes.saturated = Lanes_Ones();                                           \
+    return lanes;                                                             \
+  }                                                                           \
+                                                                              \
+  static struct Lanes Lanes_Sub_u##SIZE(__m128i lhs, __m128i rhs) {           \
+    struct Lanes lanes;                                                       \
+    lanes.value = _mm_sub_epi##SIZE(lhs, rhs);                                \
+    lanes.failed = Lanes_SignMask_##SIZE(_mm_or_si128(                        \
+        _mm_andnot_si128(lhs, rhs),                                           \
+        _mm_andnot_si128(_mm_xor_si128(lhs, rhs), lanes.value)));             \
+    lanes.saturated = _mm_setzero_si128();                                    \
+    return lanes;                                                             \
+  }                                                                           \
+                                                                              \
+  static struct Lanes Lanes_Add_i##SIZE(__m128i lhs, __m128i rhs) {           \
+    struct Lanes lanes;                                                       \
+    lanes.value = _mm_add_epi##SIZE(lhs, rhs);                                \
+    lanes.failed = Lanes_SignMask_##SIZE(                                     \
+        _mm_and_si128(_mm_xor_si128(lhs, lanes.value),                        \
+                      _mm_xor_si128(rhs, lanes.value)));                      \
+    lanes.saturated = Lanes_Saturated_i##SIZE(lhs);                           \
+    return lanes;                                                             \
+  }                                                                           \
+                                                                              \
+  static struct Lanes Lanes_Sub_i##SIZE(__m128i lhs, __m128i rhs) {           \
+    struct Lanes lanes;                                                       \
+    lanes.value = _mm_sub_epi##SIZE(lhs, rhs);                                \
+    lanes.failed = Lanes_SignMask_##SIZE(                                     \
+        _mm_and_si128(_mm_xor_si128(lhs, rhs),                                \
+                      _mm_xor_si128(lhs, lanes.value)));                      \
+    lanes.saturated = Lanes_Saturated_i##SIZE(lhs);                           \
+    return lanes;                                                             \
+  }
+
+ATB_INTS_X_FOREACH_SIZES(_ATB_DEFINE_LANES_ADDSUB)
+
+#undef _ATB_DEFINE_LANES_ADDSUB
+
+// SSE2 only multiplies 16 bits ints (low/high halves of the 32 bits
+// product): 8 bits ints are widened, 32/64 bits ones stay scalar.
+
+static struct Lanes Lanes_Mul_u16(__m128i lhs, __m128i rhs) {
+  struct Lanes lanes;
+  lanes.value = _mm_mullo_epi16(lhs, rhs);
+  lanes.failed = Lanes_Not(
+      _mm_cmpeq_epi16(_mm_mulhi_epu16(lhs, rhs), _mm_setzero_si128()));
+  lanes.saturated = Lanes_Ones();
+  return lanes;
+}
+
+static struct Lanes Lanes_Mul_i16(__m128i lhs, __m128i rhs) {
+  struct Lanes lanes;
+  lanes.value = _mm_mullo_epi16(lhs, rhs);
+  lanes.failed = Lanes_Not(_mm_cmpeq_epi16(_mm_mulhi_epi16(lhs, rhs),
+                                           _mm_srai_epi16(lanes.value, 15)));
+  lanes.saturated = Lanes_Saturated_i16(_mm_xor_si128(lhs, rhs));
+  return lanes;
+}
+
+/// Narrow the (16 bits) products back to 8 bits elements
+static struct Lanes Lanes_Mul_Narrow(__m128i lo, __m128i hi,
+                                     __m128i failed_lo, __m128i failed_hi) {
+  __m128i const mask = _mm_set1_epi16(0xFF);
+
+  struct Lanes lanes;
+  lanes.value =
+      _mm_packus_epi16(_mm_and_si128(lo, mask), _mm_and_si128(hi, mask));
+  lanes.failed = _mm_packs_epi16(failed_lo, failed_hi);
+  return lanes;
+}
+
+static struct Lanes Lanes_Mul_u8(__m128i lhs, __m128i rhs) {
+  __m128i const zero = _mm_setzero_si128();
+  __m128i const lo = _mm_mullo_epi16(_mm_unpacklo_epi8(lhs, zero),
+                                     _mm_unpacklo_epi8(rhs, zero));
+  __m128i const hi = _mm_mullo_epi16(_mm_unpackhi_epi8(lhs, zero),
+                                     _mm_unpackhi_epi8(rhs, zero));
+
+  struct Lanes lanes = Lanes_Mul_Narrow(
+      lo, hi, Lanes_Not(_mm_cmpeq_epi16(_mm_srli_epi16(lo, 8), zero)),
+      Lanes_Not(_mm_cmpeq_epi16(_mm_srli_epi16(hi, 8), zero)));
+  lanes.saturated = Lanes_Ones();
+  return lanes;
+}
+
+static struct Lanes Lanes_Mul_i8(__m128i lhs, __m128i rhs) {
+  // Sign extended by shifting the duplicated bytes
+  __m128i const lo =
+      _mm_mullo_epi16(_mm_srai_epi16(_mm_unpacklo_epi8(lhs, lhs), 8),
+                      _mm_srai_epi16(_mm_unpacklo_epi8(rhs, rhs), 8));
+  __m128i const hi =
+      _mm_mullo_epi16(_mm_srai_epi16(_mm_unpackhi_epi8(lhs, lhs), 8),
+                      _mm_srai_epi16(_mm_unpackhi_epi8(rhs, rhs), 8));
+
+  struct Lanes lanes = Lanes_Mul_Narrow(
+      lo, hi,
+      Lanes_Not(_mm_cmpeq_epi16(
+          lo, _mm_srai_epi16(_mm_slli_epi16(lo, 8), 8))),
+      Lanes_Not(_mm_cmpeq_epi16(
+          hi, _mm_srai_epi16(_mm_slli_epi16(hi, 8), 8))));
+  lanes.saturated = Lanes_Saturated_i8(_mm_xor_si128(lhs, rhs));
+  return lanes;
+}
+
+/// Store the result following each policy, accumulating the failures
+static void Lanes_Store_Unsafe(void *const dest, struct Lanes lanes,
+                               __m128i *const failed) {
+  (void)failed;
+  _mm_storeu_si128((__m128i *)dest, lanes.value);
+}
+static void Lanes_Store_Safely(void *const dest, struct Lanes lanes,
+                               __m128i *const failed) {
+  __m128i const previous = _mm_loadu_si128((__m128i const *)dest);
+  _mm_storeu_si128((__m128i *)dest,
+                   Lanes_Blend(lanes.failed, previous, lanes.value));
+  *failed = _mm_or_si128(*failed, lanes.failed);
+}
+static void Lanes_Store_Saturate(void *const dest, struct Lanes lanes,
+                                 __m128i *const failed) {
+  _mm_storeu_si128((__m128i *)dest,
+                   Lanes_Blend(lanes.failed, lanes.saturated, lanes.value));
+  *failed = _mm_or_si128(*failed, lanes.failed);
+}
+
+#define _ATB_DEFINE_BULK_POLICY(OP, POLICY, T, NAME, SIZE)                 \
+  /* Apply OP to the leading blocks of 16 bytes, returning the number of   \
+     elements processed (rhs being a scalar when rhs_step is 0) */         \
+  static inline size_t Bulk_##OP##_##POLICY##_##NAME(                      \
+      T *const dest, T const *const lhs, T const *const rhs,               \
+      size_t rhs_step, size_t size, bool *const success) {                 \
+    size_t const lanes = 16 / (SIZE / 8);                                  \
+    __m128i const scalar = (rhs_step == 0)                                 \
+                               ? Search_Set1_##SIZE((uint##SIZE##_t)*rhs)  \
+                               : _mm_setzero_si128();                      \
+    __m128i failed = _mm_setzero_si128();                                  \
+    size_t i = 0;                                                          \
+                                                                           \
+    for (; (i + lanes) <= size; i += lanes) {                              \
+      __m128i const l = _mm_loadu_si128((__m128i const *)(lhs + i));       \
+      __m128i const r = (rhs_step == 0)                                    \
+                            ? scalar                                       \
+                            : _mm_loadu_si128((__m128i const *)(rhs + i)); \
+      Lanes_Store_##POLICY(dest + i, Lanes_##OP##_##NAME(l, r), &failed);  \
+    }                                                                      \
+                                                                           \
+    *success = *success && (_mm_movemask_epi8(failed) == 0);               \
+    return i;                                                              \
+  }
+
+#define _ATB_DEFINE_BULK(OP, T, NAME, SIZE)            \
+  _ATB_DEFINE_BULK_POLICY(OP, Unsafe, T, NAME, SIZE)   \
+  _ATB_DEFINE_BULK_POLICY(OP, Safely, T, NAME, SIZE)   \
+  _ATB_DEFINE_BULK_POLICY(OP, Saturate, T, NAME, SIZE)
+
+#define _ATB_DEFINE_BULK_ADDSUB(T, NAME, MIN, MAX, SIZE) \
+  _ATB_DEFINE_BULK(Add, T, NAME, SIZE)                   \
+  _ATB_DEFINE_BULK(Sub, T, NAME, SIZE)
+
+ATB_INTS_X_FOREACH(_ATB_DEFINE_BULK_ADDSUB)
+
+_ATB_DEFINE_BULK(Mul, uint8_t, u8, 8)
+_ATB_DEFINE_BULK(Mul, uint16_t, u16, 16)
+_ATB_DEFINE_BULK(Mul, int8_t, i8, 8)
+_ATB_DEFINE_BULK(Mul, int16_t, i16, 16)
+
+#undef _ATB_DEFINE_BULK_ADDSUB
+#undef _ATB_DEFINE_BULK
+#undef _ATB_DEFINE_BULK_POLICY
+
+#endif
+
+#define _ATB_DEFINE_BULK_NONE_POLICY(OP, POLICY, T, NAME)    \
+  static inline size_t Bulk_##OP##_##POLICY##_##NAME(        \
+      T *const dest, T const *const lhs, T const *const rhs, \
+      size_t rhs_step, size_t size, bool *const success) {   \
+    (void)dest;                                              \
+    (void)lhs;                                               \
+    (void)rhs;                                               \
+    (void)rhs_step;                                          \
+    (void)size;                                              \
+    (void)success;                                           \
+    return 0;                                                \
+  }
+
+#define _ATB_DEFINE_BULK_NONE(OP, T, NAME, ...)       \
+  _ATB_DEFINE_BULK_NONE_POLICY(OP, Unsafe, T, NAME)   \
+  _ATB_DEFINE_BULK_NONE_POLICY(OP, Safely, T, NAME)   \
+  _ATB_DEFINE_BULK_NONE_POLICY(OP, Saturate, T, NAME)
+
+#if defined(__SSE2__)
+
+_ATB_DEFINE_BULK_NONE(Mul, uint32_t, u32, 32)
+_ATB_DEFINE_BULK_NONE(Mul, uint64_t, u64, 64)
+_ATB_DEFINE_BULK_NONE(Mul, int32_t, i32, 32)
+_ATB_DEFINE_BULK_NONE(Mul, int64_t, i64, 64)
+
+#else
+
+#define _ATB_DEFINE_BULK_NONE_ALL(...)   \
+  _ATB_DEFINE_BULK_NONE(Add, __VA_ARGS__) \
+  _ATB_DEFINE_BULK_NONE(Sub, __VA_ARGS__) \
+  _ATB_DEFINE_BULK_NONE(Mul, __VA_ARGS__)
+
+ATB_INTS_X_FOREACH(_ATB_DEFINE_BULK_NONE_ALL)
+
+#undef _ATB_DEFINE_BULK_NONE_ALL
+
+#endif
+
+#undef _ATB_DEFINE_BULK_NONE
+#undef _ATB_DEFINE_BULK_NONE_POLICY
+
+/// Scalar element-wise operations: _Unsafe wraps around (computed on
+/// uint64_t, like the SIMD lanes do), the others are the atb/ints.h ones
+#define _ATB_DEFINE_ELEMENT_UNSAFE(OP, SYMBOL, T, NAME)                    \
+  static inline bool Element_##OP##_Unsafe_##NAME(T lhs, T rhs,            \
+                                                  T *const dest) {         \
+    *dest = (T)((uint64_t)lhs SYMBOL (uint64_t)rhs);                       \
+    return true;                                                           \
+  }
+
+#define _ATB_DEFINE_ELEMENT_POLICY(OP, POLICY, T, NAME)                    \
+  static inline bool Element_##OP##_##POLICY##_##NAME(T lhs, T rhs,        \
+                                                      T *const dest) {     \
+    return atb_##OP##_##POLICY##_##NAME(lhs, rhs, dest);                   \
+  }
+
+#define _ATB_DEFINE_ELEMENT_ALL(T, NAME, ...)           \
+  _ATB_DEFINE_ELEMENT_UNSAFE(Add, +, T, NAME)           \
+  _ATB_DEFINE_ELEMENT_UNSAFE(Sub, -, T, NAME)           \
+  _ATB_DEFINE_ELEMENT_UNSAFE(Mul, *, T, NAME)           \
+  _ATB_DEFINE_ELEMENT_POLICY(Add, Safely, T, NAME)      \
+  _ATB_DEFINE_ELEMENT_POLICY(Add, Saturate, T, NAME)    \
+  _ATB_DEFINE_ELEMENT_POLICY(Sub, Safely, T, NAME)      \
+  _ATB_DEFINE_ELEMENT_POLICY(Sub, Saturate, T, NAME)    \
+  _ATB_DEFINE_ELEMENT_POLICY(Mul, Safely, T, NAME)      \
+  _ATB_DEFINE_ELEMENT_POLICY(Mul, Saturate, T, NAME)
+
+ATB_INTS_X_FOREACH(_ATB_DEFINE_ELEMENT_ALL)
+
+#undef _ATB_DEFINE_ELEMENT_ALL
+#undef _ATB_DEFINE_ELEMENT_POLICY
+#undef _ATB_DEFINE_ELEMENT_UNSAFE
+
+#define _ATB_DEFINE_INT_ELEMENTWISE(OP, POLICY, T, NAME)                     \
+  /* Bulk (SIMD) processing, then the remaining elements one at a time */    \
+  static inline bool Apply_##OP##_##POLICY##_##NAME(                         \
+      T *const dest, T const *const lhs, T const *const rhs,                 \
+      size_t rhs_step, size_t size) {                                        \
+    bool success = true;                                                     \
+    size_t i = Bulk_##OP##_##POLICY##_##NAME(dest, lhs, rhs, rhs_step, size, \
+                                             &success);                      \
+                                                                             \
+    for (; i < size; ++i) {                                                  \
+      if (!Element_##OP##_##POLICY##_##NAME(lhs[i], rhs[i * rhs_step],       \
+                                            dest + i)) {                     \
+        success = false;                                                     \
+      }                                                                      \
+    }                                                                        \
+                                                                             \
+    return success;                                                          \
+  }                                                                          \
+                                                                             \
+  bool atb_Span_##NAME##_##OP##_##POLICY(struct atb_Span_##NAME dest,        \
+                                         struct atb_View_##NAME lhs,         \
+                                         struct atb_View_##NAME rhs) {       \
+    assert(atb_Span_##NAME##_IsValid(dest));                                 \
+    assert(atb_View_##NAME##_IsValid(lhs) && (lhs.size == dest.size));       \
+    assert(atb_View_##NAME##_IsValid(rhs) && (rhs.size == dest.size));       \
+                                                                             \
+    return Apply_##OP##_##POLICY##_##NAME(dest.data, lhs.data, rhs.data, 1,  \
+                                          dest.size);                        \
+  }                                                                          \
+                                                                             \
+  bool atb_Span_##NAME##_##OP##Scalar_##POLICY(                              \
+      struct atb_Span_##NAME dest, struct atb_View_##NAME lhs, T rhs) {      \
+    assert(atb_Span_##NAME##_IsValid(dest));                                 \
+    assert(atb_View_##NAME##_IsValid(lhs) && (lhs.size == dest.size));       \
+                                                                             \
+    return Apply_##OP##_##POLICY##_##NAME(dest.data, lhs.data, &rhs, 0,      \
+                                          dest.size);                        \
+  }
+
+#define _ATB_DEFINE_INT_ELEMENTWISE_ALL(T, NAME, ...) \
+  _ATB_DEFINE_INT_ELEMENTWISE(Add, Unsafe, T, NAME)   \
+  _ATB_DEFINE_INT_ELEMENTWISE(Add, Safely, T, NAME)   \
+  _ATB_DEFINE_INT_ELEMENTWISE(Add, Saturate, T, NAME) \
+  _ATB_DEFINE_INT_ELEMENTWISE(Sub, Unsafe, T, NAME)   \
+  _ATB_DEFINE_INT_ELEMENTWISE(Sub, Safely, T, NAME)   \
+  _ATB_DEFINE_INT_ELEMENTWISE(Sub, Saturate, T, NAME) \
+  _ATB_DEFINE_INT_ELEMENTWISE(Mul, Unsafe, T, NAME)   \
+  _ATB_DEFINE_INT_ELEMENTWISE(Mul, Safely, T, NAME)   \
+  _ATB_DEFINE_INT_ELEMENTWISE(Mul, Saturate, T, NAME)
+
+ATB_INTS_X_FOREACH(_ATB_DEFINE_INT_ELEMENTWISE_ALL)
+
+#undef _ATB_DEFINE_INT_ELEMENTWISE_ALL
+#undef _ATB_DEFINE_INT_ELEMENTWISE
+
+/// Policies of the narrowing conversions
+enum Narrow_Policy { Narrow_Truncate, Narrow_Saturate, Narrow_Safely };
+
+#if defined(__SSE2__)
+
+/// Store the 16 bytes of SIZE bits elements (source) widened to DSIZE bits
+static inline void Widen_Store_16_16(uint8_t *const dest, __m128i values,
+                                     bool sign) {
+  (void)sign;
+  _mm_storeu_si128((__m128i *)dest, values);
+}
+static inline void Widen_Store_32_32(uint8_t *const dest, __m128i values,
+                                     bool sign) {
+  (void)sign;
+  _mm_storeu_si128((__m128i *)dest, values);
+}
+static inline void Widen_Store_64_64(uint8_t *const dest, __m128i values,
+                                     bool sign) {
+  (void)sign;
+  _mm_storeu_si128((__m128i *)dest, values);
+}
+
+#define _ATB_DEFINE_WIDEN_STORE(SIZE, NEXT, DSIZE)                             \
+  static inline void Widen_Store_##SIZE##_##DSIZE(uint8_t *const dest,         \
+                                                  __m128i values, bool sign) { \
+    __m128i const extension =                                                  \
+        sign ? Lanes_SignMask_##SIZE(values) : _mm_setzero_si128();            \
+    Widen_Store_##NEXT##_##DSIZE(                                              \
+        dest, _mm_unpacklo_epi##SIZE(values, extension), sign);                \
+    Widen_Store_##NEXT##_##DSIZE(dest + (8 * DSIZE / SIZE),                    \
+                                 _mm_unpackhi_epi##SIZE(values, extension),    \
+                                 sign);                                        \
+  }
+
+_ATB_DEFINE_WIDEN_STORE(32, 64, 64)
+_ATB_DEFINE_WIDEN_STORE(16, 32, 32)
+_ATB_DEFINE_WIDEN_STORE(16, 32, 64)
+_ATB_DEFINE_WIDEN_STORE(8, 16, 16)
+_ATB_DEFINE_WIDEN_STORE(8, 16, 32)
+_ATB_DEFINE_WIDEN_STORE(8, 16, 64)
+
+#undef _ATB_DEFINE_WIDEN_STORE
+
+#define _ATB_DEFINE_WIDEN_BULK(ST, SRC, SSIZE, DT, DST, DSIZE, SIGNED)        \
+  static size_t Widen_Bulk_##SRC##_##DST(DT *const dest, ST const *const src, \
+                                         size_t size) {                       \
+    size_t const lanes = 16 / (SSIZE / 8);                                    \
+    size_t i = 0;                                                             \
+                                                                              \
+    for (; (i + lanes) <= size; i += lanes) {                                 \
+      Widen_Store_##SSIZE##_##DSIZE(                                          \
+          (uint8_t *)(dest + i),                                              \
+          _mm_loadu_si128((__m128i const *)(src + i)), SIGNED);               \
+    }                                                                         \
+                                                                              \
+    return i;                                                                 \
+  }
+
+_ATB_INTS_X_FOREACH_WIDENING(_ATB_DEFINE_WIDEN_BULK)
+
+#undef _ATB_DEFINE_WIDEN_BULK
+
+/// Narrowed elements, with all bits set for the ones out of range
+struct Narrow {
+  __m128i value;  /*!< Converted elements */
+  __m128i failed; /*!< All bits set for the elements out of range */
+};
+
+// Each step halves the size of the elements: the source elements fit a
+// signed (i) or unsigned (u) half size element when truncating it back and
+// forth gives the same value.
+
+static __m128i Narrow_Fits_i16(__m128i values) {
+  return _mm_cmpeq_epi16(values, _mm_srai_epi16(_mm_slli_epi16(values, 8), 8));
+}
+static __m128i Narrow_Fits_i32(__m128i values) {
+  return _mm_cmpeq_epi32(values,
+                         _mm_srai_epi32(_mm_slli_epi32(values, 16), 16));
+}
+static __m128i Narrow_Fits_i64(__m128i values) {
+  // Upper half equal to the sign of the lower half
+  __m128i const sign = _mm_shuffle_epi32(_mm_srai_epi32(values, 31),
+                                         _MM_SHUFFLE(2, 2, 0, 0));
+  return _mm_shuffle_epi32(_mm_cmpeq_epi32(values, sign),
+                           _MM_SHUFFLE(3, 3, 1, 1));
+}
+static __m128i Narrow_Fits_u16(__m128i values) {
+  return _mm_cmpeq_epi16(_mm_srli_epi16(values, 8), _mm_setzero_si128());
+}
+static __m128i Narrow_Fits_u32(__m128i values) {
+  return _mm_cmpeq_epi32(_mm_srli_epi32(values, 16), _mm_setzero_si128());
+}
+static __m128i Narrow_Fits_u64(__m128i values) {
+  return _mm_shuffle_epi32(_mm_cmpeq_epi32(values, _mm_setzero_si128()),
+                           _MM_SHUFFLE(3, 3, 1, 1));
+}
+
+/// Keep the lower half of the elements of lo then hi
+static __m128i Narrow_Pack_16(__m128i lo, __m128i hi) {
+  __m128i const mask = _mm_set1_epi16(0xFF);
+  return _mm_packus_epi16(_mm_and_si128(lo, mask), _mm_and_si128(hi, mask));
+}
+static __m128i Narrow_Pack_32(__m128i lo, __m128i hi) {
+  // Sign extended first: the signed saturation doesn't modify them
+  return _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(lo, 16), 16),
+                         _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16));
+}
+static __m128i Narrow_Pack_64(__m128i lo, __m128i hi) {
+  // Lower halves (even 32 bits elements) first
+  return _mm_unpacklo_epi64(_mm_shuffle_epi32(lo, _MM_SHUFFLE(3, 1, 2, 0)),
+                            _mm_shuffle_epi32(hi, _MM_SHUFFLE(3, 1, 2, 0)));
+}
+
+// Value of the elements out of range, once saturated, for signed to signed
+// (ii), unsigned to unsigned (uu) and signed to unsigned (iu) conversions
+
+#define _ATB_DEFINE_NARROW_SATURATED(SIZE)                           \
+  static __m128i Narrow_Saturated_ii##SIZE(__m128i values) {         \
+    uint##SIZE##_t const max =                                       \
+        (uint##SIZE##_t)(((uint##SIZE##_t)1 << (SIZE / 2 - 1)) - 1); \
+    return _mm_xor_si128(Search_Set1_##SIZE(max),                    \
+                         Lanes_SignMask_##SIZE(values));             \
+  }                                                                  \
+  static __m128i Narrow_Saturated_uu##SIZE(__m128i values) {         \
+    (void)values;                                                    \
+    return Lanes_Ones();                                             \
+  }                                                                  \
+  static __m128i Narrow_Saturated_iu##SIZE(__m128i values) {         \
+    return Lanes_Not(Lanes_SignMask_##SIZE(values));                 \
+  }
+
+_ATB_DEFINE_NARROW_SATURATED(16)
+_ATB_DEFINE_NARROW_SATURATED(32)
+_ATB_DEFINE_NARROW_SATURATED(64)
+
+#undef _ATB_DEFINE_NARROW_SATURATED
+
+#define _ATB_DEFINE_NARROW_STEP(KIND, DSIGN, SIZE)                         \
+  static inline struct Narrow Narrow_Step_##KIND##SIZE(                    \
+      struct Narrow lo, struct Narrow hi, enum Narrow_Policy policy) {     \
+    if (policy != Narrow_Truncate) {                                       \
+      __m128i const lo_failed =                                            \
+          Lanes_Not(Narrow_Fits_##DSIGN##SIZE(lo.value));                  \
+      __m128i const hi_failed =                                            \
+          Lanes_Not(Narrow_Fits_##DSIGN##SIZE(hi.value));                  \
+                                                                           \
+      if (policy == Narrow_Saturate) {                                     \
+        lo.value = Lanes_Blend(                                            \
+            lo_failed, Narrow_Saturated_##KIND##SIZE(lo.value), lo.value); \
+        hi.value = Lanes_Blend(                                            \
+            hi_failed, Narrow_Saturated_##KIND##SIZE(hi.value), hi.value); \
+      }                                                                    \
+                                                                           \
+      lo.failed = _mm_or_si128(lo.failed, lo_failed);                      \
+      hi.failed = _mm_or_si128(hi.failed, hi_failed);                      \
+    }                                                                      \
+                                                                           \
+    struct Narrow narrow;                                                  \
+    narrow.value = Narrow_Pack_##SIZE(lo.value, hi.value);                 \
+    narrow.failed = Narrow_Pack_##SIZE(lo.failed, hi.failed);              \
+    return narrow;                                                         \
+  }
+
+_ATB_DEFINE_NARROW_STEP(ii, i, 16)
+_ATB_DEFINE_NARROW_STEP(ii, i, 32)
+_ATB_DEFINE_NARROW_STEP(ii, i, 64)
+_ATB_DEFINE_NARROW_STEP(uu, u, 16)
+_ATB_DEFINE_NARROW_STEP(uu, u, 32)
+_ATB_DEFINE_NARROW_STEP(uu, u, 64)
+_ATB_DEFINE_NARROW_STEP(iu, u, 16)
+_ATB_DEFINE_NARROW_STEP(iu, u, 32)
+_ATB_DEFINE_NARROW_STEP(iu, u, 64)
+
+#undef _ATB_DEFINE_NARROW_STEP
+
+/// Load 16 bytes of elements (no conversion)
+#define _ATB_DEFINE_NARROW_LOAD_SAME(NAME)                   \
+  static inline struct Narrow Narrow_Load_##NAME##_##NAME(   \
+      uint8_t const *const src, enum Narrow_Policy policy) { \
+    (void)policy;                                            \
+                                                             \
+    struct Narrow narrow;                                    \
+    narrow.value = _mm_loadu_si128((__m128i const *)src);    \
+    narrow.failed = _mm_setzero_si128();                     \
+    return narrow;                                           \
+  }
+
+_ATB_DEFINE_NARROW_LOAD_SAME(i16)
+_ATB_DEFINE_NARROW_LOAD_SAME(i32)
+_ATB_DEFINE_NARROW_LOAD_SAME(i64)
+_ATB_DEFINE_NARROW_LOAD_SAME(u16)
+_ATB_DEFINE_NARROW_LOAD_SAME(u32)
+_ATB_DEFINE_NARROW_LOAD_SAME(u64)
+
+#undef _ATB_DEFINE_NARROW_LOAD_SAME
+
+/// Load 16 bytes of DST elements, converted from twice as many bytes (or
+/// more) of SRC elements: pairs of NEXT elements narrowed by one step
+#define _ATB_DEFINE_NARROW_LOAD(SRC, SSIZE, DST, NEXT, KIND, NSIZE)     \
+  static inline struct Narrow Narrow_Load_##SRC##_##DST(                \
+      uint8_t const *const src, enum Narrow_Policy policy) {            \
+    return Narrow_Step_##KIND##NSIZE(                                   \
+        Narrow_Load_##SRC##_##NEXT(src, policy),                        \
+        Narrow_Load_##SRC##_##NEXT(src + (16 * SSIZE / NSIZE), policy), \
+        policy);                                                        \
+  }
+
+_ATB_DEFINE_NARROW_LOAD(i64, 64, i32, i64, ii, 64)
+_ATB_DEFINE_NARROW_LOAD(i64, 64, i16, i32, ii, 32)
+_ATB_DEFINE_NARROW_LOAD(i64, 64, i8, i16, ii, 16)
+_ATB_DEFINE_NARROW_LOAD(i32, 32, i16, i32, ii, 32)
+_ATB_DEFINE_NARROW_LOAD(i32, 32, i8, i16, ii, 16)
+_ATB_DEFINE_NARROW_LOAD(i16, 16, i8, i16, ii, 16)
+_ATB_DEFINE_NARROW_LOAD(u64, 64, u32, u64, uu, 64)
+_ATB_DEFINE_NARROW_LOAD(u64, 64, u16, u32, uu, 32)
+_ATB_DEFINE_NARROW_LOAD(u64, 64, u8, u16, uu, 16)
+_ATB_DEFINE_NARROW_LOAD(u32, 32, u16, u32, uu, 32)
+_ATB_DEFINE_NARROW_LOAD(u32, 32, u8, u16, uu, 16)
+_ATB_DEFINE_NARROW_LOAD(u16, 16, u8, u16, uu, 16)
+_ATB_DEFINE_NARROW_LOAD(i64, 64, u32, i64, iu, 64)
+_ATB_DEFINE_NARROW_LOAD(i64, 64, u16, u32, uu, 32)
+_ATB_DEFINE_NARROW_LOAD(i64, 64, u8, u16, uu, 16)
+_ATB_DEFINE_NARROW_LOAD(i32, 32, u16, i32, iu, 32)
+_ATB_DEFINE_NARROW_LOAD(i32, 32, u8, u16, uu, 16)
+_ATB_DEFINE_NARROW_LOAD(i16, 16, u8, i16, iu, 16)
+
+#undef _ATB_DEFINE_NARROW_LOAD
+
+#define _ATB_DEFINE_NARROW_BULK(ST, SRC, SSIZE, DT, DST, DSIZE, ...)      \
+  static inline size_t Narrow_Bulk_##SRC##_##DST(                         \
+      DT *const dest, ST const *const src, size_t size,                   \
+      enum Narrow_Policy policy, bool *const success) {                   \
+    size_t const lanes = 16 / (DSIZE / 8);                                \
+    __m128i failed = _mm_setzero_si128();                                 \
+    size_t i = 0;                                                         \
+                                                                          \
+    for (; (i + lanes) <= size; i += lanes) {                             \
+      struct Narrow const narrow =                                        \
+          Narrow_Load_##SRC##_##DST((uint8_t const *)(src + i), policy);  \
+      __m128i value = narrow.value;                                       \
+                                                                          \
+      if (policy == Narrow_Safely) {                                      \
+        value = Lanes_Blend(narrow.failed,                                \
+                            _mm_loadu_si128((__m128i const *)(dest + i)), \
+                            value);                                       \
+      }                                                                   \
+                                                                          \
+      _mm_storeu_si128((__m128i *)(dest + i), value);                     \
+      failed = _mm_or_si128(failed, narrow.failed);                       \
+    }                                                                     \
+                                                                          \
+    *success = (_mm_movemask_epi8(failed) == 0);                          \
+    return i;                                                             \
+  }
+
+_ATB_INTS_X_FOREACH_NARROWING(_ATB_DEFINE_NARROW_BULK)
+
+#undef _ATB_DEFINE_NARROW_BULK
+
+#else
+
+#define _ATB_DEFINE_WIDEN_BULK(ST, SRC, SSIZE, DT, DST, ...)                  \
+  static size_t Widen_Bulk_##SRC##_##DST(DT *const dest, ST const *const src, \
+                                         size_t size) {                       \
+    (void)dest;                                                               \
+    (void)src;                                                                \
+    (void)size;                                                               \
+    return 0;                                                                 \
+  }
+
+_ATB_INTS_X_FOREACH_WIDENING(_ATB_DEFINE_WIDEN_BULK)
+
+#undef _ATB_DEFINE_WIDEN_BULK
+
+#define _ATB_DEFINE_NARROW_BULK(ST, SRC, SSIZE, DT, DST, ...) \
+  static inline size_t Narrow_Bulk_##SRC##_##DST(             \
+      DT *const dest, ST const *const src, size_t size,       \
+      enum Narrow_Policy policy, bool *const success) {       \
+    (void)dest;                                               \
+    (void)src;                                                \
+    (void)size;                                               \
+    (void)policy;                                             \
+    *success = true;                                          \
+    return 0;                                                 \
+  }
+
+_ATB_INTS_X_FOREACH_NARROWING(_ATB_DEFINE_NARROW_BULK)
+
+#undef _ATB_DEFINE_NARROW_BULK
+
+#endif
+
+/// Clamp value in [min, max], returning false when it was out of range
+/// (computed with 64 bits (un)signed ints: Narrow_i/Narrow_u)
+#define _ATB_DEFINE_NARROW_SCALAR(SIGN, T)                       \
+  typedef T Narrow_##SIGN;                                       \
+  static inline bool Narrow_Scalar_##SIGN(T value, T min, T max, \
+                                          T *const dest) {       \
+    *dest = (value < min) ? min : ((value > max) ? max : value); \
+    return *dest == value;                                       \
+  }
+
+_ATB_DEFINE_NARROW_SCALAR(i, int64_t)
+_ATB_DEFINE_NARROW_SCALAR(u, uint64_t)
+
+#undef _ATB_DEFINE_NARROW_SCALAR
+
+#define _ATB_DEFINE_INT_WIDEN(ST, SRC, SSIZE, DT, DST, ...)             \
+  void atb_Span_##DST##_Widen_##SRC(struct atb_Span_##DST dest,         \
+                                    struct atb_View_##SRC src) {        \
+    assert(atb_Span_##DST##_IsValid(dest));                             \
+    assert(atb_View_##SRC##_IsValid(src) && (src.size == dest.size));   \
+                                                                        \
+    size_t i = Widen_Bulk_##SRC##_##DST(dest.data, src.data, src.size); \
+    for (; i < src.size; ++i) dest.data[i] = (DT)src.data[i];           \
+  }
+
+_ATB_INTS_X_FOREACH_WIDENING(_ATB_DEFINE_INT_WIDEN)
+
+#undef _ATB_DEFINE_INT_WIDEN
+
+#define _ATB_DEFINE_INT_NARROW(ST, SRC, SSIZE, DT, DST, DSIZE, SSIGN, DMIN,  \
+                               DMAX)                                         \
+  /* Bulk (SIMD) conversion, then the remaining elements one at a time */    \
+  static inline bool Narrow_##SRC##_##DST(struct atb_Span_##DST dest,        \
+                                          struct atb_View_##SRC src,         \
+                                          enum Narrow_Policy policy) {       \
+    assert(atb_Span_##DST##_IsValid(dest));                                  \
+    assert(atb_View_##SRC##_IsValid(src) && (src.size == dest.size));        \
+                                                                             \
+    bool success = true;                                                     \
+    size_t i = Narrow_Bulk_##SRC##_##DST(dest.data, src.data, src.size,      \
+                                         policy, &success);                  \
+                                                                             \
+    for (; i < src.size; ++i) {                                              \
+      if (policy == Narrow_Truncate) {                                       \
+        dest.data[i] = (DT)(uint##DSIZE##_t)src.data[i];                     \
+        continue;                                                            \
+      }                                                                      \
+                                                                             \
+      Narrow_##SSIGN value;                                                  \
+      if (Narrow_Scalar_##SSIGN(src.data[i], DMIN, DMAX, &value)) {          \
+        dest.data[i] = (DT)value;                                            \
+      } else {                                                               \
+        success = false;                                                     \
+        if (policy == Narrow_Saturate) dest.data[i] = (DT)value;             \
+      }                                                                      \
+    }                                                                        \
+                                                                             \
+    return success || (policy == Narrow_Truncate);                           \
+  }                                                                          \
+                                                                             \
+  bool atb_Span_##DST##_Narrow_##SRC##_Truncate(struct atb_Span_##DST dest,  \
+                                                struct atb_View_##SRC src) { \
+    return Narrow_##SRC##_##DST(dest, src, Narrow_Truncate);                 \
+  }                                                                          \
+                                                                             \
+  bool atb_Span_##DST##_Narrow_##SRC##_Saturate(struct atb_Span_##DST dest,  \
+                                                struct atb_View_##SRC src) { \
+    return Narrow_##SRC##_##DST(dest, src, Narrow_Saturate);                 \
+  }                                                                          \
+                                                                             \
+  bool atb_Span_##DST##_Narrow_##SRC##_Safely(struct atb_Span_##DST dest,    \
+                                              struct atb_View_##SRC src) {   \
+    return Narrow_##SRC##_##DST(dest, src, Narrow_Safely);                   \
+  }
+
+_ATB_INTS_X_FOREACH_NARROWING(_ATB_DEFINE_INT_NARROW)
+
+#undef _ATB_DEFINE_INT_NARROW
+
+/// Number of elements ahead of the current one whose destination is
+/// prefetched (scatter passes)
+#define K_RADIX_PREFETCH_DISTANCE 16
+
+/// Spans up to this size are sorted in place (insertion sort)
+#define K_RADIX_INSERTION_SIZE 32
+
+#if defined(__GNUC__) || defined(__clang__)
+#define RADIX_PREFETCH(addr) __builtin_prefetch((addr), 1)
+#else
+#define RADIX_PREFETCH(addr) ((void)(addr))
+#endif
+
+#define _ATB_DEFINE_RADIX_SORT(SIZE)                                         \
+  static void InsertionSort_##SIZE(uint##SIZE##_t *const data, size_t size,  \
+                                   uint##SIZE##_t flip) {                    \
+    for (size_t i = 1; i < size; ++i) {                                      \
+      uint##SIZE##_t const value = data[i];                                  \
+      uint##SIZE##_t const key = (uint##SIZE##_t)(value ^ flip);             \
+      size_t j = i;                                                          \
+                                                                             \
+      for (; (j > 0) && ((uint##SIZE##_t)(data[j - 1] ^ flip) > key); --j) { \
+        data[j] = data[j - 1];                                               \
+      }                                                                      \
+      data[j] = value;                                                       \
+    }                                                                        \
+  }                                                                          \
+                                                                             \
+  static bool RadixSort_##SIZE(uint##SIZE##_t *const data, size_t size,      \
+                               uint##SIZE##_t flip,                          \
+                               struct atb_Allocator const *const allocator,  \
+                               struct atb_Error *const err) {                \
+    size_t counts[SIZE / 8][256];                                            \
+    memset(counts, 0, sizeof(counts));                                       \
+                                                                             \
+    /* Histograms of all digits at once (single read of the data) */         \
+    for (size_t i = 0; i < size; ++i) {                                      \
+      uint##SIZE##_t const key = (uint##SIZE##_t)(data[i] ^ flip);           \
+      for (size_t d = 0; d < (SIZE / 8); ++d) {                              \
+        ++counts[d][(key >> (8 * d)) & 0xFF];                                \
+      }                                                                      \
+    }                                                                        \
+                                                                             \
+    /* Passes whose digit is the same for all elements are skipped */        \
+    uint##SIZE##_t const first = (uint##SIZE##_t)(data[0] ^ flip);           \
+    bool needed[SIZE / 8];                                                   \
+    bool any = false;                                                        \
+                                                                             \
+    for (size_t d = 0; d < (SIZE / 8); ++d) {                                \
+      needed[d] = (counts[d][(first >> (8 * d)) & 0xFF] != size);            \
+      any = any || needed[d];                                                \
+    }                                                                        \
+                                                                             \
+    if (!any) return true;                                                   \
+                                                                             \
+    uint##SIZE##_t *scratch = (uint##SIZE##_t *)atb_Allocator_Alloc(         \
+        allocator, NULL, size * sizeof(uint##SIZE##_t), err);                \
+    if (scratch == NULL) return false;                                       \
+                                                                             \
+    uint##SIZE##_t *src = data;                                              \
+    uint##SIZE##_t *dst = scratch;                                           \
+                                                                             \
+    for (size_t d = 0; d < (SIZE / 8); ++d) {                                \
+      if (!needed[d]) continue;                                              \
+                                                                             \
+      size_t offsets[256];                                                   \
+      size_t offset = 0;                                                     \
+      for (size_t b = 0; b < 256; ++b) {                                     \
+        offsets[b] = offset;                                                 \
+        offset += counts[d][b];                                              \
+      }                                                                      \
+                                                                             \
+      size_t const shift = 8 * d;                                            \
+      for (size_t i = 0; i < size; ++i) {                                    \
+        if ((i + K_RADIX_PREFETCH_DISTANCE) < size) {                        \
+          uint##SIZE##_t const ahead = (uint##SIZE##_t)(                     \
+              src[i + K_RADIX_PREFETCH_DISTANCE] ^ flip);                    \
+          RADIX_PREFETCH(dst + offsets[(ahead >> shift) & 0xFF]);            \
+        }                                                                    \
+                                                                             \
+        uint##SIZE##_t const value = src[i];                                 \
+        dst[offsets[((uint##SIZE##_t)(value ^ flip) >> shift) & 0xFF]++] =   \
+            value;                                                           \
+      }                                                                      \
+                                                                             \
+      uint##SIZE##_t *const swap = src;                                      \
+      src = dst;                                                             \
+      dst = swap;                                                            \
+    }                                                                        \
+                                                                             \
+    if (src != data) memcpy(data, src, size * sizeof(uint##SIZE##_t));       \
+                                                                             \
+    (void)atb_Allocator_Release(allocator, (void **)&scratch,                \
+                                K_ATB_ERROR_IGNORED);                        \
+    return true;                                                             \
+  }
+
+ATB_INTS_X_FOREACH_SIZES(_ATB_DEFINE_RADIX_SORT)
+
+#undef _ATB_DEFINE_RADIX_SORT
+
+#define _ATB_DEFINE_INT_RADIX_SORT(T, NAME, MIN, MAX, SIZE)         \
+  bool atb_Span_##NAME##_RadixSort(                                 \
+      struct atb_Span_##NAME span,                                  \
+      struct atb_Allocator const *const allocator,                  \
+      struct atb_Error *const err) {                                \
+    assert(atb_Span_##NAME##_IsValid(span));                        \
+    assert(allocator != NULL);                                      \
+                                                                    \
+    uint##SIZE##_t *const data = (uint##SIZE##_t *)span.data;       \
+    uint##SIZE##_t const flip = (uint##SIZE##_t)(MIN);              \
+                                                                    \
+    if (span.size <= K_RADIX_INSERTION_SIZE) {                      \
+      InsertionSort_##SIZE(data, span.size, flip);                  \
+      return true;                                                  \
+    }                                                               \
+                                                                    \
+    return RadixSort_##SIZE(data, span.size, flip, allocator, err); \
+  }
+
+ATB_INTS_X_FOREACH(_ATB_DEFINE_INT_RADIX_SORT)
+
+#undef _ATB_DEFINE_INT_RADIX_SORT
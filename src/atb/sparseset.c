@@ -0,0 +1,167 @@
+#include "atb/sparseset.h"
+
+#include <stdint.h> /* SIZE_MAX */
+#include <string.h>
+
+/// Number of ids/members allocated on the first insertion
+static const size_t K_SPARSE_SET_MIN_CAPACITY = 8;
+
+/// Largest number of ids (and members) storable
+static size_t SparseSet_MaxCapacity(void) {
+  uint64_t const ids = (uint64_t)UINT32_MAX + 1;
+  size_t const elements = SIZE_MAX / sizeof(uint32_t);
+
+  return (ids < (uint64_t)elements) ? (size_t)ids : elements;
+}
+
+/// Same as atb_SparseSet_Reserve for the sparse array only
+static bool SparseSet_ReserveIds(struct atb_SparseSet *const self,
+                                 size_t universe,
+                                 struct atb_Error *const err) {
+  if (self->universe >= universe) return true;
+
+  if (universe > SparseSet_MaxCapacity()) {
+    atb_GenericError_Set(err, K_ATB_ERROR_GENERIC_VALUE_TOO_LARGE);
+    return false;
+  }
+
+  uint32_t *const sparse = (uint32_t *)atb_Allocator_Alloc(
+      self->allocator, self->sparse, universe * sizeof(uint32_t), err);
+
+  if (sparse == NULL) return false;
+
+  // Never read as a position unless written first, cleared to keep reads of
+  // stale entries defined
+  memset(&(sparse[self->universe]), 0,
+         (universe - self->universe) * sizeof(uint32_t));
+
+  self->sparse = sparse;
+  self->universe = universe;
+
+  return true;
+}
+
+/// Same as atb_SparseSet_Reserve for the dense array only
+static bool SparseSet_ReserveMembers(struct atb_SparseSet *const self,
+                                     size_t capacity,
+                                     struct atb_Error *const err) {
+  if (self->capacity >= capacity) return true;
+
+  if (capacity > SparseSet_MaxCapacity()) {
+    atb_GenericError_Set(err, K_ATB_ERROR_GENERIC_VALUE_TOO_LARGE);
+    return false;
+  }
+
+  uint32_t *const dense = (uint32_t *)atb_Allocator_Alloc(
+      self->allocator, self->dense, capacity * sizeof(uint32_t), err);
+
+  if (dense == NULL) return false;
+
+  self->dense = dense;
+  self->capacity = capacity;
+
+  return true;
+}
+
+/// Next geometric capacity, able to hold needed elements
+static size_t SparseSet_Grow(size_t current, size_t needed) {
+  size_t const max = SparseSet_MaxCapacity();
+
+  size_t count = (current < (max / 2)) ? (current * 2) : max;
+  if (count < K_SPARSE_SET_MIN_CAPACITY) count = K_SPARSE_SET_MIN_CAPACITY;
+  if (count < needed) count = needed;
+  if (count > max) count = max;
+
+  return count;
+}
+
+void atb_SparseSet_Init(struct atb_SparseSet *const self,
+                        struct atb_Allocator const *const allocator) {
+  assert(self != NULL);
+  assert(allocator != NULL);
+
+  self->dense = NULL;
+  self->sparse = NULL;
+  self->size = 0;
+  self->capacity = 0;
+  self->universe = 0;
+  self->allocator = allocator;
+}
+
+void atb_SparseSet_Destroy(struct atb_SparseSet *const self) {
+  assert(self != NULL);
+
+  if (self->dense != NULL) {
+    (void)atb_Allocator_Release(self->allocator, (void **)&(self->dense),
+                                K_ATB_ERROR_IGNORED);
+  }
+
+  if (self->sparse != NULL) {
+    (void)atb_Allocator_Release(self->allocator, (void **)&(self->sparse),
+                                K_ATB_ERROR_IGNORED);
+  }
+
+  self->dense = NULL;
+  self->sparse = NULL;
+  self->size = 0;
+  self->capacity = 0;
+  self->universe = 0;
+}
+
+bool atb_SparseSet_Reserve(struct atb_SparseSet *const self, size_t universe,
+                           size_t capacity, struct atb_Error *const err) {
+  assert(self != NULL);
+  assert((uint64_t)universe <= ((uint64_t)UINT32_MAX + 1));
+
+  // Growing the sparse array first is fine: the set itself is unchanged
+  return SparseSet_ReserveIds(self, universe, err) &&
+         SparseSet_ReserveMembers(self, capacity, err);
+}
+
+bool atb_SparseSet_Insert(struct atb_SparseSet *const self, uint32_t id,
+                          struct atb_Error *const err) {
+  assert(self != NULL);
+
+  if (atb_SparseSet_Contains(self, id)) return true;
+
+  if (id >= self->universe) {
+    // id + 1 doesn't fit the sparse array (nor size_t when 32 bits)
+    if (id >= SparseSet_MaxCapacity()) {
+      atb_GenericError_Set(err, K_ATB_ERROR_GENERIC_VALUE_TOO_LARGE);
+      return false;
+    }
+
+    if (!SparseSet_ReserveIds(
+            self, SparseSet_Grow(self->universe, (size_t)id + 1), err)) {
+      return false;
+    }
+  }
+
+  size_t const capacity = self->size + 1;
+  if ((self->capacity < capacity) &&
+      !SparseSet_ReserveMembers(self, SparseSet_Grow(self->capacity, capacity),
+                                err)) {
+    return false;
+  }
+
+  self->dense[self->size] = id;
+  self->sparse[id] = (uint32_t)self->size;
+  self->size += 1;
+
+  return true;
+}
+
+bool atb_SparseSet_Erase(struct atb_SparseSet *const self, uint32_t id) {
+  assert(self != NULL);
+
+  if (!atb_SparseSet_Contains(self, id)) return false;
+
+  uint32_t const position = self->sparse[id];
+  uint32_t const last = self->dense[self->size - 1];
+
+  self->dense[position] = last;
+  self->sparse[last] = position;
+  self->size -= 1;
+
+  return true;
+}
@@ -1,6 +1,8 @@
 #include "atb/string.h"
 
-#include <ctype.h> /* isdigit */
+#include <ctype.h>  /* isdigit */
+#include <stdint.h> /* SIZE_MAX */
+#include <string.h>
 
 static const struct atb_StrView m_digits =
     atb_StrView_From_StrLiteral_INIT("0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ");
@@ -169,3 +171,167 @@ bool atb_String_GetIntBase(struct atb_StrView str, ATB_INT_BASE *const base,
 
   return success;
 }
+
+/***************************************************************************/
+/*                              Owned string                               */
+/***************************************************************************/
+
+/// Index of the tag byte inside storage.local
+#define K_STRING_TAG (K_ATB_STRING_INLINE_CAPACITY + 1)
+
+/// Size of the capacity header in front of the heap chars
+#define K_STRING_HEADER sizeof(size_t)
+
+static_assert(sizeof(struct atb_String_Heap) <= K_STRING_TAG,
+              "The heap storage must not overlap the tag byte");
+
+static char *String_Data(struct atb_String *const self) {
+  return atb_String_IsInline(self) ? self->storage.local
+                                   : self->storage.heap.data;
+}
+
+static size_t String_HeapCapacity(char const *const data) {
+  size_t capacity = 0;
+  memcpy(&capacity, data - K_STRING_HEADER, sizeof(capacity));
+  return capacity;
+}
+
+/// Update the size of self (null terminating the chars)
+static void String_SetSize(struct atb_String *const self, size_t size) {
+  if (atb_String_IsInline(self)) {
+    assert(size <= K_ATB_STRING_INLINE_CAPACITY);
+    self->storage.local[size] = '\0';
+    self->storage.local[K_STRING_TAG] = (char)size;
+  } else {
+    self->storage.heap.data[size] = '\0';
+    self->storage.heap.size = size;
+  }
+}
+
+/// Offset of str inside the chars of self (inside set when part of them)
+static size_t String_Offset(struct atb_String *const self,
+                            struct atb_StrView str, bool *const inside) {
+  uintptr_t const begin = (uintptr_t)String_Data(self);
+  uintptr_t const where = (uintptr_t)str.data;
+
+  *inside = (begin <= where) && (where < (begin + atb_String_Size(self)));
+  return (size_t)(where - begin);
+}
+
+/// Grow up to needed chars, at least doubling the current capacity
+static bool String_Grow(struct atb_String *const self, size_t needed,
+                        struct atb_Error *const err) {
+  size_t const capacity = atb_String_Capacity(self);
+  if (capacity >= needed) return true;
+
+  size_t const doubled = (capacity < (SIZE_MAX / 2)) ? (capacity * 2) : needed;
+  return atb_String_Reserve(self, (doubled < needed) ? needed : doubled, err);
+}
+
+void atb_String_Init(struct atb_String *const self,
+                     struct atb_Allocator const *const allocator) {
+  assert(self != NULL);
+  assert(allocator != NULL);
+
+  self->storage.local[0] = '\0';
+  self->storage.local[K_STRING_TAG] = 0;
+  self->allocator = allocator;
+}
+
+void atb_String_Destroy(struct atb_String *const self) {
+  assert(self != NULL);
+
+  if (!atb_String_IsInline(self)) {
+    void *block = self->storage.heap.data - K_STRING_HEADER;
+    (void)atb_Allocator_Release(self->allocator, &block, K_ATB_ERROR_IGNORED);
+  }
+
+  self->storage.local[0] = '\0';
+  self->storage.local[K_STRING_TAG] = 0;
+}
+
+size_t atb_String_Capacity(struct atb_String const *const self) {
+  return atb_String_IsInline(self)
+             ? K_ATB_STRING_INLINE_CAPACITY
+             : String_HeapCapacity(self->storage.heap.data);
+}
+
+bool atb_String_Reserve(struct atb_String *const self, size_t capacity,
+                        struct atb_Error *const err) {
+  assert(self != NULL);
+
+  if (atb_String_Capacity(self) >= capacity) return true;
+
+  if (capacity > (SIZE_MAX - K_STRING_HEADER - 1)) {
+    atb_GenericError_Set(err, K_ATB_ERROR_GENERIC_VALUE_TOO_LARGE);
+    return false;
+  }
+
+  bool const is_inline = atb_String_IsInline(self);
+  size_t const size = atb_String_Size(self);
+
+  char *const orig =
+      is_inline ? NULL : (self->storage.heap.data - K_STRING_HEADER);
+  char *const block = (char *)atb_Allocator_Alloc(
+      self->allocator, orig, K_STRING_HEADER + capacity + 1, err);
+
+  if (block == NULL) return false;
+
+  char *const data = block + K_STRING_HEADER;
+  memcpy(block, &capacity, sizeof(capacity));
+
+  if (is_inline) {
+    memcpy(data, self->storage.local, size + 1);
+    self->storage.local[K_STRING_TAG] = (char)K_ATB_STRING_HEAP_TAG;
+  }
+
+  self->storage.heap.data = data;
+  self->storage.heap.size = size;
+
+  return true;
+}
+
+bool atb_String_Assign(struct atb_String *const self, struct atb_StrView str,
+                       struct atb_Error *const err) {
+  assert(self != NULL);
+  assert((str.size == 0) || (str.data != NULL));
+
+  // Any part of self is no larger than its capacity: never reallocated here
+  if (!atb_String_Reserve(self, str.size, err)) return false;
+
+  if (str.size != 0) memmove(String_Data(self), str.data, str.size);
+  String_SetSize(self, str.size);
+
+  return true;
+}
+
+bool atb_String_Append(struct atb_String *const self, struct atb_StrView str,
+                       struct atb_Error *const err) {
+  assert(self != NULL);
+  assert((str.size == 0) || (str.data != NULL));
+
+  size_t const size = atb_String_Size(self);
+
+  if (str.size > (SIZE_MAX - K_STRING_HEADER - 1 - size)) {
+    atb_GenericError_Set(err, K_ATB_ERROR_GENERIC_VALUE_TOO_LARGE);
+    return false;
+  }
+
+  bool inside = false;
+  size_t const offset = String_Offset(self, str, &inside);
+
+  if (!String_Grow(self, size + str.size, err)) return false;
+
+  char *const data = String_Data(self);
+  if (str.size != 0) {
+    memmove(data + size, inside ? (data + offset) : str.data, str.size);
+  }
+  String_SetSize(self, size + str.size);
+
+  return true;
+}
+
+void atb_String_Clear(struct atb_String *const self) {
+  assert(self != NULL);
+  String_SetSize(self, 0);
+}
@@ -0,0 +1,485 @@
+/*
+ * Generate a minimal perfect hash (C sources) of a static set of keys.
+ *
+ * Usage: atb-perfect-hash <NAME> <KEYS_FILE> <OUTPUT_C> <OUTPUT_H>
+ *
+ * KEYS_FILE lists the keys, one per line (empty lines are ignored). The keys
+ * are hashed using atb_Hash_StrView, then spread into buckets. Each bucket
+ * gets a displacement (searched from the largest bucket to the smallest),
+ * such that all keys land on a distinct slot of a table of exactly N slots
+ * ('hash and displace'). A lookup is then: 2 hashes, 2 table reads and a
+ * single key comparison.
+ *
+ * The generated header declares:
+ * - `K_<NAME>_SIZE`: Number of keys;
+ * - `<NAME>_Find(key, index) -> bool`: Find key inside the set, optionally
+ *   returning its index (line order of KEYS_FILE);
+ * - `<NAME>_Key(index) -> struct atb_StrView`: index-th key;
+ */
+#include <ctype.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "atb/hash.h"
+
+/// Average number of keys per bucket
+#define K_KEYS_PER_BUCKET 4
+
+/// Maximum displacement tried for a bucket, before trying another seed
+#define K_MAX_DISPLACEMENT (UINT32_C(1) << 20)
+
+/// Maximum number of seeds tried
+#define K_MAX_SEEDS 64
+
+/// Spread the displacement bits over the whole hash (must match the
+/// generated code)
+#define K_DISPLACEMENT_MULTIPLIER UINT64_C(0x9E3779B97F4A7C15)
+
+struct Keys {
+  char *content;             /*!< Content of the keys file */
+  struct atb_StrView *views; /*!< Keys, pointing inside content */
+  uint64_t *hashes;          /*!< Hash of each key */
+  size_t size;               /*!< Number of keys */
+};
+
+struct Table {
+  uint64_t seed;          /*!< Seed of the key hashes */
+  uint32_t buckets;       /*!< Number of buckets */
+  uint32_t *displacement; /*!< Displacement of each bucket */
+  uint32_t *slots;        /*!< Key index stored at each slot */
+};
+
+/// Map hash uniformly to [0, range) (without modulo)
+static uint32_t Reduce(uint32_t hash, uint32_t range) {
+  return (uint32_t)(((uint64_t)hash * range) >> 32);
+}
+
+static uint32_t Bucket(struct Table const *table, uint64_t hash) {
+  return Reduce((uint32_t)(hash >> 32), table->buckets);
+}
+
+static uint32_t Slot(uint64_t hash, uint32_t displacement, uint32_t size) {
+  uint64_t const mixed =
+      atb_Hash_u64(hash ^ (displacement * K_DISPLACEMENT_MULTIPLIER));
+  return Reduce((uint32_t)(mixed >> 32), size);
+}
+
+static bool Keys_Read(struct Keys *keys, char const *path) {
+  FILE *const file = fopen(path, "rb");
+  if (file == NULL) {
+    fprintf(stderr, "Unable to open '%s'\n", path);
+    return false;
+  }
+
+  size_t capacity = 4096;
+  size_t size = 0;
+  keys->content = (char *)malloc(capacity);
+
+  while (keys->content != NULL) {
+    size += fread(keys->content + size, 1, capacity - size, file);
+    if (size < capacity) break;
+
+    capacity *= 2;
+    char *const content = (char *)realloc(keys->content, capacity);
+    if (content == NULL) free(keys->content);
+    keys->content = content;
+  }
+
+  bool const success = (keys->content != NULL) && !ferror(file);
+  fclose(file);
+
+  if (!success) {
+    fprintf(stderr, "Unable to read '%s'\n", path);
+    return false;
+  }
+
+  /* At most one key per line */
+  size_t lines = 1;
+  for (size_t i = 0; i < size; ++i) lines += (keys->content[i] == '\n');
+
+  keys->views =
+      (struct atb_StrView *)malloc(lines * sizeof(struct atb_StrView));
+  keys->hashes = (uint64_t *)malloc(lines * sizeof(uint64_t));
+  keys->size = 0;
+
+  if ((keys->views == NULL) || (keys->hashes == NULL)) {
+    fprintf(stderr, "Not enough memory\n");
+    return false;
+  }
+
+  for (size_t begin = 0; begin < size;) {
+    char const *const end = (char const *)memchr(keys->content + begin, '\n',
+                                                 size - begin);
+    size_t const length =
+        (end == NULL) ? (size - begin) : (size_t)(end - keys->content) - begin;
+
+    /* Windows line endings */
+    size_t const key_length =
+        ((length > 0) && (keys->content[begin + length - 1] == '\r'))
+            ? (length - 1)
+            : length;
+
+    if (key_length > 0) {
+      keys->views[keys->size] =
+          atb_StrView_From(keys->content + begin, key_length);
+      keys->size += 1;
+    }
+
+    begin += length + 1;
+  }
+
+  return true;
+}
+
+static bool Keys_HasDuplicates(struct Keys const *keys) {
+  for (size_t i = 0; i < keys->size; ++i) {
+    for (size_t j = i + 1; j < keys->size; ++j) {
+      if ((keys->views[i].size == keys->views[j].size) &&
+          (memcmp(keys->views[i].data, keys->views[j].data,
+                  keys->views[i].size) == 0)) {
+        fprintf(stderr, "Duplicated key '%.*s' (lines %zu and %zu)\n",
+                (int)keys->views[i].size, keys->views[i].data, i + 1, j + 1);
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+struct Bucket {
+  uint32_t index; /*!< Bucket index */
+  uint32_t size;  /*!< Number of keys inside the bucket */
+};
+
+static int Bucket_CompareSizeDesc(void const *lhs, void const *rhs) {
+  struct Bucket const *const a = (struct Bucket const *)lhs;
+  struct Bucket const *const b = (struct Bucket const *)rhs;
+
+  if (a->size != b->size) return (a->size > b->size) ? -1 : 1;
+  return (a->index < b->index) ? -1 : ((a->index > b->index) ? 1 : 0);
+}
+
+/// Try to build table->displacement/slots with table->seed. Returns false
+/// when a bucket couldn't be placed.
+static bool Table_TryBuild(struct Table *table, struct Keys const *keys,
+                           struct Bucket *buckets, uint32_t *members,
+                           uint32_t *starts, bool *used) {
+  uint32_t const size = (uint32_t)keys->size;
+
+  for (uint32_t i = 0; i < size; ++i) {
+    keys->hashes[i] = atb_Hash_StrView(keys->views[i], table->seed);
+  }
+
+  /* Group keys per bucket (counting sort) */
+  memset(starts, 0, (table->buckets + 1) * sizeof(uint32_t));
+  for (uint32_t i = 0; i < size; ++i) {
+    starts[Bucket(table, keys->hashes[i]) + 1] += 1;
+  }
+
+  for (uint32_t b = 0; b < table->buckets; ++b) {
+    buckets[b].index = b;
+    buckets[b].size = starts[b + 1];
+    starts[b + 1] += starts[b];
+  }
+
+  /* Fill each bucket from its end: starts[b + 1] ends up on its first key */
+  for (uint32_t i = size; i > 0; --i) {
+    uint32_t const b = Bucket(table, keys->hashes[i - 1]);
+    starts[b + 1] -= 1;
+    members[starts[b + 1]] = i - 1;
+  }
+
+  qsort(buckets, table->buckets, sizeof(struct Bucket),
+        Bucket_CompareSizeDesc);
+
+  memset(used, 0, size * sizeof(bool));
+
+  for (uint32_t b = 0; (b < table->buckets) && (buckets[b].size > 0); ++b) {
+    uint32_t const *const bucket = &(members[starts[buckets[b].index + 1]]);
+    uint32_t const count = buckets[b].size;
+    uint32_t d = 0;
+
+    for (; d < K_MAX_DISPLACEMENT; ++d) {
+      uint32_t placed = 0;
+
+      for (; placed < count; ++placed) {
+        uint32_t const slot = Slot(keys->hashes[bucket[placed]], d, size);
+        if (used[slot]) break;
+        used[slot] = true;
+        table->slots[slot] = bucket[placed];
+      }
+
+      if (placed == count) break;
+
+      /* Rollback the keys placed with this displacement */
+      while (placed > 0) {
+        placed -= 1;
+        used[Slot(keys->hashes[bucket[placed]], d, size)] = false;
+      }
+    }
+
+    if (d == K_MAX_DISPLACEMENT) return false;
+    table->displacement[buckets[b].index] = d;
+  }
+
+  return true;
+}
+
+static bool Table_Build(struct Table *table, struct Keys const *keys) {
+  table->buckets = (uint32_t)((keys->size + K_KEYS_PER_BUCKET - 1) /
+                              K_KEYS_PER_BUCKET);
+  table->displacement =
+      (uint32_t *)calloc(table->buckets, sizeof(uint32_t));
+  table->slots = (uint32_t *)malloc(keys->size * sizeof(uint32_t));
+
+  struct Bucket *const buckets =
+      (struct Bucket *)malloc(table->buckets * sizeof(struct Bucket));
+  uint32_t *const members = (uint32_t *)malloc(keys->size * sizeof(uint32_t));
+  uint32_t *const starts =
+      (uint32_t *)malloc((table->buckets + 1) * sizeof(uint32_t));
+  bool *const used = (bool *)malloc(keys->size * sizeof(bool));
+
+  bool success = (table->displacement != NULL) && (table->slots != NULL) &&
+                 (buckets != NULL) && (members != NULL) && (starts != NULL) &&
+                 (used != NULL);
+
+  if (!success) fprintf(stderr, "Not enough memory\n");
+
+  for (uint32_t attempt = 0; success && (attempt < K_MAX_SEEDS); ++attempt) {
+    table->seed = atb_Hash_u64(K_ATB_HASH_SEED + attempt);
+    if (Table_TryBuild(table, keys, buckets, members, starts, used)) break;
+
+    if ((attempt + 1) == K_MAX_SEEDS) {
+      fprintf(stderr, "Unable to find a perfect hash\n");
+      success = false;
+    }
+  }
+
+  free(used);
+  free(starts);
+  free(members);
+  free(buckets);
+
+  return success;
+}
+
+/// Smallest unsigned type able to hold max
+static char const *Type_For(uint32_t max) {
+  return (max <= UINT8_MAX) ? "uint8_t"
+                            : ((max <= UINT16_MAX) ? "uint16_t" : "uint32_t");
+}
+
+/// Write str as a C string literal (octal escapes, such that the following
+/// character can't be interpreted as part of the escape sequence)
+static void Write_Literal(FILE *out, struct atb_StrView str) {
+  fputc('"', out);
+
+  for (size_t i = 0; i < str.size; ++i) {
+    unsigned char const c = (unsigned char)str.data[i];
+
+    if (isalnum(c) || ((c != '"') && (c != '\\') && (c != '?') && isprint(c))) {
+      fputc(c, out);
+    } else {
+      fprintf(out, "\\%03o", c);
+    }
+  }
+
+  fputc('"', out);
+}
+
+static bool Write_Header(char const *path, char const *name,
+                         char const *upper_name, struct Keys const *keys) {
+  FILE *const out = fopen(path, "w");
+  if (out == NULL) {
+    fprintf(stderr, "Unable to open '%s'\n", path);
+    return false;
+  }
+
+  fprintf(out,
+          "#pragma once\n"
+          "\n"
+          "/* Generated by atb-perfect-hash: DO NOT EDIT */\n"
+          "\n"
+          "#include <stdbool.h>\n"
+          "#include <stddef.h>\n"
+          "\n"
+          "#include \"atb/span/string.h\"\n"
+          "\n"
+          "#if defined(__cplusplus)\n"
+          "extern \"C\" {\n"
+          "#endif\n"
+          "\n"
+          "/// Number of keys of the set\n"
+          "#define K_%s_SIZE %zu\n"
+          "\n"
+          "/**\n"
+          " *  \\brief Find \\a key inside the set (minimal perfect hash, a "
+          "single\n"
+          " *         key comparison)\n"
+          " *\n"
+          " *  \\param[out] index Set to the index of the key (optional)\n"
+          " *\n"
+          " *  \\return False when \\a key is not part of the set\n"
+          " *\n"
+          " *  \\pre atb_StrView_IsValid(key)\n"
+          " */\n"
+          "extern bool %s_Find(struct atb_StrView key, size_t *const index);\n"
+          "\n"
+          "/**\n"
+          " *  \\return The \\a index-th key of the set\n"
+          " *\n"
+          " *  \\pre index < K_%s_SIZE\n"
+          " */\n"
+          "extern struct atb_StrView %s_Key(size_t index);\n"
+          "\n"
+          "#if defined(__cplusplus)\n"
+          "} /* extern \"C\" */\n"
+          "#endif\n",
+          upper_name, keys->size, name, upper_name, name);
+
+  return fclose(out) == 0;
+}
+
+static bool Write_Source(char const *path, char const *header,
+                         char const *name, char const *upper_name,
+                         struct Keys const *keys, struct Table const *table) {
+  FILE *const out = fopen(path, "w");
+  if (out == NULL) {
+    fprintf(stderr, "Unable to open '%s'\n", path);
+    return false;
+  }
+
+  uint32_t max_displacement = 0;
+  for (uint32_t b = 0; b < table->buckets; ++b) {
+    if (table->displacement[b] > max_displacement) {
+      max_displacement = table->displacement[b];
+    }
+  }
+
+  fprintf(out,
+          "/* Generated by atb-perfect-hash: DO NOT EDIT */\n"
+          "\n"
+          "#include \"%s\"\n"
+          "\n"
+          "#include <assert.h>\n"
+          "#include <stdint.h>\n"
+          "#include <string.h>\n"
+          "\n"
+          "#include \"atb/hash.h\"\n"
+          "\n"
+          "static uint64_t const k_seed = UINT64_C(0x%016" PRIX64 ");\n"
+          "\n"
+          "static struct atb_StrView const k_keys[K_%s_SIZE] = {\n",
+          header, table->seed, upper_name);
+
+  for (size_t i = 0; i < keys->size; ++i) {
+    fputs("    atb_StrView_From_StrLiteral_INIT(", out);
+    Write_Literal(out, keys->views[i]);
+    fputs("),\n", out);
+  }
+
+  fprintf(out, "};\n\nstatic %s const k_displacements[%" PRIu32 "] = {",
+          Type_For(max_displacement), table->buckets);
+  for (uint32_t b = 0; b < table->buckets; ++b) {
+    fprintf(out, "%s%" PRIu32 ",", ((b % 12) == 0) ? "\n    " : " ",
+            table->displacement[b]);
+  }
+
+  fprintf(out, "\n};\n\nstatic %s const k_slots[K_%s_SIZE] = {",
+          Type_For((uint32_t)keys->size), upper_name);
+  for (size_t s = 0; s < keys->size; ++s) {
+    fprintf(out, "%s%" PRIu32 ",", ((s % 12) == 0) ? "\n    " : " ",
+            table->slots[s]);
+  }
+
+  fprintf(out,
+          "\n};\n"
+          "\n"
+          "static uint32_t Reduce(uint32_t hash, uint32_t range) {\n"
+          "  return (uint32_t)(((uint64_t)hash * range) >> 32);\n"
+          "}\n"
+          "\n"
+          "bool %s_Find(struct atb_StrView key, size_t *const index) {\n"
+          "  uint64_t const hash = atb_Hash_StrView(key, k_seed);\n"
+          "  uint64_t const displacement =\n"
+          "      k_displacements[Reduce((uint32_t)(hash >> 32), "
+          "%" PRIu32 ")];\n"
+          "  uint64_t const mixed =\n"
+          "      atb_Hash_u64(hash ^ (displacement * UINT64_C(0x%016" PRIX64
+          ")));\n"
+          "  size_t const i =\n"
+          "      k_slots[Reduce((uint32_t)(mixed >> 32), K_%s_SIZE)];\n"
+          "\n"
+          "  if ((key.size != k_keys[i].size) ||\n"
+          "      (memcmp(key.data, k_keys[i].data, key.size) != 0)) {\n"
+          "    return false;\n"
+          "  }\n"
+          "\n"
+          "  if (index != NULL) *index = i;\n"
+          "\n"
+          "  return true;\n"
+          "}\n"
+          "\n"
+          "struct atb_StrView %s_Key(size_t index) {\n"
+          "  assert(index < K_%s_SIZE);\n"
+          "  return k_keys[index];\n"
+          "}\n",
+          name, table->buckets, K_DISPLACEMENT_MULTIPLIER, upper_name, name,
+          upper_name);
+
+  return fclose(out) == 0;
+}
+
+int main(int argc, char *argv[]) {
+  if (argc != 5) {
+    fprintf(stderr,
+            "Usage: %s <NAME> <KEYS_FILE> <OUTPUT_C> <OUTPUT_H>\n"
+            "Generate a minimal perfect hash of the keys listed (one per "
+            "line) inside KEYS_FILE\n",
+            argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  char const *const name = argv[1];
+  char const *const output_h = argv[4];
+
+  char *const upper_name = (char *)malloc(strlen(name) + 1);
+  if (upper_name == NULL) return EXIT_FAILURE;
+  for (size_t i = 0; i <= strlen(name); ++i) {
+    upper_name[i] = (char)toupper((unsigned char)name[i]);
+  }
+
+  /* The generated source includes the header by its file name */
+  char const *header = strrchr(output_h, '/');
+  header = (header == NULL) ? output_h : (header + 1);
+
+  struct Keys keys = {NULL, NULL, NULL, 0};
+  struct Table table = {0, 0, NULL, NULL};
+
+  bool success = Keys_Read(&keys, argv[2]);
+
+  if (success && ((keys.size == 0) || (keys.size > UINT32_MAX))) {
+    fprintf(stderr, "Expecting between 1 and UINT32_MAX keys, got %zu\n",
+            keys.size);
+    success = false;
+  }
+
+  success = success && !Keys_HasDuplicates(&keys) &&
+            Table_Build(&table, &keys) &&
+            Write_Source(argv[3], header, name, upper_name, &keys, &table) &&
+            Write_Header(output_h, name, upper_name, &keys);
+
+  free(table.slots);
+  free(table.displacement);
+  free(keys.hashes);
+  free(keys.views);
+  free(keys.content);
+  free(upper_name);
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
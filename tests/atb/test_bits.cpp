@@ -62,5 +62,29 @@ TEST(AtbBitsTest, Unset) {
   EXPECT_EQ(value, 0b1100'1100);
 }
 
+TEST(AtbBitsTest, Popcount) {
+  EXPECT_EQ(atb_Bits_Popcount_u64(0), 0);
+  EXPECT_EQ(atb_Bits_Popcount_u64(0b1011), 3);
+  EXPECT_EQ(atb_Bits_Popcount_u64(UINT64_MAX), 64);
+  EXPECT_EQ(atb_Bits_Popcount_u64(0x8000'0000'0000'0001), 2);
+}
+
+TEST(AtbBitsTest, Ctz) {
+  EXPECT_EQ(atb_Bits_Ctz_u64(0b1), 0);
+  EXPECT_EQ(atb_Bits_Ctz_u64(0b1000), 3);
+  EXPECT_EQ(atb_Bits_Ctz_u64(0x8000'0000'0000'0000), 63);
+}
+
+TEST(AtbBitsTest, Clz) {
+  EXPECT_EQ(atb_Bits_Clz_u64(0b1), 63);
+  EXPECT_EQ(atb_Bits_Clz_u64(0b1000), 60);
+  EXPECT_EQ(atb_Bits_Clz_u64(UINT64_MAX), 0);
+}
+
+TEST(AtbBitsDeathTest, CtzClz) {
+  EXPECT_DEBUG_DEATH(atb_Bits_Ctz_u64(0), "value != 0");
+  EXPECT_DEBUG_DEATH(atb_Bits_Clz_u64(0), "value != 0");
+}
+
 } // namespace
 } // namespace atb
@@ -0,0 +1,203 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "atb/bitset.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+struct AtbBitsetTest : testing::Test {
+  // Storage filled with garbage, to ensure bits beyond size are ignored
+  auto Make(std::size_t size) -> atb_Bitset {
+    storage.emplace_back(ATB_BITSET_WORDS_FOR(size), kGarbage);
+    auto &words = storage.back();
+    auto bitset = atb_Bitset_From({words.data(), words.size()}, size);
+    atb_Bitset_ClearRange(bitset, 0, size);
+    return bitset;
+  }
+
+  static auto ToVector(atb_Bitset bitset) -> std::vector<bool> {
+    std::vector<bool> bits(bitset.size);
+    for (std::size_t i = 0; i < bitset.size; ++i) {
+      bits[i] = atb_Bitset_Test(bitset, i);
+    }
+    return bits;
+  }
+
+  static constexpr std::uint64_t kGarbage = 0xA5A5A5A5A5A5A5A5;
+
+  std::vector<std::vector<std::uint64_t>> storage;
+};
+
+using AtbBitsetDeathTest = AtbBitsetTest;
+
+TEST_F(AtbBitsetDeathTest, Preconditions) {
+  std::uint64_t words[2] = {};
+
+  EXPECT_DEBUG_DEATH(atb_Bitset_From({words, 2}, 129), "words.size >=");
+
+  auto bitset = atb_Bitset_From({words, 2}, 100);
+  EXPECT_DEBUG_DEATH(atb_Bitset_Set(bitset, 100), "i < self.size");
+  EXPECT_DEBUG_DEATH(atb_Bitset_SetRange(bitset, 90, 11), "count <=");
+  EXPECT_DEBUG_DEATH(atb_Bitset_FindNext(bitset, 101), "from <= self.size");
+}
+
+TEST_F(AtbBitsetTest, SingleBit) {
+  auto bitset = Make(130);
+
+  EXPECT_EQ(atb_Bitset_Count(bitset), 0);
+  EXPECT_EQ(atb_Bitset_FindFirst(bitset), 130);
+
+  atb_Bitset_Set(bitset, 0);
+  atb_Bitset_Set(bitset, 64);
+  atb_Bitset_Set(bitset, 129);
+
+  EXPECT_TRUE(atb_Bitset_Test(bitset, 0));
+  EXPECT_FALSE(atb_Bitset_Test(bitset, 1));
+  EXPECT_TRUE(atb_Bitset_Test(bitset, 64));
+  EXPECT_TRUE(atb_Bitset_Test(bitset, 129));
+  EXPECT_EQ(atb_Bitset_Count(bitset), 3);
+
+  EXPECT_EQ(atb_Bitset_FindFirst(bitset), 0);
+  EXPECT_EQ(atb_Bitset_FindNext(bitset, 1), 64);
+  EXPECT_EQ(atb_Bitset_FindNext(bitset, 65), 129);
+  EXPECT_EQ(atb_Bitset_FindNext(bitset, 130), 130);
+
+  atb_Bitset_Clear(bitset, 64);
+  EXPECT_FALSE(atb_Bitset_Test(bitset, 64));
+  EXPECT_EQ(atb_Bitset_FindNext(bitset, 1), 129);
+
+  // Garbage past the end is left untouched
+  EXPECT_EQ(storage.back().back() & ~std::uint64_t{0b11}, kGarbage & ~0b11);
+}
+
+TEST_F(AtbBitsetTest, Ranges) {
+  auto bitset = Make(300);
+
+  atb_Bitset_SetRange(bitset, 10, 0);
+  EXPECT_EQ(atb_Bitset_Count(bitset), 0);
+  EXPECT_TRUE(atb_Bitset_TestAll(bitset, 10, 0));
+  EXPECT_FALSE(atb_Bitset_TestAny(bitset, 10, 0));
+
+  // Inside a single word
+  atb_Bitset_SetRange(bitset, 3, 5);
+  EXPECT_EQ(atb_Bitset_Count(bitset), 5);
+  EXPECT_TRUE(atb_Bitset_TestAll(bitset, 3, 5));
+  EXPECT_FALSE(atb_Bitset_TestAll(bitset, 2, 5));
+  EXPECT_FALSE(atb_Bitset_TestAny(bitset, 8, 100));
+
+  // Across several words
+  atb_Bitset_SetRange(bitset, 60, 200);
+  EXPECT_EQ(atb_Bitset_Count(bitset), 205);
+  EXPECT_EQ(atb_Bitset_CountRange(bitset, 100, 100), 100);
+  EXPECT_TRUE(atb_Bitset_TestAll(bitset, 60, 200));
+  EXPECT_FALSE(atb_Bitset_TestAll(bitset, 60, 201));
+  EXPECT_TRUE(atb_Bitset_TestAny(bitset, 259, 41));
+  EXPECT_FALSE(atb_Bitset_TestAny(bitset, 260, 40));
+
+  atb_Bitset_ClearRange(bitset, 64, 128);
+  EXPECT_EQ(atb_Bitset_Count(bitset), 77);
+  EXPECT_EQ(atb_Bitset_FindNext(bitset, 61), 61);
+  EXPECT_EQ(atb_Bitset_FindNext(bitset, 64), 192);
+
+  atb_Bitset_SetRange(bitset, 0, 300);
+  EXPECT_EQ(atb_Bitset_Count(bitset), 300);
+  EXPECT_TRUE(atb_Bitset_TestAll(bitset, 0, 300));
+}
+
+TEST_F(AtbBitsetTest, SetOperations) {
+  auto lhs = Make(200);
+  auto rhs = Make(200);
+  auto dest = Make(200);
+
+  atb_Bitset_SetRange(lhs, 0, 120);
+  atb_Bitset_SetRange(rhs, 80, 120);
+
+  atb_Bitset_And(dest, lhs, rhs);
+  EXPECT_EQ(atb_Bitset_Count(dest), 40);
+  EXPECT_EQ(atb_Bitset_FindFirst(dest), 80);
+
+  atb_Bitset_Or(dest, lhs, rhs);
+  EXPECT_EQ(atb_Bitset_Count(dest), 200);
+
+  atb_Bitset_Xor(dest, lhs, rhs);
+  EXPECT_EQ(atb_Bitset_Count(dest), 160);
+  EXPECT_FALSE(atb_Bitset_TestAny(dest, 80, 40));
+
+  atb_Bitset_AndNot(dest, lhs, rhs);
+  EXPECT_EQ(atb_Bitset_Count(dest), 80);
+  EXPECT_TRUE(atb_Bitset_TestAll(dest, 0, 80));
+
+  // In place
+  atb_Bitset_AndNot(lhs, lhs, lhs);
+  EXPECT_EQ(atb_Bitset_Count(lhs), 0);
+
+  // Garbage past the end is left untouched
+  EXPECT_EQ(storage.back().back() >> 8, kGarbage >> 8);
+}
+
+TEST_F(AtbBitsetTest, Random) {
+  std::mt19937 gen(42);
+
+  for (std::size_t size : {1, 63, 64, 65, 1000, 4097}) {
+    auto lhs = Make(size);
+    auto rhs = Make(size);
+    std::vector<bool> l(size);
+    std::vector<bool> r(size);
+
+    for (int i = 0; i < 50; ++i) {
+      std::size_t const first = gen() % size;
+      std::size_t const count = gen() % (size - first + 1);
+      bool const set = (gen() % 3) != 0;
+
+      auto &bitset = (i % 2) ? lhs : rhs;
+      auto &bits = (i % 2) ? l : r;
+
+      if (set) {
+        atb_Bitset_SetRange(bitset, first, count);
+      } else {
+        atb_Bitset_ClearRange(bitset, first, count);
+      }
+      for (std::size_t b = first; b < first + count; ++b) bits[b] = set;
+
+      ASSERT_EQ(ToVector(bitset), bits);
+
+      std::size_t expected_count = 0;
+      bool all = true;
+      for (std::size_t b = first; b < first + count; ++b) {
+        expected_count += bits[b] ? 1 : 0;
+        all = all && bits[b];
+      }
+      EXPECT_EQ(atb_Bitset_CountRange(bitset, first, count), expected_count);
+      EXPECT_EQ(atb_Bitset_TestAll(bitset, first, count), all);
+      EXPECT_EQ(atb_Bitset_TestAny(bitset, first, count),
+                expected_count != 0);
+
+      std::size_t next = first;
+      while ((next < size) && !bits[next]) ++next;
+      EXPECT_EQ(atb_Bitset_FindNext(bitset, first), next);
+    }
+
+    auto dest = Make(size);
+    std::vector<bool> expected(size);
+
+    atb_Bitset_And(dest, lhs, rhs);
+    for (std::size_t b = 0; b < size; ++b) expected[b] = l[b] && r[b];
+    EXPECT_EQ(ToVector(dest), expected);
+
+    atb_Bitset_Or(dest, lhs, rhs);
+    for (std::size_t b = 0; b < size; ++b) expected[b] = l[b] || r[b];
+    EXPECT_EQ(ToVector(dest), expected);
+
+    atb_Bitset_Xor(dest, lhs, rhs);
+    for (std::size_t b = 0; b < size; ++b) expected[b] = l[b] != r[b];
+    EXPECT_EQ(ToVector(dest), expected);
+
+    atb_Bitset_AndNot(dest, lhs, rhs);
+    for (std::size_t b = 0; b < size; ++b) expected[b] = l[b] && !r[b];
+    EXPECT_EQ(ToVector(dest), expected);
+  }
+}
+
+} // namespace
@@ -0,0 +1,123 @@
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "atb/bloom.h"
+#include "atb/hash.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+struct AtbBloomTest : testing::Test {
+  void Make(std::size_t keys, std::size_t bits_per_key) {
+    storage.assign(ATB_BLOOM_WORDS_FOR(keys, bits_per_key), ~std::uint64_t{0});
+    bloom = atb_Bloom_From({storage.data(), storage.size()});
+    atb_Bloom_Clear(bloom);
+  }
+
+  std::vector<std::uint64_t> storage;
+  atb_Bloom bloom;
+};
+
+using AtbBloomDeathTest = AtbBloomTest;
+
+TEST_F(AtbBloomDeathTest, From) {
+  std::uint64_t words[12] = {};
+  EXPECT_DEBUG_DEATH(atb_Bloom_From({words, 12}), "K_ATB_BLOOM_BLOCK_WORDS");
+  EXPECT_DEBUG_DEATH(atb_Bloom_From({words, 0}), "K_ATB_BLOOM_BLOCK_WORDS");
+}
+
+TEST_F(AtbBloomTest, WordsFor) {
+  EXPECT_EQ(ATB_BLOOM_WORDS_FOR(0, 10), 8);
+  EXPECT_EQ(ATB_BLOOM_WORDS_FOR(52, 10), 16);
+  EXPECT_EQ(ATB_BLOOM_WORDS_FOR(1000, 10) % K_ATB_BLOOM_BLOCK_WORDS, 0);
+  EXPECT_GE(ATB_BLOOM_WORDS_FOR(1000, 10) * 64, 1000 * 10);
+}
+
+TEST_F(AtbBloomTest, NoFalseNegatives) {
+  constexpr std::size_t kKeys = 10000;
+  Make(kKeys, 10);
+
+  std::mt19937_64 gen(42);
+  std::vector<std::uint64_t> inserted(kKeys);
+  for (auto &hash : inserted) hash = gen();
+
+  for (std::size_t i = 0; i < kKeys / 2; ++i) {
+    atb_Bloom_Insert(bloom, inserted[i]);
+  }
+  atb_Bloom_InsertBatch(bloom, {inserted.data() + (kKeys / 2), kKeys / 2});
+
+  std::vector<std::uint8_t> results(kKeys, 0xFF);
+  EXPECT_EQ(atb_Bloom_QueryBatch(bloom, {inserted.data(), kKeys},
+                                 {results.data(), results.size()}),
+            kKeys);
+  for (std::size_t i = 0; i < kKeys; ++i) {
+    ASSERT_EQ(results[i], 1);
+    ASSERT_TRUE(atb_Bloom_MayContain(bloom, inserted[i]));
+  }
+
+  // ~1% false positives with 10 bits per key
+  std::vector<std::uint64_t> others(kKeys);
+  for (auto &hash : others) hash = gen();
+
+  auto const hits = atb_Bloom_QueryBatch(bloom, {others.data(), kKeys},
+                                         {results.data(), results.size()});
+  EXPECT_LT(hits, kKeys / 50);
+
+  std::size_t expected_hits = 0;
+  for (std::size_t i = 0; i < kKeys; ++i) {
+    EXPECT_EQ(results[i] == 1, atb_Bloom_MayContain(bloom, others[i]));
+    expected_hits += results[i];
+  }
+  EXPECT_EQ(hits, expected_hits);
+
+  atb_Bloom_Clear(bloom);
+  EXPECT_FALSE(atb_Bloom_MayContain(bloom, inserted[0]));
+}
+
+TEST_F(AtbBloomTest, OneBlockPerKey) {
+  Make(1000, 10);
+
+  std::uint64_t const hash = atb_Hash_u64(42);
+  atb_Bloom_Insert(bloom, hash);
+
+  std::size_t touched_blocks = 0;
+  std::size_t bits = 0;
+  for (std::size_t b = 0; b < storage.size(); b += K_ATB_BLOOM_BLOCK_WORDS) {
+    bool touched = false;
+    for (std::size_t w = 0; w < K_ATB_BLOOM_BLOCK_WORDS; ++w) {
+      touched = touched || (storage[b + w] != 0);
+      bits += static_cast<std::size_t>(__builtin_popcountll(storage[b + w]));
+    }
+    touched_blocks += touched ? 1 : 0;
+  }
+
+  EXPECT_EQ(touched_blocks, 1);
+  EXPECT_EQ(bits, K_ATB_BLOOM_BLOCK_WORDS);
+}
+
+TEST_F(AtbBloomTest, Strs) {
+  Make(300, 10);
+
+  std::vector<std::string> strings;
+  for (int i = 0; i < 300; ++i) strings.push_back("key-" + std::to_string(i));
+
+  std::vector<atb_StrView> keys;
+  for (auto const &str : strings) keys.push_back({str.data(), str.size()});
+
+  atb_Bloom_InsertStrs(bloom, keys.data(), 200);
+
+  std::vector<std::uint8_t> results(keys.size());
+  auto const hits = atb_Bloom_QueryStrs(bloom, keys.data(), keys.size(),
+                                        {results.data(), results.size()});
+
+  EXPECT_GE(hits, 200);
+  EXPECT_LT(hits, 210);
+  for (std::size_t i = 0; i < 200; ++i) ASSERT_EQ(results[i], 1);
+
+  EXPECT_TRUE(atb_Bloom_MayContain(
+      bloom, atb_Hash_StrView(keys[150], K_ATB_HASH_SEED)));
+}
+
+} // namespace
@@ -0,0 +1,291 @@
+#include <cstdint>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "atb/allocator/default.h"
+#include "atb/btree.h"
+#include "gtest/gtest.h"
+#include "test_allocator.hpp"
+
+namespace {
+
+using ::testing::_;
+using ::testing::Return;
+
+atb_Cmp_t CompareInt(std::int32_t lhs, std::int32_t rhs) {
+  return (lhs < rhs) ? K_ATB_CMP_LESS
+                     : ((lhs > rhs) ? K_ATB_CMP_GREATER : K_ATB_CMP_EQUAL);
+}
+
+/// Key big enough to force the minimum degree (t = 2) on the B-tree
+struct BigKey {
+  std::int32_t value;
+  char padding[252];
+};
+
+atb_Cmp_t CompareBigKey(BigKey lhs, BigKey rhs) {
+  return CompareInt(lhs.value, rhs.value);
+}
+
+} // namespace
+
+ATB_BTREE_DECLARE(static, BTree_i32, std::int32_t, std::int32_t);
+ATB_BTREE_DEFINE(static, BTree_i32, std::int32_t, std::int32_t, CompareInt);
+
+ATB_BTREE_DECLARE(static, BTree_Big, BigKey, std::int32_t);
+ATB_BTREE_DEFINE(static, BTree_Big, BigKey, std::int32_t, CompareBigKey);
+
+namespace {
+
+static_assert(ATB_BTREE_MIN_DEGREE(std::int32_t) == 32);
+static_assert(ATB_BTREE_MIN_DEGREE(BigKey) == 2);
+
+auto Collect(BTree_i32_Iterator it)
+    -> std::vector<std::pair<std::int32_t, std::int32_t>> {
+  std::vector<std::pair<std::int32_t, std::int32_t>> out;
+  for (; !BTree_i32_Iterator_IsEnd(it); it = BTree_i32_Iterator_Next(it)) {
+    out.emplace_back(*BTree_i32_Iterator_Key(it),
+                     *BTree_i32_Iterator_Value(it));
+  }
+  return out;
+}
+
+auto Collect(BTree_Big_Iterator it)
+    -> std::vector<std::pair<std::int32_t, std::int32_t>> {
+  std::vector<std::pair<std::int32_t, std::int32_t>> out;
+  for (; !BTree_Big_Iterator_IsEnd(it); it = BTree_Big_Iterator_Next(it)) {
+    out.emplace_back(BTree_Big_Iterator_Key(it)->value,
+                     *BTree_Big_Iterator_Value(it));
+  }
+  return out;
+}
+
+auto Collect(std::map<std::int32_t, std::int32_t>::const_iterator first,
+             std::map<std::int32_t, std::int32_t>::const_iterator last)
+    -> std::vector<std::pair<std::int32_t, std::int32_t>> {
+  return {first, last};
+}
+
+struct AtbBTreeTest : testing::Test {
+  void SetUp() override { BTree_i32_Init(&tree, atb_DefaultAllocator()); }
+  void TearDown() override { BTree_i32_Destroy(&tree); }
+
+  BTree_i32 tree;
+};
+
+using AtbBTreeDeathTest = AtbBTreeTest;
+
+TEST_F(AtbBTreeDeathTest, Init) {
+  EXPECT_DEBUG_DEATH(BTree_i32_Init(nullptr, atb_DefaultAllocator()),
+                     "self != NULL");
+  EXPECT_DEBUG_DEATH(BTree_i32_Init(&tree, nullptr), "allocator != NULL");
+}
+
+TEST_F(AtbBTreeDeathTest, Iterator) {
+  auto end = BTree_i32_Begin(&tree);
+  ASSERT_TRUE(BTree_i32_Iterator_IsEnd(end));
+
+  EXPECT_DEBUG_DEATH(BTree_i32_Iterator_Next(end), "IsEnd");
+  EXPECT_DEBUG_DEATH(BTree_i32_Iterator_Key(end), "IsEnd");
+  EXPECT_DEBUG_DEATH(BTree_i32_Iterator_Value(end), "IsEnd");
+}
+
+TEST_F(AtbBTreeTest, Empty) {
+  EXPECT_EQ(BTree_i32_Size(&tree), 0);
+  EXPECT_EQ(BTree_i32_Find(&tree, 0), nullptr);
+  EXPECT_FALSE(BTree_i32_Erase(&tree, 0, nullptr));
+  EXPECT_TRUE(BTree_i32_Iterator_IsEnd(BTree_i32_Begin(&tree)));
+  EXPECT_TRUE(BTree_i32_Iterator_IsEnd(BTree_i32_LowerBound(&tree, 0)));
+  EXPECT_TRUE(BTree_i32_Iterator_IsEnd(BTree_i32_UpperBound(&tree, 0)));
+}
+
+TEST_F(AtbBTreeTest, InsertFindReplace) {
+  EXPECT_TRUE(BTree_i32_Insert(&tree, 3, 30, K_ATB_ERROR_IGNORED));
+  EXPECT_TRUE(BTree_i32_Insert(&tree, 1, 10, K_ATB_ERROR_IGNORED));
+  EXPECT_TRUE(BTree_i32_Insert(&tree, 2, 20, K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(BTree_i32_Size(&tree), 3);
+
+  ASSERT_NE(BTree_i32_Find(&tree, 2), nullptr);
+  EXPECT_EQ(*BTree_i32_Find(&tree, 2), 20);
+  EXPECT_EQ(BTree_i32_Find(&tree, 4), nullptr);
+
+  // Inserting an existing key replaces its value
+  EXPECT_TRUE(BTree_i32_Insert(&tree, 2, 42, K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(BTree_i32_Size(&tree), 3);
+  EXPECT_EQ(*BTree_i32_Find(&tree, 2), 42);
+
+  // Values are mutable through Find
+  *BTree_i32_Find(&tree, 1) = 11;
+
+  EXPECT_EQ(Collect(BTree_i32_Begin(&tree)),
+            (std::vector<std::pair<std::int32_t, std::int32_t>>{
+                {1, 11}, {2, 42}, {3, 30}}));
+
+  std::int32_t removed = 0;
+  EXPECT_TRUE(BTree_i32_Erase(&tree, 2, &removed));
+  EXPECT_EQ(removed, 42);
+  EXPECT_FALSE(BTree_i32_Erase(&tree, 2, &removed));
+  EXPECT_EQ(BTree_i32_Size(&tree), 2);
+  EXPECT_EQ(BTree_i32_Find(&tree, 2), nullptr);
+}
+
+TEST_F(AtbBTreeTest, RangeScan) {
+  for (std::int32_t i = 0; i < 10000; i += 2) {
+    ASSERT_TRUE(BTree_i32_Insert(&tree, i, -i, K_ATB_ERROR_IGNORED));
+  }
+
+  // [lo, hi) with lo being present and hi absent
+  std::vector<std::pair<std::int32_t, std::int32_t>> range;
+  for (auto it = BTree_i32_LowerBound(&tree, 1000);
+       !BTree_i32_Iterator_IsEnd(it) && (*BTree_i32_Iterator_Key(it) < 1101);
+       it = BTree_i32_Iterator_Next(it)) {
+    range.emplace_back(*BTree_i32_Iterator_Key(it),
+                       *BTree_i32_Iterator_Value(it));
+  }
+
+  ASSERT_EQ(range.size(), 51);
+  EXPECT_EQ(range.front().first, 1000);
+  EXPECT_EQ(range.back().first, 1100);
+
+  EXPECT_EQ(*BTree_i32_Iterator_Key(BTree_i32_LowerBound(&tree, 1001)), 1002);
+  EXPECT_EQ(*BTree_i32_Iterator_Key(BTree_i32_UpperBound(&tree, 1000)), 1002);
+  EXPECT_EQ(*BTree_i32_Iterator_Key(BTree_i32_UpperBound(&tree, 999)), 1000);
+  EXPECT_EQ(*BTree_i32_Iterator_Key(BTree_i32_LowerBound(&tree, -5)), 0);
+
+  EXPECT_TRUE(BTree_i32_Iterator_IsEnd(BTree_i32_LowerBound(&tree, 9999)));
+  EXPECT_TRUE(BTree_i32_Iterator_IsEnd(BTree_i32_UpperBound(&tree, 9998)));
+}
+
+TEST_F(AtbBTreeTest, InsertAllocFailure) {
+  atb::MockAllocator mock;
+  BTree_i32 failing;
+  BTree_i32_Init(&failing, mock.Itf());
+
+  EXPECT_CALL(mock, Alloc(nullptr, _, _)).WillOnce(Return(nullptr));
+
+  EXPECT_FALSE(BTree_i32_Insert(&failing, 1, 1, K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(BTree_i32_Size(&failing), 0);
+  EXPECT_TRUE(BTree_i32_Iterator_IsEnd(BTree_i32_Begin(&failing)));
+
+  BTree_i32_Destroy(&failing);
+}
+
+template <typename Tree>
+struct Ops;
+
+template <>
+struct Ops<BTree_i32> {
+  static void Init(BTree_i32 *t) { BTree_i32_Init(t, atb_DefaultAllocator()); }
+  static void Destroy(BTree_i32 *t) { BTree_i32_Destroy(t); }
+  static bool Insert(BTree_i32 *t, std::int32_t k, std::int32_t v) {
+    return BTree_i32_Insert(t, k, v, K_ATB_ERROR_IGNORED);
+  }
+  static bool Erase(BTree_i32 *t, std::int32_t k, std::int32_t *v) {
+    return BTree_i32_Erase(t, k, v);
+  }
+  static std::int32_t *Find(BTree_i32 *t, std::int32_t k) {
+    return BTree_i32_Find(t, k);
+  }
+  static std::size_t Size(BTree_i32 *t) { return BTree_i32_Size(t); }
+  static auto All(BTree_i32 *t) { return Collect(BTree_i32_Begin(t)); }
+  static auto From(BTree_i32 *t, std::int32_t k) {
+    return Collect(BTree_i32_UpperBound(t, k));
+  }
+  static auto FromIncluded(BTree_i32 *t, std::int32_t k) {
+    return Collect(BTree_i32_LowerBound(t, k));
+  }
+};
+
+template <>
+struct Ops<BTree_Big> {
+  static BigKey Key(std::int32_t k) { return BigKey{k, {}}; }
+
+  static void Init(BTree_Big *t) { BTree_Big_Init(t, atb_DefaultAllocator()); }
+  static void Destroy(BTree_Big *t) { BTree_Big_Destroy(t); }
+  static bool Insert(BTree_Big *t, std::int32_t k, std::int32_t v) {
+    return BTree_Big_Insert(t, Key(k), v, K_ATB_ERROR_IGNORED);
+  }
+  static bool Erase(BTree_Big *t, std::int32_t k, std::int32_t *v) {
+    return BTree_Big_Erase(t, Key(k), v);
+  }
+  static std::int32_t *Find(BTree_Big *t, std::int32_t k) {
+    return BTree_Big_Find(t, Key(k));
+  }
+  static std::size_t Size(BTree_Big *t) { return BTree_Big_Size(t); }
+  static auto All(BTree_Big *t) { return Collect(BTree_Big_Begin(t)); }
+  static auto From(BTree_Big *t, std::int32_t k) {
+    return Collect(BTree_Big_UpperBound(t, Key(k)));
+  }
+  static auto FromIncluded(BTree_Big *t, std::int32_t k) {
+    return Collect(BTree_Big_LowerBound(t, Key(k)));
+  }
+};
+
+template <typename Tree>
+void RandomOperations(std::int32_t key_range) {
+  using Op = Ops<Tree>;
+
+  Tree tree;
+  Op::Init(&tree);
+
+  std::map<std::int32_t, std::int32_t> expected;
+  std::mt19937 gen(42);
+
+  for (int round = 0; round < 4; ++round) {
+    // Mostly inserts, then mostly erases, until the tree is empty again
+    bool const inserting = (round % 2) == 0;
+
+    for (int i = 0; i < 20000; ++i) {
+      auto const key = static_cast<std::int32_t>(gen() % key_range);
+      auto const value = static_cast<std::int32_t>(gen());
+
+      if (inserting == ((gen() % 4) != 0)) {
+        ASSERT_TRUE(Op::Insert(&tree, key, value));
+        expected[key] = value;
+      } else {
+        std::int32_t removed = 0;
+        auto const found = expected.find(key);
+        ASSERT_EQ(Op::Erase(&tree, key, &removed), found != expected.end());
+        if (found != expected.end()) {
+          EXPECT_EQ(removed, found->second);
+          expected.erase(found);
+        }
+      }
+
+      ASSERT_EQ(Op::Size(&tree), expected.size());
+    }
+
+    for (std::int32_t key = 0; key < key_range; ++key) {
+      auto const found = expected.find(key);
+      auto *const value = Op::Find(&tree, key);
+
+      ASSERT_EQ(value != nullptr, found != expected.end());
+      if (value != nullptr) {
+        EXPECT_EQ(*value, found->second);
+      }
+    }
+
+    EXPECT_EQ(Op::All(&tree), Collect(expected.begin(), expected.end()));
+
+    auto const pivot = key_range / 3;
+    EXPECT_EQ(Op::From(&tree, pivot),
+              Collect(expected.upper_bound(pivot), expected.end()));
+    EXPECT_EQ(Op::FromIncluded(&tree, pivot),
+              Collect(expected.lower_bound(pivot), expected.end()));
+  }
+
+  for (std::int32_t key = 0; key < key_range; ++key) {
+    Op::Erase(&tree, key, nullptr);
+  }
+  EXPECT_EQ(Op::Size(&tree), 0);
+  EXPECT_TRUE(Op::All(&tree).empty());
+
+  Op::Destroy(&tree);
+}
+
+TEST(AtbBTreeRandomTest, Small) { RandomOperations<BTree_i32>(5000); }
+
+TEST(AtbBTreeRandomTest, MinDegree) { RandomOperations<BTree_Big>(2000); }
+
+} // namespace
@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "atb/countmin.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+struct AtbCountMinTest : testing::Test {
+  auto Make(std::size_t width, std::size_t depth) -> atb_CountMin {
+    storage.emplace_back(width * depth, 0xFFFFFFFF);
+    auto &counters = storage.back();
+    auto cms = atb_CountMin_From({counters.data(), counters.size()}, depth);
+    atb_CountMin_Clear(&cms);
+    return cms;
+  }
+
+  std::vector<std::vector<std::uint32_t>> storage;
+};
+
+using AtbCountMinDeathTest = AtbCountMinTest;
+
+TEST_F(AtbCountMinDeathTest, From) {
+  std::uint32_t counters[10] = {};
+  EXPECT_DEBUG_DEATH(atb_CountMin_From({counters, 10}, 0), "depth > 0");
+  EXPECT_DEBUG_DEATH(atb_CountMin_From({counters, 10}, 3), "% depth");
+}
+
+TEST_F(AtbCountMinTest, Estimate) {
+  auto cms = Make(1024, 4);
+  EXPECT_EQ(cms.width, 1024);
+  EXPECT_EQ(atb_CountMin_Estimate(&cms, atb_Hash_u64(1)), 0);
+
+  // Zipf-like stream: value v appears ~(1000 / v) times
+  std::mt19937 gen(42);
+  std::vector<std::uint64_t> stream;
+  std::map<std::uint64_t, std::uint32_t> exact;
+  for (std::uint64_t v = 1; v <= 5000; ++v) {
+    for (std::uint64_t n = 0; n < (1000 / v) + 1; ++n) stream.push_back(v);
+  }
+  std::shuffle(stream.begin(), stream.end(), gen);
+  for (auto v : stream) exact[v] += 1;
+
+  atb_CountMin_AddInts(&cms, {stream.data(), stream.size()});
+  EXPECT_EQ(cms.total, stream.size());
+
+  // Never below the real count, error bounded by e * total / width
+  auto const bound = static_cast<std::uint32_t>(
+      2.72 * static_cast<double>(stream.size()) / 1024.0);
+  for (auto const &[value, count] : exact) {
+    auto const estimate = atb_CountMin_Estimate(&cms, atb_Hash_u64(value));
+    ASSERT_GE(estimate, count);
+    ASSERT_LE(estimate, count + bound);
+  }
+
+  // Heavy hitters stand out
+  EXPECT_GE(atb_CountMin_Estimate(&cms, atb_Hash_u64(1)), 1001);
+}
+
+TEST_F(AtbCountMinTest, AddSaturates) {
+  auto cms = Make(16, 2);
+
+  atb_CountMin_Add(&cms, 42, UINT32_MAX - 1);
+  atb_CountMin_Add(&cms, 42, 10);
+  EXPECT_EQ(atb_CountMin_Estimate(&cms, 42), UINT32_MAX);
+}
+
+TEST_F(AtbCountMinTest, Merge) {
+  auto lhs = Make(256, 3);
+  auto rhs = Make(256, 3);
+
+  std::vector<std::string> strings = {"GET /", "GET /", "POST /login"};
+  std::vector<atb_StrView> keys;
+  for (auto const &str : strings) keys.push_back({str.data(), str.size()});
+
+  atb_CountMin_AddStrs(&lhs, keys.data(), keys.size());
+  atb_CountMin_AddStrs(&rhs, keys.data(), 2);
+
+  std::vector<std::uint64_t> hashes;
+  for (auto const &key : keys) {
+    hashes.push_back(atb_Hash_StrView(key, K_ATB_HASH_SEED));
+  }
+  atb_CountMin_AddHashes(&rhs, {hashes.data(), 1});
+
+  atb_CountMin_Merge(&lhs, &rhs);
+  EXPECT_EQ(lhs.total, 6);
+  EXPECT_EQ(atb_CountMin_Estimate(&lhs, hashes[0]), 5);
+  EXPECT_EQ(atb_CountMin_Estimate(&lhs, hashes[2]), 1);
+}
+
+} // namespace
@@ -0,0 +1,201 @@
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "atb/allocator/default.h"
+#include "atb/deque.h"
+#include "atb/span/ints.h"
+#include "gtest/gtest.h"
+#include "test_allocator.hpp"
+
+ATB_DEQUE_DECLARE(static, Deque_u32, atb_Span_u32, std::uint32_t);
+ATB_DEQUE_DEFINE(static, Deque_u32, atb_Span_u32, std::uint32_t);
+
+namespace {
+
+using ::testing::_;
+using ::testing::Return;
+
+constexpr auto kChunkCapacity = ATB_DEQUE_CHUNK_CAPACITY(std::uint32_t);
+
+static_assert(kChunkCapacity == 128);
+static_assert(ATB_DEQUE_CHUNK_CAPACITY(char[1024]) == 1);
+
+struct AtbDequeTest : testing::Test {
+  void SetUp() override { Deque_u32_Init(&deque, atb_DefaultAllocator()); }
+  void TearDown() override { Deque_u32_Destroy(&deque); }
+
+  auto Spans() const -> std::vector<std::vector<std::uint32_t>> {
+    std::vector<std::vector<std::uint32_t>> out;
+    for (auto *chunk = Deque_u32_Chunk_First(&deque); chunk != nullptr;
+         chunk = Deque_u32_Chunk_Next(&deque, chunk)) {
+      auto span = Deque_u32_Chunk_AsSpan(chunk);
+      out.emplace_back(span.data, span.data + span.size);
+    }
+    return out;
+  }
+
+  auto Content() const -> std::vector<std::uint32_t> {
+    std::vector<std::uint32_t> out;
+    for (auto const &span : Spans()) {
+      out.insert(out.end(), span.begin(), span.end());
+    }
+    return out;
+  }
+
+  Deque_u32 deque;
+};
+
+using AtbDequeDeathTest = AtbDequeTest;
+
+TEST_F(AtbDequeDeathTest, Init) {
+  EXPECT_DEBUG_DEATH(Deque_u32_Init(nullptr, atb_DefaultAllocator()),
+                     "self != NULL");
+  EXPECT_DEBUG_DEATH(Deque_u32_Init(&deque, nullptr), "allocator != NULL");
+}
+
+TEST_F(AtbDequeTest, Empty) {
+  EXPECT_EQ(Deque_u32_Size(&deque), 0);
+  EXPECT_EQ(Deque_u32_Front(&deque), nullptr);
+  EXPECT_EQ(Deque_u32_Back(&deque), nullptr);
+  EXPECT_EQ(Deque_u32_Chunk_First(&deque), nullptr);
+  EXPECT_EQ(Deque_u32_Chunk_Last(&deque), nullptr);
+  EXPECT_FALSE(Deque_u32_PopBack(&deque, nullptr));
+  EXPECT_FALSE(Deque_u32_PopFront(&deque, nullptr));
+}
+
+TEST_F(AtbDequeTest, PushPopBothEnds) {
+  for (std::uint32_t i = 0; i < 3; ++i) {
+    ASSERT_NE(Deque_u32_PushBack(&deque, 3 + i, K_ATB_ERROR_IGNORED),
+              nullptr);
+    ASSERT_NE(Deque_u32_PushFront(&deque, 2 - i, K_ATB_ERROR_IGNORED),
+              nullptr);
+  }
+
+  EXPECT_EQ(Deque_u32_Size(&deque), 6);
+  EXPECT_EQ(*Deque_u32_Front(&deque), 0);
+  EXPECT_EQ(*Deque_u32_Back(&deque), 5);
+
+  // Front and back pushes are in separate chunks
+  EXPECT_EQ(Spans(), (std::vector<std::vector<std::uint32_t>>{{0, 1, 2},
+                                                              {3, 4, 5}}));
+
+  std::uint32_t value = 0;
+  EXPECT_TRUE(Deque_u32_PopFront(&deque, &value));
+  EXPECT_EQ(value, 0);
+  EXPECT_TRUE(Deque_u32_PopBack(&deque, &value));
+  EXPECT_EQ(value, 5);
+  EXPECT_EQ(Content(), (std::vector<std::uint32_t>{1, 2, 3, 4}));
+}
+
+TEST_F(AtbDequeTest, StableAddresses) {
+  std::vector<std::uint32_t *> addresses;
+
+  for (std::uint32_t i = 0; i < 10 * kChunkCapacity; ++i) {
+    auto *element = Deque_u32_PushBack(&deque, i, K_ATB_ERROR_IGNORED);
+    ASSERT_NE(element, nullptr);
+    addresses.push_back(element);
+  }
+
+  // Pushing/Popping at both ends never moves the other elements
+  for (std::uint32_t i = 0; i < 5 * kChunkCapacity; ++i) {
+    ASSERT_NE(Deque_u32_PushFront(&deque, i, K_ATB_ERROR_IGNORED), nullptr);
+    ASSERT_NE(Deque_u32_PushBack(&deque, i, K_ATB_ERROR_IGNORED), nullptr);
+  }
+  for (std::uint32_t i = 0; i < 5 * kChunkCapacity; ++i) {
+    ASSERT_TRUE(Deque_u32_PopFront(&deque, nullptr));
+    ASSERT_TRUE(Deque_u32_PopBack(&deque, nullptr));
+  }
+
+  for (std::uint32_t i = 0; i < addresses.size(); ++i) {
+    EXPECT_EQ(*(addresses[i]), i);
+  }
+}
+
+TEST_F(AtbDequeTest, ChunkSpans) {
+  for (std::uint32_t i = 0; i < 3 * kChunkCapacity; ++i) {
+    ASSERT_NE(Deque_u32_PushBack(&deque, i, K_ATB_ERROR_IGNORED), nullptr);
+  }
+  for (std::uint32_t i = 0; i < 10; ++i) {
+    ASSERT_TRUE(Deque_u32_PopFront(&deque, nullptr));
+  }
+
+  auto spans = Spans();
+  ASSERT_EQ(spans.size(), 3);
+  EXPECT_EQ(spans[0].size(), kChunkCapacity - 10);
+  EXPECT_EQ(spans[1].size(), kChunkCapacity);
+  EXPECT_EQ(spans[2].size(), kChunkCapacity);
+
+  // Reverse iteration
+  std::uint32_t expected = 3 * kChunkCapacity;
+  for (auto *chunk = Deque_u32_Chunk_Last(&deque); chunk != nullptr;
+       chunk = Deque_u32_Chunk_Prev(&deque, chunk)) {
+    auto span = Deque_u32_Chunk_AsSpan(chunk);
+    for (auto i = span.size; i > 0; --i) {
+      EXPECT_EQ(span.data[i - 1], --expected);
+    }
+  }
+  EXPECT_EQ(expected, 10);
+}
+
+TEST_F(AtbDequeTest, AllocFailure) {
+  atb::MockAllocator mock;
+  Deque_u32 failing;
+  Deque_u32_Init(&failing, mock.Itf());
+
+  EXPECT_CALL(mock, Alloc(nullptr, sizeof(Deque_u32_Chunk), _))
+      .WillOnce(Return(nullptr))
+      .WillOnce(Return(nullptr));
+
+  EXPECT_EQ(Deque_u32_PushBack(&failing, 1, K_ATB_ERROR_IGNORED), nullptr);
+  EXPECT_EQ(Deque_u32_PushFront(&failing, 1, K_ATB_ERROR_IGNORED), nullptr);
+  EXPECT_EQ(Deque_u32_Size(&failing), 0);
+  EXPECT_EQ(Deque_u32_Chunk_First(&failing), nullptr);
+
+  Deque_u32_Destroy(&failing);
+}
+
+TEST_F(AtbDequeTest, Random) {
+  std::mt19937 gen(42);
+  std::deque<std::uint32_t> expected;
+
+  for (int i = 0; i < 20000; ++i) {
+    auto const value = static_cast<std::uint32_t>(gen());
+    std::uint32_t popped = 0;
+
+    switch (gen() % 4) {
+      case 0:
+        ASSERT_NE(Deque_u32_PushBack(&deque, value, K_ATB_ERROR_IGNORED),
+                  nullptr);
+        expected.push_back(value);
+        break;
+      case 1:
+        ASSERT_NE(Deque_u32_PushFront(&deque, value, K_ATB_ERROR_IGNORED),
+                  nullptr);
+        expected.push_front(value);
+        break;
+      case 2:
+        ASSERT_EQ(Deque_u32_PopBack(&deque, &popped), !expected.empty());
+        if (!expected.empty()) {
+          EXPECT_EQ(popped, expected.back());
+          expected.pop_back();
+        }
+        break;
+      default:
+        ASSERT_EQ(Deque_u32_PopFront(&deque, &popped), !expected.empty());
+        if (!expected.empty()) {
+          EXPECT_EQ(popped, expected.front());
+          expected.pop_front();
+        }
+        break;
+    }
+
+    ASSERT_EQ(Deque_u32_Size(&deque), expected.size());
+  }
+
+  EXPECT_EQ(Content(),
+            std::vector<std::uint32_t>(expected.begin(), expected.end()));
+}
+
+} // namespace
@@ -0,0 +1,201 @@
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "atb/allocator/default.h"
+#include "atb/flatmap.h"
+#include "atb/span/ints.h"
+#include "gtest/gtest.h"
+#include "test_allocator.hpp"
+
+namespace {
+
+atb_Cmp_t CompareInt(std::int32_t lhs, std::int32_t rhs) {
+  return (lhs < rhs) ? K_ATB_CMP_LESS
+                     : ((lhs > rhs) ? K_ATB_CMP_GREATER : K_ATB_CMP_EQUAL);
+}
+
+} // namespace
+
+ATB_FLATMAP_DECLARE(static, FlatMap_i32, std::int32_t, std::uint64_t,
+                    atb_Span_i32, atb_Span_u64);
+ATB_FLATMAP_DEFINE(static, FlatMap_i32, std::int32_t, std::uint64_t,
+                   atb_Span_i32, atb_Span_u64, CompareInt);
+
+namespace {
+
+using ::testing::_;
+using ::testing::Return;
+
+struct AtbFlatMapTest : testing::Test {
+  void SetUp() override { FlatMap_i32_Init(&map, atb_DefaultAllocator()); }
+  void TearDown() override { FlatMap_i32_Destroy(&map); }
+
+  auto Content() const -> std::vector<std::pair<std::int32_t, std::uint64_t>> {
+    auto const keys = FlatMap_i32_Keys(&map);
+    auto const values = FlatMap_i32_Values(&map);
+    EXPECT_EQ(keys.size, values.size);
+
+    std::vector<std::pair<std::int32_t, std::uint64_t>> out;
+    for (std::size_t i = 0; i < keys.size; ++i) {
+      out.emplace_back(keys.data[i], values.data[i]);
+    }
+    return out;
+  }
+
+  static auto Content(std::map<std::int32_t, std::uint64_t> const &expected)
+      -> std::vector<std::pair<std::int32_t, std::uint64_t>> {
+    return {expected.begin(), expected.end()};
+  }
+
+  FlatMap_i32 map = {};
+};
+
+using AtbFlatMapDeathTest = AtbFlatMapTest;
+
+TEST_F(AtbFlatMapTest, Empty) {
+  EXPECT_EQ(FlatMap_i32_Size(&map), 0);
+  EXPECT_EQ(FlatMap_i32_Find(&map, 1), nullptr);
+  EXPECT_EQ(FlatMap_i32_LowerBound(&map, 1), 0);
+  EXPECT_EQ(FlatMap_i32_UpperBound(&map, 1), 0);
+  EXPECT_FALSE(FlatMap_i32_Erase(&map, 1, nullptr));
+  EXPECT_TRUE(
+      FlatMap_i32_InsertBatch(&map, nullptr, nullptr, 0, K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(FlatMap_i32_Size(&map), 0);
+}
+
+TEST_F(AtbFlatMapTest, InsertFindErase) {
+  for (std::int32_t key : {5, 1, 9, 3, 7}) {
+    EXPECT_TRUE(FlatMap_i32_Insert(&map, key, static_cast<std::uint64_t>(key),
+                                   K_ATB_ERROR_IGNORED));
+  }
+
+  EXPECT_EQ(Content(), (std::vector<std::pair<std::int32_t, std::uint64_t>>{
+                           {1, 1}, {3, 3}, {5, 5}, {7, 7}, {9, 9}}));
+
+  // Replace
+  EXPECT_TRUE(FlatMap_i32_Insert(&map, 5, 50, K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(FlatMap_i32_Size(&map), 5);
+  ASSERT_NE(FlatMap_i32_Find(&map, 5), nullptr);
+  EXPECT_EQ(*FlatMap_i32_Find(&map, 5), 50);
+  EXPECT_EQ(FlatMap_i32_Find(&map, 4), nullptr);
+
+  EXPECT_EQ(FlatMap_i32_LowerBound(&map, 3), 1);
+  EXPECT_EQ(FlatMap_i32_UpperBound(&map, 3), 2);
+  EXPECT_EQ(FlatMap_i32_LowerBound(&map, 4), 2);
+  EXPECT_EQ(FlatMap_i32_UpperBound(&map, 4), 2);
+  EXPECT_EQ(FlatMap_i32_LowerBound(&map, 10), 5);
+
+  std::uint64_t value = 0;
+  EXPECT_TRUE(FlatMap_i32_Erase(&map, 5, &value));
+  EXPECT_EQ(value, 50);
+  EXPECT_FALSE(FlatMap_i32_Erase(&map, 5, &value));
+  EXPECT_EQ(Content(), (std::vector<std::pair<std::int32_t, std::uint64_t>>{
+                           {1, 1}, {3, 3}, {7, 7}, {9, 9}}));
+
+  FlatMap_i32_Clear(&map);
+  EXPECT_EQ(FlatMap_i32_Size(&map), 0);
+  EXPECT_EQ(FlatMap_i32_Find(&map, 1), nullptr);
+}
+
+TEST_F(AtbFlatMapTest, InsertBatch) {
+  std::vector<std::int32_t> keys = {4, 2, 8, 2, 6};
+  std::vector<std::uint64_t> values = {40, 20, 80, 21, 60};
+
+  EXPECT_TRUE(FlatMap_i32_InsertBatch(&map, keys.data(), values.data(),
+                                      keys.size(), K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(Content(), (std::vector<std::pair<std::int32_t, std::uint64_t>>{
+                           {2, 21}, {4, 40}, {6, 60}, {8, 80}}));
+
+  // Merge with existing keys
+  keys = {9, 1, 4, 5, 8, 4};
+  values = {90, 10, 41, 50, 81, 42};
+  EXPECT_TRUE(FlatMap_i32_InsertBatch(&map, keys.data(), values.data(),
+                                      keys.size(), K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(Content(),
+            (std::vector<std::pair<std::int32_t, std::uint64_t>>{{1, 10},
+                                                                 {2, 21},
+                                                                 {4, 42},
+                                                                 {5, 50},
+                                                                 {6, 60},
+                                                                 {8, 81},
+                                                                 {9, 90}}));
+}
+
+TEST_F(AtbFlatMapTest, Random) {
+  std::mt19937 gen(42);
+  std::map<std::int32_t, std::uint64_t> expected;
+
+  for (int round = 0; round < 200; ++round) {
+    switch (gen() % 3) {
+      case 0: {
+        auto const key = static_cast<std::int32_t>(gen() % 4096);
+        ASSERT_TRUE(
+            FlatMap_i32_Insert(&map, key, round, K_ATB_ERROR_IGNORED));
+        expected[key] = static_cast<std::uint64_t>(round);
+      } break;
+      case 1: {
+        auto const key = static_cast<std::int32_t>(gen() % 4096);
+        std::uint64_t value = 0;
+        auto const it = expected.find(key);
+        ASSERT_EQ(FlatMap_i32_Erase(&map, key, &value), it != expected.end());
+        if (it != expected.end()) {
+          EXPECT_EQ(value, it->second);
+          expected.erase(it);
+        }
+      } break;
+      default: {
+        // Batches larger than a sorted run, with duplicates
+        std::vector<std::int32_t> keys(gen() % 200);
+        std::vector<std::uint64_t> values(keys.size());
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+          keys[i] = static_cast<std::int32_t>(gen() % 4096);
+          values[i] = gen();
+          expected[keys[i]] = values[i];
+        }
+        ASSERT_TRUE(FlatMap_i32_InsertBatch(&map, keys.data(), values.data(),
+                                            keys.size(), K_ATB_ERROR_IGNORED));
+      } break;
+    }
+
+    ASSERT_EQ(Content(), Content(expected));
+
+    auto const query = static_cast<std::int32_t>(gen() % 4096);
+    auto const lower = expected.lower_bound(query);
+    auto const upper = expected.upper_bound(query);
+    EXPECT_EQ(FlatMap_i32_LowerBound(&map, query),
+              static_cast<std::size_t>(std::distance(expected.begin(), lower)));
+    EXPECT_EQ(FlatMap_i32_UpperBound(&map, query),
+              static_cast<std::size_t>(std::distance(expected.begin(), upper)));
+  }
+}
+
+TEST_F(AtbFlatMapTest, InsertBatchFailure) {
+  atb::MockAllocator mock;
+  FlatMap_i32 failing;
+  FlatMap_i32_Init(&failing, mock.Itf());
+
+  EXPECT_CALL(mock, Alloc(nullptr, _, _)).WillOnce(Return(nullptr));
+
+  std::vector<std::int32_t> keys = {3, 2, 1};
+  std::vector<std::uint64_t> values = {3, 2, 1};
+  EXPECT_FALSE(FlatMap_i32_InsertBatch(&failing, keys.data(), values.data(),
+                                       keys.size(), K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(FlatMap_i32_Size(&failing), 0);
+
+  // Untouched on failure
+  EXPECT_EQ(keys, (std::vector<std::int32_t>{3, 2, 1}));
+
+  FlatMap_i32_Destroy(&failing);
+}
+
+TEST_F(AtbFlatMapDeathTest, InvalidBatch) {
+  EXPECT_DEBUG_DEATH(FlatMap_i32_InsertBatch(&map, nullptr, nullptr, 1,
+                                             K_ATB_ERROR_IGNORED),
+                     "count == 0");
+}
+
+} // namespace
@@ -0,0 +1,51 @@
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <string>
+
+#include "atb/hash.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+TEST(AtbHashTest, u64) {
+  EXPECT_EQ(atb_Hash_u64(0), 0);
+  EXPECT_NE(atb_Hash_u64(1), atb_Hash_u64(2));
+
+  // Consecutive integers spread over the low bits
+  std::set<std::uint64_t> buckets;
+  for (std::uint64_t i = 0; i < 64; ++i) {
+    buckets.insert(atb_Hash_u64(i) & 0xFF);
+  }
+  EXPECT_GT(buckets.size(), 32);
+}
+
+TEST(AtbHashTest, Bytes) {
+  std::string const str = "The quick brown fox jumps over the lazy dog";
+
+  auto const hash = atb_Hash_Bytes(str.data(), str.size(), K_ATB_HASH_SEED);
+  EXPECT_EQ(hash, atb_Hash_Bytes(str.data(), str.size(), K_ATB_HASH_SEED));
+  EXPECT_NE(hash, atb_Hash_Bytes(str.data(), str.size(), 0));
+  EXPECT_NE(hash, atb_Hash_Bytes(str.data(), str.size() - 1, K_ATB_HASH_SEED));
+
+  EXPECT_EQ(atb_Hash_Bytes(nullptr, 0, 0), atb_Hash_Bytes(str.data(), 0, 0));
+
+  // Unaligned data hashes the same
+  char buffer[64] = {};
+  std::memcpy(buffer + 3, str.data(), str.size());
+  EXPECT_EQ(hash, atb_Hash_Bytes(buffer + 3, str.size(), K_ATB_HASH_SEED));
+
+  // Every tail size matters
+  std::set<std::uint64_t> hashes;
+  for (std::size_t size = 0; size <= 16; ++size) {
+    hashes.insert(atb_Hash_Bytes(str.data(), size, K_ATB_HASH_SEED));
+  }
+  EXPECT_EQ(hashes.size(), 17);
+}
+
+TEST(AtbHashTest, StrView) {
+  auto sv = atb_StrView_From_StrLiteral("hello");
+  EXPECT_EQ(atb_Hash_StrView(sv, 42), atb_Hash_Bytes("hello", 5, 42));
+}
+
+} // namespace
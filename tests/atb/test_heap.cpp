@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "atb/heap.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+struct Timer {
+  std::uint64_t deadline;
+  atb_Heap_Node node;
+};
+
+auto DeadlineOf(atb_Heap_Node const *node) -> std::uint64_t {
+  return atb_Heap_Entry(node, Timer const, node)->deadline;
+}
+
+atb_Cmp_t Timer_Compare(void *data, atb_Heap_Node const *lhs,
+                        atb_Heap_Node const *rhs) {
+  (void)data;
+  auto l = DeadlineOf(lhs);
+  auto r = DeadlineOf(rhs);
+  return (l < r) ? K_ATB_CMP_LESS
+                 : ((l > r) ? K_ATB_CMP_GREATER : K_ATB_CMP_EQUAL);
+}
+
+struct AtbHeapTest : testing::Test {
+  void SetUp() override {
+    atb_Heap_Init(&heap, ATB_BIND_AS(atb_Heap_Compare, Timer_Compare, nullptr));
+  }
+
+  auto PopAll() -> std::vector<std::uint64_t> {
+    std::vector<std::uint64_t> out;
+    while (auto *node = atb_Heap_Pop(&heap)) {
+      out.push_back(DeadlineOf(node));
+    }
+    return out;
+  }
+
+  atb_Heap heap;
+};
+
+using AtbHeapDeathTest = AtbHeapTest;
+
+TEST_F(AtbHeapDeathTest, Init) {
+  EXPECT_DEBUG_DEATH(
+      atb_Heap_Init(nullptr,
+                    ATB_BIND_AS(atb_Heap_Compare, Timer_Compare, nullptr)),
+      "self != NULL");
+
+  EXPECT_DEBUG_DEATH(atb_Heap_Init(&heap, K_ATB_BIND_NULL_AS(atb_Heap_Compare)),
+                     "IS_VALID");
+}
+
+TEST_F(AtbHeapTest, Empty) {
+  EXPECT_TRUE(atb_Heap_IsEmpty(&heap));
+  EXPECT_EQ(heap.size, 0);
+  EXPECT_EQ(atb_Heap_Top(&heap), nullptr);
+  EXPECT_EQ(atb_Heap_Pop(&heap), nullptr);
+}
+
+TEST_F(AtbHeapTest, InsertPop) {
+  Timer timers[] = {{5, {}}, {3, {}}, {8, {}}, {1, {}}, {3, {}}, {0, {}}};
+
+  for (auto &t : timers) {
+    atb_Heap_Insert(&heap, &(t.node));
+  }
+
+  EXPECT_FALSE(atb_Heap_IsEmpty(&heap));
+  EXPECT_EQ(heap.size, std::size(timers));
+  EXPECT_EQ(atb_Heap_Top(&heap), &(timers[5].node));
+
+  EXPECT_EQ(PopAll(), (std::vector<std::uint64_t>{0, 1, 3, 3, 5, 8}));
+  EXPECT_TRUE(atb_Heap_IsEmpty(&heap));
+  EXPECT_EQ(heap.size, 0);
+}
+
+TEST_F(AtbHeapTest, PopUnlinkNode) {
+  Timer t{42, {}};
+  atb_Heap_Insert(&heap, &(t.node));
+
+  EXPECT_EQ(atb_Heap_Pop(&heap), &(t.node));
+  EXPECT_EQ(t.node.child, nullptr);
+  EXPECT_EQ(t.node.next, nullptr);
+  EXPECT_EQ(t.node.prev, nullptr);
+}
+
+TEST_F(AtbHeapTest, Random) {
+  std::mt19937_64 gen(42);
+  std::vector<Timer> timers(1000);
+
+  for (auto &t : timers) {
+    t.deadline = gen() % 100;
+    atb_Heap_Insert(&heap, &(t.node));
+  }
+
+  // Pop half of it, then re-insert
+  for (auto i = 0; i < 500; ++i) {
+    auto *node = atb_Heap_Pop(&heap);
+    ASSERT_NE(node, nullptr);
+    atb_Heap_Entry(node, Timer, node)->deadline = gen() % 100;
+    atb_Heap_Insert(&heap, node);
+  }
+
+  std::vector<std::uint64_t> expected;
+  for (auto const &t : timers) expected.push_back(t.deadline);
+  std::sort(expected.begin(), expected.end());
+
+  EXPECT_EQ(PopAll(), expected);
+}
+
+TEST_F(AtbHeapTest, DecreaseKey) {
+  std::vector<Timer> timers(100);
+  for (auto i = 0u; i < timers.size(); ++i) {
+    timers[i].deadline = 100 + i;
+    atb_Heap_Insert(&heap, &(timers[i].node));
+  }
+
+  // Force some structure into the heap
+  auto *first = atb_Heap_Pop(&heap);
+  EXPECT_EQ(DeadlineOf(first), 100);
+
+  // Decrease a key deep down the heap
+  timers[50].deadline = 10;
+  atb_Heap_DecreaseKey(&heap, &(timers[50].node));
+  EXPECT_EQ(atb_Heap_Top(&heap), &(timers[50].node));
+
+  // Decreasing the top doesn't change anything
+  timers[50].deadline = 5;
+  atb_Heap_DecreaseKey(&heap, &(timers[50].node));
+  EXPECT_EQ(atb_Heap_Top(&heap), &(timers[50].node));
+
+  timers[99].deadline = 150;
+  atb_Heap_DecreaseKey(&heap, &(timers[99].node));
+
+  auto values = PopAll();
+  EXPECT_EQ(values.size(), 99);
+  EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+  EXPECT_EQ(values.front(), 5);
+}
+
+TEST_F(AtbHeapTest, Remove) {
+  std::vector<Timer> timers(64);
+  for (auto i = 0u; i < timers.size(); ++i) {
+    timers[i].deadline = i;
+    atb_Heap_Insert(&heap, &(timers[i].node));
+  }
+
+  // Pop once to have an actual tree
+  EXPECT_EQ(DeadlineOf(atb_Heap_Pop(&heap)), 0);
+
+  std::vector<std::uint64_t> expected;
+  for (auto i = 1u; i < timers.size(); ++i) {
+    if ((i % 3) == 0) {
+      atb_Heap_Remove(&heap, &(timers[i].node));
+      EXPECT_EQ(timers[i].node.child, nullptr);
+      EXPECT_EQ(timers[i].node.next, nullptr);
+      EXPECT_EQ(timers[i].node.prev, nullptr);
+    } else {
+      expected.push_back(i);
+    }
+  }
+
+  // Removing the root works as a pop
+  atb_Heap_Remove(&heap, &(timers[1].node));
+  expected.erase(expected.begin());
+
+  EXPECT_EQ(heap.size, expected.size());
+  EXPECT_EQ(PopAll(), expected);
+}
+
+TEST_F(AtbHeapTest, Merge) {
+  atb_Heap other;
+  atb_Heap_Init(&other, heap.compare);
+
+  Timer lhs[] = {{4, {}}, {2, {}}, {6, {}}};
+  Timer rhs[] = {{5, {}}, {1, {}}, {3, {}}};
+
+  for (auto &t : lhs) atb_Heap_Insert(&heap, &(t.node));
+  for (auto &t : rhs) atb_Heap_Insert(&other, &(t.node));
+
+  atb_Heap_Merge(&heap, &other);
+  EXPECT_TRUE(atb_Heap_IsEmpty(&other));
+  EXPECT_EQ(other.size, 0);
+  EXPECT_EQ(heap.size, 6);
+
+  // Merging an empty heap does nothing
+  atb_Heap_Merge(&heap, &other);
+  EXPECT_EQ(heap.size, 6);
+
+  EXPECT_EQ(PopAll(), (std::vector<std::uint64_t>{1, 2, 3, 4, 5, 6}));
+}
+
+} // namespace
@@ -0,0 +1,86 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "atb/hyperloglog.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+struct AtbHyperLogLogTest : testing::Test {
+  auto Make(std::uint8_t precision) -> atb_HyperLogLog {
+    storage.emplace_back(ATB_HYPERLOGLOG_REGISTERS(precision), 0xFF);
+    auto &registers = storage.back();
+    auto hll = atb_HyperLogLog_From({registers.data(), registers.size()},
+                                    precision);
+    atb_HyperLogLog_Clear(hll);
+    return hll;
+  }
+
+  std::vector<std::vector<std::uint8_t>> storage;
+};
+
+using AtbHyperLogLogDeathTest = AtbHyperLogLogTest;
+
+TEST_F(AtbHyperLogLogDeathTest, From) {
+  std::uint8_t registers[16] = {};
+  EXPECT_DEBUG_DEATH(atb_HyperLogLog_From({registers, 16}, 3),
+                     "K_ATB_HYPERLOGLOG_MIN_PRECISION");
+  EXPECT_DEBUG_DEATH(atb_HyperLogLog_From({registers, 16}, 5),
+                     "registers.size ==");
+}
+
+TEST_F(AtbHyperLogLogTest, Empty) {
+  auto hll = Make(10);
+  EXPECT_EQ(atb_HyperLogLog_Estimate(hll), 0);
+}
+
+TEST_F(AtbHyperLogLogTest, Estimate) {
+  auto hll = Make(14);
+
+  // Relative error of ~1% expected with 2^14 registers
+  std::uint64_t added = 0;
+  for (std::uint64_t target : {10, 1000, 100000, 1000000}) {
+    std::vector<std::uint64_t> values;
+    for (; added < target; ++added) values.push_back(added);
+    atb_HyperLogLog_AddInts(hll, {values.data(), values.size()});
+
+    // Duplicates don't change anything
+    atb_HyperLogLog_AddInts(hll, {values.data(), values.size()});
+
+    auto const estimate = static_cast<double>(atb_HyperLogLog_Estimate(hll));
+    EXPECT_NEAR(estimate, static_cast<double>(target),
+                static_cast<double>(target) * 0.03)
+        << target;
+  }
+}
+
+TEST_F(AtbHyperLogLogTest, Merge) {
+  auto lhs = Make(12);
+  auto rhs = Make(12);
+
+  std::vector<std::string> strings;
+  for (int i = 0; i < 30000; ++i) strings.push_back(std::to_string(i));
+
+  std::vector<atb_StrView> keys;
+  for (auto const &str : strings) keys.push_back({str.data(), str.size()});
+
+  // [0, 20000) and [10000, 30000)
+  atb_HyperLogLog_AddStrs(lhs, keys.data(), 20000);
+  atb_HyperLogLog_AddStrs(rhs, keys.data() + 10000, 20000);
+
+  atb_HyperLogLog_Merge(lhs, rhs);
+  EXPECT_NEAR(static_cast<double>(atb_HyperLogLog_Estimate(lhs)), 30000.0,
+              30000.0 * 0.05);
+
+  // Same hashes give the same estimate
+  auto hashes = Make(12);
+  std::vector<std::uint64_t> values;
+  for (auto const &key : keys) {
+    values.push_back(atb_Hash_StrView(key, K_ATB_HASH_SEED));
+  }
+  atb_HyperLogLog_AddHashes(hashes, {values.data(), values.size()});
+  EXPECT_EQ(atb_HyperLogLog_Estimate(hashes), atb_HyperLogLog_Estimate(lhs));
+}
+
+} // namespace
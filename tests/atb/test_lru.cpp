@@ -0,0 +1,217 @@
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <random>
+#include <vector>
+
+#include "atb/allocator/default.h"
+#include "atb/hash.h"
+#include "atb/lru.h"
+#include "gtest/gtest.h"
+#include "test_allocator.hpp"
+
+namespace {
+
+using ::testing::_;
+using ::testing::Return;
+
+struct Entry {
+  std::uint32_t key;
+  std::uint32_t value;
+  atb_Lru_Node node;
+};
+
+auto EntryOf(atb_Lru_Node const *node) -> Entry const * {
+  return atb_Lru_Entry(node, Entry const, node);
+}
+
+bool Entry_Match(void *data, atb_Lru_Node const *node, void const *key) {
+  (void)data;
+  return EntryOf(node)->key == *static_cast<std::uint32_t const *>(key);
+}
+
+void Entry_Evict(void *data, atb_Lru_Node *node) {
+  static_cast<std::vector<std::uint32_t> *>(data)->push_back(
+      EntryOf(node)->key);
+}
+
+struct AtbLruTest : testing::Test {
+  void Init(atb_Lru_Limits limits) {
+    atb_Lru_Init(&lru, atb_DefaultAllocator(), limits,
+                 ATB_BIND_AS(atb_Lru_Match, Entry_Match, nullptr),
+                 ATB_BIND_AS(atb_Lru_Evict, Entry_Evict, &evicted));
+  }
+
+  // Tests owning entries MUST destroy the cache before they go out of scope
+  void TearDown() override { atb_Lru_Destroy(&lru); }
+
+  auto Insert(Entry &entry, std::size_t bytes = 1) -> bool {
+    return atb_Lru_Insert(&lru, &(entry.node), atb_Hash_u64(entry.key),
+                          &(entry.key), bytes, K_ATB_ERROR_IGNORED);
+  }
+
+  auto Find(std::uint32_t key) -> Entry const * {
+    auto *node = atb_Lru_Find(&lru, atb_Hash_u64(key), &key);
+    return (node == nullptr) ? nullptr : EntryOf(node);
+  }
+
+  atb_Lru lru;
+  std::vector<std::uint32_t> evicted;
+};
+
+using AtbLruDeathTest = AtbLruTest;
+
+TEST_F(AtbLruDeathTest, Init) {
+  EXPECT_DEBUG_DEATH(
+      atb_Lru_Init(nullptr, atb_DefaultAllocator(), {},
+                   ATB_BIND_AS(atb_Lru_Match, Entry_Match, nullptr),
+                   K_ATB_BIND_NULL_AS(atb_Lru_Evict)),
+      "self != NULL");
+
+  EXPECT_DEBUG_DEATH(atb_Lru_Init(&lru, atb_DefaultAllocator(), {},
+                                  K_ATB_BIND_NULL_AS(atb_Lru_Match),
+                                  K_ATB_BIND_NULL_AS(atb_Lru_Evict)),
+                     "IS_VALID");
+
+  Init({});
+}
+
+TEST_F(AtbLruTest, Empty) {
+  Init({});
+
+  EXPECT_EQ(atb_Lru_Size(&lru), 0);
+  EXPECT_EQ(atb_Lru_Bytes(&lru), 0);
+  EXPECT_EQ(Find(42), nullptr);
+}
+
+TEST_F(AtbLruTest, EvictByEntries) {
+  Init({.entries = 3, .bytes = 0});
+
+  Entry entries[] = {{1, 10, {}}, {2, 20, {}}, {3, 30, {}}, {4, 40, {}}};
+
+  EXPECT_TRUE(Insert(entries[0]));
+  EXPECT_TRUE(Insert(entries[1]));
+  EXPECT_TRUE(Insert(entries[2]));
+
+  // Hit on 1 makes 2 the least recently used
+  ASSERT_NE(Find(1), nullptr);
+  EXPECT_EQ(Find(1)->value, 10);
+
+  EXPECT_TRUE(Insert(entries[3]));
+  EXPECT_EQ(evicted, (std::vector<std::uint32_t>{2}));
+  EXPECT_EQ(atb_Lru_Size(&lru), 3);
+
+  EXPECT_EQ(Find(2), nullptr);
+  EXPECT_NE(Find(3), nullptr);
+  EXPECT_NE(Find(4), nullptr);
+
+  // Peek doesn't change recency: 1 is still the LRU
+  std::uint32_t key = 1;
+  EXPECT_NE(atb_Lru_Peek(&lru, atb_Hash_u64(key), &key), nullptr);
+
+  atb_Lru_SetLimits(&lru, {.entries = 1, .bytes = 0});
+  EXPECT_EQ(evicted, (std::vector<std::uint32_t>{2, 1, 3}));
+  EXPECT_EQ(atb_Lru_Size(&lru), 1);
+
+  atb_Lru_Destroy(&lru);
+}
+
+TEST_F(AtbLruTest, EvictByBytes) {
+  Init({.entries = 0, .bytes = 100});
+
+  Entry entries[] = {{1, 10, {}}, {2, 20, {}}, {3, 30, {}}};
+
+  EXPECT_TRUE(Insert(entries[0], 40));
+  EXPECT_TRUE(Insert(entries[1], 40));
+  EXPECT_EQ(atb_Lru_Bytes(&lru), 80);
+
+  EXPECT_TRUE(Insert(entries[2], 30));
+  EXPECT_EQ(evicted, (std::vector<std::uint32_t>{1}));
+  EXPECT_EQ(atb_Lru_Bytes(&lru), 70);
+
+  // An entry bigger than the limit evicts everything else, but not itself
+  Entry big = {4, 40, {}};
+  EXPECT_TRUE(Insert(big, 1000));
+  EXPECT_EQ(evicted, (std::vector<std::uint32_t>{1, 2, 3}));
+  EXPECT_EQ(atb_Lru_Size(&lru), 1);
+  EXPECT_EQ(atb_Lru_Bytes(&lru), 1000);
+
+  atb_Lru_Destroy(&lru);
+}
+
+TEST_F(AtbLruTest, ReplaceAndRemove) {
+  Init({});
+
+  Entry first = {1, 10, {}};
+  Entry second = {1, 11, {}};
+
+  EXPECT_TRUE(Insert(first, 5));
+  EXPECT_TRUE(Insert(second, 7));
+  EXPECT_EQ(evicted, (std::vector<std::uint32_t>{1}));
+  EXPECT_EQ(atb_Lru_Size(&lru), 1);
+  EXPECT_EQ(atb_Lru_Bytes(&lru), 7);
+  EXPECT_EQ(Find(1), &second);
+
+  atb_Lru_Remove(&lru, &(second.node));
+  EXPECT_EQ(evicted.size(), 1);
+  EXPECT_EQ(atb_Lru_Size(&lru), 0);
+  EXPECT_EQ(atb_Lru_Bytes(&lru), 0);
+  EXPECT_EQ(Find(1), nullptr);
+
+  atb_Lru_Destroy(&lru);
+}
+
+TEST_F(AtbLruTest, InsertFailure) {
+  atb::MockAllocator mock;
+  atb_Lru failing;
+  atb_Lru_Init(&failing, mock.Itf(), {},
+               ATB_BIND_AS(atb_Lru_Match, Entry_Match, nullptr),
+               K_ATB_BIND_NULL_AS(atb_Lru_Evict));
+
+  EXPECT_CALL(mock, Alloc(nullptr, _, _)).WillOnce(Return(nullptr));
+
+  Entry entry = {1, 10, {}};
+  EXPECT_FALSE(atb_Lru_Insert(&failing, &(entry.node), atb_Hash_u64(1),
+                              &(entry.key), 1, K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(atb_Lru_Size(&failing), 0);
+
+  atb_Lru_Destroy(&failing);
+  Init({});
+}
+
+TEST_F(AtbLruTest, Random) {
+  constexpr std::size_t kCapacity = 64;
+  Init({.entries = kCapacity, .bytes = 0});
+
+  std::mt19937 gen(42);
+  std::vector<Entry> storage(4096);
+  std::list<std::uint32_t> expected; // Most recently used first
+  std::size_t used = 0;
+
+  for (int i = 0; i < 4000; ++i) {
+    auto const key = static_cast<std::uint32_t>(gen() % 256);
+    auto *entry = Find(key);
+    auto it = std::find(expected.begin(), expected.end(), key);
+
+    ASSERT_EQ(entry != nullptr, it != expected.end());
+    if (entry != nullptr) {
+      EXPECT_EQ(entry->key, key);
+      expected.splice(expected.begin(), expected, it);
+    } else {
+      auto &slot = storage[used++];
+      slot.key = key;
+      ASSERT_TRUE(Insert(slot));
+      expected.push_front(key);
+      if (expected.size() > kCapacity) {
+        EXPECT_EQ(evicted.back(), expected.back());
+        expected.pop_back();
+      }
+    }
+
+    ASSERT_EQ(atb_Lru_Size(&lru), expected.size());
+  }
+
+  atb_Lru_Destroy(&lru);
+}
+
+} // namespace
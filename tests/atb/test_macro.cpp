@@ -53,4 +53,20 @@ TEST(AtbMacroTest, TKN_STR) {
   EXPECT_STREQ("0", ATB_TKN_STR(0));
   EXPECT_STREQ("0", ATB_TKN_STR(TEST_COUCOU_0));
 }
+
+#define TEST_SUM(CTX, a) +((a)*CTX)
+#define TEST_FIELD(T, NAME) T NAME;
+
+TEST(AtbMacroTest, FOR_EACH) {
+  EXPECT_EQ(2, ATB_FOR_EACH(TEST_SUM, 2, 1));
+  EXPECT_EQ(20, ATB_FOR_EACH(TEST_SUM, 2, 1, 2, 3, 4));
+  EXPECT_EQ(272, ATB_FOR_EACH(TEST_SUM, 2, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11,
+                              12, 13, 14, 15, 16));
+
+  struct Fields {
+    ATB_FOR_EACH(TEST_FIELD, int, a, b, c)
+  };
+  Fields const fields = {1, 2, 3};
+  EXPECT_EQ(6, fields.a + fields.b + fields.c);
+}
 } // namespace
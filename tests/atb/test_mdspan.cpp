@@ -0,0 +1,149 @@
+#include <array>
+#include <cstdint>
+#include <numeric>
+
+#include "atb/mdspan.h"
+#include "atb/span/ints.h"
+#include "gtest/gtest.h"
+
+ATB_MDSPAN_DECLARE(static, MdSpan_i32, atb_Span_i32, std::int32_t);
+ATB_MDSPAN_DEFINE(static, MdSpan_i32, atb_Span_i32, std::int32_t);
+
+namespace {
+
+struct AtbMdSpanTest : testing::Test {
+  void SetUp() override { std::iota(data.begin(), data.end(), 0); }
+
+  auto Span() -> atb_Span_i32 {
+    return atb_Span_i32{data.data(), data.size()};
+  }
+
+  std::array<std::int32_t, 24> data = {};
+};
+
+using AtbMdSpanDeathTest = AtbMdSpanTest;
+
+TEST_F(AtbMdSpanTest, RowMajor) {
+  std::size_t const extents[] = {4, 6};
+  auto const md = MdSpan_i32_From(Span(), 2, extents, K_ATB_MDSPAN_ROW_MAJOR);
+
+  EXPECT_EQ(MdSpan_i32_Extent(md, 0), 4);
+  EXPECT_EQ(MdSpan_i32_Extent(md, 1), 6);
+  EXPECT_EQ(MdSpan_i32_Stride(md, 0), 6);
+  EXPECT_EQ(MdSpan_i32_Stride(md, 1), 1);
+  EXPECT_EQ(MdSpan_i32_Size(md), 24);
+  EXPECT_TRUE(MdSpan_i32_IsContiguous(md));
+
+  for (std::size_t i = 0; i < 4; ++i) {
+    for (std::size_t j = 0; j < 6; ++j) {
+      EXPECT_EQ(*MdSpan_i32_At2(md, i, j),
+                static_cast<std::int32_t>(i * 6 + j));
+    }
+  }
+
+  auto const row = MdSpan_i32_Row(md, 2);
+  EXPECT_EQ(row.data, data.data() + 12);
+  EXPECT_EQ(row.size, 6);
+
+  auto const flat = MdSpan_i32_Flatten(md);
+  EXPECT_EQ(flat.data, data.data());
+  EXPECT_EQ(flat.size, data.size());
+}
+
+TEST_F(AtbMdSpanTest, ColMajor) {
+  std::size_t const extents[] = {4, 6};
+  auto const md = MdSpan_i32_From(Span(), 2, extents, K_ATB_MDSPAN_COL_MAJOR);
+
+  EXPECT_EQ(MdSpan_i32_Stride(md, 0), 1);
+  EXPECT_EQ(MdSpan_i32_Stride(md, 1), 4);
+  EXPECT_FALSE(MdSpan_i32_IsContiguous(md));
+  EXPECT_EQ(*MdSpan_i32_At2(md, 3, 2), 11);
+
+  // Transposed: row-major again
+  auto const t = MdSpan_i32_Transpose(md, 0, 1);
+  EXPECT_EQ(MdSpan_i32_Extent(t, 0), 6);
+  EXPECT_EQ(MdSpan_i32_Extent(t, 1), 4);
+  EXPECT_TRUE(MdSpan_i32_IsContiguous(t));
+  EXPECT_EQ(*MdSpan_i32_At2(t, 2, 3), 11);
+}
+
+TEST_F(AtbMdSpanTest, ThreeDimensions) {
+  std::size_t const extents[] = {2, 3, 4};
+  auto const md = MdSpan_i32_From(Span(), 3, extents, K_ATB_MDSPAN_ROW_MAJOR);
+
+  EXPECT_EQ(MdSpan_i32_Size(md), 24);
+  EXPECT_EQ(*MdSpan_i32_At3(md, 1, 2, 3), 23);
+  EXPECT_EQ(*MdSpan_i32_At3(md, 1, 0, 2), 14);
+
+  // Plane (2-D) of the 3-D mdspan
+  auto const plane = MdSpan_i32_Select(md, 0, 1);
+  EXPECT_EQ(plane.rank, 2);
+  EXPECT_EQ(MdSpan_i32_Extent(plane, 0), 3);
+  EXPECT_EQ(MdSpan_i32_Extent(plane, 1), 4);
+  EXPECT_TRUE(MdSpan_i32_IsContiguous(plane));
+  EXPECT_EQ(*MdSpan_i32_At2(plane, 2, 3), 23);
+
+  // Column of that plane (1-D, strided)
+  auto const column = MdSpan_i32_Select(plane, 1, 1);
+  EXPECT_EQ(column.rank, 1);
+  EXPECT_EQ(MdSpan_i32_Extent(column, 0), 3);
+  EXPECT_EQ(MdSpan_i32_Stride(column, 0), 4);
+  EXPECT_FALSE(MdSpan_i32_IsContiguous(column));
+}
+
+TEST_F(AtbMdSpanTest, Tiles) {
+  std::size_t const extents[] = {4, 6};
+  auto const md = MdSpan_i32_From(Span(), 2, extents, K_ATB_MDSPAN_ROW_MAJOR);
+
+  // 2x3 tiles, never copied
+  std::int32_t sum = 0;
+  for (std::size_t y = 0; y < 4; y += 2) {
+    auto const band = MdSpan_i32_Slice(md, 0, y, 2);
+    for (std::size_t x = 0; x < 6; x += 3) {
+      auto const tile = MdSpan_i32_Slice(band, 1, x, 3);
+      EXPECT_EQ(MdSpan_i32_Size(tile), 6);
+      EXPECT_FALSE(MdSpan_i32_IsContiguous(tile));
+      EXPECT_EQ(*MdSpan_i32_At2(tile, 0, 0),
+                static_cast<std::int32_t>(y * 6 + x));
+
+      for (std::size_t i = 0; i < MdSpan_i32_Extent(tile, 0); ++i) {
+        auto const row = MdSpan_i32_Row(tile, i);
+        EXPECT_EQ(row.data, data.data() + (y + i) * 6 + x);
+        sum = std::accumulate(row.data, row.data + row.size, sum);
+      }
+    }
+  }
+  EXPECT_EQ(sum, std::accumulate(data.begin(), data.end(), 0));
+
+  // Full width slices stay contiguous
+  EXPECT_TRUE(MdSpan_i32_IsContiguous(MdSpan_i32_Slice(md, 0, 1, 2)));
+}
+
+TEST_F(AtbMdSpanTest, Strided) {
+  // Every other element of every other row (2x3 out of 4x6)
+  std::size_t const extents[] = {2, 3};
+  std::size_t const strides[] = {12, 2};
+  auto const md = MdSpan_i32_From_Strided(data.data(), 2, extents, strides);
+
+  EXPECT_EQ(*MdSpan_i32_At2(md, 0, 0), 0);
+  EXPECT_EQ(*MdSpan_i32_At2(md, 0, 2), 4);
+  EXPECT_EQ(*MdSpan_i32_At2(md, 1, 1), 14);
+  EXPECT_FALSE(MdSpan_i32_IsContiguous(md));
+}
+
+TEST_F(AtbMdSpanDeathTest, OutOfBounds) {
+  std::size_t const extents[] = {4, 6};
+  auto const md = MdSpan_i32_From(Span(), 2, extents, K_ATB_MDSPAN_ROW_MAJOR);
+
+  EXPECT_DEBUG_DEATH(MdSpan_i32_At2(md, 4, 0), "i < md.extents\\[0\\]");
+  EXPECT_DEBUG_DEATH(MdSpan_i32_At3(md, 0, 0, 0), "md.rank == 3");
+  EXPECT_DEBUG_DEATH(MdSpan_i32_Slice(md, 1, 4, 3),
+                     "count <= \\(md.extents\\[dim\\] - offset\\)");
+
+  std::size_t const large[] = {5, 6};
+  EXPECT_DEBUG_DEATH(
+      MdSpan_i32_From(Span(), 2, large, K_ATB_MDSPAN_ROW_MAJOR),
+      "stride <= span.size");
+}
+
+} // namespace
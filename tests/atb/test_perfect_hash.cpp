@@ -0,0 +1,96 @@
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test_keywords.h" // Generated from test_perfect_hash.txt
+
+namespace {
+
+auto ViewOf(std::string const &str) -> atb_StrView {
+  return atb_StrView{str.data(), str.size()};
+}
+
+/// Same keys as test_perfect_hash.txt, in the same order
+auto Keywords() -> std::vector<std::string> {
+  return {"auto",
+          "break",
+          "case",
+          "char",
+          "const",
+          "continue",
+          "default",
+          "do",
+          "double",
+          "else",
+          "enum",
+          "extern",
+          "float",
+          "for",
+          "goto",
+          "if",
+          "inline",
+          "int",
+          "long",
+          "register",
+          "restrict",
+          "return",
+          "short",
+          "signed",
+          "sizeof",
+          "static",
+          "struct",
+          "switch",
+          "typedef",
+          "union",
+          "unsigned",
+          "void",
+          "volatile",
+          "while",
+          "_Alignas",
+          "_Alignof",
+          "_Atomic",
+          "_Bool",
+          "_Complex",
+          "_Generic",
+          "_Imaginary",
+          "_Noreturn",
+          "_Static_assert",
+          "_Thread_local",
+          "a\"quote",
+          "back\\slash",
+          "?\?=",
+          "\xc3\xa9t\xc3\xa9",
+          "tab\ttab"};
+}
+
+TEST(AtbPerfectHashTest, AllKeysFound) {
+  auto const keywords = Keywords();
+  ASSERT_EQ(K_TEST_KEYWORDS_SIZE, keywords.size());
+
+  for (std::size_t i = 0; i < keywords.size(); ++i) {
+    std::size_t index = K_TEST_KEYWORDS_SIZE;
+    EXPECT_TRUE(test_keywords_Find(ViewOf(keywords[i]), &index))
+        << keywords[i];
+    EXPECT_EQ(index, i);
+
+    auto const key = test_keywords_Key(i);
+    EXPECT_EQ(std::string(key.data, key.size), keywords[i]);
+  }
+}
+
+TEST(AtbPerfectHashTest, OtherKeysNotFound) {
+  for (auto const &keyword : Keywords()) {
+    EXPECT_FALSE(test_keywords_Find(ViewOf(keyword + "_"), nullptr));
+    EXPECT_FALSE(
+        test_keywords_Find(ViewOf(keyword.substr(0, keyword.size() - 1)),
+                           nullptr));
+  }
+
+  EXPECT_FALSE(test_keywords_Find(ViewOf("AUTO"), nullptr));
+  EXPECT_FALSE(test_keywords_Find(ViewOf("main"), nullptr));
+  EXPECT_FALSE(test_keywords_Find(ViewOf(std::string("int\0", 4)), nullptr));
+}
+
+} // namespace
@@ -0,0 +1,325 @@
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "atb/allocator/default.h"
+#include "atb/radix.h"
+#include "gtest/gtest.h"
+#include "test_allocator.hpp"
+
+namespace {
+
+using ::testing::_;
+
+auto ViewOf(std::string const &str) -> atb_StrView {
+  return atb_StrView{str.data(), str.size()};
+}
+
+auto ValueOf(std::uintptr_t value) -> void * {
+  return reinterpret_cast<void *>(value);
+}
+
+bool Collect(void *data, atb_StrView prefix, void *value) {
+  auto *visited =
+      static_cast<std::vector<std::pair<std::string, void *>> *>(data);
+  visited->emplace_back(std::string(prefix.data, prefix.size), value);
+  return visited->size() < 3;
+}
+
+struct AtbRadixTest : testing::Test {
+  void SetUp() override { atb_Radix_Init(&radix, atb_DefaultAllocator()); }
+
+  void TearDown() override { atb_Radix_Destroy(&radix); }
+
+  bool Insert(std::string const &key, std::uintptr_t value) {
+    return atb_Radix_Insert(&radix, ViewOf(key), ValueOf(value),
+                            K_ATB_ERROR_IGNORED);
+  }
+
+  auto Find(std::string const &key) -> void * {
+    void *value = nullptr;
+    return atb_Radix_Find(&radix, ViewOf(key), &value) ? value : nullptr;
+  }
+
+  atb_Radix radix = {};
+};
+
+using AtbRadixDeathTest = AtbRadixTest;
+
+TEST_F(AtbRadixTest, Empty) {
+  EXPECT_EQ(atb_Radix_Size(&radix), 0);
+  EXPECT_FALSE(atb_Radix_Find(&radix, ViewOf(""), nullptr));
+  EXPECT_FALSE(atb_Radix_Find(&radix, ViewOf("abc"), nullptr));
+  EXPECT_FALSE(atb_Radix_LongestPrefix(&radix, ViewOf("abc"), nullptr,
+                                       nullptr));
+  EXPECT_FALSE(atb_Radix_Remove(&radix, ViewOf("abc"), nullptr));
+}
+
+TEST_F(AtbRadixTest, InsertFind) {
+  EXPECT_TRUE(Insert("romane", 1));
+  EXPECT_TRUE(Insert("romanus", 2));
+  EXPECT_TRUE(Insert("romulus", 3));
+  EXPECT_TRUE(Insert("rubens", 4));
+  EXPECT_TRUE(Insert("ruber", 5));
+  EXPECT_TRUE(Insert("rom", 6)); // Ends on an existing split
+  EXPECT_TRUE(Insert("ro", 7));  // Splits an edge without a new leaf
+  EXPECT_TRUE(Insert("", 8));
+  EXPECT_EQ(atb_Radix_Size(&radix), 8);
+
+  EXPECT_EQ(Find("romane"), ValueOf(1));
+  EXPECT_EQ(Find("romanus"), ValueOf(2));
+  EXPECT_EQ(Find("romulus"), ValueOf(3));
+  EXPECT_EQ(Find("rubens"), ValueOf(4));
+  EXPECT_EQ(Find("ruber"), ValueOf(5));
+  EXPECT_EQ(Find("rom"), ValueOf(6));
+  EXPECT_EQ(Find("ro"), ValueOf(7));
+  EXPECT_EQ(Find(""), ValueOf(8));
+
+  EXPECT_EQ(Find("r"), nullptr);
+  EXPECT_EQ(Find("roman"), nullptr);
+  EXPECT_EQ(Find("romanes"), nullptr);
+  EXPECT_EQ(Find("rubic"), nullptr);
+  EXPECT_EQ(Find("x"), nullptr);
+
+  // Replace
+  EXPECT_TRUE(Insert("romane", 10));
+  EXPECT_EQ(atb_Radix_Size(&radix), 8);
+  EXPECT_EQ(Find("romane"), ValueOf(10));
+}
+
+TEST_F(AtbRadixTest, BinaryKeys) {
+  std::string const a("a\0b", 3);
+  std::string const b("a\0c", 3);
+  std::string const c("\xff\xfe", 2);
+
+  EXPECT_TRUE(Insert(a, 1));
+  EXPECT_TRUE(Insert(b, 2));
+  EXPECT_TRUE(Insert(c, 3));
+
+  EXPECT_EQ(Find(a), ValueOf(1));
+  EXPECT_EQ(Find(b), ValueOf(2));
+  EXPECT_EQ(Find(c), ValueOf(3));
+  EXPECT_EQ(Find("a"), nullptr);
+}
+
+TEST_F(AtbRadixTest, Remove) {
+  EXPECT_TRUE(Insert("test", 1));
+  EXPECT_TRUE(Insert("team", 2));
+  EXPECT_TRUE(Insert("te", 3));
+  EXPECT_TRUE(Insert("toast", 4));
+
+  void *value = nullptr;
+  EXPECT_FALSE(atb_Radix_Remove(&radix, ViewOf("tea"), &value));
+  EXPECT_FALSE(atb_Radix_Remove(&radix, ViewOf("t"), &value));
+
+  EXPECT_TRUE(atb_Radix_Remove(&radix, ViewOf("te"), &value));
+  EXPECT_EQ(value, ValueOf(3));
+  EXPECT_EQ(atb_Radix_Size(&radix), 3);
+  EXPECT_EQ(Find("te"), nullptr);
+  EXPECT_EQ(Find("test"), ValueOf(1));
+  EXPECT_EQ(Find("team"), ValueOf(2));
+
+  EXPECT_TRUE(atb_Radix_Remove(&radix, ViewOf("test"), nullptr));
+  EXPECT_EQ(Find("team"), ValueOf(2));
+  EXPECT_EQ(Find("toast"), ValueOf(4));
+
+  EXPECT_TRUE(atb_Radix_Remove(&radix, ViewOf("toast"), nullptr));
+  EXPECT_FALSE(atb_Radix_Remove(&radix, ViewOf("toast"), nullptr));
+  EXPECT_EQ(Find("team"), ValueOf(2));
+
+  // Tree can be re-used once empty
+  EXPECT_TRUE(atb_Radix_Remove(&radix, ViewOf("team"), nullptr));
+  EXPECT_EQ(atb_Radix_Size(&radix), 0);
+  EXPECT_TRUE(Insert("tea", 5));
+  EXPECT_EQ(Find("tea"), ValueOf(5));
+
+  // Merging a node with a long child label
+  std::string const long_a = "x" + std::string(40, 'A');
+  std::string const long_b = "x" + std::string(40, 'B');
+
+  EXPECT_TRUE(Insert(long_a, 6));
+  EXPECT_TRUE(Insert(long_b, 7));
+  EXPECT_TRUE(atb_Radix_Remove(&radix, ViewOf(long_a), nullptr));
+  EXPECT_EQ(Find(long_a), nullptr);
+  EXPECT_EQ(Find(long_b), ValueOf(7));
+  EXPECT_EQ(Find("tea"), ValueOf(5));
+}
+
+TEST_F(AtbRadixTest, LongestPrefix) {
+  EXPECT_TRUE(Insert("/", 1));
+  EXPECT_TRUE(Insert("/api/", 2));
+  EXPECT_TRUE(Insert("/api/v2/", 3));
+  EXPECT_TRUE(Insert("/static/", 4));
+
+  size_t length = 0;
+  void *value = nullptr;
+
+  EXPECT_TRUE(atb_Radix_LongestPrefix(&radix, ViewOf("/api/v2/users"),
+                                      &length, &value));
+  EXPECT_EQ(length, 8);
+  EXPECT_EQ(value, ValueOf(3));
+
+  EXPECT_TRUE(atb_Radix_LongestPrefix(&radix, ViewOf("/api/v1/users"),
+                                      &length, &value));
+  EXPECT_EQ(length, 5);
+  EXPECT_EQ(value, ValueOf(2));
+
+  EXPECT_TRUE(
+      atb_Radix_LongestPrefix(&radix, ViewOf("/api"), &length, &value));
+  EXPECT_EQ(length, 1);
+  EXPECT_EQ(value, ValueOf(1));
+
+  EXPECT_TRUE(
+      atb_Radix_LongestPrefix(&radix, ViewOf("/static/"), &length, &value));
+  EXPECT_EQ(length, 8);
+  EXPECT_EQ(value, ValueOf(4));
+
+  EXPECT_FALSE(
+      atb_Radix_LongestPrefix(&radix, ViewOf("api/"), &length, &value));
+}
+
+TEST_F(AtbRadixTest, AllPrefixes) {
+  EXPECT_TRUE(Insert("a", 1));
+  EXPECT_TRUE(Insert("abc", 2));
+  EXPECT_TRUE(Insert("abcde", 3));
+  EXPECT_TRUE(Insert("abd", 4));
+  EXPECT_TRUE(Insert("abcdef", 5));
+
+  std::vector<std::pair<std::string, void *>> visited;
+  auto const visit = ATB_BIND_AS(atb_Radix_Visit, Collect, &visited);
+
+  EXPECT_TRUE(atb_Radix_AllPrefixes(&radix, ViewOf("abcd"), visit));
+  EXPECT_EQ(visited, (std::vector<std::pair<std::string, void *>>{
+                         {"a", ValueOf(1)}, {"abc", ValueOf(2)}}));
+
+  // Stops once Collect returns false
+  visited.clear();
+  EXPECT_FALSE(atb_Radix_AllPrefixes(&radix, ViewOf("abcdefg"), visit));
+  EXPECT_EQ(visited.size(), 3);
+
+  visited.clear();
+  EXPECT_TRUE(atb_Radix_AllPrefixes(&radix, ViewOf("b"), visit));
+  EXPECT_TRUE(visited.empty());
+}
+
+TEST_F(AtbRadixTest, Random) {
+  std::mt19937 gen(42);
+  std::map<std::string, std::uintptr_t> expected;
+
+  // Short keys over a small alphabet: lots of shared prefixes
+  auto const random_key = [&gen]() {
+    std::string key(gen() % 8, '\0');
+    for (auto &c : key) c = static_cast<char>('a' + (gen() % 3));
+    return key;
+  };
+
+  for (std::uintptr_t i = 1; i < 5000; ++i) {
+    auto const key = random_key();
+
+    if ((gen() % 3) == 0) {
+      void *value = nullptr;
+      auto const it = expected.find(key);
+
+      ASSERT_EQ(atb_Radix_Remove(&radix, ViewOf(key), &value),
+                it != expected.end());
+      if (it != expected.end()) {
+        EXPECT_EQ(value, ValueOf(it->second));
+        expected.erase(it);
+      }
+    } else {
+      ASSERT_TRUE(Insert(key, i));
+      expected[key] = i;
+    }
+
+    ASSERT_EQ(atb_Radix_Size(&radix), expected.size());
+
+    auto const query = random_key();
+    auto const it = expected.find(query);
+    ASSERT_EQ(Find(query), (it != expected.end()) ? ValueOf(it->second)
+                                                  : nullptr);
+
+    // Naive longest prefix
+    bool found = false;
+    size_t longest = 0;
+    for (auto const &[k, v] : expected) {
+      if ((query.compare(0, k.size(), k) == 0) && (k.size() >= longest)) {
+        found = true;
+        longest = k.size();
+      }
+    }
+
+    size_t length = 0;
+    void *value = nullptr;
+    ASSERT_EQ(
+        atb_Radix_LongestPrefix(&radix, ViewOf(query), &length, &value),
+        found);
+    if (found) {
+      EXPECT_EQ(length, longest);
+      EXPECT_EQ(value, ValueOf(expected[query.substr(0, longest)]));
+    }
+  }
+}
+
+TEST_F(AtbRadixTest, InsertFailure) {
+  atb::MockAllocator mock;
+  int remaining = 0; // Number of allocations succeeding
+
+  EXPECT_CALL(mock, Alloc(nullptr, _, _))
+      .WillRepeatedly([&remaining](void *, size_t size, atb_Error *) {
+        return (remaining-- > 0) ? std::malloc(size) : nullptr;
+      });
+  EXPECT_CALL(mock, Release(_, _)).WillRepeatedly([](void *mem, atb_Error *) {
+    std::free(mem);
+    return true;
+  });
+
+  atb_Radix failing;
+  atb_Radix_Init(&failing, mock.Itf());
+
+  // Root
+  EXPECT_FALSE(atb_Radix_Insert(&failing, ViewOf("abc"), ValueOf(1),
+                                K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(atb_Radix_Size(&failing), 0);
+
+  // Root, leaf and root children
+  remaining = 3;
+  EXPECT_TRUE(atb_Radix_Insert(&failing, ViewOf("abc"), ValueOf(1),
+                               K_ATB_ERROR_IGNORED));
+
+  // Split needs 3 allocations, whichever fails leaves the tree unchanged
+  for (int i = 0; i < 3; ++i) {
+    remaining = i;
+    EXPECT_FALSE(atb_Radix_Insert(&failing, ViewOf("abd"), ValueOf(2),
+                                  K_ATB_ERROR_IGNORED));
+    EXPECT_EQ(atb_Radix_Size(&failing), 1);
+    EXPECT_FALSE(atb_Radix_Find(&failing, ViewOf("ab"), nullptr));
+    EXPECT_FALSE(atb_Radix_Find(&failing, ViewOf("abd"), nullptr));
+
+    void *value = nullptr;
+    EXPECT_TRUE(atb_Radix_Find(&failing, ViewOf("abc"), &value));
+    EXPECT_EQ(value, ValueOf(1));
+  }
+
+  remaining = 3;
+  EXPECT_TRUE(atb_Radix_Insert(&failing, ViewOf("abd"), ValueOf(2),
+                               K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(atb_Radix_Size(&failing), 2);
+
+  atb_Radix_Destroy(&failing);
+}
+
+TEST_F(AtbRadixDeathTest, InvalidArguments) {
+  EXPECT_DEBUG_DEATH(atb_Radix_Insert(&radix, atb_StrView{nullptr, 0},
+                                      nullptr, K_ATB_ERROR_IGNORED),
+                     "atb_StrView_IsValid");
+  EXPECT_DEBUG_DEATH(
+      atb_Radix_AllPrefixes(&radix, ViewOf("a"),
+                            K_ATB_BIND_NULL_AS(atb_Radix_Visit)),
+      "ATB_CALLABLE_IS_VALID");
+}
+
+} // namespace
@@ -0,0 +1,247 @@
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "atb/allocator/default.h"
+#include "atb/ring.h"
+#include "atb/span/ints.h"
+#include "gtest/gtest.h"
+#include "test_allocator.hpp"
+
+ATB_RING_DECLARE(static, Ring_u32, atb_Span_u32, std::uint32_t);
+ATB_RING_DEFINE(static, Ring_u32, atb_Span_u32, std::uint32_t);
+
+namespace {
+
+using ::testing::_;
+using ::testing::Return;
+
+auto Content(Ring_u32 const &ring) -> std::vector<std::uint32_t> {
+  atb_Span_u32 first;
+  atb_Span_u32 second;
+  Ring_u32_AsSpans(&ring, &first, &second);
+
+  std::vector<std::uint32_t> out(first.data, first.data + first.size);
+  out.insert(out.end(), second.data, second.data + second.size);
+  return out;
+}
+
+struct AtbRingTest : testing::Test {
+  void SetUp() override { Ring_u32_Init(&ring, atb_DefaultAllocator()); }
+  void TearDown() override { Ring_u32_Destroy(&ring); }
+
+  Ring_u32 ring;
+};
+
+using AtbRingDeathTest = AtbRingTest;
+
+TEST_F(AtbRingDeathTest, Init) {
+  EXPECT_DEBUG_DEATH(Ring_u32_Init(nullptr, atb_DefaultAllocator()),
+                     "self != NULL");
+  EXPECT_DEBUG_DEATH(Ring_u32_Init(&ring, nullptr), "allocator != NULL");
+
+  std::uint32_t buffer[6] = {};
+  EXPECT_DEBUG_DEATH(Ring_u32_Init_Fixed(&ring, atb_Span_u32{buffer, 6}),
+                     "IsPow2");
+  EXPECT_DEBUG_DEATH(Ring_u32_Init_Fixed(&ring, atb_Span_u32{buffer, 0}),
+                     "IsPow2");
+}
+
+TEST_F(AtbRingDeathTest, OutOfRange) {
+  EXPECT_DEBUG_DEATH(Ring_u32_At(&ring, 0), "i < self->size");
+  EXPECT_DEBUG_DEATH(Ring_u32_Consume(&ring, 1), "n <= self->size");
+}
+
+TEST_F(AtbRingTest, Empty) {
+  EXPECT_EQ(Ring_u32_Size(&ring), 0);
+  EXPECT_EQ(Ring_u32_Capacity(&ring), 0);
+  EXPECT_FALSE(Ring_u32_PopBack(&ring, nullptr));
+  EXPECT_FALSE(Ring_u32_PopFront(&ring, nullptr));
+  EXPECT_TRUE(Content(ring).empty());
+  EXPECT_TRUE(Ring_u32_Append(&ring, nullptr, 0, K_ATB_ERROR_IGNORED));
+}
+
+TEST_F(AtbRingTest, PushPopBothEnds) {
+  for (std::uint32_t i = 0; i < 5; ++i) {
+    ASSERT_TRUE(Ring_u32_PushBack(&ring, 10 + i, K_ATB_ERROR_IGNORED));
+    ASSERT_TRUE(Ring_u32_PushFront(&ring, 9 - i, K_ATB_ERROR_IGNORED));
+  }
+
+  EXPECT_EQ(Ring_u32_Size(&ring), 10);
+  EXPECT_EQ(Ring_u32_Capacity(&ring), 16);
+  EXPECT_EQ(*Ring_u32_At(&ring, 0), 5);
+  EXPECT_EQ(*Ring_u32_At(&ring, 9), 14);
+  EXPECT_EQ(Content(ring), (std::vector<std::uint32_t>{5, 6, 7, 8, 9, 10, 11,
+                                                        12, 13, 14}));
+
+  std::uint32_t value = 0;
+  EXPECT_TRUE(Ring_u32_PopFront(&ring, &value));
+  EXPECT_EQ(value, 5);
+  EXPECT_TRUE(Ring_u32_PopBack(&ring, &value));
+  EXPECT_EQ(value, 14);
+  EXPECT_EQ(Ring_u32_Size(&ring), 8);
+}
+
+TEST_F(AtbRingTest, Fixed) {
+  std::uint32_t buffer[4] = {};
+  Ring_u32 fixed;
+  Ring_u32_Init_Fixed(&fixed, atb_Span_u32{buffer, std::size(buffer)});
+
+  for (std::uint32_t i = 0; i < 4; ++i) {
+    EXPECT_TRUE(Ring_u32_PushBack(&fixed, i, K_ATB_ERROR_IGNORED));
+  }
+
+  atb_Error err;
+  EXPECT_FALSE(Ring_u32_PushBack(&fixed, 4, &err));
+  EXPECT_EQ(err.category, K_ATB_ERROR_GENERIC);
+  EXPECT_EQ(err.code, K_ATB_ERROR_GENERIC_NO_BUFFER_SPACE);
+  EXPECT_FALSE(Ring_u32_PushFront(&fixed, 4, K_ATB_ERROR_IGNORED));
+
+  // Wrap around
+  Ring_u32_Consume(&fixed, 3);
+  std::uint32_t const values[] = {4, 5, 6};
+  EXPECT_TRUE(Ring_u32_Append(&fixed, values, 3, K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(Content(fixed), (std::vector<std::uint32_t>{3, 4, 5, 6}));
+  EXPECT_EQ(Ring_u32_Capacity(&fixed), 4);
+
+  atb_Span_u32 first;
+  atb_Span_u32 second;
+  Ring_u32_AsSpans(&fixed, &first, &second);
+  EXPECT_EQ(first.data, &(buffer[3]));
+  EXPECT_EQ(first.size, 1);
+  EXPECT_EQ(second.data, &(buffer[0]));
+  EXPECT_EQ(second.size, 3);
+
+  Ring_u32_Destroy(&fixed);
+}
+
+TEST_F(AtbRingTest, Streaming) {
+  std::uint32_t buffer[8] = {};
+  Ring_u32 fixed;
+  Ring_u32_Init_Fixed(&fixed, atb_Span_u32{buffer, std::size(buffer)});
+
+  atb_Span_u32 first;
+  atb_Span_u32 second;
+
+  // Produce directly inside the free storage
+  Ring_u32_AsFreeSpans(&fixed, &first, &second);
+  EXPECT_EQ(first.data, buffer);
+  EXPECT_EQ(first.size, 8);
+  EXPECT_EQ(second.size, 0);
+
+  for (std::uint32_t i = 0; i < 6; ++i) first.data[i] = i;
+  Ring_u32_Commit(&fixed, 6);
+  Ring_u32_Consume(&fixed, 5);
+
+  // Free space wraps around
+  Ring_u32_AsFreeSpans(&fixed, &first, &second);
+  EXPECT_EQ(first.data, &(buffer[6]));
+  EXPECT_EQ(first.size, 2);
+  EXPECT_EQ(second.data, buffer);
+  EXPECT_EQ(second.size, 5);
+
+  // Fully consuming the ring makes the free space contiguous again
+  Ring_u32_Consume(&fixed, 1);
+  Ring_u32_AsFreeSpans(&fixed, &first, &second);
+  EXPECT_EQ(first.data, buffer);
+  EXPECT_EQ(first.size, 8);
+  EXPECT_EQ(second.size, 0);
+
+  Ring_u32_Destroy(&fixed);
+}
+
+TEST_F(AtbRingTest, GrowUnwrap) {
+  // Both cases: wrapped part smaller/bigger than the head part
+  for (std::uint32_t consumed : {2u, 6u}) {
+    Ring_u32_Clear(&ring);
+    for (std::uint32_t i = 0; i < 8; ++i) {
+      ASSERT_TRUE(Ring_u32_PushBack(&ring, i, K_ATB_ERROR_IGNORED));
+    }
+    ASSERT_EQ(Ring_u32_Capacity(&ring), 8);
+
+    Ring_u32_Consume(&ring, consumed);
+
+    std::vector<std::uint32_t> expected;
+    for (std::uint32_t i = consumed; i < 8; ++i) expected.push_back(i);
+    for (std::uint32_t i = 8; i < 8 + consumed + 1; ++i) {
+      ASSERT_TRUE(Ring_u32_PushBack(&ring, i, K_ATB_ERROR_IGNORED));
+      expected.push_back(i);
+    }
+
+    EXPECT_EQ(Ring_u32_Capacity(&ring), 16);
+    EXPECT_EQ(Content(ring), expected);
+
+    Ring_u32_Destroy(&ring);
+  }
+}
+
+TEST_F(AtbRingTest, ReserveFailure) {
+  atb::MockAllocator mock;
+  Ring_u32 failing;
+  Ring_u32_Init(&failing, mock.Itf());
+
+  EXPECT_CALL(mock, Alloc(nullptr, 8 * sizeof(std::uint32_t), _))
+      .WillOnce(Return(nullptr));
+
+  EXPECT_FALSE(Ring_u32_PushBack(&failing, 1, K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(Ring_u32_Size(&failing), 0);
+  EXPECT_EQ(Ring_u32_Capacity(&failing), 0);
+
+  atb_Error err;
+  EXPECT_FALSE(Ring_u32_Reserve(&failing, SIZE_MAX, &err));
+  EXPECT_EQ(err.category, K_ATB_ERROR_GENERIC);
+  EXPECT_EQ(err.code, K_ATB_ERROR_GENERIC_VALUE_TOO_LARGE);
+}
+
+TEST_F(AtbRingTest, Random) {
+  std::mt19937 gen(42);
+  std::deque<std::uint32_t> expected;
+
+  for (int i = 0; i < 10000; ++i) {
+    auto const value = static_cast<std::uint32_t>(gen());
+
+    switch (gen() % 5) {
+      case 0:
+        ASSERT_TRUE(Ring_u32_PushBack(&ring, value, K_ATB_ERROR_IGNORED));
+        expected.push_back(value);
+        break;
+      case 1:
+        ASSERT_TRUE(Ring_u32_PushFront(&ring, value, K_ATB_ERROR_IGNORED));
+        expected.push_front(value);
+        break;
+      case 2: {
+        std::uint32_t popped = 0;
+        ASSERT_EQ(Ring_u32_PopBack(&ring, &popped), !expected.empty());
+        if (!expected.empty()) {
+          EXPECT_EQ(popped, expected.back());
+          expected.pop_back();
+        }
+      } break;
+      case 3: {
+        std::uint32_t popped = 0;
+        ASSERT_EQ(Ring_u32_PopFront(&ring, &popped), !expected.empty());
+        if (!expected.empty()) {
+          EXPECT_EQ(popped, expected.front());
+          expected.pop_front();
+        }
+      } break;
+      default: {
+        std::uint32_t const values[] = {value, value + 1, value + 2};
+        ASSERT_TRUE(Ring_u32_Append(&ring, values, std::size(values),
+                                    K_ATB_ERROR_IGNORED));
+        expected.insert(expected.end(), std::begin(values), std::end(values));
+      } break;
+    }
+
+    ASSERT_EQ(Ring_u32_Size(&ring), expected.size());
+  }
+
+  EXPECT_EQ(Content(ring),
+            std::vector<std::uint32_t>(expected.begin(), expected.end()));
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(*Ring_u32_At(&ring, i), expected[i]);
+  }
+}
+
+} // namespace
@@ -0,0 +1,298 @@
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "atb/allocator/default.h"
+#include "atb/roaring.h"
+#include "gtest/gtest.h"
+#include "test_allocator.hpp"
+
+namespace {
+
+using ::testing::_;
+using ::testing::Return;
+
+bool PushBack(void *data, std::uint32_t value) {
+  static_cast<std::vector<std::uint32_t> *>(data)->push_back(value);
+  return true;
+}
+
+struct AtbRoaringTest : testing::Test {
+  void SetUp() override {
+    for (auto &bitmap : bitmaps) {
+      atb_Roaring_Init(&bitmap, atb_DefaultAllocator());
+    }
+  }
+
+  void TearDown() override {
+    for (auto &bitmap : bitmaps) atb_Roaring_Destroy(&bitmap);
+  }
+
+  static auto Values(atb_Roaring const &bitmap) -> std::vector<std::uint32_t> {
+    std::vector<std::uint32_t> values;
+    EXPECT_TRUE(atb_Roaring_ForEach(
+        &bitmap, ATB_BIND_AS(atb_Roaring_Visit, PushBack, &values)));
+    return values;
+  }
+
+  static auto Values(std::set<std::uint32_t> const &set)
+      -> std::vector<std::uint32_t> {
+    return {set.begin(), set.end()};
+  }
+
+  static auto KindOf(atb_Roaring const &bitmap, std::uint16_t key) -> int {
+    for (std::size_t i = 0; i < bitmap.size; ++i) {
+      if (bitmap.containers[i].key == key) return bitmap.containers[i].kind;
+    }
+    return -1;
+  }
+
+  atb_Roaring bitmaps[3];
+  atb_Roaring &lhs = bitmaps[0];
+  atb_Roaring &rhs = bitmaps[1];
+  atb_Roaring &dest = bitmaps[2];
+};
+
+TEST_F(AtbRoaringTest, Empty) {
+  EXPECT_EQ(atb_Roaring_Cardinality(&lhs), 0);
+  EXPECT_FALSE(atb_Roaring_Contains(&lhs, 0));
+  EXPECT_TRUE(Values(lhs).empty());
+  EXPECT_TRUE(atb_Roaring_Remove(&lhs, 42, K_ATB_ERROR_IGNORED));
+}
+
+TEST_F(AtbRoaringTest, AddRemove) {
+  for (std::uint32_t value : {5U, 1U, 70000U, 5U, UINT32_MAX}) {
+    EXPECT_TRUE(atb_Roaring_Add(&lhs, value, K_ATB_ERROR_IGNORED));
+  }
+
+  EXPECT_EQ(atb_Roaring_Cardinality(&lhs), 4);
+  EXPECT_EQ(lhs.size, 3);
+  EXPECT_TRUE(atb_Roaring_Contains(&lhs, 70000));
+  EXPECT_FALSE(atb_Roaring_Contains(&lhs, 70001));
+  EXPECT_EQ(Values(lhs),
+            (std::vector<std::uint32_t>{1, 5, 70000, UINT32_MAX}));
+
+  EXPECT_TRUE(atb_Roaring_Remove(&lhs, 70000, K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(lhs.size, 2);
+  EXPECT_EQ(Values(lhs), (std::vector<std::uint32_t>{1, 5, UINT32_MAX}));
+}
+
+TEST_F(AtbRoaringTest, Containers) {
+  // Sparse values stay an array
+  for (std::uint32_t i = 0; i < K_ATB_ROARING_ARRAY_MAX_SIZE; ++i) {
+    ASSERT_TRUE(atb_Roaring_Add(&lhs, i * 2, K_ATB_ERROR_IGNORED));
+  }
+  EXPECT_EQ(KindOf(lhs, 0), K_ATB_ROARING_ARRAY);
+
+  // Then becomes a bitmap...
+  ASSERT_TRUE(atb_Roaring_Add(&lhs, 1, K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(KindOf(lhs, 0), K_ATB_ROARING_BITMAP);
+  EXPECT_EQ(atb_Roaring_Cardinality(&lhs), K_ATB_ROARING_ARRAY_MAX_SIZE + 1);
+
+  // ...and back to an array when shrinking
+  ASSERT_TRUE(atb_Roaring_Remove(&lhs, 1, K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(KindOf(lhs, 0), K_ATB_ROARING_ARRAY);
+
+  // Ranges are stored as runs
+  ASSERT_TRUE(atb_Roaring_AddRange(&rhs, 10, 200000, K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(atb_Roaring_Cardinality(&rhs), 199991);
+  EXPECT_EQ(KindOf(rhs, 0), K_ATB_ROARING_RUN);
+  EXPECT_EQ(KindOf(rhs, 1), K_ATB_ROARING_RUN);
+  EXPECT_EQ(KindOf(rhs, 3), K_ATB_ROARING_RUN);
+  EXPECT_TRUE(atb_Roaring_Contains(&rhs, 65536));
+  EXPECT_FALSE(atb_Roaring_Contains(&rhs, 200001));
+
+  // Runs are split/merged in place
+  ASSERT_TRUE(atb_Roaring_Remove(&rhs, 100, K_ATB_ERROR_IGNORED));
+  ASSERT_TRUE(atb_Roaring_Remove(&rhs, 10, K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(rhs.containers[0].size, 2);
+  ASSERT_TRUE(atb_Roaring_Add(&rhs, 100, K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(rhs.containers[0].size, 1);
+  EXPECT_EQ(KindOf(rhs, 0), K_ATB_ROARING_RUN);
+  EXPECT_EQ(atb_Roaring_Cardinality(&rhs), 199990);
+
+  // Optimize picks the smallest representation
+  for (std::uint32_t i = 0; i < 5000; ++i) {
+    ASSERT_TRUE(atb_Roaring_Add(&lhs, (7 << 16) + i, K_ATB_ERROR_IGNORED));
+  }
+  EXPECT_EQ(KindOf(lhs, 7), K_ATB_ROARING_BITMAP);
+  ASSERT_TRUE(atb_Roaring_Optimize(&lhs, K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(KindOf(lhs, 0), K_ATB_ROARING_ARRAY);
+  EXPECT_EQ(KindOf(lhs, 7), K_ATB_ROARING_RUN);
+  EXPECT_EQ(atb_Roaring_Cardinality(&lhs), K_ATB_ROARING_ARRAY_MAX_SIZE + 5000);
+}
+
+TEST_F(AtbRoaringTest, AllocationFailure) {
+  atb::MockAllocator mock;
+  atb_Roaring failing;
+  atb_Roaring_Init(&failing, mock.Itf());
+
+  EXPECT_CALL(mock, Alloc(nullptr, _, _)).WillOnce(Return(nullptr));
+
+  EXPECT_FALSE(atb_Roaring_Add(&failing, 1, K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(atb_Roaring_Cardinality(&failing), 0);
+
+  atb_Roaring_Destroy(&failing);
+}
+
+TEST_F(AtbRoaringTest, SetOperations) {
+  std::mt19937 gen(42);
+  std::set<std::uint32_t> l;
+  std::set<std::uint32_t> r;
+
+  // Mix of sparse, dense and run containers on overlapping chunks
+  auto fill = [&gen](atb_Roaring &bitmap, std::set<std::uint32_t> &set,
+                     std::uint32_t dense_key) {
+    for (int i = 0; i < 3000; ++i) {
+      auto const value = static_cast<std::uint32_t>(gen() % (6 << 16));
+      ASSERT_TRUE(atb_Roaring_Add(&bitmap, value, K_ATB_ERROR_IGNORED));
+      set.insert(value);
+    }
+    for (int i = 0; i < 20000; ++i) {
+      auto const value =
+          (dense_key << 16) | static_cast<std::uint32_t>(gen() & 0xFFFF);
+      ASSERT_TRUE(atb_Roaring_Add(&bitmap, value, K_ATB_ERROR_IGNORED));
+      set.insert(value);
+    }
+    auto const first =
+        (dense_key << 16) + 1000 + static_cast<std::uint32_t>(gen() % 1000);
+    ASSERT_TRUE(atb_Roaring_AddRange(&bitmap, first + (3 << 16),
+                                     first + (4 << 16), K_ATB_ERROR_IGNORED));
+    for (auto v = first + (3 << 16); v <= first + (4 << 16); ++v) set.insert(v);
+  };
+
+  fill(lhs, l, 1);
+  fill(rhs, r, 2);
+  ASSERT_EQ(Values(lhs), Values(l));
+  ASSERT_EQ(Values(rhs), Values(r));
+
+  std::set<std::uint32_t> expected;
+
+  for (bool optimize : {false, true}) {
+    if (optimize) {
+      ASSERT_TRUE(atb_Roaring_Optimize(&lhs, K_ATB_ERROR_IGNORED));
+      ASSERT_TRUE(atb_Roaring_Optimize(&rhs, K_ATB_ERROR_IGNORED));
+      ASSERT_EQ(Values(lhs), Values(l));
+    }
+
+    ASSERT_TRUE(atb_Roaring_Union(&dest, &lhs, &rhs, K_ATB_ERROR_IGNORED));
+    expected = l;
+    expected.insert(r.begin(), r.end());
+    EXPECT_EQ(Values(dest), Values(expected));
+    EXPECT_EQ(atb_Roaring_Cardinality(&dest), expected.size());
+
+    ASSERT_TRUE(
+        atb_Roaring_Intersection(&dest, &lhs, &rhs, K_ATB_ERROR_IGNORED));
+    expected.clear();
+    for (auto v : l) {
+      if (r.count(v) != 0) expected.insert(v);
+    }
+    EXPECT_EQ(Values(dest), Values(expected));
+    EXPECT_EQ(atb_Roaring_IntersectionCardinality(&lhs, &rhs),
+              expected.size());
+    EXPECT_EQ(atb_Roaring_IntersectionCardinality(&rhs, &lhs),
+              expected.size());
+  }
+}
+
+TEST_F(AtbRoaringTest, Serialization) {
+  ASSERT_TRUE(atb_Roaring_Add(&lhs, 3, K_ATB_ERROR_IGNORED));
+  ASSERT_TRUE(atb_Roaring_AddRange(&lhs, 65536, 65536 * 3 + 7,
+                                   K_ATB_ERROR_IGNORED));
+  for (std::uint32_t i = 0; i < 10000; ++i) {
+    ASSERT_TRUE(
+        atb_Roaring_Add(&lhs, (5 << 16) + (i * 3), K_ATB_ERROR_IGNORED));
+  }
+  ASSERT_EQ(KindOf(lhs, 5), K_ATB_ROARING_BITMAP);
+
+  std::size_t const size = atb_Roaring_SerializedSize(&lhs);
+  std::vector<std::uint64_t> storage((size / 8) + 1);
+  atb_Span_u8 buffer = {reinterpret_cast<std::uint8_t *>(storage.data()), size};
+
+  atb_Error err;
+  EXPECT_FALSE(atb_Roaring_Serialize(&lhs, {buffer.data, size - 1}, &err));
+  EXPECT_EQ(err.code, K_ATB_ERROR_GENERIC_NO_BUFFER_SPACE);
+
+  ASSERT_TRUE(atb_Roaring_Serialize(&lhs, buffer, K_ATB_ERROR_IGNORED));
+  auto const serialized = storage;
+
+  atb_Roaring view;
+  ASSERT_TRUE(atb_Roaring_View(&view, atb_DefaultAllocator(),
+                               {buffer.data, buffer.size}, &err));
+  EXPECT_EQ(Values(view), Values(lhs));
+  EXPECT_EQ(atb_Roaring_IntersectionCardinality(&view, &lhs),
+            atb_Roaring_Cardinality(&lhs));
+
+  // Modifications are copy-on-write, the bytes are never written to
+  for (std::uint32_t value : {3U, 65536U, (5U << 16) + 1}) {
+    ASSERT_TRUE(atb_Roaring_Add(&view, value + 1, K_ATB_ERROR_IGNORED));
+    ASSERT_TRUE(atb_Roaring_Remove(&view, value, K_ATB_ERROR_IGNORED));
+  }
+  EXPECT_EQ(storage, serialized);
+  EXPECT_FALSE(atb_Roaring_Contains(&view, 3));
+  EXPECT_TRUE(atb_Roaring_Contains(&view, 4));
+  EXPECT_TRUE(atb_Roaring_Contains(&lhs, 3));
+  atb_Roaring_Destroy(&view);
+
+  // Invalid bytes are rejected
+  buffer.data[0] ^= 0xFF;
+  EXPECT_FALSE(atb_Roaring_View(&view, atb_DefaultAllocator(),
+                                {buffer.data, buffer.size}, &err));
+  EXPECT_EQ(err.code, K_ATB_ERROR_GENERIC_BAD_MESSAGE);
+  buffer.data[0] ^= 0xFF;
+
+  EXPECT_FALSE(atb_Roaring_View(&view, atb_DefaultAllocator(),
+                                {buffer.data, buffer.size - 8}, &err));
+  EXPECT_FALSE(atb_Roaring_View(&view, atb_DefaultAllocator(),
+                                {buffer.data + 1, buffer.size - 1}, &err));
+
+  // Corrupted bitmap (cardinality mismatch)
+  buffer.data[size - 1] ^= 0x80;
+  EXPECT_FALSE(atb_Roaring_View(&view, atb_DefaultAllocator(),
+                                {buffer.data, buffer.size}, &err));
+  EXPECT_EQ(err.code, K_ATB_ERROR_GENERIC_BAD_MESSAGE);
+}
+
+TEST_F(AtbRoaringTest, ViewOversizedArray) {
+  // header, one ARRAY descriptor and more values than an ARRAY may hold
+  constexpr std::uint32_t kSize = K_ATB_ROARING_ARRAY_MAX_SIZE + 1;
+  std::vector<std::uint64_t> storage(3 + ((kSize * 2) / 8) + 1, 0);
+  auto *const bytes = reinterpret_cast<std::uint8_t *>(storage.data());
+
+  std::uint32_t const header[2] = {K_ATB_ROARING_MAGIC, 1};
+  std::memcpy(bytes, header, sizeof(header));
+
+  std::uint16_t const key_kind[2] = {0, K_ATB_ROARING_ARRAY};
+  std::uint32_t const sizes[3] = {kSize, kSize, 24};
+  std::memcpy(bytes + 8, key_kind, sizeof(key_kind));
+  std::memcpy(bytes + 12, sizes, sizeof(sizes));
+
+  for (std::uint16_t i = 0; i < kSize; ++i) {
+    std::memcpy(bytes + 24 + (i * 2), &i, sizeof(i));
+  }
+
+  atb_Roaring view;
+  atb_Error err;
+  EXPECT_FALSE(atb_Roaring_View(&view, atb_DefaultAllocator(),
+                                {bytes, storage.size() * 8}, &err));
+  EXPECT_EQ(err.code, K_ATB_ERROR_GENERIC_BAD_MESSAGE);
+}
+
+TEST_F(AtbRoaringTest, SerializeEmpty) {
+  std::uint64_t storage[1] = {};
+  atb_Span_u8 buffer = {reinterpret_cast<std::uint8_t *>(storage), 8};
+
+  EXPECT_EQ(atb_Roaring_SerializedSize(&lhs), 8);
+  ASSERT_TRUE(atb_Roaring_Serialize(&lhs, buffer, K_ATB_ERROR_IGNORED));
+
+  atb_Roaring view;
+  ASSERT_TRUE(atb_Roaring_View(&view, atb_DefaultAllocator(),
+                               {buffer.data, buffer.size},
+                               K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(atb_Roaring_Cardinality(&view), 0);
+  atb_Roaring_Destroy(&view);
+}
+
+} // namespace
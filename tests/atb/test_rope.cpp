@@ -0,0 +1,179 @@
+#include <cstdlib>
+#include <random>
+#include <string>
+
+#include "atb/allocator/default.h"
+#include "atb/rope.h"
+#include "gtest/gtest.h"
+#include "test_allocator.hpp"
+
+namespace {
+
+using ::testing::_;
+using ::testing::Return;
+
+auto View(std::string const &s) -> atb_StrView {
+  return atb_StrView{s.data(), s.size()};
+}
+
+auto Content(atb_Rope const &rope, std::size_t offset = 0) -> std::string {
+  std::string out;
+
+  for (auto it = atb_Rope_At(&rope, offset); !atb_Rope_Iterator_IsEnd(it);
+       it = atb_Rope_Iterator_Next(it)) {
+    auto const chunk = atb_Rope_Iterator_Chunk(it);
+    EXPECT_GT(chunk.size, 0);
+    EXPECT_LE(chunk.size, K_ATB_ROPE_CHUNK_SIZE);
+    out.append(chunk.data, chunk.size);
+  }
+
+  EXPECT_EQ(out.size(), atb_Rope_Size(&rope) - offset);
+  return out;
+}
+
+auto Text(std::mt19937 &rng, std::size_t size) -> std::string {
+  std::string text(size, ' ');
+  for (auto &c : text) c = static_cast<char>('a' + (rng() % 26));
+  return text;
+}
+
+struct AtbRopeTest : testing::Test {
+  void SetUp() override { atb_Rope_Init(&rope, atb_DefaultAllocator()); }
+  void TearDown() override { atb_Rope_Destroy(&rope); }
+
+  atb_Rope rope = {};
+};
+
+using AtbRopeDeathTest = AtbRopeTest;
+
+TEST_F(AtbRopeTest, Empty) {
+  EXPECT_EQ(atb_Rope_Size(&rope), 0);
+  EXPECT_TRUE(atb_Rope_Iterator_IsEnd(atb_Rope_Begin(&rope)));
+  EXPECT_TRUE(atb_Rope_Insert(&rope, 0, View(""), K_ATB_ERROR_IGNORED));
+  EXPECT_TRUE(atb_Rope_Erase(&rope, 0, 0, K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(rope.root, nullptr);
+}
+
+TEST_F(AtbRopeTest, InsertErase) {
+  EXPECT_TRUE(atb_Rope_Insert(&rope, 0, View("Hello!"), K_ATB_ERROR_IGNORED));
+  EXPECT_TRUE(atb_Rope_Insert(&rope, 5, View(" World"), K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(Content(rope), "Hello World!");
+
+  EXPECT_TRUE(atb_Rope_Erase(&rope, 0, 6, K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(Content(rope), "World!");
+  EXPECT_EQ(Content(rope, 3), "ld!");
+
+  EXPECT_TRUE(atb_Rope_Erase(&rope, 0, 6, K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(atb_Rope_Size(&rope), 0);
+  EXPECT_EQ(rope.root, nullptr);
+}
+
+TEST_F(AtbRopeTest, LargeText) {
+  std::mt19937 rng(42);
+  std::string expected = Text(rng, 10 * K_ATB_ROPE_CHUNK_SIZE + 7);
+
+  EXPECT_TRUE(atb_Rope_Insert(&rope, 0, View(expected), K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(Content(rope), expected);
+
+  // Edits spanning several chunks
+  auto const middle = Text(rng, 3 * K_ATB_ROPE_CHUNK_SIZE);
+  EXPECT_TRUE(
+      atb_Rope_Insert(&rope, 1000, View(middle), K_ATB_ERROR_IGNORED));
+  expected.insert(1000, middle);
+  EXPECT_EQ(Content(rope), expected);
+
+  EXPECT_TRUE(atb_Rope_Erase(&rope, 100, 2000, K_ATB_ERROR_IGNORED));
+  expected.erase(100, 2000);
+  EXPECT_EQ(Content(rope), expected);
+}
+
+TEST_F(AtbRopeTest, Random) {
+  std::mt19937 rng(42);
+  std::string expected;
+
+  for (int i = 0; i < 5000; ++i) {
+    auto const offset = rng() % (expected.size() + 1);
+
+    if (((rng() % 3) == 0) && !expected.empty()) {
+      auto const count = rng() % (std::min<std::size_t>(
+                                      expected.size() - offset, 100) +
+                                  1);
+      ASSERT_TRUE(atb_Rope_Erase(&rope, offset, count, K_ATB_ERROR_IGNORED));
+      expected.erase(offset, count);
+    } else {
+      auto const text =
+          Text(rng, ((rng() % 10) == 0) ? (rng() % 2000) : (rng() % 16));
+      ASSERT_TRUE(
+          atb_Rope_Insert(&rope, offset, View(text), K_ATB_ERROR_IGNORED));
+      expected.insert(offset, text);
+    }
+
+    ASSERT_EQ(atb_Rope_Size(&rope), expected.size());
+  }
+
+  EXPECT_EQ(Content(rope), expected);
+}
+
+TEST_F(AtbRopeTest, SplitConcat) {
+  std::mt19937 rng(42);
+  std::string const expected = Text(rng, 5000);
+  EXPECT_TRUE(atb_Rope_Insert(&rope, 0, View(expected), K_ATB_ERROR_IGNORED));
+
+  for (std::size_t offset : {std::size_t{0}, std::size_t{1}, std::size_t{480},
+                             std::size_t{2500}, std::size_t{5000}}) {
+    atb_Rope tail;
+    ASSERT_TRUE(atb_Rope_Split(&rope, offset, &tail, K_ATB_ERROR_IGNORED));
+    EXPECT_EQ(Content(rope), expected.substr(0, offset));
+    EXPECT_EQ(Content(tail), expected.substr(offset));
+
+    atb_Rope_Concat(&rope, &tail);
+    EXPECT_EQ(atb_Rope_Size(&tail), 0);
+    EXPECT_EQ(Content(rope), expected);
+
+    atb_Rope_Destroy(&tail);
+  }
+}
+
+TEST_F(AtbRopeTest, AllocationFailure) {
+  atb::MockAllocator mock;
+  atb_Rope failing;
+  atb_Rope_Init(&failing, mock.Itf());
+
+  EXPECT_CALL(mock, Alloc(nullptr, _, _))
+      .WillOnce([](void *, std::size_t size, atb_Error *) {
+        return std::malloc(size);
+      })
+      .WillRepeatedly(Return(nullptr));
+  EXPECT_CALL(mock, Release(_, _)).WillRepeatedly([](void *mem, atb_Error *) {
+    std::free(mem);
+    return true;
+  });
+
+  std::string const text(100, 'x');
+  ASSERT_TRUE(atb_Rope_Insert(&failing, 0, View(text), K_ATB_ERROR_IGNORED));
+
+  // In place: no allocation needed
+  EXPECT_TRUE(atb_Rope_Insert(&failing, 50, View("yy"), K_ATB_ERROR_IGNORED));
+  EXPECT_TRUE(atb_Rope_Erase(&failing, 50, 2, K_ATB_ERROR_IGNORED));
+
+  // Chunk split needed
+  EXPECT_FALSE(atb_Rope_Insert(&failing, 50,
+                               View(std::string(K_ATB_ROPE_CHUNK_SIZE, 'y')),
+                               K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(Content(failing), text);
+
+  // Whole chunks released: no allocation needed
+  EXPECT_TRUE(atb_Rope_Erase(&failing, 0, 100, K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(atb_Rope_Size(&failing), 0);
+
+  atb_Rope_Destroy(&failing);
+}
+
+TEST_F(AtbRopeDeathTest, OutOfRange) {
+  EXPECT_DEBUG_DEATH(atb_Rope_Insert(&rope, 1, View("a"), K_ATB_ERROR_IGNORED),
+                     "offset <= atb_Rope_Size\\(self\\)");
+  EXPECT_DEBUG_DEATH(atb_Rope_Erase(&rope, 0, 1, K_ATB_ERROR_IGNORED),
+                     "count <= \\(atb_Rope_Size\\(self\\) - offset\\)");
+}
+
+} // namespace
@@ -0,0 +1,151 @@
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "atb/allocator/default.h"
+#include "atb/sharedstr.h"
+#include "gtest/gtest.h"
+#include "test_allocator.hpp"
+
+namespace {
+
+using ::testing::_;
+using ::testing::Return;
+
+auto View(std::string const &s) -> atb_StrView {
+  return atb_StrView{s.data(), s.size()};
+}
+
+auto Content(atb_SharedStr const &str) -> std::string {
+  auto const view = atb_SharedStr_View(&str);
+  return {view.data, view.size};
+}
+
+TEST(AtbSharedStrTest, Empty) {
+  atb_SharedStr str = {};
+  EXPECT_TRUE(
+      atb_SharedStr_From(&str, View(""), atb_DefaultAllocator(), nullptr));
+  EXPECT_EQ(str.block, nullptr);
+  EXPECT_EQ(atb_SharedStr_UseCount(&str), 0);
+  EXPECT_EQ(atb_SharedStr_View(&str).size, 0);
+
+  atb_SharedStr slice = atb_SharedStr_Slice(&str, 0, 0);
+  EXPECT_EQ(slice.block, nullptr);
+
+  atb_SharedStr_Release(&slice);
+  atb_SharedStr_Release(&str);
+}
+
+TEST(AtbSharedStrTest, Slices) {
+  atb::MockAllocator mock;
+
+  EXPECT_CALL(mock, Alloc(nullptr, _, _))
+      .WillOnce([](void *, std::size_t size, atb_Error *) {
+        return std::malloc(size);
+      });
+  EXPECT_CALL(mock, Release(_, _)).WillOnce([](void *mem, atb_Error *) {
+    std::free(mem);
+    return true;
+  });
+
+  std::string source = "key=value";
+  atb_SharedStr line = {};
+  ASSERT_TRUE(atb_SharedStr_From(&line, View(source), mock.Itf(), nullptr));
+
+  // Deep copy of the source
+  source[0] = 'K';
+  EXPECT_EQ(Content(line), "key=value");
+  EXPECT_EQ(atb_SharedStr_UseCount(&line), 1);
+
+  atb_SharedStr key = atb_SharedStr_Slice(&line, 0, 3);
+  atb_SharedStr value = atb_SharedStr_Slice(&line, 4, 5);
+  atb_SharedStr copy = atb_SharedStr_Share(&line);
+  EXPECT_EQ(atb_SharedStr_UseCount(&line), 4);
+
+  // Zero-copy
+  EXPECT_EQ(key.data, line.data);
+  EXPECT_EQ(value.data, line.data + 4);
+  EXPECT_EQ(copy.data, line.data);
+
+  atb_SharedStr_Release(&line);
+  EXPECT_EQ(line.block, nullptr);
+  EXPECT_EQ(atb_SharedStr_UseCount(&key), 3);
+
+  atb_SharedStr sub = atb_SharedStr_Slice(&value, 1, 3);
+  EXPECT_EQ(Content(key), "key");
+  EXPECT_EQ(Content(value), "value");
+  EXPECT_EQ(Content(sub), "alu");
+  EXPECT_EQ(Content(copy), "key=value");
+
+  atb_SharedStr_Release(&copy);
+  atb_SharedStr_Release(&key);
+  atb_SharedStr_Release(&value);
+  EXPECT_EQ(atb_SharedStr_UseCount(&sub), 1);
+
+  // Last reference: block released
+  atb_SharedStr_Release(&sub);
+  EXPECT_EQ(atb_SharedStr_UseCount(&sub), 0);
+}
+
+TEST(AtbSharedStrTest, AllocationFailure) {
+  atb::MockAllocator mock;
+  EXPECT_CALL(mock, Alloc(nullptr, _, _)).WillOnce(Return(nullptr));
+
+  atb_SharedStr str = {};
+  EXPECT_FALSE(atb_SharedStr_From(&str, View("data"), mock.Itf(), nullptr));
+  EXPECT_EQ(str.block, nullptr);
+  EXPECT_EQ(str.size, 0);
+}
+
+TEST(AtbSharedStrTest, Threads) {
+  atb::MockAllocator mock;
+
+  EXPECT_CALL(mock, Alloc(nullptr, _, _))
+      .WillOnce([](void *, std::size_t size, atb_Error *) {
+        return std::malloc(size);
+      });
+  EXPECT_CALL(mock, Release(_, _)).WillOnce([](void *mem, atb_Error *) {
+    std::free(mem);
+    return true;
+  });
+
+  std::string const source(1000, 'x');
+  atb_SharedStr str = {};
+  ASSERT_TRUE(atb_SharedStr_From(&str, View(source), mock.Itf(), nullptr));
+
+  std::vector<std::thread> workers;
+  std::vector<std::size_t> counts(8, 0);
+
+  for (std::size_t t = 0; t < counts.size(); ++t) {
+    atb_SharedStr slice = atb_SharedStr_Slice(&str, t * 100, 100);
+
+    workers.emplace_back([slice, &counts, t]() mutable {
+      for (int i = 0; i < 1000; ++i) {
+        atb_SharedStr copy = atb_SharedStr_Share(&slice);
+        counts[t] += Content(copy).size();
+        atb_SharedStr_Release(&copy);
+      }
+      atb_SharedStr_Release(&slice);
+    });
+  }
+
+  atb_SharedStr_Release(&str);
+
+  for (auto &worker : workers) worker.join();
+  for (auto const count : counts) EXPECT_EQ(count, 100 * 1000);
+}
+
+TEST(AtbSharedStrDeathTest, Slice) {
+  atb_SharedStr str = {};
+  ASSERT_TRUE(atb_SharedStr_From(&str, View("abc"), atb_DefaultAllocator(),
+                                 nullptr));
+
+  EXPECT_DEBUG_DEATH(atb_SharedStr_Slice(&str, 4, 0), "offset <= self->size");
+  EXPECT_DEBUG_DEATH(atb_SharedStr_Slice(&str, 1, 3),
+                     "size <= \\(self->size - offset\\)");
+
+  atb_SharedStr_Release(&str);
+}
+
+} // namespace
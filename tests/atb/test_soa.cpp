@@ -0,0 +1,178 @@
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "atb/allocator/default.h"
+#include "atb/soa.h"
+#include "atb/span/ints.h"
+#include "gtest/gtest.h"
+#include "test_allocator.hpp"
+
+ATB_SOA_DECLARE(static, Particles, (std::int32_t, x, atb_Span_i32),
+                (std::int32_t, y, atb_Span_i32),
+                (std::uint8_t, flags, atb_Span_u8),
+                (std::uint64_t, id, atb_Span_u64));
+ATB_SOA_DEFINE(static, Particles, (std::int32_t, x, atb_Span_i32),
+               (std::int32_t, y, atb_Span_i32),
+               (std::uint8_t, flags, atb_Span_u8),
+               (std::uint64_t, id, atb_Span_u64));
+
+namespace {
+
+using ::testing::_;
+using ::testing::Return;
+
+struct Particle {
+  std::int32_t x;
+  std::int32_t y;
+  std::uint8_t flags;
+  std::uint64_t id;
+
+  bool operator==(Particle const &other) const {
+    return (x == other.x) && (y == other.y) && (flags == other.flags) &&
+           (id == other.id);
+  }
+};
+
+struct AtbSoaTest : testing::Test {
+  void SetUp() override { Particles_Init(&soa, atb_DefaultAllocator()); }
+  void TearDown() override { Particles_Destroy(&soa); }
+
+  bool Push(Particle const &p) {
+    return Particles_PushBack(&soa, p.x, p.y, p.flags, p.id,
+                              K_ATB_ERROR_IGNORED);
+  }
+
+  auto Content() const -> std::vector<Particle> {
+    auto const x = Particles_Column_x(&soa);
+    auto const y = Particles_Column_y(&soa);
+    auto const flags = Particles_Column_flags(&soa);
+    auto const id = Particles_Column_id(&soa);
+
+    EXPECT_EQ(x.size, Particles_Size(&soa));
+    EXPECT_EQ(y.size, Particles_Size(&soa));
+    EXPECT_EQ(flags.size, Particles_Size(&soa));
+    EXPECT_EQ(id.size, Particles_Size(&soa));
+
+    std::vector<Particle> out;
+    for (std::size_t i = 0; i < x.size; ++i) {
+      out.push_back({x.data[i], y.data[i], flags.data[i], id.data[i]});
+    }
+    return out;
+  }
+
+  Particles soa = {};
+};
+
+using AtbSoaDeathTest = AtbSoaTest;
+
+TEST_F(AtbSoaTest, Empty) {
+  EXPECT_EQ(Particles_Size(&soa), 0);
+  EXPECT_EQ(Particles_Capacity(&soa), 0);
+  EXPECT_EQ(Particles_Column_x(&soa).data, nullptr);
+  EXPECT_FALSE(Particles_PopBack(&soa));
+}
+
+TEST_F(AtbSoaTest, PushBack) {
+  std::vector<Particle> expected;
+
+  for (std::int32_t i = 0; i < 100; ++i) {
+    Particle const p = {i, -i, static_cast<std::uint8_t>(i % 7),
+                        static_cast<std::uint64_t>(i) << 40};
+    ASSERT_TRUE(Push(p));
+    expected.push_back(p);
+  }
+
+  EXPECT_EQ(Particles_Size(&soa), 100);
+  EXPECT_GE(Particles_Capacity(&soa), 100);
+  EXPECT_EQ(Content(), expected);
+
+  // Columns are independent arrays
+  auto const x = Particles_Column_x(&soa);
+  for (std::size_t i = 0; i < x.size; ++i) x.data[i] *= 2;
+  for (auto &p : expected) p.x *= 2;
+  EXPECT_EQ(Content(), expected);
+
+  EXPECT_TRUE(Particles_PopBack(&soa));
+  expected.pop_back();
+  EXPECT_EQ(Content(), expected);
+
+  Particles_Clear(&soa);
+  EXPECT_EQ(Particles_Size(&soa), 0);
+  EXPECT_GE(Particles_Capacity(&soa), 100);
+}
+
+TEST_F(AtbSoaTest, Reserve) {
+  EXPECT_TRUE(Particles_Reserve(&soa, 1000, K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(Particles_Capacity(&soa), 1000);
+
+  auto const *const data = Particles_Column_id(&soa).data;
+  for (std::uint64_t i = 0; i < 1000; ++i) ASSERT_TRUE(Push({0, 0, 0, i}));
+  EXPECT_EQ(Particles_Column_id(&soa).data, data);
+
+  EXPECT_TRUE(Particles_Reserve(&soa, 10, K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(Particles_Capacity(&soa), 1000);
+
+  atb_Error err;
+  EXPECT_FALSE(Particles_Reserve(&soa, SIZE_MAX / 2, &err));
+  EXPECT_EQ(Particles_Capacity(&soa), 1000);
+}
+
+TEST_F(AtbSoaTest, Erase) {
+  std::mt19937 gen(42);
+  std::vector<Particle> expected;
+
+  for (int i = 0; i < 2000; ++i) {
+    auto const action = gen() % 4;
+
+    if ((action < 2) || expected.empty()) {
+      Particle const p = {static_cast<std::int32_t>(gen()),
+                          static_cast<std::int32_t>(gen()),
+                          static_cast<std::uint8_t>(gen()), gen()};
+      ASSERT_TRUE(Push(p));
+      expected.push_back(p);
+    } else if (action == 2) {
+      auto const index = gen() % expected.size();
+      Particles_Erase(&soa, index);
+      expected.erase(expected.begin() + static_cast<std::ptrdiff_t>(index));
+    } else {
+      auto const index = gen() % expected.size();
+      Particles_SwapErase(&soa, index);
+      expected[index] = expected.back();
+      expected.pop_back();
+    }
+
+    ASSERT_EQ(Content(), expected);
+  }
+}
+
+TEST_F(AtbSoaTest, GrowFailure) {
+  atb::MockAllocator mock;
+  Particles failing;
+  Particles_Init(&failing, mock.Itf());
+
+  // Second column fails to grow: first one got allocated, capacity unchanged
+  void *const first = std::malloc(K_ATB_SOA_MIN_CAPACITY * sizeof(int32_t));
+  EXPECT_CALL(mock, Alloc(nullptr, _, _))
+      .WillOnce(Return(first))
+      .WillOnce(Return(nullptr));
+  EXPECT_FALSE(Particles_PushBack(&failing, 1, 2, 3, 4, K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(Particles_Size(&failing), 0);
+  EXPECT_EQ(Particles_Capacity(&failing), 0);
+
+  EXPECT_CALL(mock, Release(first, _)).WillOnce([](void *mem, atb_Error *) {
+    std::free(mem);
+    return true;
+  });
+  Particles_Destroy(&failing);
+}
+
+TEST_F(AtbSoaDeathTest, OutOfRange) {
+  ASSERT_TRUE(Push({1, 2, 3, 4}));
+
+  EXPECT_DEBUG_DEATH(Particles_Erase(&soa, 1), "i < self->size");
+  EXPECT_DEBUG_DEATH(Particles_SwapErase(&soa, 1), "i < self->size");
+}
+
+} // namespace
@@ -2,7 +2,9 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <numeric>
+#include <vector>
 
 auto operator<<(std::ostream &os,
                 const atb_View_Copy_Opt_t &opt) -> std::ostream & {
@@ -368,6 +370,51 @@ TEST_F(AtbSpanTest, Fill) {
   EXPECT_THAT(arr, Each(Eq(value)));
 }
 
+template <std::size_t N>
+struct Bytes {
+  std::uint8_t data[N];
+};
+
+template <typename T>
+void ExpectFill(T const &value) {
+  std::vector<std::uint8_t> buffer(sizeof(T) * 300 + 1);
+
+  for (std::size_t offset : {0, 1}) {
+    for (std::size_t count : {0, 1, 2, 3, 7, 8, 15, 16, 17, 63, 64, 65, 299}) {
+      std::fill(buffer.begin(), buffer.end(), 0xAA);
+      auto *const dest = buffer.data() + offset;
+
+      atb_AnySpan_Fill(dest, count, &value, sizeof(T));
+
+      for (std::size_t i = 0; i < count; ++i) {
+        ASSERT_EQ(std::memcmp(dest + i * sizeof(T), &value, sizeof(T)), 0)
+            << "size=" << sizeof(T) << " count=" << count << " i=" << i;
+      }
+      ASSERT_TRUE(std::all_of(dest + count * sizeof(T),
+                              buffer.data() + buffer.size(),
+                              [](std::uint8_t b) { return b == 0xAA; }));
+    }
+  }
+}
+
+TEST(AtbAnySpanTest, Fill) {
+  // Byte uniform (memset)
+  ExpectFill(std::uint8_t{0x42});
+  ExpectFill(std::uint32_t{0});
+  ExpectFill(std::uint64_t{UINT64_MAX});
+
+  // Broadcast
+  ExpectFill(std::uint16_t{0x1234});
+  ExpectFill(std::uint32_t{0x12345678});
+  ExpectFill(std::uint64_t{0x0123456789ABCDEF});
+  ExpectFill(Bytes<16>{{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}});
+
+  // Other sizes
+  ExpectFill(Bytes<3>{{1, 2, 3}});
+  ExpectFill(Bytes<24>{{1, 2, 3}});
+  ExpectFill(Bytes<5000>{{1, 2, 3}});
+}
+
 TEST_F(AtbViewTest, From) {
   auto view = View_u32_From(nullptr, 2);
   EXPECT_THAT(view, FieldsMatch(View_u32{nullptr, 2}));
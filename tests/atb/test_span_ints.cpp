@@ -1,5 +1,14 @@
 #include "test_span_ints.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "atb/allocator/default.h"
+#include "test_allocator.hpp"
+
 #define _DEFINE_STREAMS(_, NAME, ...)                                       \
   auto operator<<(std::ostream &os, atb_Span_##NAME span)->std::ostream & { \
     os << "Span_" #NAME;                                                    \
@@ -21,6 +30,9 @@ namespace atb {
 
 namespace {
 
+using ::testing::_;
+using ::testing::Return;
+
 TEST(AtbSpanIntsTest, Convert) {
   std::uint64_t arr_u64[] = {1, 2, 3, 4};
   atb_Span_u64 span_u64 = atb_AnySpan_From_Array(arr_u64);
@@ -83,6 +95,605 @@ TEST(AtbSpanIntsTest, Convert) {
   }
 }
 
+template <typename T, typename View>
+void ExpectMismatch(std::size_t (*mismatch)(View, View),
+                    atb_Cmp_t (*compare)(View, View)) {
+  std::mt19937 rng(42);
+
+  for (int n = 0; n < 500; ++n) {
+    std::vector<T> lhs(rng() % 100);
+    for (auto &v : lhs) v = static_cast<T>(rng());
+
+    std::vector<T> rhs(lhs.begin(),
+                       lhs.begin() + static_cast<std::ptrdiff_t>(
+                                         rng() % (lhs.size() + 1)));
+    // Empty views are still VALID (non NULL data)
+    lhs.reserve(1);
+    rhs.reserve(1);
+
+    if (!rhs.empty() && ((rng() % 4) != 0)) {
+      rhs[rng() % rhs.size()] = static_cast<T>(rng());
+    }
+
+    View const l{lhs.data(), lhs.size()};
+    View const r{rhs.data(), rhs.size()};
+
+    auto const expected =
+        std::mismatch(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    ASSERT_EQ(mismatch(l, r),
+              static_cast<std::size_t>(expected.first - lhs.begin()));
+    ASSERT_EQ(mismatch(r, l),
+              static_cast<std::size_t>(expected.first - lhs.begin()));
+
+    atb_Cmp_t const order = std::lexicographical_compare(
+                                lhs.begin(), lhs.end(), rhs.begin(), rhs.end())
+                                ? K_ATB_CMP_LESS
+                                : ((lhs == rhs) ? K_ATB_CMP_EQUAL
+                                                : K_ATB_CMP_GREATER);
+    ASSERT_EQ(compare(l, r), order);
+  }
+}
+
+TEST(AtbSpanIntsTest, Mismatch) {
+  ExpectMismatch<std::int8_t>(atb_View_i8_Mismatch, atb_View_i8_CompareValues);
+  ExpectMismatch<std::int16_t>(atb_View_i16_Mismatch,
+                               atb_View_i16_CompareValues);
+  ExpectMismatch<std::int32_t>(atb_View_i32_Mismatch,
+                               atb_View_i32_CompareValues);
+  ExpectMismatch<std::int64_t>(atb_View_i64_Mismatch,
+                               atb_View_i64_CompareValues);
+  ExpectMismatch<std::uint8_t>(atb_View_u8_Mismatch,
+                               atb_View_u8_CompareValues);
+  ExpectMismatch<std::uint16_t>(atb_View_u16_Mismatch,
+                                atb_View_u16_CompareValues);
+  ExpectMismatch<std::uint32_t>(atb_View_u32_Mismatch,
+                                atb_View_u32_CompareValues);
+  ExpectMismatch<std::uint64_t>(atb_View_u64_Mismatch,
+                                atb_View_u64_CompareValues);
+}
+
+TEST(AtbSpanIntsTest, CompareValues) {
+  std::int32_t const negative[] = {-1};
+  std::int32_t const positive[] = {1, 2};
+  atb_View_i32 const lhs = atb_AnySpan_From_Array(negative);
+  atb_View_i32 const rhs = atb_AnySpan_From_Array(positive);
+
+  EXPECT_EQ(atb_View_i32_CompareValues(lhs, rhs), K_ATB_CMP_LESS);
+  EXPECT_EQ(atb_View_i32_CompareValues(rhs, lhs), K_ATB_CMP_GREATER);
+  EXPECT_EQ(atb_View_i32_CompareValues(lhs, lhs), K_ATB_CMP_EQUAL);
+
+  // Multi-bytes values are not ordered by their (little endian) bytes
+  std::uint16_t const small[] = {0x00FF};
+  std::uint16_t const large[] = {0x0100};
+  EXPECT_EQ(atb_View_u16_CompareValues(atb_AnySpan_From_Array(small),
+                                       atb_AnySpan_From_Array(large)),
+            K_ATB_CMP_LESS);
+}
+
+template <typename T, typename View>
+void ExpectSearch(bool (*find)(View, T, std::size_t *),
+                  bool (*rfind)(View, T, std::size_t *),
+                  std::size_t (*count)(View, T), bool (*contains)(View, T)) {
+  std::mt19937 rng(42);
+
+  for (int n = 0; n < 500; ++n) {
+    // Few distinct values: most searches find several matches
+    std::vector<T> values(rng() % 100);
+    for (auto &v : values) v = static_cast<T>(rng() % 8);
+    values.reserve(1);
+
+    View const view{values.data(), values.size()};
+    T const value = static_cast<T>(rng() % 9);
+
+    auto const first = std::find(values.begin(), values.end(), value);
+    auto const last = std::find(values.rbegin(), values.rend(), value);
+    auto const expected = std::count(values.begin(), values.end(), value);
+
+    std::size_t where = 1000;
+    ASSERT_EQ(find(view, value, &where), first != values.end());
+    if (first != values.end()) {
+      ASSERT_EQ(where, static_cast<std::size_t>(first - values.begin()));
+    }
+
+    where = 1000;
+    ASSERT_EQ(rfind(view, value, &where), last != values.rend());
+    if (last != values.rend()) {
+      ASSERT_EQ(where, values.size() - 1 -
+                           static_cast<std::size_t>(last - values.rbegin()));
+    } else {
+      ASSERT_EQ(where, 1000);
+    }
+
+    ASSERT_EQ(count(view, value), static_cast<std::size_t>(expected));
+    ASSERT_EQ(contains(view, value), expected > 0);
+  }
+}
+
+TEST(AtbSpanIntsTest, Search) {
+  ExpectSearch<std::int8_t>(atb_View_i8_Find, atb_View_i8_RFind,
+                            atb_View_i8_Count, atb_View_i8_Contains);
+  ExpectSearch<std::int16_t>(atb_View_i16_Find, atb_View_i16_RFind,
+                             atb_View_i16_Count, atb_View_i16_Contains);
+  ExpectSearch<std::int32_t>(atb_View_i32_Find, atb_View_i32_RFind,
+                             atb_View_i32_Count, atb_View_i32_Contains);
+  ExpectSearch<std::int64_t>(atb_View_i64_Find, atb_View_i64_RFind,
+                             atb_View_i64_Count, atb_View_i64_Contains);
+  ExpectSearch<std::uint8_t>(atb_View_u8_Find, atb_View_u8_RFind,
+                             atb_View_u8_Count, atb_View_u8_Contains);
+  ExpectSearch<std::uint16_t>(atb_View_u16_Find, atb_View_u16_RFind,
+                              atb_View_u16_Count, atb_View_u16_Contains);
+  ExpectSearch<std::uint32_t>(atb_View_u32_Find, atb_View_u32_RFind,
+                              atb_View_u32_Count, atb_View_u32_Contains);
+  ExpectSearch<std::uint64_t>(atb_View_u64_Find, atb_View_u64_RFind,
+                              atb_View_u64_Count, atb_View_u64_Contains);
+}
+
+TEST(AtbSpanIntsTest, SearchHalves) {
+  // Only one 32 bits half of the 64 bits value matching is not a match
+  std::uint64_t const values[] = {0x1'0000'0002, 0x2'0000'0001, 0x2, 0x1};
+  atb_View_u64 const view = atb_AnySpan_From_Array(values);
+
+  std::size_t where = 0;
+  EXPECT_TRUE(atb_View_u64_Find(view, 0x2, &where));
+  EXPECT_EQ(where, 2);
+  EXPECT_TRUE(atb_View_u64_RFind(view, 0x1, &where));
+  EXPECT_EQ(where, 3);
+  EXPECT_EQ(atb_View_u64_Count(view, 0x2), 1);
+  EXPECT_FALSE(atb_View_u64_Contains(view, 0x2'0000'0002));
+
+  // Negative values are found whatever their width
+  std::int16_t const negative[] = {1, -1, 1, -1, 1, -1, 1, -1, 1, -1};
+  EXPECT_TRUE(
+      atb_View_i16_RFind(atb_AnySpan_From_Array(negative), -1, &where));
+  EXPECT_EQ(where, 9);
+  EXPECT_EQ(atb_View_i16_Count(atb_AnySpan_From_Array(negative), -1), 5);
+}
+
+template <typename T, typename View> struct Reductions {
+  bool (*sum_unsafe)(View, T *);
+  bool (*sum_safely)(View, T *);
+  bool (*sum_saturate)(View, T *);
+  bool (*min)(View, T *);
+  bool (*max)(View, T *);
+  bool (*minmax)(View, T *, T *);
+};
+
+#define REDUCTIONS(T, NAME)                                                 \
+  Reductions<T, atb_View_##NAME> {                                          \
+    atb_View_##NAME##_Sum_Unsafe, atb_View_##NAME##_Sum_Safely,             \
+        atb_View_##NAME##_Sum_Saturate, atb_View_##NAME##_Min,              \
+        atb_View_##NAME##_Max, atb_View_##NAME##_MinMax                     \
+  }
+
+template <typename T, typename View>
+void ExpectReductions(Reductions<T, View> const &reduce) {
+  using Limits = std::numeric_limits<T>;
+  std::mt19937_64 rng(42);
+
+  for (int n = 0; n < 500; ++n) {
+    std::vector<T> values(rng() % 100);
+    // Mostly extreme values: sums overflowing (or not) whatever the type
+    for (auto &v : values) {
+      v = ((rng() % 2) == 0) ? static_cast<T>(rng())
+                             : (((rng() % 2) == 0) ? Limits::max()
+                                                   : Limits::min());
+    }
+    values.reserve(1);
+
+    View const view{values.data(), values.size()};
+    __int128 exact = 0;
+    for (auto v : values) exact += v;
+
+    T sum = 0;
+    EXPECT_TRUE(reduce.sum_unsafe(view, &sum));
+    ASSERT_EQ(sum, static_cast<T>(exact));
+
+    bool const fits = (exact >= Limits::min()) && (exact <= Limits::max());
+    sum = 42;
+    ASSERT_EQ(reduce.sum_safely(view, &sum), fits);
+    ASSERT_EQ(sum, fits ? static_cast<T>(exact) : 42);
+
+    ASSERT_EQ(reduce.sum_saturate(view, &sum), fits);
+    ASSERT_EQ(sum, fits ? static_cast<T>(exact)
+                        : ((exact < 0) ? Limits::min() : Limits::max()));
+
+    T min = 42;
+    T max = 42;
+    ASSERT_EQ(reduce.minmax(view, &min, &max), !values.empty());
+    if (values.empty()) {
+      ASSERT_EQ(min, 42);
+      ASSERT_FALSE(reduce.min(view, &min));
+      ASSERT_FALSE(reduce.max(view, &max));
+      continue;
+    }
+
+    auto const expected = std::minmax_element(values.begin(), values.end());
+    ASSERT_EQ(min, *expected.first);
+    ASSERT_EQ(max, *expected.second);
+
+    min = max = 42;
+    ASSERT_TRUE(reduce.min(view, &min));
+    ASSERT_TRUE(reduce.max(view, &max));
+    ASSERT_EQ(min, *expected.first);
+    ASSERT_EQ(max, *expected.second);
+  }
+}
+
+TEST(AtbSpanIntsTest, Reductions) {
+  ExpectReductions(REDUCTIONS(std::int8_t, i8));
+  ExpectReductions(REDUCTIONS(std::int16_t, i16));
+  ExpectReductions(REDUCTIONS(std::int32_t, i32));
+  ExpectReductions(REDUCTIONS(std::int64_t, i64));
+  ExpectReductions(REDUCTIONS(std::uint8_t, u8));
+  ExpectReductions(REDUCTIONS(std::uint16_t, u16));
+  ExpectReductions(REDUCTIONS(std::uint32_t, u32));
+  ExpectReductions(REDUCTIONS(std::uint64_t, u64));
+}
+
+TEST(AtbSpanIntsTest, SumCancelling) {
+  // Intermediate overflows cancelling out don't fail
+  std::int64_t const values[] = {INT64_MAX, 1,  INT64_MAX, -1,
+                                  INT64_MIN, -2, INT64_MIN};
+  std::int64_t sum = 0;
+  EXPECT_TRUE(
+      atb_View_i64_Sum_Safely(atb_AnySpan_From_Array(values), &sum));
+  EXPECT_EQ(sum, -4);
+
+  // Widened (16 bits) accumulators flushed over large views
+  std::vector<std::int16_t> large(300001, INT16_MAX);
+  for (std::size_t i = 1; i < large.size(); i += 2) large[i] = -INT16_MAX;
+  atb_View_i16 const view{large.data(), large.size()};
+  std::int16_t small = 0;
+  EXPECT_TRUE(atb_View_i16_Sum_Safely(view, &small));
+  EXPECT_EQ(small, INT16_MAX);
+
+  std::vector<std::uint16_t> ones(300000, 1);
+  std::uint16_t count = 0;
+  EXPECT_FALSE(atb_View_u16_Sum_Saturate(
+      atb_View_u16{ones.data(), ones.size()}, &count));
+  EXPECT_EQ(count, UINT16_MAX);
+}
+
+#undef REDUCTIONS
+
+// Wrapped around results of the _Unsafe element-wise operations
+template <typename T> T WrappedAdd(T lhs, T rhs) {
+  return static_cast<T>(static_cast<std::uint64_t>(lhs) +
+                        static_cast<std::uint64_t>(rhs));
+}
+template <typename T> T WrappedSub(T lhs, T rhs) {
+  return static_cast<T>(static_cast<std::uint64_t>(lhs) -
+                        static_cast<std::uint64_t>(rhs));
+}
+template <typename T> T WrappedMul(T lhs, T rhs) {
+  return static_cast<T>(static_cast<std::uint64_t>(lhs) *
+                        static_cast<std::uint64_t>(rhs));
+}
+
+template <typename T, typename Span, typename View> struct ElementWise {
+  bool (*reference)(T, T, T *); // atb_<OP>_<POLICY>_<INT> (atb/ints.h)
+  T (*wrapped)(T, T);
+  bool (*views)(Span, View, View);
+  bool (*scalar)(Span, View, T);
+  bool (*views_unsafe)(Span, View, View);
+  bool (*scalar_unsafe)(Span, View, T);
+};
+
+#define ELEMENTWISE(T, NAME, OP, POLICY)                                    \
+  ElementWise<T, atb_Span_##NAME, atb_View_##NAME> {                        \
+    atb_##OP##_##POLICY##_##NAME, Wrapped##OP<T>,                           \
+        atb_Span_##NAME##_##OP##_##POLICY,                                  \
+        atb_Span_##NAME##_##OP##Scalar_##POLICY,                            \
+        atb_Span_##NAME##_##OP##_Unsafe,                                    \
+        atb_Span_##NAME##_##OP##Scalar_Unsafe                               \
+  }
+
+template <typename T, typename Span, typename View>
+void ExpectElementWise(ElementWise<T, Span, View> const &op) {
+  using Limits = std::numeric_limits<T>;
+  std::mt19937_64 rng(42);
+
+  auto const random = [&rng]() {
+    switch (rng() % 4) {
+    case 0: return Limits::max();
+    case 1: return Limits::min();
+    case 2: return static_cast<T>(rng() % 16);
+    default: return static_cast<T>(rng());
+    }
+  };
+
+  for (int n = 0; n < 200; ++n) {
+    std::vector<T> lhs(rng() % 100);
+    std::vector<T> rhs(lhs.size());
+    std::vector<T> dest(lhs.size());
+    for (auto &v : lhs) v = random();
+    for (auto &v : rhs) v = random();
+    for (auto &v : dest) v = random();
+    lhs.reserve(1);
+    rhs.reserve(1);
+    dest.reserve(1);
+
+    T const scalar = random();
+    View const l{lhs.data(), lhs.size()};
+    View const r{rhs.data(), rhs.size()};
+
+    // Same result as the scalar policy, one element at a time
+    auto expected = dest;
+    bool success = true;
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+      success = op.reference(lhs[i], rhs[i], &expected[i]) && success;
+    }
+
+    auto result = dest;
+    ASSERT_EQ(op.views(Span{result.data(), result.size()}, l, r), success);
+    ASSERT_EQ(result, expected);
+
+    expected = dest;
+    success = true;
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+      success = op.reference(lhs[i], scalar, &expected[i]) && success;
+    }
+
+    result = dest;
+    ASSERT_EQ(op.scalar(Span{result.data(), result.size()}, l, scalar),
+              success);
+    ASSERT_EQ(result, expected);
+
+    // _Unsafe: overflowing elements wrap around
+    result = dest;
+    ASSERT_TRUE(op.views_unsafe(Span{result.data(), result.size()}, l, r));
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+      ASSERT_EQ(result[i], op.wrapped(lhs[i], rhs[i]));
+    }
+
+    result = dest;
+    ASSERT_TRUE(
+        op.scalar_unsafe(Span{result.data(), result.size()}, l, scalar));
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+      ASSERT_EQ(result[i], op.wrapped(lhs[i], scalar));
+    }
+  }
+}
+
+#define EXPECT_ELEMENTWISE(T, NAME, ...)                                    \
+  ExpectElementWise(ELEMENTWISE(T, NAME, Add, Safely));                     \
+  ExpectElementWise(ELEMENTWISE(T, NAME, Add, Saturate));                   \
+  ExpectElementWise(ELEMENTWISE(T, NAME, Sub, Safely));                     \
+  ExpectElementWise(ELEMENTWISE(T, NAME, Sub, Saturate));                   \
+  ExpectElementWise(ELEMENTWISE(T, NAME, Mul, Safely));                     \
+  ExpectElementWise(ELEMENTWISE(T, NAME, Mul, Saturate));
+
+TEST(AtbSpanIntsTest, ElementWise) { ATB_INTS_X_FOREACH(EXPECT_ELEMENTWISE) }
+
+TEST(AtbSpanIntsTest, ElementWiseInPlace) {
+  std::int16_t values[] = {1, 2, 3, 4, 5, 6, 7, 8, INT16_MAX, -3};
+  atb_Span_i16 const span = atb_AnySpan_From_Array(values);
+  atb_View_i16 const view = {values, span.size};
+
+  // INT16_MAX is left unchanged, then saturated
+  EXPECT_FALSE(atb_Span_i16_Add_Safely(span, view, view));
+  EXPECT_FALSE(atb_Span_i16_MulScalar_Saturate(span, view, 1000));
+
+  std::int16_t const expected[] = {2000,  4000,  6000,  8000,      10000,
+                                   12000, 14000, 16000, INT16_MAX, -6000};
+  EXPECT_TRUE(std::equal(std::begin(values), std::end(values),
+                         std::begin(expected)));
+}
+
+#undef EXPECT_ELEMENTWISE
+#undef ELEMENTWISE
+
+template <typename Src> auto RandomValues(std::mt19937_64 &rng) {
+  using Limits = std::numeric_limits<Src>;
+  std::vector<Src> values(rng() % 100);
+
+  for (auto &v : values) {
+    switch (rng() % 4) {
+    case 0: v = Limits::max(); break;
+    case 1: v = Limits::min(); break;
+    case 2: v = static_cast<Src>(rng() % 512) - static_cast<Src>(256); break;
+    default: v = static_cast<Src>(rng()); break;
+    }
+  }
+
+  values.reserve(1);
+  return values;
+}
+
+template <typename Dst, typename Src, typename DstSpan, typename SrcView>
+void ExpectWiden(void (*widen)(DstSpan, SrcView)) {
+  std::mt19937_64 rng(42);
+
+  for (int n = 0; n < 100; ++n) {
+    auto const src = RandomValues<Src>(rng);
+    std::vector<Dst> dest(src.size());
+    dest.reserve(1);
+
+    widen(DstSpan{dest.data(), dest.size()}, SrcView{src.data(), src.size()});
+    for (std::size_t i = 0; i < src.size(); ++i) {
+      ASSERT_EQ(dest[i], static_cast<Dst>(src[i]));
+    }
+  }
+}
+
+template <typename Dst, typename Src, typename DstSpan, typename SrcView>
+void ExpectNarrow(bool (*truncate)(DstSpan, SrcView),
+                  bool (*saturate)(DstSpan, SrcView),
+                  bool (*safely)(DstSpan, SrcView)) {
+  using Limits = std::numeric_limits<Dst>;
+  std::mt19937_64 rng(42);
+
+  for (int n = 0; n < 100; ++n) {
+    auto const src = RandomValues<Src>(rng);
+    SrcView const view{src.data(), src.size()};
+
+    std::vector<Dst> truncated(src.size());
+    std::vector<Dst> saturated(src.size());
+    std::vector<Dst> converted(src.size(), 42);
+    truncated.reserve(1);
+    saturated.reserve(1);
+    converted.reserve(1);
+
+    bool expected = true;
+    for (auto v : src) {
+      expected = expected && (v >= static_cast<__int128>(Limits::min())) &&
+                 (v <= static_cast<__int128>(Limits::max()));
+    }
+
+    ASSERT_TRUE(truncate(DstSpan{truncated.data(), truncated.size()}, view));
+    ASSERT_EQ(saturate(DstSpan{saturated.data(), saturated.size()}, view),
+              expected);
+    ASSERT_EQ(safely(DstSpan{converted.data(), converted.size()}, view),
+              expected);
+
+    for (std::size_t i = 0; i < src.size(); ++i) {
+      __int128 const v = src[i];
+      bool const below = v < static_cast<__int128>(Limits::min());
+      bool const above = v > static_cast<__int128>(Limits::max());
+
+      ASSERT_EQ(truncated[i], static_cast<Dst>(src[i]));
+      ASSERT_EQ(saturated[i], below   ? Limits::min()
+                              : above ? Limits::max()
+                                      : static_cast<Dst>(src[i]));
+      ASSERT_EQ(converted[i], (below || above) ? 42 : static_cast<Dst>(src[i]));
+    }
+  }
+}
+
+#define EXPECT_WIDEN(ST, SRC, SSIZE, DT, DST, ...)                           \
+  ExpectWiden<DT, ST>(atb_Span_##DST##_Widen_##SRC);
+
+#define EXPECT_NARROW(ST, SRC, SSIZE, DT, DST, ...)                          \
+  ExpectNarrow<DT, ST>(atb_Span_##DST##_Narrow_##SRC##_Truncate,             \
+                       atb_Span_##DST##_Narrow_##SRC##_Saturate,             \
+                       atb_Span_##DST##_Narrow_##SRC##_Safely);
+
+TEST(AtbSpanIntsTest, Widen) { _ATB_INTS_X_FOREACH_WIDENING(EXPECT_WIDEN) }
+
+TEST(AtbSpanIntsTest, Narrow) { _ATB_INTS_X_FOREACH_NARROWING(EXPECT_NARROW) }
+
+#undef EXPECT_NARROW
+#undef EXPECT_WIDEN
+
+template <typename T, typename Span>
+void ExpectRadixSort(bool (*sort)(Span, atb_Allocator const *,
+                                  atb_Error *)) {
+  std::mt19937_64 rng(42);
+
+  for (int n = 0; n < 50; ++n) {
+    // Small spans (insertion sort), and small values (skipped passes)
+    std::vector<T> values(rng() % ((n % 2) ? 40 : 3000));
+    for (auto &v : values) {
+      v = static_cast<T>((n % 3) ? rng() : (rng() % 1000));
+    }
+    values.reserve(1);
+
+    auto expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    ASSERT_TRUE(sort(Span{values.data(), values.size()}, atb_DefaultAllocator(),
+                     K_ATB_ERROR_IGNORED));
+    ASSERT_EQ(values, expected);
+  }
+}
+
+TEST(AtbSpanIntsTest, RadixSort) {
+  ExpectRadixSort<std::int8_t>(atb_Span_i8_RadixSort);
+  ExpectRadixSort<std::int16_t>(atb_Span_i16_RadixSort);
+  ExpectRadixSort<std::int32_t>(atb_Span_i32_RadixSort);
+  ExpectRadixSort<std::int64_t>(atb_Span_i64_RadixSort);
+  ExpectRadixSort<std::uint8_t>(atb_Span_u8_RadixSort);
+  ExpectRadixSort<std::uint16_t>(atb_Span_u16_RadixSort);
+  ExpectRadixSort<std::uint32_t>(atb_Span_u32_RadixSort);
+  ExpectRadixSort<std::uint64_t>(atb_Span_u64_RadixSort);
+}
+
+TEST(AtbSpanIntsTest, RadixSortAllocation) {
+  MockAllocator mock;
+  std::vector<std::int32_t> values(100);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<std::int32_t>(50 - i);
+  }
+  atb_Span_i32 const span{values.data(), values.size()};
+
+  // Failure: left untouched
+  auto const original = values;
+  EXPECT_CALL(mock, Alloc(nullptr, _, _)).WillOnce(Return(nullptr));
+  EXPECT_FALSE(atb_Span_i32_RadixSort(span, mock.Itf(), K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(values, original);
+  testing::Mock::VerifyAndClearExpectations(&mock);
+
+  // Already sorted on all digits (equal): no scratch memory needed
+  std::fill(values.begin(), values.end(), -7);
+  EXPECT_CALL(mock, Alloc(_, _, _)).Times(0);
+  EXPECT_TRUE(atb_Span_i32_RadixSort(span, mock.Itf(), K_ATB_ERROR_IGNORED));
+}
+
+TEST(AtbSpanIntsDeathTest, Mismatch) {
+  std::uint32_t const arr[] = {1};
+  atb_View_u32 const valid = atb_AnySpan_From_Array(arr);
+
+  EXPECT_DEBUG_DEATH(atb_View_u32_Mismatch(K_ATB_ANYSPAN_INVALID, valid),
+                     "IsValid\\(lhs\\)");
+  EXPECT_DEBUG_DEATH(atb_View_u32_Mismatch(valid, K_ATB_ANYSPAN_INVALID),
+                     "IsValid\\(rhs\\)");
+}
+
+TEST(AtbSpanIntsDeathTest, Reductions) {
+  std::uint32_t const arr[] = {1};
+  atb_View_u32 const valid = atb_AnySpan_From_Array(arr);
+  std::uint32_t dest = 0;
+
+  EXPECT_DEBUG_DEATH(atb_View_u32_Sum_Safely(K_ATB_ANYSPAN_INVALID, &dest),
+                     "IsValid\\(view\\)");
+  EXPECT_DEBUG_DEATH(atb_View_u32_Sum_Unsafe(valid, nullptr),
+                     "dest != NULL");
+  EXPECT_DEBUG_DEATH(atb_View_u32_MinMax(valid, &dest, nullptr),
+                     "max != NULL");
+}
+
+TEST(AtbSpanIntsDeathTest, ElementWise) {
+  std::uint8_t arr[] = {1, 2};
+  atb_Span_u8 const dest = atb_AnySpan_From_Array(arr);
+  atb_View_u8 const view = {arr, 2};
+  atb_View_u8 const shorter = {arr, 1};
+
+  EXPECT_DEBUG_DEATH(atb_Span_u8_Add_Safely(dest, shorter, view),
+                     "lhs.size == dest.size");
+  EXPECT_DEBUG_DEATH(atb_Span_u8_Mul_Unsafe(dest, view, shorter),
+                     "rhs.size == dest.size");
+  EXPECT_DEBUG_DEATH(
+      atb_Span_u8_SubScalar_Saturate(K_ATB_ANYSPAN_INVALID, view, 1),
+      "IsValid\\(dest\\)");
+}
+
+TEST(AtbSpanIntsDeathTest, Convert) {
+  std::int32_t values[] = {1, 2};
+  std::int16_t narrow[] = {1};
+
+  EXPECT_DEBUG_DEATH(
+      atb_Span_i16_Narrow_i32_Saturate(atb_AnySpan_From_Array(narrow),
+                                       atb_AnySpan_From_Array(values)),
+      "src.size == dest.size");
+  EXPECT_DEBUG_DEATH(atb_Span_i32_Widen_i16(K_ATB_ANYSPAN_INVALID,
+                                            atb_AnySpan_From_Array(narrow)),
+                     "IsValid\\(dest\\)");
+}
+
+TEST(AtbSpanIntsDeathTest, RadixSort) {
+  EXPECT_DEBUG_DEATH(atb_Span_u16_RadixSort(K_ATB_ANYSPAN_INVALID,
+                                            atb_DefaultAllocator(),
+                                            K_ATB_ERROR_IGNORED),
+                     "IsValid\\(span\\)");
+}
+
+TEST(AtbSpanIntsDeathTest, Search) {
+  EXPECT_DEBUG_DEATH(atb_View_u8_Find(K_ATB_ANYSPAN_INVALID, 0, nullptr),
+                     "IsValid\\(view\\)");
+  EXPECT_DEBUG_DEATH(atb_View_u8_Count(K_ATB_ANYSPAN_INVALID, 0),
+                     "IsValid\\(view\\)");
+}
+
 } // namespace
 
 } // namespace atb
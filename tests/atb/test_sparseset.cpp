@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "atb/allocator/default.h"
+#include "atb/sparseset.h"
+#include "gtest/gtest.h"
+#include "test_allocator.hpp"
+
+namespace {
+
+using ::testing::_;
+using ::testing::Return;
+
+struct AtbSparseSetTest : testing::Test {
+  void SetUp() override { atb_SparseSet_Init(&set, atb_DefaultAllocator()); }
+  void TearDown() override { atb_SparseSet_Destroy(&set); }
+
+  auto Members() const -> std::set<std::uint32_t> {
+    auto const members = atb_SparseSet_Members(&set);
+    return {members.data, members.data + members.size};
+  }
+
+  atb_SparseSet set = {};
+};
+
+using AtbSparseSetDeathTest = AtbSparseSetTest;
+
+TEST_F(AtbSparseSetTest, Empty) {
+  EXPECT_EQ(atb_SparseSet_Size(&set), 0);
+  EXPECT_EQ(atb_SparseSet_Members(&set).size, 0);
+  EXPECT_FALSE(atb_SparseSet_Contains(&set, 0));
+  EXPECT_FALSE(atb_SparseSet_Contains(&set, UINT32_MAX));
+  EXPECT_FALSE(atb_SparseSet_Erase(&set, 0));
+}
+
+TEST_F(AtbSparseSetTest, InsertErase) {
+  EXPECT_TRUE(atb_SparseSet_Insert(&set, 1000, K_ATB_ERROR_IGNORED));
+  EXPECT_TRUE(atb_SparseSet_Insert(&set, 3, K_ATB_ERROR_IGNORED));
+  EXPECT_TRUE(atb_SparseSet_Insert(&set, 3, K_ATB_ERROR_IGNORED));
+  EXPECT_TRUE(atb_SparseSet_Insert(&set, 0, K_ATB_ERROR_IGNORED));
+
+  EXPECT_EQ(atb_SparseSet_Size(&set), 3);
+  EXPECT_EQ(Members(), (std::set<std::uint32_t>{0, 3, 1000}));
+  EXPECT_TRUE(atb_SparseSet_Contains(&set, 1000));
+  EXPECT_FALSE(atb_SparseSet_Contains(&set, 999));
+  EXPECT_FALSE(atb_SparseSet_Contains(&set, 1001));
+
+  EXPECT_TRUE(atb_SparseSet_Erase(&set, 1000));
+  EXPECT_FALSE(atb_SparseSet_Erase(&set, 1000));
+  EXPECT_FALSE(atb_SparseSet_Contains(&set, 1000));
+  EXPECT_EQ(Members(), (std::set<std::uint32_t>{0, 3}));
+
+  // Last member moved in place of the erased one
+  auto const members = atb_SparseSet_Members(&set);
+  EXPECT_EQ(members.data[0], 0);
+  EXPECT_EQ(members.data[1], 3);
+}
+
+TEST_F(AtbSparseSetTest, LargestId) {
+  EXPECT_TRUE(atb_SparseSet_Reserve(&set, 16, 1, K_ATB_ERROR_IGNORED));
+  EXPECT_FALSE(atb_SparseSet_Contains(&set, 15));
+
+  EXPECT_TRUE(atb_SparseSet_Insert(&set, 15, K_ATB_ERROR_IGNORED));
+  EXPECT_TRUE(atb_SparseSet_Contains(&set, 15));
+  EXPECT_EQ(set.universe, 16);
+  EXPECT_EQ(set.capacity, 1);
+}
+
+TEST_F(AtbSparseSetTest, Clear) {
+  for (std::uint32_t id = 0; id < 100; id += 2) {
+    ASSERT_TRUE(atb_SparseSet_Insert(&set, id, K_ATB_ERROR_IGNORED));
+  }
+  auto const capacity = set.capacity;
+
+  atb_SparseSet_Clear(&set);
+  EXPECT_EQ(atb_SparseSet_Size(&set), 0);
+  EXPECT_EQ(set.capacity, capacity);
+
+  // Stale sparse entries are never seen as members
+  for (std::uint32_t id = 0; id < 100; ++id) {
+    EXPECT_FALSE(atb_SparseSet_Contains(&set, id)) << id;
+  }
+
+  EXPECT_TRUE(atb_SparseSet_Insert(&set, 50, K_ATB_ERROR_IGNORED));
+  EXPECT_TRUE(atb_SparseSet_Contains(&set, 50));
+  EXPECT_FALSE(atb_SparseSet_Contains(&set, 0));
+}
+
+TEST_F(AtbSparseSetTest, Random) {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<std::uint32_t> ids(0, 4096);
+  std::set<std::uint32_t> expected;
+
+  for (int i = 0; i < 20000; ++i) {
+    auto const id = ids(rng);
+
+    if ((rng() % 3) == 0) {
+      EXPECT_EQ(atb_SparseSet_Erase(&set, id), (expected.erase(id) == 1));
+    } else {
+      ASSERT_TRUE(atb_SparseSet_Insert(&set, id, K_ATB_ERROR_IGNORED));
+      expected.insert(id);
+    }
+
+    ASSERT_EQ(atb_SparseSet_Size(&set), expected.size());
+    ASSERT_EQ(atb_SparseSet_Contains(&set, id), (expected.count(id) == 1));
+  }
+
+  EXPECT_EQ(Members(), expected);
+}
+
+TEST_F(AtbSparseSetTest, AllocationFailure) {
+  atb::MockAllocator mock;
+  atb_SparseSet failing;
+  atb_SparseSet_Init(&failing, mock.Itf());
+
+  EXPECT_CALL(mock, Alloc(nullptr, _, _))
+      .WillOnce([](void *, std::size_t size, atb_Error *) {
+        return std::malloc(size);
+      })
+      .WillOnce(Return(nullptr));
+  EXPECT_CALL(mock, Release(_, _)).WillRepeatedly([](void *mem, atb_Error *) {
+    std::free(mem);
+    return true;
+  });
+
+  EXPECT_FALSE(atb_SparseSet_Insert(&failing, 7, K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(atb_SparseSet_Size(&failing), 0);
+  EXPECT_FALSE(atb_SparseSet_Contains(&failing, 7));
+
+  atb_SparseSet_Destroy(&failing);
+}
+
+TEST_F(AtbSparseSetTest, TooLarge) {
+  if (sizeof(std::size_t) > sizeof(std::uint32_t)) {
+    EXPECT_FALSE(atb_SparseSet_Reserve(&set, 0, SIZE_MAX, K_ATB_ERROR_IGNORED));
+  }
+  EXPECT_EQ(set.capacity, 0);
+}
+
+TEST_F(AtbSparseSetDeathTest, InvalidUniverse) {
+  if (sizeof(std::size_t) > sizeof(std::uint32_t)) {
+    EXPECT_DEBUG_DEATH(atb_SparseSet_Reserve(&set, SIZE_MAX, 0,
+                                             K_ATB_ERROR_IGNORED),
+                       "universe");
+  }
+}
+
+} // namespace
@@ -1,5 +1,10 @@
+#include <cstdlib>
+#include <string>
+
+#include "atb/allocator/default.h"
 #include "atb/string.h"
 #include "gtest/gtest.h"
+#include "test_allocator.hpp"
 #include "test_error.hpp"
 #include "test_span_string.hpp"
 
@@ -295,5 +300,127 @@ TEST(AtbStringTest, GetIntBase) {
                    }));
 }
 
+struct AtbOwnedStringTest : testing::Test {
+  void SetUp() override { atb_String_Init(&str, atb_DefaultAllocator()); }
+  void TearDown() override { atb_String_Destroy(&str); }
+
+  static auto View(std::string const &s) -> atb_StrView {
+    return atb_StrView{s.data(), s.size()};
+  }
+
+  auto Content() const -> std::string {
+    auto const view = atb_String_View(&str);
+    EXPECT_EQ(view.data[view.size], '\0');
+    EXPECT_EQ(view.data, atb_String_CStr(&str));
+    return {view.data, view.size};
+  }
+
+  atb_String str = {};
+};
+
+using AtbOwnedStringDeathTest = AtbOwnedStringTest;
+
+TEST_F(AtbOwnedStringTest, Empty) {
+  EXPECT_TRUE(atb_String_IsInline(&str));
+  EXPECT_EQ(atb_String_Size(&str), 0);
+  EXPECT_EQ(atb_String_Capacity(&str), K_ATB_STRING_INLINE_CAPACITY);
+  EXPECT_EQ(Content(), "");
+}
+
+TEST_F(AtbOwnedStringTest, Inline) {
+  std::string const full(K_ATB_STRING_INLINE_CAPACITY, 'x');
+
+  EXPECT_TRUE(atb_String_Assign(&str, View("label"), K_ATB_ERROR_IGNORED));
+  EXPECT_TRUE(atb_String_IsInline(&str));
+  EXPECT_EQ(Content(), "label");
+
+  EXPECT_TRUE(atb_String_Assign(&str, View(full), K_ATB_ERROR_IGNORED));
+  EXPECT_TRUE(atb_String_IsInline(&str));
+  EXPECT_EQ(Content(), full);
+
+  atb_StrSpan const span = atb_String_Span(&str);
+  span.data[0] = 'y';
+  EXPECT_EQ(Content()[0], 'y');
+}
+
+TEST_F(AtbOwnedStringTest, Heap) {
+  std::string expected;
+
+  for (int i = 0; i < 100; ++i) {
+    auto const chunk = std::to_string(i);
+    ASSERT_TRUE(atb_String_Append(&str, View(chunk), K_ATB_ERROR_IGNORED));
+    expected += chunk;
+
+    EXPECT_EQ(atb_String_IsInline(&str),
+              expected.size() <= K_ATB_STRING_INLINE_CAPACITY);
+    EXPECT_GE(atb_String_Capacity(&str), expected.size());
+    ASSERT_EQ(Content(), expected);
+  }
+
+  auto const capacity = atb_String_Capacity(&str);
+  atb_String_Clear(&str);
+  EXPECT_EQ(Content(), "");
+  EXPECT_EQ(atb_String_Capacity(&str), capacity);
+
+  EXPECT_TRUE(atb_String_Assign(&str, View("short"), K_ATB_ERROR_IGNORED));
+  EXPECT_FALSE(atb_String_IsInline(&str));
+  EXPECT_EQ(Content(), "short");
+}
+
+TEST_F(AtbOwnedStringTest, Aliasing) {
+  EXPECT_TRUE(atb_String_Assign(&str, View("0123456789"), K_ATB_ERROR_IGNORED));
+
+  // Append itself (forcing a move to the heap)
+  EXPECT_TRUE(
+      atb_String_Append(&str, atb_String_View(&str), K_ATB_ERROR_IGNORED));
+  EXPECT_TRUE(
+      atb_String_Append(&str, atb_String_View(&str), K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(Content(), "0123456789012345678901234567890123456789");
+
+  auto view = atb_String_View(&str);
+  view.data += 35;
+  view.size = 5;
+  EXPECT_TRUE(atb_String_Assign(&str, view, K_ATB_ERROR_IGNORED));
+  EXPECT_EQ(Content(), "56789");
+}
+
+TEST_F(AtbOwnedStringTest, Reserve) {
+  EXPECT_TRUE(atb_String_Assign(&str, View("abc"), K_ATB_ERROR_IGNORED));
+  EXPECT_TRUE(atb_String_Reserve(&str, 10, K_ATB_ERROR_IGNORED));
+  EXPECT_TRUE(atb_String_IsInline(&str));
+
+  EXPECT_TRUE(atb_String_Reserve(&str, 100, K_ATB_ERROR_IGNORED));
+  EXPECT_FALSE(atb_String_IsInline(&str));
+  EXPECT_EQ(atb_String_Capacity(&str), 100);
+  EXPECT_EQ(Content(), "abc");
+
+  atb_Error err;
+  EXPECT_FALSE(atb_String_Reserve(&str, SIZE_MAX, &err));
+  EXPECT_EQ(atb_String_Capacity(&str), 100);
+}
+
+TEST_F(AtbOwnedStringTest, AllocationFailure) {
+  MockAllocator mock;
+  atb_String failing;
+  atb_String_Init(&failing, mock.Itf());
+
+  EXPECT_CALL(mock, Alloc(nullptr, testing::_, testing::_))
+      .WillOnce(testing::Return(nullptr));
+
+  EXPECT_TRUE(atb_String_Assign(&failing, View("fits"), K_ATB_ERROR_IGNORED));
+  EXPECT_FALSE(atb_String_Append(&failing, View(std::string(40, 'x')),
+                                 K_ATB_ERROR_IGNORED));
+  EXPECT_TRUE(atb_String_IsInline(&failing));
+  EXPECT_EQ(std::string(atb_String_CStr(&failing)), "fits");
+
+  atb_String_Destroy(&failing);
+}
+
+TEST_F(AtbOwnedStringDeathTest, Assign) {
+  EXPECT_DEBUG_DEATH(atb_String_Assign(&str, atb_StrView{nullptr, 1},
+                                       K_ATB_ERROR_IGNORED),
+                     "str.data != NULL");
+}
+
 } // namespace
 } // namespace atb